@@ -1,6 +1,7 @@
 #include "DemoBrowser.hpp"
 
 #include "Demos/DynamicImageDemo.hpp"
+#include "Demos/FlushBenchmarkDemo.hpp"
 #include "Demos/InputDemo.hpp"
 #include "Demos/ScissorRectsDemo.hpp"
 #include "Demos/ShadersDemo.hpp"
@@ -188,6 +189,7 @@ void DemoBrowser::createFactoryFunctions()
         CREATE_DEMO(ShadersDemo),
         CREATE_DEMO(DynamicImageDemo),
         CREATE_DEMO(ScissorRectsDemo),
+        CREATE_DEMO(FlushBenchmarkDemo),
     };
 }
 
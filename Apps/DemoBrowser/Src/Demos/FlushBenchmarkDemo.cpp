@@ -0,0 +1,99 @@
+#include "FlushBenchmarkDemo.hpp"
+
+#include "DemoBrowser.hpp"
+
+FlushBenchmarkDemo::FlushBenchmarkDemo(DemoBrowser* browser)
+    : Demo("Flush Benchmark", browser)
+    , _image("logo32.png")
+{
+    // Don't let the display's refresh rate limit the measurement.
+    auto window            = browser->window();
+    _wasDisplaySyncEnabled = window.isDisplaySyncEnabled();
+    window.setIsDisplaySyncEnabled(false);
+}
+
+FlushBenchmarkDemo::~FlushBenchmarkDemo() noexcept
+{
+    browser().window().setIsDisplaySyncEnabled(_wasDisplaySyncEnabled);
+}
+
+void FlushBenchmarkDemo::update(GameTime time)
+{
+    _measuredTime += time.elapsedPrecise();
+    ++_measuredFrames;
+
+    if (_measuredTime >= 1.0)
+    {
+        _averageFrameTime = _measuredTime / _measuredFrames;
+        _measuredTime     = 0.0;
+        _measuredFrames   = 0;
+    }
+}
+
+void FlushBenchmarkDemo::draw(Painter painter)
+{
+    const auto cellSize = _image.size();
+    const auto rowCount = max(int(painter.viewSize().y / cellSize.y), 1);
+
+    const auto meshVertices = Array{
+        MeshVertex{.position = Vec2(0, 0), .uv = Vec2(0, 0), .color = white},
+        MeshVertex{.position = Vec2(cellSize.x, 0), .uv = Vec2(1, 0), .color = white},
+        MeshVertex{.position = Vec2(0, cellSize.y), .uv = Vec2(0, 1), .color = white},
+        MeshVertex{.position = cellSize, .uv = Vec2(1, 1), .color = white},
+    };
+
+    const auto meshIndices = Array<uint16_t, 6>{0, 1, 2, 2, 1, 3};
+
+    for (int i = 0; i < _iterationsPerFrame; ++i)
+    {
+        const auto y     = float(i % rowCount) * cellSize.y;
+        const auto color = Color(float(i % 7) / 6.0f, 0.5f, 1.0f - (float(i % 5) / 4.0f));
+
+        // Sprites, polygons and meshes are drawn in different batches, so switching between them
+        // flushes the painter.
+        for (int j = 0; j < _spritesPerIteration; ++j)
+        {
+            painter.drawSprite(_image, Vec2(float(j) * cellSize.x, y), color);
+        }
+
+        painter.fillRectangle(
+            Rectangle(float(_spritesPerIteration) * cellSize.x, y, cellSize.x, cellSize.y),
+            color);
+
+        auto transformedVertices = meshVertices;
+
+        for (auto& vertex : transformedVertices)
+        {
+            vertex.position += Vec2(float(_spritesPerIteration + 1) * cellSize.x, y);
+            vertex.color = color;
+        }
+
+        painter.drawMesh(transformedVertices, meshIndices, _image);
+    }
+}
+
+void FlushBenchmarkDemo::onImGui(ImGui imgui)
+{
+    imgui.slider("Iterations", _iterationsPerFrame, 1, 2000);
+    imgui.slider("Sprites", _spritesPerIteration, 1, 256);
+    imgui.newLine();
+
+    const auto stats = browser().performanceStats();
+
+    imgui.separatorWithText("Results");
+    imgui.text("Frame Time: %.3f ms", _averageFrameTime * 1000.0);
+    imgui.text("Flushes per Frame: %u", stats.drawCallCount);
+    imgui.text("Sprite Buffer: %u KiB", stats.spriteBufferHighWaterMark / 1024);
+    imgui.text("Polygon Buffer: %u KiB", stats.polygonBufferHighWaterMark / 1024);
+    imgui.text(
+        "Mesh Buffers: %u KiB",
+        (stats.meshVertexBufferHighWaterMark + stats.meshIndexBufferHighWaterMark) / 1024);
+    imgui.newLine();
+
+    imgui.checkbox("Show Profiler", _isProfilerVisible);
+
+    if (_isProfilerVisible)
+    {
+        showProfilerWindow(imgui);
+    }
+}
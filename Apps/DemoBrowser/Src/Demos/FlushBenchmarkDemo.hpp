@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Demo.hpp"
+
+// Measures the cost of flushing the painter many times per frame.
+//
+// Every iteration draws a batch of sprites, polygons and a mesh, so that each one results in
+// a separate flush. This stresses the way a backend streams vertex data to the GPU.
+//
+// To compare the persistently mapped and the per-draw mapped OpenGL paths under Mesa's software
+// rasterizer, run the demo with LIBGL_ALWAYS_SOFTWARE=1 (llvmpipe), once as-is and once with
+// MESA_GL_VERSION_OVERRIDE=3.3, which hides buffer storage support from Polly.
+class FlushBenchmarkDemo final : public Demo
+{
+  public:
+    explicit FlushBenchmarkDemo(DemoBrowser* browser);
+
+    ~FlushBenchmarkDemo() noexcept override;
+
+    void update(GameTime time) override;
+
+    void draw(Painter painter) override;
+
+    void onImGui(ImGui imgui) override;
+
+  private:
+    Image _image;
+    bool  _wasDisplaySyncEnabled = false;
+    int   _iterationsPerFrame    = 200;
+    int   _spritesPerIteration   = 16;
+    bool  _isProfilerVisible     = false;
+
+    // Frame times are averaged over a second, so that they're readable.
+    double _measuredTime     = 0.0;
+    u32    _measuredFrames   = 0;
+    double _averageFrameTime = 0.0;
+};
@@ -28,7 +28,8 @@ if command_name == 'compile':
         args.base,
         args.asset,
         args.dst,
-        args.optimize)
+        args.optimize,
+        args.shadercompiler)
 elif command_name == 'pack':
     command = PackAssetsCommand(
         args.encryptionkey,
@@ -22,6 +22,10 @@ def add_arg_options(command_name: str, parser: argparse.ArgumentParser):
         parser.add_argument('--encryptionkey',
                             help='The key to use for the encryption of asset data.',
                             required=True)
+
+        parser.add_argument('--shadercompiler',
+                            help='Path to the PollyShaderCompiler executable, used to precompile shaders.',
+                            required=False)
     elif command_name == 'pack':
         parser.add_argument('--dst',
                             help='Path to the destination archive.',
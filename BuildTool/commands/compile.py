@@ -3,6 +3,9 @@ import io
 import os
 import pathlib
 import json
+import subprocess
+import sys
+import tempfile
 import zlib
 
 from util import Util, BinaryWriter
@@ -14,13 +17,15 @@ image_file_extensions = ['png', 'bmp', 'jpg',
 
 
 class CompileAssetCommand:
-    def __init__(self, encryption_key: str, base: str, asset: str, dst: str, optimize: bool):
+    def __init__(self, encryption_key: str, base: str, asset: str, dst: str, optimize: bool,
+                 shader_compiler: str = None):
         self.encryption_key = encryption_key
         self.base = base
         self.asset_filename = os.path.join(base, asset)
         self.dst_filename = dst
         self.optimize = optimize
         self.asset_name = Util.get_clean_path(asset)
+        self.shader_compiler = shader_compiler
 
     def execute(self):
         with self.__process_asset() as processed_data:
@@ -80,11 +85,33 @@ class CompileAssetCommand:
         writer.write_bytes_no_length(self.__load_asset_contents())
 
     def __process_shader(self, writer: BinaryWriter):
+        if self.shader_compiler:
+            self.__process_precompiled_shader(writer)
+            return
+
         writer.write_u8(ord('s'))
         shader_source_bytes = self.__load_asset_contents()
         shader_source_code = shader_source_bytes.decode('utf-8')
         writer.write_str_encrypted(shader_source_code)
 
+    def __process_precompiled_shader(self, writer: BinaryWriter):
+        # The shader compiler verifies the shader and generates its code for the game's
+        # graphics backend, so that none of this has to happen when the game loads it.
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            tmp_filename = os.path.join(tmp_dir, 'shader.bin')
+
+            result = subprocess.run([self.shader_compiler,
+                                     self.asset_filename,
+                                     self.asset_name,
+                                     tmp_filename,
+                                     self.encryption_key])
+
+            if result.returncode != 0:
+                sys.exit(f'Failed to compile shader "{self.asset_name}".')
+
+            writer.write_u8(ord('p'))
+            writer.write_bytes_no_length(Util.load_file_contents(tmp_filename))
+
     def __process_font(self, writer: BinaryWriter):
         writer.write_u8(ord('f'))
         writer.write_bytes_no_length(self.__load_asset_contents())
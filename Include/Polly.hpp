@@ -19,6 +19,7 @@
 #include "Polly/Degrees.hpp"
 #include "Polly/Direction.hpp"
 #include "Polly/Display.hpp"
+#include "Polly/DrawStateCombination.hpp"
 #include "Polly/Error.hpp"
 #include "Polly/Event.hpp"
 #include "Polly/FileSystem.hpp"
@@ -29,6 +30,7 @@
 #include "Polly/Gamepad.hpp"
 #include "Polly/GamePerformanceStats.hpp"
 #include "Polly/Image.hpp"
+#include "Polly/ImageAtlasOptions.hpp"
 #include "Polly/ImGui.hpp"
 #include "Polly/Input.hpp"
 #include "Polly/Interval.hpp"
@@ -47,12 +49,14 @@
 #include "Polly/Narrow.hpp"
 #include "Polly/NotNull.hpp"
 #include "Polly/Painter.hpp"
+#include "Polly/PainterCommandList.hpp"
 #include "Polly/Pair.hpp"
 #include "Polly/Particle.hpp"
 #include "Polly/ParticleEmitter.hpp"
 #include "Polly/ParticleModifier.hpp"
 #include "Polly/ParticleSystem.hpp"
 #include "Polly/PlatformInfo.hpp"
+#include "Polly/Profiler.hpp"
 #include "Polly/Radians.hpp"
 #include "Polly/Random.hpp"
 #include "Polly/ReadableFile.hpp"
@@ -70,6 +74,7 @@
 #include "Polly/Span.hpp"
 #include "Polly/Spine.hpp"
 #include "Polly/Sprite.hpp"
+#include "Polly/StaticSpriteBatch.hpp"
 #include "Polly/String.hpp"
 #include "Polly/StringView.hpp"
 #include "Polly/Text.hpp"
@@ -79,6 +84,7 @@
 #include "Polly/UniquePtr.hpp"
 #include "Polly/Util.hpp"
 #include "Polly/Version.hpp"
+#include "Polly/VertexGenerationOptions.hpp"
 #include "Polly/Window.hpp"
 #include "Polly/WritableFile.hpp"
 
@@ -0,0 +1,34 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly, a minimalistic 2D C++ game framework.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/BlendState.hpp"
+#include "Polly/Image.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/Shader.hpp"
+
+namespace Polly
+{
+/// Describes a combination of drawing states that the painter can prepare ahead of time.
+///
+/// @see Painter::prepareDrawStates()
+struct DrawStateCombination
+{
+    /// The kind of objects that are drawn using the states.
+    ShaderType objectType = ShaderType::Sprite;
+
+    /// The custom shader that is set for the objects, for example via Painter::setSpriteShader().
+    /// If empty, the painter's built-in shaders for the kind of objects are prepared.
+    /// If set, its type must be equal to objectType.
+    Shader shader;
+
+    /// The blend state that is set for the objects.
+    BlendState blendState = nonPremultiplied;
+
+    /// The format of the canvas that the objects are drawn into.
+    /// If empty, the objects are drawn directly into the window.
+    Maybe<ImageFormat> canvasFormat;
+};
+} // namespace Polly
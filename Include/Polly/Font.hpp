@@ -16,6 +16,66 @@ struct Vec2;
 
 using GlyphAction = Function<bool(char32_t codepoint, const Rectangle& rect)>;
 
+/// Describes how much of a font's glyph atlas is in use.
+///
+/// @see Font::atlasStats
+struct FontAtlasStats
+{
+    /// The number of atlas pages (images) that the font has allocated.
+    u32 pageCount = 0;
+
+    /// The number of bytes that the font's atlas pages occupy.
+    u64 byteCount = 0;
+
+    /// The number of glyphs that were rasterized, across all sizes.
+    u32 glyphCount = 0;
+
+    /// The number of glyphs that were rasterized as distance fields.
+    u32 distanceFieldGlyphCount = 0;
+
+    /// The number of atlas pixels that are occupied by glyphs, including their padding.
+    u64 usedPixelCount = 0;
+
+    /// The number of pixels of all atlas pages combined.
+    u64 totalPixelCount = 0;
+
+    /// The fraction of the total page area that is occupied by glyphs,
+    /// in the range [0.0 .. 1.0].
+    double occupancy = 0.0;
+
+    /// The total number of glyphs that have been evicted from the atlas.
+    u32 evictedGlyphCount = 0;
+
+    /// The total number of times that an atlas page has been repacked to make room for new glyphs.
+    u32 recycledPageCount = 0;
+};
+
+/// Defines how a font caches its rasterized glyphs.
+///
+/// @see Font::setCacheOptions
+struct FontCacheOptions
+{
+    /// Font sizes are rounded to a multiple of this value before glyphs are rasterized,
+    /// so that text of similar sizes shares the same glyphs. Glyphs are then slightly
+    /// scaled to the requested size.
+    ///
+    /// Zero disables rounding, which rasterizes glyphs for every distinct font size.
+    float sizeQuantum = 0.0f;
+
+    /// The number of bytes that the font's atlas pages may occupy.
+    ///
+    /// When a new page would exceed this budget, the least recently used page is repacked
+    /// instead, keeping only the glyphs that were used recently. If no page can be repacked,
+    /// a new page is allocated regardless.
+    ///
+    /// Zero means that the atlas may grow without bounds.
+    u64 maxAtlasByteCount = 0;
+
+    /// The number of frames a glyph has to remain unused before it may be evicted
+    /// from the atlas. Eviction only happens when the atlas budget is exhausted.
+    u32 evictionAge = 120;
+};
+
 /// Represents a font to draw simple text.
 ///
 /// Fonts can be drawn using Painter::drawString() and Painter::drawText() function.
@@ -64,6 +124,45 @@ class Font final
     /// @param action The action to perform for each glyph.
     void forEachGlyph(StringView text, float size, const GlyphAction& action) const;
 
+    /// Sets whether the font draws its glyphs using signed distance fields.
+    ///
+    /// Normally, every glyph is rasterized once per font size. In distance field mode,
+    /// every glyph is instead rasterized once as a distance field and then drawn at any
+    /// size by a special sprite shader. This saves atlas space and rasterization time when
+    /// text is drawn at many different sizes or is scaled, at the cost of slightly softer
+    /// corners at large sizes.
+    ///
+    /// Text that is drawn in distance field mode may have an outline and a glow.
+    /// These are set using Painter::setDistanceFieldTextStyle().
+    ///
+    /// Text objects keep the mode that their font had when they were created.
+    ///
+    /// The mode is disabled by default. It's not supported by the Software backend, which
+    /// can't run the distance field shader; fonts keep drawing bitmap glyphs there.
+    ///
+    /// @param value True if glyphs should be drawn using distance fields; false otherwise.
+    void setDistanceFieldEnabled(bool value);
+
+    /// Gets a value indicating whether the font draws its glyphs using signed distance fields.
+    ///
+    /// @see setDistanceFieldEnabled
+    bool isDistanceFieldEnabled() const;
+
+    /// Gets statistics about the font's glyph atlas.
+    FontAtlasStats atlasStats() const;
+
+    /// Gets the options that define how the font caches its glyphs.
+    FontCacheOptions cacheOptions() const;
+
+    /// Sets the options that define how the font caches its glyphs.
+    ///
+    /// Long-running games that draw a lot of different characters, for example from
+    /// user-generated text, should set an atlas budget, so that the atlas doesn't grow
+    /// indefinitely.
+    ///
+    /// @param options The options to use for subsequently rasterized glyphs.
+    void setCacheOptions(const FontCacheOptions& options);
+
     StringView assetName() const;
 };
 } // namespace Polly
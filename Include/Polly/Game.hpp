@@ -8,10 +8,12 @@
 #include "Polly/Display.hpp"
 #include "Polly/Event.hpp"
 #include "Polly/GameTime.hpp"
+#include "Polly/ImageAtlasOptions.hpp"
 #include "Polly/Maybe.hpp"
 #include "Polly/Prerequisites.hpp"
 #include "Polly/UniquePtr.hpp"
 #include "Polly/Version.hpp"
+#include "Polly/VertexGenerationOptions.hpp"
 
 namespace Polly
 {
@@ -49,6 +51,33 @@ struct GameInitArgs
     /// If empty, the game window will be created in a normal state,
     /// on the system's default display.
     Maybe<u32> fullScreenDisplayIndex;
+
+    /// If true, the game runs without a visible window and without using the GPU.
+    ///
+    /// Every draw call is still accepted, batched and accounted for in the game's
+    /// performance stats, but nothing is rendered. Audio is disabled as well.
+    /// This is useful for dedicated servers, bots and simulations that share their code
+    /// with the actual game, and for measuring the pure CPU cost of a game's frames.
+    bool isHeadless = false;
+
+    /// If specified, every game tick advances the game time by exactly this
+    /// number of seconds, regardless of how much real time has passed.
+    ///
+    /// Combined with an uncapped framerate (see Game::setTargetFramerate()), this allows a
+    /// game to be simulated as fast as possible while remaining deterministic.
+    Maybe<double> fixedTimeStep;
+
+    /// If specified, small images are automatically packed into shared atlas pages,
+    /// which reduces the number of draw calls when drawing many different images.
+    ///
+    /// @see ImageAtlasOptions
+    Maybe<ImageAtlasOptions> imageAtlasing;
+
+    /// Defines how the vertices of large sprite and mesh batches are generated
+    /// on multiple threads.
+    ///
+    /// @see VertexGenerationOptions
+    VertexGenerationOptions vertexGeneration;
 };
 
 /// Represents the central game class.
@@ -90,6 +119,11 @@ class Game
     ///        the same result.
     GameTime time() const;
 
+    /// Gets a value indicating whether the game runs in headless mode.
+    ///
+    /// @see GameInitArgs::isHeadless
+    bool isHeadless() const;
+
     /// Gets the main window of the game.
     Window window() const;
 
@@ -33,5 +33,51 @@ struct GamePerformanceStats
 
     /// The total number of vertices that have been processed by the GPU
     u32 vertexCount = 0;
+
+    /// The number of bytes of shader parameters that were uploaded to the GPU.
+    ///
+    /// @note This is currently only reported by the Vulkan backend.
+    u32 uniformBufferBytes = 0;
+
+    /// The number of descriptor set bindings that were performed in total.
+    ///
+    /// @note This is currently only reported by the Vulkan backend.
+    u32 descriptorSetBindCount = 0;
+
+    /// The estimated time, in seconds, that was saved by generating the vertices
+    /// of large batches on multiple threads.
+    ///
+    /// @see VertexGenerationOptions
+    double vertexGenerationTimeSaved = 0.0;
+
+    /// The largest number of bytes that were written to the painter's sprite buffer
+    /// within a single frame, since the game started.
+    ///
+    /// The painter's per-frame buffers grow automatically when a frame needs more than they hold.
+    /// These values show how large they have become, and are zero on backends that don't use
+    /// growable buffers.
+    u32 spriteBufferHighWaterMark = 0;
+
+    /// The largest number of bytes that were written to the painter's polygon vertex buffer
+    /// within a single frame, since the game started.
+    u32 polygonBufferHighWaterMark = 0;
+
+    /// The largest number of bytes that were written to the painter's mesh vertex buffer
+    /// within a single frame, since the game started.
+    u32 meshVertexBufferHighWaterMark = 0;
+
+    /// The largest number of bytes that were written to the painter's mesh index buffer
+    /// within a single frame, since the game started.
+    u32 meshIndexBufferHighWaterMark = 0;
+
+    /// The number of Painter::drawString() calls that could reuse text that was shaped
+    /// during a previous frame.
+    ///
+    /// Strings that are drawn repeatedly, such as labels and scores, are only shaped again
+    /// when they change. For text that changes rarely, a Text object avoids even the lookup.
+    u32 shapedTextCacheHitCount = 0;
+
+    /// The number of Painter::drawString() calls that had to shape their text.
+    u32 shapedTextCacheMissCount = 0;
 };
 } // namespace Polly
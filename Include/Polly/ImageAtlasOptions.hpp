@@ -0,0 +1,43 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly, a minimalistic 2D C++ game framework.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Prerequisites.hpp"
+
+namespace Polly
+{
+/// Defines how the painter packs small images into shared atlas pages.
+///
+/// When enabled (see GameInitArgs::imageAtlasing), small immutable images that are loaded
+/// from the game's assets or from memory are additionally copied into larger atlas pages.
+/// Painter::drawSprite() then transparently draws such images from their page, which
+/// allows sprites of different images to be drawn as part of the same batch.
+///
+/// Images that don't fit into the atlas are drawn from their own image, as usual. The same
+/// applies to sprites that are drawn using a sampler whose address mode isn't
+/// ImageAddressMode::ClampToEdgeTexels, since wrapping requires the image's own texture.
+/// Statistics about the atlas are available via Painter::imageAtlasStats().
+struct ImageAtlasOptions
+{
+    /// The width and height of a single atlas page, in pixels.
+    u32 pageSize = 2048;
+
+    /// The maximum number of atlas pages that may exist at the same time.
+    u32 maxPageCount = 4;
+
+    /// The maximum width and height of an image for it to be put into the atlas, in pixels.
+    u32 maxImageExtent = 256;
+
+    /// The number of frames an image has to remain undrawn before it may be evicted
+    /// from the atlas. Eviction only happens when the atlas is out of space.
+    u32 evictionAge = 120;
+
+    /// The minimum fraction of a page's allocated space that has to be occupied by live
+    /// images. Pages that fall below this threshold are defragmented at the start of
+    /// the next frame. If the atlas ran out of space, every page that contains space of
+    /// evicted or destroyed images is defragmented, regardless of this threshold.
+    float defragmentationThreshold = 0.75f;
+};
+} // namespace Polly
@@ -21,11 +21,13 @@ class Text;
 class Image;
 class ParticleSystem;
 class SpineSkeleton;
+class StaticSpriteBatch;
 struct Rectangle;
 struct Matrix;
 struct BlendState;
 struct Sampler;
 struct Sprite;
+struct DrawStateCombination;
 enum class Direction;
 
 /// Defines the format of an image when it is saved.
@@ -51,6 +53,60 @@ struct PainterCapabilities
     u32 maxCanvasWidth  = 0;
     u32 maxCanvasHeight = 0;
     u32 maxScissorRects = 0;
+
+    /// The number of different images that can be drawn as part of a single sprite batch.
+    /// Drawing sprites that alternate between at most this many images doesn't
+    /// cause additional draw calls.
+    u32 maxSpriteBatchImages = 1;
+};
+
+/// Represents statistics of the painter's automatic image atlas.
+///
+/// All values are zero if image atlasing is disabled.
+///
+/// @see ImageAtlasOptions
+struct ImageAtlasStats
+{
+    /// The number of atlas pages that currently exist.
+    u32 pageCount = 0;
+
+    /// The number of images that are currently drawn from an atlas page.
+    u32 placedImageCount = 0;
+
+    /// The number of images that are eligible for the atlas, but currently drawn
+    /// from their own image, because the atlas was out of space.
+    u32 unplacedImageCount = 0;
+
+    /// The fraction of the total page area that is occupied by images,
+    /// in the range [0.0 .. 1.0].
+    double occupancy = 0.0;
+
+    /// The total number of images that have been evicted from the atlas.
+    u32 evictionCount = 0;
+
+    /// The total number of times that an atlas page has been defragmented.
+    u32 defragmentationCount = 0;
+};
+
+/// Defines the outline and glow of text that is drawn using distance field fonts.
+///
+/// Widths are specified in pixels at the text's font size. Since a distance field only covers
+/// a limited distance around each glyph, widths are limited to about a sixth of the font size.
+///
+/// @see Font::setDistanceFieldEnabled
+struct DistanceFieldTextStyle
+{
+    /// The width of the outline around the glyphs. Zero disables the outline.
+    float outlineWidth = 0.0f;
+
+    /// The color of the outline.
+    Color outlineColor = black;
+
+    /// The width of the glow around the glyphs and their outline. Zero disables the glow.
+    float glowWidth = 0.0f;
+
+    /// The color of the glow, at its strongest point.
+    Color glowColor = black;
 };
 
 /// Represents the system's graphics device.
@@ -66,6 +122,8 @@ class Painter final
     PollyObject(Painter);
 
   public:
+    class CommandList;
+
     /// Sets the active set of scissor rectangles.
     ///
     /// @param scissorRects The scissor rectangles to set for subsequent drawing.
@@ -127,6 +185,53 @@ class Painter final
     /// @param blendState The blend state to use for subsequent drawing.
     void setBlendState(BlendState blendState);
 
+    /// Starts recording sprites instead of drawing them immediately.
+    ///
+    /// This includes sprites that are drawn as part of text and particle systems.
+    /// Recorded sprites are drawn when submitDeferredDrawing() is called, or at the latest
+    /// at the end of the frame. Before that, they're sorted by their draw layer first and then
+    /// by the state they were drawn with (shader, blend state, sampler, transformation and image),
+    /// so that sprites of the same state are merged into as few draw calls as possible.
+    ///
+    /// The order of sprites is therefore only preserved across draw layers, not within a single
+    /// layer. Use setDrawLayer() to ensure that sprites are drawn on top of others.
+    ///
+    /// Drawing anything other than sprites, changing the canvas or scissor rectangles, and
+    /// changing a parameter of a shader that a recorded sprite uses all draw the sprites
+    /// that were recorded so far first.
+    void beginDeferredDrawing();
+
+    /// Draws all sprites that were recorded since beginDeferredDrawing() and stops recording.
+    void submitDeferredDrawing();
+
+    /// Gets a value indicating whether sprites are currently recorded for deferred drawing.
+    ///
+    /// @see beginDeferredDrawing
+    bool isDrawingDeferred() const;
+
+    /// Gets the draw layer of subsequently recorded sprites.
+    u8 drawLayer() const;
+
+    /// Sets the draw layer of subsequently recorded sprites.
+    ///
+    /// Recorded sprites of a higher layer are drawn on top of sprites of lower layers.
+    /// The layer only affects deferred drawing and is reset to zero at the start of every frame.
+    ///
+    /// @param layer The layer to use for subsequently recorded sprites.
+    void setDrawLayer(u8 layer);
+
+    /// Gets the style of subsequently drawn distance field text.
+    DistanceFieldTextStyle distanceFieldTextStyle() const;
+
+    /// Sets the style of subsequently drawn text whose font uses distance fields.
+    ///
+    /// Text of other fonts is unaffected.
+    ///
+    /// @param style The style to use for subsequent drawing.
+    ///
+    /// @see Font::setDistanceFieldEnabled
+    void setDistanceFieldTextStyle(const DistanceFieldTextStyle& style);
+
     /// Draws a 2D sprite.
     ///
     /// @note This is a shortcut for drawSprite(const Sprite&).
@@ -146,6 +251,22 @@ class Painter final
     /// @param sprites The sprites to draw.
     void drawSprites(Span<Sprite> sprites);
 
+    /// Draws all sprites of a static sprite batch.
+    ///
+    /// The sprites are drawn with one draw call per run of consecutive sprites that share
+    /// the same image, without generating their vertices again.
+    ///
+    /// @param batch The batch to draw.
+    void drawStaticSpriteBatch(StaticSpriteBatch batch);
+
+    /// Draws all commands of a command list, in the order in which they were recorded.
+    ///
+    /// The commands are drawn using the painter's current state, such as its transformation
+    /// and shaders. The list is left unchanged, so that it can be submitted again.
+    ///
+    /// @param list The command list to draw.
+    void submitCommandList(const CommandList& list);
+
     /// Draws 2D text from a dynamic string.
     ///
     /// This will perform text shaping on the fly and therefore has some overhead.
@@ -371,6 +492,24 @@ class Painter final
     /// Gets the device's capabilities.
     PainterCapabilities capabilities() const;
 
+    /// Gets statistics of the automatic image atlas.
+    ///
+    /// @see GameInitArgs::imageAtlasing
+    ImageAtlasStats imageAtlasStats() const;
+
+    /// Prepares the painter for drawing with specific combinations of states.
+    ///
+    /// Some backends create internal objects the first time that a combination of shader,
+    /// blend state, kind of object and canvas format is drawn, which may cause a noticeable
+    /// hitch in that frame. Calling this function, for example during a loading screen,
+    /// creates those objects ahead of time.
+    /// Backends that don't need such preparation ignore this call.
+    ///
+    /// @param combinations The combinations of states to prepare
+    ///
+    /// @throw Error If a combination's shader doesn't match its kind of object.
+    void prepareDrawStates(Span<DrawStateCombination> combinations);
+
     /// Gets the name of the graphics API that's used on the current platform.
     static StringView backendName();
 };
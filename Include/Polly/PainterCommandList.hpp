@@ -0,0 +1,178 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly, a minimalistic 2D C++ game framework.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Color.hpp"
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Linalg.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/MeshVertex.hpp"
+#include "Polly/Painter.hpp"
+#include "Polly/Radians.hpp"
+#include "Polly/Rectangle.hpp"
+#include "Polly/Span.hpp"
+#include "Polly/Sprite.hpp"
+#include "Polly/StringView.hpp"
+#include "Polly/TextDecoration.hpp"
+#include "Polly/UniquePtr.hpp"
+
+namespace Polly
+{
+/// Represents a list of draw commands that is recorded independently of the painter.
+///
+/// Command lists allow draw commands to be built on multiple threads, for example one list
+/// per part of the game world. Recording into a command list doesn't touch any painter state,
+/// so different command lists may be recorded concurrently. A single command list however
+/// must not be recorded into by multiple threads at the same time.
+///
+/// Once recorded, a command list is drawn on the main thread via Painter::submitCommandList(),
+/// using the painter's state at that time (such as its transformation and shaders).
+///
+/// Polly objects such as images and fonts use reference counting that isn't thread-safe.
+/// Command lists therefore don't keep references to the objects they're given, and only take
+/// them by reference. The caller has to ensure that all referenced objects stay alive until
+/// the list is submitted.
+///
+/// For the same reason, worker threads should record sprites using the drawSprite() overloads
+/// that take an image and the sprite's properties separately. Constructing Sprite objects
+/// copies their image, which modifies its reference count.
+class Painter::CommandList final
+{
+  public:
+    /// Creates an empty command list.
+    CommandList();
+
+    DeleteCopy(CommandList);
+
+    CommandList(CommandList&&) noexcept;
+
+    CommandList& operator=(CommandList&&) noexcept;
+
+    ~CommandList() noexcept;
+
+    /// Records a 2D sprite.
+    ///
+    /// @param image The image of the sprite.
+    /// @param position The position of the sprite.
+    /// @param color The color of the sprite.
+    void drawSprite(const Image& image, Vec2 position, Color color = white);
+
+    /// Records a 2D sprite.
+    ///
+    /// This is the equivalent of recording a Sprite, without having to construct one.
+    ///
+    /// @param image The image of the sprite.
+    /// @param dstRect The destination area of the sprite, in pixels.
+    /// @param srcRect The image coordinates of the sprite, in pixels.
+    /// @param color The multiplicative color of the sprite.
+    /// @param rotation The rotation of the sprite, in radians.
+    /// @param origin The top-left origin of the sprite, in pixels.
+    /// @param flip Flip flags of the sprite.
+    void drawSprite(
+        const Image&     image,
+        Rectangle        dstRect,
+        Maybe<Rectangle> srcRect  = none,
+        Color            color    = white,
+        Radians          rotation = Radians(0),
+        Vec2             origin   = Vec2(0, 0),
+        SpriteFlip       flip     = SpriteFlip::None);
+
+    /// Records a 2D sprite.
+    ///
+    /// @attention Sprites hold a reference to their image. When recording on a worker thread,
+    ///            prefer the overload that takes the image separately.
+    ///
+    /// @param sprite The sprite to record.
+    void drawSprite(const Sprite& sprite);
+
+    /// Records multiple 2D sprites.
+    ///
+    /// @attention Sprites hold a reference to their image. When recording on a worker thread,
+    ///            prefer the overload of drawSprite() that takes the image separately.
+    ///
+    /// @param sprites The sprites to record.
+    void drawSprites(Span<Sprite> sprites);
+
+    /// Records 2D text from a dynamic string.
+    ///
+    /// The string is copied, but only shaped when the command list is submitted.
+    ///
+    /// @param text The text to draw.
+    /// @param font The font to draw the text with.
+    /// @param fontSize The size of the font to use, in pixels.
+    /// @param position The top-left position of the text.
+    /// @param color The color of the text.
+    /// @param decoration The text decorations.
+    void drawString(
+        StringView            text,
+        const Font&           font,
+        float                 fontSize,
+        Vec2                  position,
+        Color                 color      = white,
+        Maybe<TextDecoration> decoration = none);
+
+    /// Records 2D text from a pre-created Text object.
+    ///
+    /// @param text The text object to draw.
+    /// @param position The top-left position of the text.
+    /// @param color The color of the text.
+    void drawText(const Text& text, Vec2 position, Color color = white);
+
+    /// Records a 2D line.
+    void drawLine(Vec2 start, Vec2 end, Color color, float strokeWidth);
+
+    /// Records a hollow 2D rectangle.
+    void drawRectangle(Rectangle rectangle, Color color, float strokeWidth);
+
+    /// Records a filled 2D rectangle.
+    void fillRectangle(Rectangle rectangle, Color color);
+
+    /// Records a hollow 2D rectangle with rounded corners.
+    void drawRoundedRectangle(Rectangle rectangle, float cornerRadius, Color color, float strokeWidth);
+
+    /// Records a filled 2D rectangle with rounded corners.
+    void fillRoundedRectangle(Rectangle rectangle, float cornerRadius, Color color);
+
+    /// Records a hollow 2D ellipse.
+    void drawEllipse(Vec2 center, Vec2 radius, Color color, float strokeWidth);
+
+    /// Records a filled 2D ellipse.
+    void fillEllipse(Vec2 center, Vec2 radius, Color color);
+
+    /// Records a hollow 2D polygon. The vertices are copied.
+    void drawPolygon(Span<Vec2> vertices, Color color, float strokeWidth);
+
+    /// Records a filled 2D polygon. The vertices are copied.
+    void fillPolygon(Span<Vec2> vertices, Color color);
+
+    /// Records a 2D mesh. The vertices and indices are copied.
+    ///
+    /// @param vertices The vertices of the mesh
+    /// @param indices A set of indices that index into the vertices set
+    /// @param image The image to apply to the mesh
+    void drawMesh(Span<MeshVertex> vertices, Span<uint16_t> indices, const Image& image);
+
+    /// Gets a value indicating whether the list doesn't contain any commands.
+    bool isEmpty() const;
+
+    /// Removes all commands from the list, but keeps its memory for subsequent recording.
+    void clear();
+
+    class Impl;
+
+    Impl* impl()
+    {
+        return _impl.get();
+    }
+
+    const Impl* impl() const
+    {
+        return _impl.get();
+    }
+
+  private:
+    UniquePtr<Impl> _impl;
+};
+} // namespace Polly
@@ -0,0 +1,107 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly, a minimalistic 2D C++ game framework.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+// This file contains Polly's built-in CPU profiler.
+//
+// The profiler records scoped zones, which are declared using the PollyProfileScope()
+// and PollyProfileFunction() macros. Polly declares zones for its own work, such as event
+// processing, Game::update(), Game::draw(), batch flushing and glyph rasterization.
+// Games may declare their own zones in the same way.
+//
+// Example usage:
+//
+// void MyGame::update(GameTime time)
+// {
+//     PollyProfileFunction();
+//
+//     {
+//         PollyProfileScope("Physics");
+//         ...
+//     }
+// }
+//
+// Zones are only recorded if Polly is built with the POLLY_ENABLE_PROFILER CMake option.
+// Otherwise, the macros expand to nothing and the profiler functions have no effect.
+
+#pragma once
+
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Defer.hpp"
+#include "Polly/Prerequisites.hpp"
+#include "Polly/String.hpp"
+
+namespace Polly
+{
+class ImGui;
+
+/// Gets the zones that the profiler has recorded most recently, as a trace
+/// in the Chrome Trace Event format.
+///
+/// The trace can be opened using https://ui.perfetto.dev or chrome://tracing.
+///
+/// Every thread keeps a fixed number of its most recent zones, which usually
+/// covers the last few hundred frames.
+///
+/// If the profiler is disabled, an empty trace is returned.
+String profilerChromeTrace();
+
+/// Saves the result of profilerChromeTrace() to a file in the game's storage.
+///
+/// @param filename The name of the file, for example "trace.json"
+///
+/// @see WritableFile
+void saveProfilerChromeTrace(StringView filename);
+
+/// Shows a window that displays the zones of the previous frame as a flame graph.
+///
+/// Call this from within Game::onImGui().
+void showProfilerWindow(ImGui imgui);
+
+namespace Details
+{
+u64 beginProfileZone();
+
+void endProfileZone(const char* name, u64 startTime);
+
+class ProfileZone final
+{
+  public:
+    explicit ProfileZone(const char* name)
+        : _name(name)
+        , _startTime(beginProfileZone())
+    {
+    }
+
+    DeleteCopyAndMove(ProfileZone);
+
+    ~ProfileZone() noexcept
+    {
+        endProfileZone(_name, _startTime);
+    }
+
+  private:
+    const char* _name;
+    u64         _startTime;
+};
+} // namespace Details
+} // namespace Polly
+
+// NOLINTBEGIN
+#ifdef POLLY_ENABLE_PROFILER
+
+/// Records the time until the end of the current scope as a profiler zone.
+///
+/// The name must be a string literal or otherwise outlive the profiler.
+#define PollyProfileScope(name)                                                                              \
+    const auto POLLY_UNIQUE_NAME(pollyProfileZone) = ::Polly::Details::ProfileZone(name)
+
+#else
+
+#define PollyProfileScope(name)
+
+#endif
+
+/// Records the time until the end of the current function as a profiler zone.
+#define PollyProfileFunction() PollyProfileScope(__FUNCTION__)
+// NOLINTEND
@@ -0,0 +1,55 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly, a minimalistic 2D C++ game framework.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Prerequisites.hpp"
+#include "Polly/Span.hpp"
+#include "Polly/Sprite.hpp"
+
+namespace Polly
+{
+/// Represents a fixed list of sprites whose vertices are generated once and then kept
+/// in GPU memory.
+///
+/// Static sprite batches are intended for content that rarely changes, such as backgrounds,
+/// decorations and tile layers. When drawn via Painter::drawStaticSpriteBatch(), the sprites
+/// don't have to be processed again; only the painter's current transformation, shader,
+/// blend state and sampler are applied to them.
+///
+/// A batch doesn't observe its sprites. A sprite that should change must be replaced
+/// explicitly using setSprite() or setSprites(), after which only the vertices of the
+/// replaced sprites are generated and uploaded again.
+class StaticSpriteBatch
+{
+    PollyObject(StaticSpriteBatch);
+
+  public:
+    /// Creates a static sprite batch.
+    ///
+    /// @param sprites The sprites of the batch, in the order in which they're drawn.
+    ///                Sprites without an image are skipped when drawing.
+    explicit StaticSpriteBatch(Span<Sprite> sprites);
+
+    /// Gets the number of sprites in the batch.
+    u32 spriteCount() const;
+
+    /// Gets a sprite of the batch.
+    ///
+    /// @param index The index of the sprite
+    const Sprite& spriteAt(u32 index) const;
+
+    /// Replaces a single sprite of the batch.
+    ///
+    /// @param index The index of the sprite to replace
+    /// @param sprite The new sprite
+    void setSprite(u32 index, const Sprite& sprite);
+
+    /// Replaces a range of sprites of the batch.
+    ///
+    /// @param offset The index of the first sprite to replace
+    /// @param sprites The new sprites
+    void setSprites(u32 offset, Span<Sprite> sprites);
+};
+} // namespace Polly
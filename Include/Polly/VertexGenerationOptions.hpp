@@ -0,0 +1,36 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly, a minimalistic 2D C++ game framework.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Maybe.hpp"
+#include "Polly/Prerequisites.hpp"
+
+namespace Polly
+{
+/// Defines when the painter generates the vertices of a draw batch on multiple threads.
+///
+/// When a single batch contains many sprites, polygon vertices or mesh vertices, it is split
+/// into chunks whose vertices are then written in parallel by a set of worker threads.
+/// The time saved by this is reported via GamePerformanceStats::vertexGenerationTimeSaved.
+struct VertexGenerationOptions
+{
+    /// The number of worker threads that assist the main thread.
+    ///
+    /// If empty, a number suitable for the system's CPU is chosen.
+    /// Zero disables parallel vertex generation.
+    Maybe<u32> workerCount;
+
+    /// The minimum number of sprites a batch must contain to be split across threads.
+    u32 minSpriteCount = 8192;
+
+    /// The minimum number of polygon vertices a batch must contain to be split across threads.
+    ///
+    /// Polygons are drawn by functions such as Painter::drawRectangle() and Painter::fillEllipse().
+    u32 minPolygonVertexCount = 16384;
+
+    /// The minimum number of mesh vertices a batch must contain to be split across threads.
+    u32 minMeshVertexCount = 32768;
+};
+} // namespace Polly
@@ -4,6 +4,8 @@ endif ()
 
 option(POLLY_ENABLE_ADDRESS_SANITIZER "Enable clang address sanitizer" OFF)
 option(POLLY_ENABLE_VERBOSE_LOGGING "Enable verbose logging during debug mode" OFF)
+option(POLLY_ENABLE_PROFILER "Record profiler zones (see Polly/Profiler.hpp)" OFF)
+option(POLLY_USE_SOFTWARE_RENDERER "Use the CPU software rasterizer instead of the platform's graphics API" OFF)
 option(POLLY_BUILD_APPS "Build the Polly testbed and sample games" ${is_master_project})
 
 if (ANDROID)
@@ -71,6 +71,16 @@ function(polly_add_game)
         set(compiled_asset ${compiled_assets_dir}/${asset_name}.asset)
         list(APPEND compiled_assets ${compiled_asset})
 
+        # Shaders are precompiled if the shader compiler tool is available (see PrecompiledShader).
+        set(shader_compiler_args)
+        set(shader_compiler_deps)
+        get_filename_component(asset_ext ${file} LAST_EXT)
+
+        if (asset_ext STREQUAL ".shd" AND TARGET PollyShaderCompiler)
+            set(shader_compiler_args --shadercompiler "$<TARGET_FILE:PollyShaderCompiler>")
+            set(shader_compiler_deps PollyShaderCompiler)
+        endif ()
+
         add_custom_command(
             OUTPUT ${compiled_asset}
             COMMAND Python3::Interpreter BuildTool compile
@@ -78,8 +88,9 @@ function(polly_add_game)
             --asset "${asset_name}"
             --dst "${compiled_asset}"
             --encryptionkey "${asset_encryption_key}"
+            ${shader_compiler_args}
             WORKING_DIRECTORY ${polly_root_dir}
-            DEPENDS ${file} ${game_props_file}
+            DEPENDS ${file} ${game_props_file} ${shader_compiler_deps}
             COMMENT "Compiling ${asset_name}"
         )
     endforeach ()
@@ -8,10 +8,15 @@
 # anything special that Vulkan offers that OpenGL doesn't have.
 # Vulkan work will resume once all current backends are fully stable.
 #
+# POLLY_USE_SOFTWARE_RENDERER overrides the selection with a CPU rasterizer that renders into system
+# memory, which is useful for machines without a usable GPU driver (e.g. CI runners).
+#
 # In the future, Polly is going to support graphics API selection at runtime, meaning
 # that games can be configured to use one or another, after they've been built.
 
-if (APPLE)
+if (POLLY_USE_SOFTWARE_RENDERER)
+    set(polly_have_gfx_software TRUE)
+elseif (APPLE)
     set(polly_have_gfx_metal TRUE)
 elseif (WIN32)
     set(polly_have_gfx_d3d11 TRUE)
@@ -135,6 +135,11 @@ Archive::UnpackedAssetData Archive::unpackAsset(StringView name) const
     };
 }
 
+bool Archive::containsAsset(StringView name) const
+{
+    return containsWhere(_entries, [&](const auto& e) { return e.name == name; });
+}
+
 void Archive::readEntries(BinaryReader& reader)
 {
     const auto assetCount = reader.readUInt32();
@@ -30,6 +30,11 @@ class Archive final
     /// @throw Error When the unpacking failed in general.
     UnpackedAssetData unpackAsset(StringView name) const;
 
+    /// Gets a value indicating whether the archive contains an asset.
+    ///
+    /// @param name The name of the asset, e.g. "images/spritesheet.png"
+    bool containsAsset(StringView name) const;
+
   private:
     struct AssetEntry
     {
@@ -13,6 +13,7 @@
 #include "Polly/Graphics/FontImpl.hpp"
 #include "Polly/Graphics/ImageImpl.hpp"
 #include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Graphics/PrecompiledShader.hpp"
 #include "Polly/Graphics/ShaderImpl.hpp"
 #include "Polly/Image.hpp"
 #include "Polly/Logging.hpp"
@@ -145,9 +146,22 @@ Shader ContentManager::loadShader(StringView name)
             const auto [type, unpacked_data] = _archive.unpackAsset(assetName);
             auto reader                      = BinaryReader(unpacked_data, Details::assetDecryptionKey);
 
-            verifyAssetType(assetName, type, 's', "a shader");
+            // Shaders are either stored as source code, or precompiled by the build tool.
+            if (type != 'p')
+            {
+                verifyAssetType(assetName, type, 's', "a shader");
+                return Shader::fromSource(assetName, reader.readEncryptedString());
+            }
+
+            const auto precompiledShader = PrecompiledShader::deserialize(reader);
+
+            auto shaderImpl = Painter::Impl::instance()->createUserShader(precompiledShader, assetName);
+            shaderImpl->setAssetName(assetName);
 
-            return Shader::fromSource(assetName, reader.readEncryptedString());
+            auto shader = Shader(shaderImpl.release());
+            shader.setDebuggingLabel(assetName);
+
+            return shader;
         });
 }
 
@@ -198,6 +212,18 @@ List<u8> ContentManager::loadAssetData(StringView name)
     return _archive.unpackAsset(name).data;
 }
 
+Maybe<List<u8>> ContentManager::tryLoadAssetData(StringView name)
+{
+    const auto _ = std::lock_guard(_mutex);
+
+    if (not _archive.containsAsset(name))
+    {
+        return none;
+    }
+
+    return _archive.unpackAsset(name).data;
+}
+
 void ContentManager::notifyAssetDestroyed(const Asset* asset)
 {
     for (auto idx = 0u; const auto& [key, refToLoadedAsset] : _loadedAssets)
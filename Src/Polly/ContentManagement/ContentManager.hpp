@@ -71,6 +71,9 @@ class ContentManager final
 
     List<u8> loadAssetData(StringView name);
 
+    // Like loadAssetData(), but returns none instead of throwing when the asset doesn't exist.
+    Maybe<List<u8>> tryLoadAssetData(StringView name);
+
     SpineAtlas loadSpineAtlas(StringView name);
 
     SpineSkeletonData loadSpineSkeletonData(StringView name, SpineAtlas atlas, float scale);
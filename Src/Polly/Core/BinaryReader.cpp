@@ -149,6 +149,11 @@ String BinaryReader::readEncryptedString()
     auto       str     = readString();
     const auto keySize = _decryptionKey.size();
 
+    if (keySize == 0)
+    {
+        return str;
+    }
+
     for (u32 i = 0, size = str.size(); i < size; ++i)
     {
         str[i] = int(str[i]) xor _decryptionKey[i % keySize];
@@ -47,4 +47,12 @@
 #  define POLLY_COMPILER_MSVC 1 // NOLINT(*-macro-usage)
 #endif
 
+// SSE2 is part of every x86-64 CPU; NEON is only used on AArch64, where it's mandatory as well.
+// Neither requires any additional compiler flags.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define polly_have_sse2 1 // NOLINT(*-macro-usage)
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#  define polly_have_neon 1 // NOLINT(*-macro-usage)
+#endif
+
 // clang-format on
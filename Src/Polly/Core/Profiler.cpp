@@ -0,0 +1,286 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Profiler.hpp"
+
+#include "Polly/Core/ProfilerInternals.hpp"
+#include "Polly/Logging.hpp"
+#include "Polly/ToString.hpp"
+#include "Polly/UniquePtr.hpp"
+#include "Polly/WritableFile.hpp"
+
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace Polly
+{
+#ifdef POLLY_ENABLE_PROFILER
+
+// Every thread keeps this many of its most recent zones, which is enough for a few hundred frames.
+// Older zones are overwritten.
+static constexpr auto eventsPerThread = 1u << 14;
+
+// The events of a single thread.
+// Only the owning thread writes events, and it publishes them by incrementing eventCount.
+// Other threads may read the published events at any time, without having to lock anything.
+struct ProfilerThreadBuffer
+{
+    u32                   id = 0;
+    String                name;
+    u32                   depth      = 0;
+    std::atomic<u64>      eventCount = 0;
+    List<ProfileEvent, 1> events;
+};
+
+// Guards the list of buffers and their names, but not their events.
+static std::mutex sRegistryMutex;
+
+static List<UniquePtr<ProfilerThreadBuffer>> sThreadBuffers;
+
+static thread_local ProfilerThreadBuffer* sThreadBuffer = nullptr;
+
+static Maybe<u64>           sCurrentFrameStartTime;
+static Maybe<ProfiledFrame> sLastFrame;
+
+static ProfilerThreadBuffer& currentThreadBuffer()
+{
+    if (not sThreadBuffer)
+    {
+        auto buffer = makeUnique<ProfilerThreadBuffer>();
+        buffer->events.resize(eventsPerThread);
+
+        auto lock = std::lock_guard(sRegistryMutex);
+
+        buffer->id    = sThreadBuffers.size() + 1;
+        sThreadBuffer = buffer.get();
+        sThreadBuffers.add(std::move(buffer));
+    }
+
+    return *sThreadBuffer;
+}
+
+u64 Details::beginProfileZone()
+{
+    ++currentThreadBuffer().depth;
+    return SDL_GetTicksNS();
+}
+
+void Details::endProfileZone(const char* name, u64 startTime)
+{
+    const auto endTime = SDL_GetTicksNS();
+    auto&      buffer  = currentThreadBuffer();
+
+    assume(buffer.depth > 0);
+    --buffer.depth;
+
+    const auto index = buffer.eventCount.load(std::memory_order_relaxed);
+
+    buffer.events[u32(index % eventsPerThread)] = ProfileEvent{
+        .name      = name,
+        .startTime = startTime,
+        .endTime   = endTime,
+        .depth     = buffer.depth,
+    };
+
+    buffer.eventCount.store(index + 1, std::memory_order_release);
+}
+
+void setProfilerThreadName(StringView name)
+{
+    auto& buffer = currentThreadBuffer();
+    auto  lock   = std::lock_guard(sRegistryMutex);
+    buffer.name  = name;
+}
+
+void markProfilerFrame()
+{
+    const auto now = SDL_GetTicksNS();
+
+    if (sCurrentFrameStartTime)
+    {
+        sLastFrame = ProfiledFrame{
+            .startTime = *sCurrentFrameStartTime,
+            .endTime   = now,
+        };
+    }
+
+    sCurrentFrameStartTime = now;
+}
+
+Maybe<ProfiledFrame> lastProfiledFrame()
+{
+    return sLastFrame;
+}
+
+List<ProfiledThread> collectProfileEvents(u64 startTime, u64 endTime)
+{
+    auto result = List<ProfiledThread>();
+    auto lock   = std::lock_guard(sRegistryMutex);
+
+    for (const auto& buffer : sThreadBuffers)
+    {
+        auto thread = ProfiledThread();
+        thread.id   = buffer->id;
+        thread.name = buffer->name;
+
+        const auto eventCount = buffer->eventCount.load(std::memory_order_acquire);
+        const auto firstIndex = eventCount > eventsPerThread ? eventCount - eventsPerThread : u64(0);
+
+        auto index = eventCount;
+
+        // Events are stored in the order in which they ended. The search can therefore stop
+        // at the first event that ended before the range.
+        while (index > firstIndex)
+        {
+            --index;
+
+            const auto& event = buffer->events[u32(index % eventsPerThread)];
+
+            if (event.endTime < startTime)
+            {
+                break;
+            }
+
+            if (event.startTime <= endTime)
+            {
+                thread.events.add(event);
+            }
+        }
+
+        // The owning thread might have overwritten events while we were reading them.
+        // This only happens if it records an entire buffer's worth of events in the meantime,
+        // in which case its events are skipped.
+        if (buffer->eventCount.load(std::memory_order_acquire) >= index + eventsPerThread)
+        {
+            continue;
+        }
+
+        if (not thread.events.isEmpty())
+        {
+            std::ranges::reverse(thread.events);
+            result.add(std::move(thread));
+        }
+    }
+
+    return result;
+}
+
+static void appendJsonString(String& out, StringView str)
+{
+    out += '"';
+
+    for (const auto ch : str)
+    {
+        if (ch == '"' or ch == '\\')
+        {
+            out += '\\';
+        }
+
+        out += ch;
+    }
+
+    out += '"';
+}
+
+String profilerChromeTrace()
+{
+    const auto threads = collectProfileEvents(0, std::numeric_limits<u64>::max());
+
+    auto out = String(R"({"displayTimeUnit":"ms","traceEvents":[)");
+
+    auto isFirstEvent = true;
+
+    const auto beginEvent = [&]
+    {
+        if (not isFirstEvent)
+        {
+            out += ",\n";
+        }
+
+        isFirstEvent = false;
+    };
+
+    for (const auto& thread : threads)
+    {
+        const auto tid = toString(thread.id);
+
+        if (not thread.name.isEmpty())
+        {
+            beginEvent();
+            out += R"({"name":"thread_name","ph":"M","pid":1,"tid":)";
+            out += tid;
+            out += R"(,"args":{"name":)";
+            appendJsonString(out, thread.name);
+            out += "}}";
+        }
+
+        // Timestamps are in microseconds.
+        for (const auto& event : thread.events)
+        {
+            beginEvent();
+            out += R"({"name":)";
+            appendJsonString(out, event.name);
+            out += R"(,"ph":"X","pid":1,"tid":)";
+            out += tid;
+            out += R"(,"ts":)";
+            out += toString(double(event.startTime) / 1000.0);
+            out += R"(,"dur":)";
+            out += toString(double(event.endTime - event.startTime) / 1000.0);
+            out += '}';
+        }
+    }
+
+    out += "]}";
+
+    return out;
+}
+
+#else
+
+u64 Details::beginProfileZone()
+{
+    return 0;
+}
+
+void Details::endProfileZone([[maybe_unused]] const char* name, [[maybe_unused]] u64 startTime)
+{
+}
+
+void setProfilerThreadName([[maybe_unused]] StringView name)
+{
+}
+
+void markProfilerFrame()
+{
+}
+
+Maybe<ProfiledFrame> lastProfiledFrame()
+{
+    return none;
+}
+
+List<ProfiledThread> collectProfileEvents([[maybe_unused]] u64 startTime, [[maybe_unused]] u64 endTime)
+{
+    return {};
+}
+
+String profilerChromeTrace()
+{
+    return R"({"displayTimeUnit":"ms","traceEvents":[]})";
+}
+
+#endif
+
+void saveProfilerChromeTrace(StringView filename)
+{
+    const auto trace = profilerChromeTrace();
+    auto       file  = WritableFile(filename);
+
+    file.writeBytes(Span(reinterpret_cast<const u8*>(trace.data()), trace.size()));
+
+    logInfo("Saved profiler trace to '{}'", file.fullFilename());
+}
+} // namespace Polly
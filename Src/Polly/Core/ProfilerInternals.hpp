@@ -0,0 +1,46 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/List.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/String.hpp"
+
+namespace Polly
+{
+struct ProfileEvent
+{
+    const char* name      = nullptr;
+    u64         startTime = 0;
+    u64         endTime   = 0;
+    u32         depth     = 0;
+};
+
+struct ProfiledThread
+{
+    u32                    id = 0;
+    String                 name;
+    List<ProfileEvent, 64> events;
+};
+
+struct ProfiledFrame
+{
+    u64 startTime = 0;
+    u64 endTime   = 0;
+};
+
+// Names the calling thread in exported traces.
+void setProfilerThreadName(StringView name);
+
+// Marks the start of a new frame. Must be called by the main thread.
+void markProfilerFrame();
+
+// The time range of the most recently completed frame, if there is one.
+Maybe<ProfiledFrame> lastProfiledFrame();
+
+// Gathers the recorded events of all threads that overlap the specified time range.
+// Threads without such events are omitted.
+List<ProfiledThread> collectProfileEvents(u64 startTime, u64 endTime);
+} // namespace Polly
@@ -0,0 +1,169 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Core/WorkerPool.hpp"
+
+#include "Polly/Core/ProfilerInternals.hpp"
+#include "Polly/Logging.hpp"
+#include "Polly/Math.hpp"
+#include "Polly/Profiler.hpp"
+
+namespace Polly
+{
+WorkerPool::WorkerPool(u32 workerCount)
+{
+    logVerbose("Creating WorkerPool with {} worker(s)", workerCount);
+
+    _threads.reserve(workerCount);
+
+    for (auto i = 0u; i < workerCount; ++i)
+    {
+        _threads.emplace([this] { workerMain(); });
+    }
+}
+
+WorkerPool::~WorkerPool() noexcept
+{
+    {
+        auto lock   = std::lock_guard(_mutex);
+        _isStopping = true;
+    }
+
+    _wakeUpCondition.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::parallelFor(u32 taskCount, const Function<void(u32)>& func)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    if (_threads.isEmpty() or taskCount == 1)
+    {
+        for (auto i = 0u; i < taskCount; ++i)
+        {
+            func(i);
+        }
+
+        return;
+    }
+
+    {
+        auto lock    = std::lock_guard(_mutex);
+        _func        = &func;
+        _taskCount   = taskCount;
+        _busyWorkers = _threads.size();
+        _exception   = nullptr;
+        _nextTask.store(0, std::memory_order_relaxed);
+        ++_generation;
+    }
+
+    _wakeUpCondition.notify_all();
+
+    // The calling thread is a worker, too.
+    runTasks();
+
+    auto exception = std::exception_ptr();
+
+    {
+        auto lock = std::unique_lock(_mutex);
+        _doneCondition.wait(lock, [this] { return _busyWorkers == 0; });
+        _func     = nullptr;
+        exception = std::exchange(_exception, nullptr);
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+u32 WorkerPool::workerCount() const
+{
+    return _threads.size();
+}
+
+u32 WorkerPool::defaultWorkerCount()
+{
+    const auto hardwareThreadCount = std::thread::hardware_concurrency();
+
+    return hardwareThreadCount > 1 ? min(hardwareThreadCount - 1, 15u) : 0u;
+}
+
+void WorkerPool::workerMain()
+{
+    setProfilerThreadName("Worker");
+
+    auto lastGeneration = u64(0);
+
+    while (true)
+    {
+        {
+            auto lock = std::unique_lock(_mutex);
+
+            _wakeUpCondition.wait(
+                lock,
+                [this, lastGeneration] { return _isStopping or _generation != lastGeneration; });
+
+            if (_isStopping)
+            {
+                return;
+            }
+
+            lastGeneration = _generation;
+        }
+
+        {
+            PollyProfileScope("WorkerPool::runTasks");
+            runTasks();
+        }
+
+        {
+            auto lock = std::lock_guard(_mutex);
+            --_busyWorkers;
+
+            if (_busyWorkers == 0)
+            {
+                _doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void WorkerPool::runTasks()
+{
+    while (true)
+    {
+        const auto index = _nextTask.fetch_add(1, std::memory_order_relaxed);
+
+        if (index >= _taskCount)
+        {
+            break;
+        }
+
+        try
+        {
+            (*_func)(index);
+        }
+        catch (...)
+        {
+            auto lock = std::lock_guard(_mutex);
+
+            if (not _exception)
+            {
+                _exception = std::current_exception();
+            }
+
+            // Skip all remaining tasks.
+            _nextTask.store(_taskCount, std::memory_order_relaxed);
+        }
+    }
+}
+} // namespace Polly
@@ -0,0 +1,59 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Function.hpp"
+#include "Polly/List.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace Polly
+{
+// A fixed set of worker threads that cooperatively execute index-based jobs.
+//
+// The pool is intended for short, frame-bound bursts of work (e.g. rasterizing
+// screen tiles or filling vertex ranges). The calling thread always participates
+// in a job, which means that a pool with zero workers simply runs everything inline.
+class WorkerPool final
+{
+  public:
+    explicit WorkerPool(u32 workerCount);
+
+    DeleteCopyAndMove(WorkerPool);
+
+    ~WorkerPool() noexcept;
+
+    // Invokes func(i) for every i in [0, taskCount) and blocks until all invocations have finished.
+    // If any invocation throws, the first exception is rethrown on the calling thread.
+    void parallelFor(u32 taskCount, const Function<void(u32)>& func);
+
+    u32 workerCount() const;
+
+    // Number of workers that makes sense for the current system, leaving one hardware
+    // thread for the calling (main) thread.
+    static u32 defaultWorkerCount();
+
+  private:
+    void workerMain();
+
+    void runTasks();
+
+    List<std::thread, 8>       _threads;
+    std::mutex                 _mutex;
+    std::condition_variable    _wakeUpCondition;
+    std::condition_variable    _doneCondition;
+    u64                        _generation  = 0;
+    bool                       _isStopping  = false;
+    const Function<void(u32)>* _func        = nullptr;
+    u32                        _taskCount   = 0;
+    std::atomic<u32>           _nextTask    = 0;
+    u32                        _busyWorkers = 0;
+    std::exception_ptr         _exception;
+};
+} // namespace Polly
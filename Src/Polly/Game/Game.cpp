@@ -90,6 +90,11 @@ Span<Gamepad> Game::gamepads() const
     return _impl->gamepads();
 }
 
+bool Game::isHeadless() const
+{
+    return _impl->isHeadless();
+}
+
 Window Game::window() const
 {
     return _impl->window();
@@ -6,6 +6,8 @@
 #include "Polly/Audio/AudioDeviceImpl.hpp"
 #include "Polly/ContentManagement/ContentManager.hpp"
 #include "Polly/Core/LoggingInternals.hpp"
+#include "Polly/Core/ProfilerInternals.hpp"
+#include "Polly/FileSystem.hpp"
 #include "Polly/Graphics/FontImpl.hpp"
 #include "Polly/ImGui/ImGuiImpl.hpp"
 #include "Polly/Input.hpp"
@@ -13,6 +15,7 @@
 #include "Polly/Input/InputImpl.hpp"
 #include "Polly/Input/MouseCursorImpl.hpp"
 #include "Polly/Logging.hpp"
+#include "Polly/Profiler.hpp"
 #include "Polly/RunGame.hpp"
 #include "Polly/Text.hpp"
 #include "Polly/Version.hpp"
@@ -52,6 +55,14 @@ int Polly::Details::runGame(int a, char* b[], MainFunction c, [[maybe_unused]] v
 #include "Polly/Graphics/OpenGL/OpenGLWindow.hpp"
 #endif
 
+#include "Polly/Graphics/Null/NullPainter.hpp"
+#include "Polly/Graphics/Null/NullWindow.hpp"
+
+#ifdef polly_have_gfx_software
+#include "Polly/Graphics/Software/SoftwarePainter.hpp"
+#include "Polly/Graphics/Software/SoftwareWindow.hpp"
+#endif
+
 #ifdef polly_have_gfx_vulkan
 #include <Polly/Graphics/Vulkan/VulkanPainter.hpp>
 #include <Polly/Graphics/Vulkan/VulkanWindow.hpp>
@@ -87,6 +98,8 @@ Game::Impl::Impl(const GameInitArgs& args)
     : _gameFinalizer(*this)
     , _title(args.title)
     , _companyName(args.companyName)
+    , _isHeadless(args.isHeadless)
+    , _fixedTimeStep(args.fixedTimeStep)
 {
     sGameInstance = this;
 
@@ -94,7 +107,22 @@ Game::Impl::Impl(const GameInitArgs& args)
     _gameAutoreleasePool = NS::TransferPtr(NS::AutoreleasePool::alloc()->init());
 #endif
 
-    logVerbose("Creating game with title='{}'; audio enabled={}", args.title, args.enableAudio);
+    logVerbose(
+        "Creating game with title='{}'; audio enabled={}; headless={}",
+        args.title,
+        args.enableAudio,
+        args.isHeadless);
+
+    if (_fixedTimeStep and *_fixedTimeStep <= 0.0)
+    {
+        throw Error(formatString("Invalid fixed time step specified ({}).", *_fixedTimeStep));
+    }
+
+    if (_isHeadless)
+    {
+        // Windows of the dummy driver never touch a display server.
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    }
 
     constexpr auto initFlags = SDL_INIT_VIDEO | SDL_INIT_JOYSTICK | SDL_INIT_GAMEPAD;
 
@@ -109,26 +137,46 @@ Game::Impl::Impl(const GameInitArgs& args)
 
     InputImpl::createInstance();
 
+    // Created before the painter, since the painter may look up precompiled data in the assets.
+    _contentManager = makeUnique<ContentManager>();
+
+    if (_isHeadless)
+    {
+        initializeImGui();
+        createHeadlessWindowAndPainter(args.title, args.initialWindowSize);
+        createAudioDevice(true);
+    }
+    else
+    {
 #ifdef polly_have_gfx_d3d11
-    checkHResult(CreateDXGIFactory(IID_IDXGIFactory, &_idxgiFactory), "Failed to create the IDXGIFactory.");
+        checkHResult(
+            CreateDXGIFactory(IID_IDXGIFactory, &_idxgiFactory),
+            "Failed to create the IDXGIFactory.");
 #endif
 
 #ifdef polly_have_gfx_vulkan
-    checkVkResult(
-        volkInitialize(),
-        "Failed to load Vulkan functions. This is an indication that the system does not support Vulkan.");
+        checkVkResult(
+            volkInitialize(),
+            "Failed to load Vulkan functions. This is an indication that the system does not support "
+            "Vulkan.");
 
-    createVkInstance(args.title, args.version);
-    volkLoadInstance(_vkInstance);
+        createVkInstance(args.title, args.version);
+        volkLoadInstance(_vkInstance);
 #endif
 
-    createWindow(args.title, args.initialWindowSize, args.fullScreenDisplayIndex);
-    openInitialGamepads();
-    initializeImGui();
-    createPainter();
-    createAudioDevice(!args.enableAudio);
+        createWindow(args.title, args.initialWindowSize, args.fullScreenDisplayIndex);
+        openInitialGamepads();
+        initializeImGui();
+        createPainter();
+        createAudioDevice(!args.enableAudio);
+    }
 
-    _contentManager = makeUnique<ContentManager>();
+    if (args.imageAtlasing)
+    {
+        _painter.impl()->enableImageAtlasing(*args.imageAtlasing);
+    }
+
+    _painter.impl()->enableParallelVertexGeneration(args.vertexGeneration);
 }
 
 Game::Impl::~Impl() noexcept
@@ -162,16 +210,26 @@ void Game::Impl::run(NotNull<Game*> backLink)
 
     _timer.init();
 
+    setProfilerThreadName("Main");
+
     while (_isRunning)
     {
 #ifdef polly_have_gfx_metal
         auto arp = NS::TransferPtr(NS::AutoreleasePool::alloc()->init());
 #endif
 
-        processEvents();
+        markProfilerFrame();
+
+        PollyProfileScope("Frame");
+
+        {
+            PollyProfileScope("Game::processEvents");
+            processEvents();
+        }
 
         if (_audioDevice)
         {
+            PollyProfileScope("AudioDevice::purgeSounds");
             auto& audioDeviceImpl = *_audioDevice.impl();
             audioDeviceImpl.purgeSounds();
         }
@@ -180,15 +238,20 @@ void Game::Impl::run(NotNull<Game*> backLink)
         const auto currentTime   = SDL_GetPerformanceCounter();
         const auto timeFrequency = SDL_GetPerformanceFrequency();
 
-        const auto elapsedTime =
+        const auto realElapsedTime =
             _isFirstTick ? 0.0 : double(currentTime - _previousTime) / double(timeFrequency);
 
+        const auto elapsedTime = _fixedTimeStep and not _isFirstTick ? *_fixedTimeStep : realElapsedTime;
+
         _previousTime = currentTime;
         _gameTime     = GameTime(elapsedTime, _gameTime.total() + elapsedTime);
 
         updateOnScreenMessages(_gameTime.elapsed());
 
-        _backLink->update(_gameTime);
+        {
+            PollyProfileScope("Game::update");
+            _backLink->update(_gameTime);
+        }
 
         {
             auto& imGuiImpl = *_imgui.impl();
@@ -216,19 +279,28 @@ void Game::Impl::run(NotNull<Game*> backLink)
                 _isDrawing = false;
             };
 
-            _backLink->draw(_painter);
+            {
+                PollyProfileScope("Game::draw");
+                _backLink->draw(_painter);
+            }
 
             _painter.setSpriteShader({});
             _painter.setTransformation({});
             drawOnScreenLogMessages(painterImpl);
 
-            painterImpl.endFrame(_imgui, [this](ImGui imgui) { _backLink->onImGui(imgui); });
+            painterImpl.endFrame(
+                _imgui,
+                [this](ImGui imgui)
+                {
+                    PollyProfileScope("Game::onImGui");
+                    _backLink->onImGui(imgui);
+                });
         }
 
         _isFirstTick = false;
 
         ++_fpsCounter;
-        _timeSinceLastFPSMeasurement += _gameTime.elapsed();
+        _timeSinceLastFPSMeasurement += realElapsedTime;
 
         if (_timeSinceLastFPSMeasurement >= 1.0)
         {
@@ -259,11 +331,33 @@ StringView Game::Impl::companyName() const
     return _companyName;
 }
 
+Maybe<String> Game::Impl::writableStoragePath() const
+{
+    if (_title.isEmpty() or _companyName.isEmpty())
+    {
+        return none;
+    }
+
+    auto path = FileSystem::randomWritablePath(_companyName, _title);
+
+    if (path)
+    {
+        FileSystem::transformToCleanPath(*path, true);
+    }
+
+    return path;
+}
+
 GameTime Game::Impl::time() const
 {
     return _gameTime;
 }
 
+bool Game::Impl::isHeadless() const
+{
+    return _isHeadless;
+}
+
 ContentManager& Game::Impl::contentManager()
 {
     return *_contentManager;
@@ -375,7 +469,10 @@ void Game::Impl::createWindow(
     Maybe<Vec2> initialWindowSize,
     Maybe<u32>  fullScreenDisplayIndex)
 {
-#if defined(polly_have_gfx_metal)
+#if defined(polly_have_gfx_software)
+    auto impl =
+        makeUnique<SoftwareWindow>(title, initialWindowSize, fullScreenDisplayIndex, _connectedDisplays);
+#elif defined(polly_have_gfx_metal)
     auto impl = makeUnique<MetalWindow>(title, initialWindowSize, fullScreenDisplayIndex, _connectedDisplays);
 #elif defined(polly_have_gfx_d3d11)
     auto impl = makeUnique<D3DWindow>(
@@ -401,6 +498,16 @@ void Game::Impl::createWindow(
     setImpl(_window, impl.release());
 }
 
+void Game::Impl::createHeadlessWindowAndPainter(StringView title, Maybe<Vec2> initialWindowSize)
+{
+    logDebug("Initializing headless mode");
+
+    auto windowImpl = makeUnique<NullWindow>(title, initialWindowSize);
+    setImpl(_window, windowImpl.release());
+
+    _painter = Painter(makeUnique<NullPainter>(*_window.impl(), _performanceStats).release());
+}
+
 void Game::Impl::openInitialGamepads()
 {
     assume(_connectedGamepads.isEmpty());
@@ -465,7 +572,9 @@ void Game::Impl::createPainter()
 
     auto impl = UniquePtr<Painter::Impl>();
 
-#if defined(polly_have_gfx_metal)
+#if defined(polly_have_gfx_software)
+    impl = makeUnique<SoftwarePainter>(*_window.impl(), _performanceStats);
+#elif defined(polly_have_gfx_metal)
     impl = makeUnique<MetalPainter>(*_window.impl(), _performanceStats);
 #elif defined(polly_have_gfx_d3d11)
     impl = makeUnique<D3D11Painter>(*_window.impl(), _performanceStats);
@@ -66,8 +66,14 @@ class Game::Impl final : public Object
 
     StringView companyName() const;
 
+    // The game's per-user writable directory (with a trailing slash), which is used for
+    // caches and settings. It's only available if the game has a title and a company name.
+    Maybe<String> writableStoragePath() const;
+
     GameTime time() const;
 
+    bool isHeadless() const;
+
     ContentManager& contentManager();
 
     bool isAudioDeviceInitialized() const;
@@ -127,6 +133,8 @@ class Game::Impl final : public Object
   private:
     void createWindow(StringView title, Maybe<Vec2> initialWindowSize, Maybe<u32> fullScreenDisplayIndex);
 
+    void createHeadlessWindowAndPainter(StringView title, Maybe<Vec2> initialWindowSize);
+
     void openInitialGamepads();
 
     void initializeImGui();
@@ -181,6 +189,8 @@ class Game::Impl final : public Object
 
     String               _title;
     String               _companyName;
+    bool                 _isHeadless   = false;
+    Maybe<double>        _fixedTimeStep;
     bool                 _isRunning    = false;
     bool                 _isFirstTick  = true;
     bool                 _isDrawing    = false;
@@ -4,6 +4,7 @@
 
 #include "Polly/Graphics/D3D11/D3D11Painter.hpp"
 
+#include "Polly/Algorithm.hpp"
 #include "Polly/Array.hpp"
 #include "Polly/Defer.hpp"
 #include "Polly/GamePerformanceStats.hpp"
@@ -11,9 +12,11 @@
 #include "Polly/Graphics/D3D11/D3D11UserShader.hpp"
 #include "Polly/Graphics/D3D11/D3DWindow.hpp"
 #include "Polly/Graphics/InternalSharedShaderStructs.hpp"
+#include "Polly/Graphics/PrecompiledShader.hpp"
 #include "Polly/Graphics/Tessellation2D.hpp"
 #include "Polly/Graphics/VertexElement.hpp"
 #include "Polly/ImGui.hpp"
+#include "Polly/Profiler.hpp"
 #include "Polly/ShaderCompiler/Ast.hpp"
 #include "Polly/ShaderCompiler/HLSLShaderGenerator.hpp"
 
@@ -46,7 +49,13 @@ D3D11Painter::D3D11Painter(Window::Impl& windowImpl, GamePerformanceStats& perfo
     createPolyRenderingResources();
     createMeshRenderingResources();
 
-    postInit(determineCapabilities(), 1, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices);
+    postInit(
+        determineCapabilities(),
+        1,
+        maxSpriteBatchSize,
+        maxPolyVertices,
+        maxMeshVertices,
+        maxMeshIndices);
 
     if (!ImGui_ImplSDL3_InitForD3D(windowImpl.sdlWindow()))
     {
@@ -69,8 +78,41 @@ D3D11Painter::~D3D11Painter() noexcept
 
 void D3D11Painter::onFrameStarted()
 {
+    PollyProfileScope("D3D11Painter::onFrameStarted");
+
     beginEvent(L"Painter Frame");
 
+    // Grow the per-frame buffers if the last frame didn't fit into them.
+    {
+        if (const auto vertexCount = _spriteVertexRing.startFrame())
+        {
+            createSpriteVertexBuffer(*vertexCount);
+        }
+
+        if (const auto vertexCount = _polyVertexRing.startFrame())
+        {
+            createPolyVertexBuffer(*vertexCount);
+        }
+
+        const auto meshVertexCount = _meshVertexRing.startFrame();
+        const auto meshIndexCount  = _meshIndexRing.startFrame();
+
+        if (meshVertexCount or meshIndexCount)
+        {
+            createMeshBuffers(_meshVertexRing.capacity(), _meshIndexRing.capacity());
+        }
+
+        auto& stats = performanceStats();
+
+        stats.spriteBufferHighWaterMark = _spriteVertexRing.highWaterMark() * u32(sizeof(PackedSpriteVertex));
+
+        stats.polygonBufferHighWaterMark =
+            _polyVertexRing.highWaterMark() * u32(sizeof(Tessellation2D::PackedPolyVertex));
+
+        stats.meshVertexBufferHighWaterMark = _meshVertexRing.highWaterMark() * u32(sizeof(PackedMeshVertex));
+        stats.meshIndexBufferHighWaterMark  = _meshIndexRing.highWaterMark() * u32(sizeof(u32));
+    }
+
     // Bind vertex buffers
     {
         const auto vertexBuffers = Array{
@@ -80,9 +122,9 @@ void D3D11Painter::onFrameStarted()
         };
 
         const auto strides = Array{
-            static_cast<UINT>(sizeof(SpriteVertex)),
-            static_cast<UINT>(sizeof(Tessellation2D::PolyVertex)),
-            static_cast<UINT>(sizeof(MeshVertex)),
+            static_cast<UINT>(sizeof(PackedSpriteVertex)),
+            static_cast<UINT>(sizeof(Tessellation2D::PackedPolyVertex)),
+            static_cast<UINT>(sizeof(PackedMeshVertex)),
         };
 
         const auto offsets = Array{0u, 0u, 0u};
@@ -110,12 +152,6 @@ void D3D11Painter::onFrameStarted()
     _id3d11Context->RSSetState(_rasterizerStateDefault.Get());
     _lastBoundRasterizerState = _rasterizerStateDefault.Get();
 
-    _spriteVertexCounter = 0;
-    _spriteIndexCounter  = 0;
-    _polyVertexCounter   = 0;
-    _meshVertexCounter   = 0;
-    _meshIndexCounter    = 0;
-
     _lastBoundViewport          = Rectangle();
     _lastBoundIndexBuffer       = nullptr;
     _lastBoundUserShaderCBuffer = nullptr;
@@ -132,6 +168,8 @@ void D3D11Painter::onFrameStarted()
 
 void D3D11Painter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc)
 {
+    PollyProfileScope("D3D11Painter::onFrameEnded");
+
     defer
     {
         endEvent();
@@ -139,6 +177,8 @@ void D3D11Painter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGui
 
     if (imGuiDrawFunc)
     {
+        PollyProfileScope("ImGui");
+
         beginEvent(L"ImGui");
 
         setCanvas(none, none, false);
@@ -198,6 +238,27 @@ UniquePtr<Shader::Impl> D3D11Painter::onCreateNativeUserShader(
         ast.filename());
 }
 
+UniquePtr<Shader::Impl> D3D11Painter::onCreatePrecompiledUserShader(
+    const PrecompiledShader& shader,
+    StringView               filenameHint)
+{
+    if (shader.hlslCode.isEmpty())
+    {
+        return Impl::onCreatePrecompiledUserShader(shader, filenameHint);
+    }
+
+    return makeUnique<D3D11UserShader>(
+        *this,
+        shader.type,
+        shader.sourceCode,
+        shader.hlslCode,
+        shader.reflection.parameters,
+        shader.reflection.flags,
+        shader.reflection.cbufferSize,
+        _d3d11ShaderCompiler,
+        filenameHint);
+}
+
 void D3D11Painter::onBeforeCanvasChanged(
     [[maybe_unused]] Image     oldCanvas,
     [[maybe_unused]] Rectangle viewport)
@@ -375,7 +436,12 @@ int D3D11Painter::prepareDrawCall()
 
         if (indexBuffer != _lastBoundIndexBuffer)
         {
-            _id3d11Context->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+            // Mesh indices are 32-bit, since they're offset by the position of their mesh in the
+            // vertex buffer, which may exceed the 16-bit range.
+            const auto format =
+                currentBatchMode == BatchMode::Mesh ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+
+            _id3d11Context->IASetIndexBuffer(indexBuffer, format, 0);
             _lastBoundIndexBuffer = indexBuffer;
         }
 
@@ -478,39 +544,42 @@ int D3D11Painter::prepareDrawCall()
 void D3D11Painter::flushSprites(
     Span<InternalSprite>  sprites,
     GamePerformanceStats& stats,
-    Rectangle             imageSizeAndInverse)
+    Span<Rectangle>       imageSizesAndInverse)
 {
+    PollyProfileScope("D3D11Painter::flushSprites");
+
     beginEvent(L"flushSprites");
 
+    const auto vertexCount = sprites.size() * verticesPerSprite;
+    const auto indexCount  = sprites.size() * indicesPerSprite;
+    const auto range       = _spriteVertexRing.allocate(vertexCount);
+
     // Draw sprites
     auto mappedVertices = D3D11_MAPPED_SUBRESOURCE();
     checkHResult(
         _id3d11Context->Map(
             _spriteVertexBuffer.Get(),
             0,
-            _spriteVertexCounter == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+            range.mustDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
             0,
             &mappedVertices),
         "Failed to map the sprite vertex buffer.");
 
-    auto* dstVertices = static_cast<SpriteVertex*>(mappedVertices.pData) + _spriteVertexCounter;
+    auto* dstVertices = static_cast<PackedSpriteVertex*>(mappedVertices.pData) + range.offset;
 
-    fillSpriteVertices<false>(dstVertices, sprites, imageSizeAndInverse);
+    fillSpriteVertices<false>(dstVertices, sprites, imageSizesAndInverse);
 
     _id3d11Context->Unmap(_spriteVertexBuffer.Get(), 0);
 
-    const auto vertexCount = sprites.size() * verticesPerSprite;
-    const auto indexCount  = sprites.size() * indicesPerSprite;
-
     applyInputLayout(_spriteInputLayout.Get());
     applyPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    _id3d11Context->DrawIndexed(indexCount, _spriteIndexCounter, 0);
+
+    // Every batch starts at the beginning of the sprite index buffer, offset by a base vertex.
+    _id3d11Context->DrawIndexed(indexCount, 0, INT(range.offset));
 
     ++stats.drawCallCount;
     stats.vertexCount += vertexCount;
-
-    _spriteVertexCounter += vertexCount;
-    _spriteIndexCounter += indexCount;
+    stats.spriteBufferHighWaterMark = _spriteVertexRing.highWaterMark() * u32(sizeof(PackedSpriteVertex));
 
     endEvent();
 }
@@ -521,88 +590,178 @@ void D3D11Painter::flushPolys(
     u32                           numberOfVerticesToDraw,
     GamePerformanceStats&         stats)
 {
+    PollyProfileScope("D3D11Painter::flushPolys");
+
     beginEvent(L"flushPolys");
 
+    const auto range = _polyVertexRing.allocate(numberOfVerticesToDraw);
+
     auto mappedVertices = D3D11_MAPPED_SUBRESOURCE();
     checkHResult(
         _id3d11Context->Map(
             _polyVertexBuffer.Get(),
             0,
-            _polyVertexCounter == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+            range.mustDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
             0,
             &mappedVertices),
         "Failed to map the polygon vertex buffer.");
 
-    auto* dstVertices = static_cast<Tessellation2D::PolyVertex*>(mappedVertices.pData) + _polyVertexCounter;
+    auto* dstVertices = static_cast<Tessellation2D::PackedPolyVertex*>(mappedVertices.pData) + range.offset;
 
-    Tessellation2D::processPolyQueue(polys, dstVertices, polyCmdVertexCounts);
+    fillPolyVertices(polys, dstVertices, polyCmdVertexCounts, numberOfVerticesToDraw);
 
     _id3d11Context->Unmap(_polyVertexBuffer.Get(), 0);
 
     applyInputLayout(_polyInputLayout.Get());
     applyPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
-    _id3d11Context->Draw(numberOfVerticesToDraw, _polyVertexCounter);
+    _id3d11Context->Draw(numberOfVerticesToDraw, range.offset);
 
     ++stats.drawCallCount;
     stats.vertexCount += numberOfVerticesToDraw;
 
-    _polyVertexCounter += numberOfVerticesToDraw;
+    stats.polygonBufferHighWaterMark =
+        _polyVertexRing.highWaterMark() * u32(sizeof(Tessellation2D::PackedPolyVertex));
 
     endEvent();
 }
 
 void D3D11Painter::flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats)
 {
+    PollyProfileScope("D3D11Painter::flushMeshes");
+
     beginEvent(L"flushMeshes");
 
-    const auto baseVertex = _meshVertexCounter;
+    const auto vertexCount = sumBy(meshes, [](const MeshEntry& entry) { return entry.vertices.size(); });
+    const auto indexCount  = sumBy(meshes, [](const MeshEntry& entry) { return entry.indices.size(); });
+    const auto vertexRange = _meshVertexRing.allocate(vertexCount);
+    const auto indexRange  = _meshIndexRing.allocate(indexCount);
 
     auto mappedVertices = D3D11_MAPPED_SUBRESOURCE();
     checkHResult(
         _id3d11Context->Map(
             _meshVertexBuffer.Get(),
             0,
-            baseVertex == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+            vertexRange.mustDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
             0,
             &mappedVertices),
         "Failed to map the mesh vertex buffer.");
 
-    auto* dstVertices = static_cast<MeshVertex*>(mappedVertices.pData) + baseVertex;
+    auto* dstVertices = static_cast<PackedMeshVertex*>(mappedVertices.pData) + vertexRange.offset;
 
     auto mappedIndices = D3D11_MAPPED_SUBRESOURCE();
     checkHResult(
         _id3d11Context->Map(
             _meshIndexBuffer.Get(),
             0,
-            _meshIndexCounter == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+            indexRange.mustDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
             0,
             &mappedIndices),
         "Failed to map the mesh index buffer.");
 
-    auto* dstIndices = static_cast<u16*>(mappedIndices.pData) + _meshIndexCounter;
+    auto* dstIndices = static_cast<u32*>(mappedIndices.pData) + indexRange.offset;
 
     const auto [totalVertexCount, totalIndexCount] =
-        fillMeshVertices(meshes, dstVertices, dstIndices, baseVertex);
+        fillMeshVertices(meshes, dstVertices, dstIndices, vertexRange.offset);
 
     _id3d11Context->Unmap(_meshVertexBuffer.Get(), 0);
     _id3d11Context->Unmap(_meshIndexBuffer.Get(), 0);
 
     applyInputLayout(_meshInputLayout.Get());
     applyPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    _id3d11Context->DrawIndexed(totalIndexCount, _meshIndexCounter, 0);
-
-    _meshVertexCounter += totalVertexCount;
-    _meshIndexCounter += totalIndexCount;
+    _id3d11Context->DrawIndexed(totalIndexCount, indexRange.offset, 0);
 
     ++stats.drawCallCount;
     stats.vertexCount += totalVertexCount;
+    stats.meshVertexBufferHighWaterMark = _meshVertexRing.highWaterMark() * u32(sizeof(PackedMeshVertex));
+    stats.meshIndexBufferHighWaterMark  = _meshIndexRing.highWaterMark() * u32(sizeof(u32));
+
+    endEvent();
+}
+
+UniquePtr<StaticSpriteBatch::Impl::Buffer> D3D11Painter::createStaticSpriteBuffer(u32 spriteCount)
+{
+    auto buffer = makeUnique<StaticSpriteBuffer>();
+
+    const auto desc = D3D11_BUFFER_DESC{
+        .ByteWidth = spriteCount * verticesPerSprite * sizeof(PackedSpriteVertex),
+        .Usage     = D3D11_USAGE_DEFAULT,
+        .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+    };
+
+    checkHResult(
+        _id3d11Device->CreateBuffer(&desc, nullptr, &buffer->vertexBuffer),
+        "Failed to create a static sprite vertex buffer.");
+
+    setD3D11ObjectLabel(buffer->vertexBuffer.Get(), "StaticSpriteVertexBuffer");
+
+    return buffer;
+}
+
+void D3D11Painter::updateStaticSpriteBuffer(
+    StaticSpriteBatch::Impl::Buffer& buffer,
+    u32                              offset,
+    Span<InternalSprite>             sprites,
+    const Rectangle&                 imageSizeAndInverse)
+{
+    auto& staticBuffer = static_cast<StaticSpriteBuffer&>(buffer);
+
+    _staticSpriteVertices.resize(sprites.size() * verticesPerSprite);
+
+    fillSpriteVertices<false>(_staticSpriteVertices.data(), sprites, Span(&imageSizeAndInverse, 1));
+
+    const auto updateBox = D3D11_BOX{
+        .left   = UINT(offset * verticesPerSprite * sizeof(PackedSpriteVertex)),
+        .top    = 0,
+        .front  = 0,
+        .right  = UINT((offset + sprites.size()) * verticesPerSprite * sizeof(PackedSpriteVertex)),
+        .bottom = 1,
+        .back   = 1,
+    };
+
+    _id3d11Context->UpdateSubresource(
+        staticBuffer.vertexBuffer.Get(),
+        0,
+        &updateBox,
+        _staticSpriteVertices.data(),
+        0,
+        0);
+}
+
+void D3D11Painter::drawStaticSprites(
+    StaticSpriteBatch::Impl::Buffer& buffer,
+    u32                              offset,
+    u32                              count,
+    GamePerformanceStats&            stats)
+{
+    beginEvent(L"drawStaticSprites");
+
+    const auto& staticBuffer = static_cast<const StaticSpriteBuffer&>(buffer);
+    const auto  stride       = static_cast<UINT>(sizeof(PackedSpriteVertex));
+    const auto  zeroOffset   = UINT(0);
+    auto*       vertexBuffer = staticBuffer.vertexBuffer.Get();
+
+    _id3d11Context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &zeroOffset);
+
+    applyInputLayout(_spriteInputLayout.Get());
+    applyPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    // Every chunk starts at the beginning of the sprite index buffer, offset by a base vertex.
+    _id3d11Context->DrawIndexed(count * indicesPerSprite, 0, INT(offset * verticesPerSprite));
+
+    // Restore the sprite vertex buffer, which stays bound for the entire frame.
+    auto* spriteVertexBuffer = _spriteVertexBuffer.Get();
+    _id3d11Context->IASetVertexBuffers(0, 1, &spriteVertexBuffer, &stride, &zeroOffset);
+
+    ++stats.drawCallCount;
+    stats.vertexCount += count * verticesPerSprite;
 
     endEvent();
 }
 
 void D3D11Painter::spriteQueueLimitReached()
 {
-    throw Error("Sprite queue limit reached.");
+    // The sprite vertex buffer is a ring that grows as needed, so just draw what we have so far.
+    flush();
 }
 
 ID3D11Device* D3D11Painter::id3d11Device() const
@@ -765,28 +924,15 @@ void D3D11Painter::createSpriteRenderingResources()
     const auto [spriteVertexShader, spriteInputLayout] = _d3d11ShaderCompiler.compileVertexShader(
         AllShaders_hlslStringView(),
         "spritesVS"_sv,
-        Array{VertexElement::Vec4, VertexElement::Vec4},
+        Array{VertexElement::Vec2, VertexElement::Vec2, VertexElement::UByte4Normalized},
         0,
         "SpriteVertexShader"_sv);
 
     _spriteVertexShader = spriteVertexShader;
     _spriteInputLayout  = spriteInputLayout;
 
-    // Vertex buffer
-    {
-        const auto desc = D3D11_BUFFER_DESC{
-            .ByteWidth      = maxSpriteBatchSize * verticesPerSprite * sizeof(SpriteVertex),
-            .Usage          = D3D11_USAGE_DYNAMIC,
-            .BindFlags      = D3D11_BIND_VERTEX_BUFFER,
-            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
-        };
-
-        checkHResult(
-            _id3d11Device->CreateBuffer(&desc, nullptr, &_spriteVertexBuffer),
-            "Failed to create the sprite vertex buffer.");
-
-        setD3D11ObjectLabel(_spriteVertexBuffer.Get(), "SpriteVertexBuffer");
-    }
+    _spriteVertexRing = DynamicBufferRing(maxSpriteBatchSize * verticesPerSprite);
+    createSpriteVertexBuffer(_spriteVertexRing.capacity());
 
     // Index buffer
     {
@@ -815,27 +961,15 @@ void D3D11Painter::createPolyRenderingResources()
     const auto [polyVertexShader, polyInputLayout] = _d3d11ShaderCompiler.compileVertexShader(
         AllShaders_hlslStringView(),
         "polyVS"_sv,
-        Array{VertexElement::Vec4, VertexElement::Vec4},
+        Array{VertexElement::Vec2, VertexElement::UByte4Normalized},
         1,
         "PolyVertexShader"_sv);
 
     _polyVertexShader = polyVertexShader;
     _polyInputLayout  = polyInputLayout;
 
-    // Vertex buffer
-    {
-        auto desc           = D3D11_BUFFER_DESC();
-        desc.ByteWidth      = sizeof(Tessellation2D::PolyVertex) * maxPolyVertices;
-        desc.Usage          = D3D11_USAGE_DYNAMIC;
-        desc.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
-        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-
-        checkHResult(
-            _id3d11Device->CreateBuffer(&desc, nullptr, &_polyVertexBuffer),
-            "Failed to create the polygon vertex buffer.");
-
-        setD3D11ObjectLabel(_polyVertexBuffer.Get(), "PolyVertexBuffer");
-    }
+    _polyVertexRing = DynamicBufferRing(maxPolyVertices);
+    createPolyVertexBuffer(_polyVertexRing.capacity());
 }
 
 void D3D11Painter::createMeshRenderingResources()
@@ -844,16 +978,53 @@ void D3D11Painter::createMeshRenderingResources()
     const auto [meshVertexShader, meshInputLayout] = _d3d11ShaderCompiler.compileVertexShader(
         AllShaders_hlslStringView(),
         "meshVS"_sv,
-        Array{VertexElement::Vec4, VertexElement::Vec4},
+        Array{VertexElement::Vec2, VertexElement::Vec2, VertexElement::UByte4Normalized},
         2,
         "MeshVertexShader"_sv);
 
     _meshVertexShader = meshVertexShader;
     _meshInputLayout  = meshInputLayout;
 
-    // Buffers
+    _meshVertexRing = DynamicBufferRing(maxMeshVertices);
+    _meshIndexRing  = DynamicBufferRing(maxMeshIndices);
+    createMeshBuffers(_meshVertexRing.capacity(), _meshIndexRing.capacity());
+}
+
+void D3D11Painter::createSpriteVertexBuffer(u32 vertexCount)
+{
+    const auto desc = D3D11_BUFFER_DESC{
+        .ByteWidth      = vertexCount * u32(sizeof(PackedSpriteVertex)),
+        .Usage          = D3D11_USAGE_DYNAMIC,
+        .BindFlags      = D3D11_BIND_VERTEX_BUFFER,
+        .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+    };
+
+    checkHResult(
+        _id3d11Device->CreateBuffer(&desc, nullptr, &_spriteVertexBuffer),
+        "Failed to create the sprite vertex buffer.");
+
+    setD3D11ObjectLabel(_spriteVertexBuffer.Get(), "SpriteVertexBuffer");
+}
+
+void D3D11Painter::createPolyVertexBuffer(u32 vertexCount)
+{
+    auto desc           = D3D11_BUFFER_DESC();
+    desc.ByteWidth      = vertexCount * u32(sizeof(Tessellation2D::PackedPolyVertex));
+    desc.Usage          = D3D11_USAGE_DYNAMIC;
+    desc.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    checkHResult(
+        _id3d11Device->CreateBuffer(&desc, nullptr, &_polyVertexBuffer),
+        "Failed to create the polygon vertex buffer.");
+
+    setD3D11ObjectLabel(_polyVertexBuffer.Get(), "PolyVertexBuffer");
+}
+
+void D3D11Painter::createMeshBuffers(u32 vertexCount, u32 indexCount)
+{
     auto desc           = D3D11_BUFFER_DESC();
-    desc.ByteWidth      = sizeof(MeshVertex) * maxMeshVertices;
+    desc.ByteWidth      = vertexCount * u32(sizeof(PackedMeshVertex));
     desc.Usage          = D3D11_USAGE_DYNAMIC;
     desc.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
     desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
@@ -864,7 +1035,7 @@ void D3D11Painter::createMeshRenderingResources()
 
     setD3D11ObjectLabel(_meshVertexBuffer.Get(), "MeshVertexBuffer");
 
-    desc.ByteWidth = sizeof(u16) * maxMeshVertices;
+    desc.ByteWidth = indexCount * u32(sizeof(u32));
     desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 
     checkHResult(
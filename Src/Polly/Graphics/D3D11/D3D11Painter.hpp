@@ -8,6 +8,7 @@
 #include "Polly/Graphics/D3D11/D3D11PipelineObjectCache.hpp"
 #include "Polly/Graphics/D3D11/D3D11Prerequisites.hpp"
 #include "Polly/Graphics/D3D11/D3D11ShaderCompiler.hpp"
+#include "Polly/Graphics/DynamicBufferRing.hpp"
 #include "Polly/Graphics/PainterImpl.hpp"
 #include "Polly/ShaderCompiler/HLSLShaderGenerator.hpp"
 
@@ -44,6 +45,10 @@ class D3D11Painter final : public Painter::Impl
         UserShaderFlags                     flags,
         u16                                 cbufferSize) override;
 
+    UniquePtr<Shader::Impl> onCreatePrecompiledUserShader(
+        const PrecompiledShader& shader,
+        StringView               filenameHint) override;
+
     void onBeforeCanvasChanged(Image oldCanvas, Rectangle viewport) override;
 
     void onAfterCanvasChanged(Image newCanvas, Maybe<Color> clearColor, Rectangle viewport) override;
@@ -58,7 +63,7 @@ class D3D11Painter final : public Painter::Impl
     void flushSprites(
         Span<InternalSprite>  sprites,
         GamePerformanceStats& stats,
-        Rectangle             imageSizeAndInverse) override;
+        Span<Rectangle>       imageSizesAndInverse) override;
 
     void flushPolys(
         Span<Tessellation2D::Command> polys,
@@ -68,6 +73,20 @@ class D3D11Painter final : public Painter::Impl
 
     void flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats) override;
 
+    UniquePtr<StaticSpriteBatch::Impl::Buffer> createStaticSpriteBuffer(u32 spriteCount) override;
+
+    void updateStaticSpriteBuffer(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        Span<InternalSprite>             sprites,
+        const Rectangle&                 imageSizeAndInverse) override;
+
+    void drawStaticSprites(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        u32                              count,
+        GamePerformanceStats&            stats) override;
+
     void spriteQueueLimitReached() override;
 
     ID3D11Device* id3d11Device() const;
@@ -75,9 +94,18 @@ class D3D11Painter final : public Painter::Impl
     ID3D11DeviceContext* id3d11Context() const;
 
   private:
+    // These limit the size of a single batch; larger batches are split by the painter.
+    // The per-frame buffers start at these sizes and grow when a frame needs more.
     static constexpr auto maxSpriteBatchSize = std::numeric_limits<uint16_t>::max() / verticesPerSprite;
     static constexpr auto maxPolyVertices    = std::numeric_limits<uint16_t>::max();
     static constexpr auto maxMeshVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshIndices     = maxMeshVertices * 3;
+
+    class StaticSpriteBuffer final : public StaticSpriteBatch::Impl::Buffer
+    {
+      public:
+        ComPtr<ID3D11Buffer> vertexBuffer;
+    };
 
     // For user shaders, we use buckets of cbuffers, each with increasing sizes.
     // Since we're always using D3D11_MAP_WRITE_DISCARD every time we update a cbuffer,
@@ -104,6 +132,12 @@ class D3D11Painter final : public Painter::Impl
 
     void createMeshRenderingResources();
 
+    void createSpriteVertexBuffer(u32 vertexCount);
+
+    void createPolyVertexBuffer(u32 vertexCount);
+
+    void createMeshBuffers(u32 vertexCount, u32 indexCount);
+
     void applyInputLayout(ID3D11InputLayout* inputLayout);
 
     void applyPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
@@ -144,11 +178,13 @@ class D3D11Painter final : public Painter::Impl
     ComPtr<ID3D11Buffer>       _meshVertexBuffer;
     ComPtr<ID3D11Buffer>       _meshIndexBuffer;
 
-    u32 _spriteVertexCounter = 0;
-    u32 _spriteIndexCounter  = 0;
-    u32 _polyVertexCounter   = 0;
-    u32 _meshVertexCounter   = 0;
-    u32 _meshIndexCounter    = 0;
+    DynamicBufferRing _spriteVertexRing;
+    DynamicBufferRing _polyVertexRing;
+    DynamicBufferRing _meshVertexRing;
+    DynamicBufferRing _meshIndexRing;
+
+    // Temporary storage for vertices that are uploaded to static sprite buffers.
+    List<PackedSpriteVertex> _staticSpriteVertices;
 
     Rectangle     _lastBoundViewport;
     ID3D11Buffer* _lastBoundIndexBuffer       = nullptr;
@@ -27,6 +27,7 @@ static Maybe<DXGI_FORMAT> convertVertexElementFormat(VertexElement element)
         case VertexElement::Vec2: return DXGI_FORMAT_R32G32_FLOAT;
         case VertexElement::Vec3: return DXGI_FORMAT_R32G32B32_FLOAT;
         case VertexElement::Vec4: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        case VertexElement::UByte4Normalized: return DXGI_FORMAT_R8G8B8A8_UNORM;
     }
 
     return none;
@@ -37,7 +38,8 @@ static Maybe<u32> vertexElementSizeInBytes(VertexElement element)
     switch (element)
     {
         case VertexElement::Int:
-        case VertexElement::Float: return 4u;
+        case VertexElement::Float:
+        case VertexElement::UByte4Normalized: return 4u;
         case VertexElement::Vec2: return 4u * 2;
         case VertexElement::Vec3: return 4u * 3;
         case VertexElement::Vec4: return 4u * 4;
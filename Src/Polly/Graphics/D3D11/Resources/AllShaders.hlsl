@@ -3,10 +3,12 @@ cbuffer Param : register(b0)
     row_major float4x4 Transformation;
 };
 
+// The vertex colors are stored as normalized 8-bit values and arrive here as floats.
 struct SpriteVertex
 {
-    float4 positionAndUV : TEXCOORD0;
-    float4 color : TEXCOORD1;
+    float2 position : TEXCOORD0;
+    float2 uv : TEXCOORD1;
+    float4 color : TEXCOORD2;
 };
 
 struct SpriteVSOutput
@@ -18,8 +20,9 @@ struct SpriteVSOutput
 
 struct MeshVertex
 {
-    float4 positionAndUV : TEXCOORD0;
-    float4 color : TEXCOORD1;
+    float2 position : TEXCOORD0;
+    float2 uv : TEXCOORD1;
+    float4 color : TEXCOORD2;
 };
 
 struct MeshVSOutput
@@ -31,7 +34,7 @@ struct MeshVSOutput
 
 struct PolyVertex
 {
-    float4 position : TEXCOORD0;
+    float2 position : TEXCOORD0;
     float4 color : TEXCOORD1;
 };
 
@@ -44,11 +47,11 @@ struct PolyVSOutput
 SpriteVSOutput spritesVS(SpriteVertex input)
 {
     SpriteVSOutput output = (SpriteVSOutput) 0;
-    float4 inPos = float4(input.positionAndUV.xy, 0, 1);
+    float4 inPos = float4(input.position, 0, 1);
     
     output.position = mul(inPos, Transformation);
     output.color = input.color;
-    output.uv = input.positionAndUV.zw;
+    output.uv = input.uv;
 
     return output;
 }
@@ -56,7 +59,7 @@ SpriteVSOutput spritesVS(SpriteVertex input)
 PolyVSOutput polyVS(PolyVertex input)
 {
     PolyVSOutput output = (PolyVSOutput) 0;
-    output.position = mul(input.position, Transformation);
+    output.position = mul(float4(input.position, 0, 1), Transformation);
     output.color = input.color;
     
     return output;
@@ -65,8 +68,8 @@ PolyVSOutput polyVS(PolyVertex input)
 MeshVSOutput meshVS(MeshVertex input)
 {
     MeshVSOutput output = (MeshVSOutput) 0;
-    output.position = mul(float4(input.positionAndUV.xy, 0, 1), Transformation);
-    output.uv = input.positionAndUV.zw;
+    output.position = mul(float4(input.position, 0, 1), Transformation);
+    output.uv = input.uv;
     output.color = input.color;
     
     return output;
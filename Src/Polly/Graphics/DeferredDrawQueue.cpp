@@ -0,0 +1,126 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/DeferredDrawQueue.hpp"
+
+#include "Polly/Algorithm.hpp"
+
+namespace Polly
+{
+bool DeferredDrawQueue::record(
+    const Sprite&     sprite,
+    u8                layer,
+    const Shader&     shader,
+    const BlendState& blendState,
+    const Sampler&    sampler,
+    const Matrix&     transformation)
+{
+    const auto shaderIndex         = indexOfState(_shaders, shader);
+    const auto blendStateIndex     = indexOfState(_blendStates, blendState);
+    const auto samplerIndex        = indexOfState(_samplers, sampler);
+    const auto transformationIndex = indexOfState(_transformations, transformation);
+
+    if (not shaderIndex or not blendStateIndex or not samplerIndex or not transformationIndex)
+    {
+        return false;
+    }
+
+    const auto* imageImpl = sprite.image.impl();
+
+    // Consecutive sprites usually share the same image.
+    if (imageImpl != _lastImage)
+    {
+        if (const auto index = _imageIndices.find(imageImpl))
+        {
+            _lastImageIndex = *index;
+        }
+        else
+        {
+            if (_imageIndices.size() == maxImageCount)
+            {
+                return false;
+            }
+
+            _lastImageIndex = _imageIndices.size();
+            _imageIndices.add(imageImpl, _lastImageIndex);
+        }
+
+        _lastImage = imageImpl;
+    }
+
+    const auto key = (u64(layer) << 56)
+                     | (u64(*shaderIndex) << 48)
+                     | (u64(*blendStateIndex) << 40)
+                     | (u64(*samplerIndex) << 32)
+                     | (u64(*transformationIndex) << 24)
+                     | u64(_lastImageIndex);
+
+    _sortEntries.add(
+        SortEntry{
+            .key   = key,
+            .index = _commands.size(),
+        });
+
+    _commands.add(
+        Command{
+            .sprite         = sprite,
+            .shader         = *shaderIndex,
+            .blendState     = *blendStateIndex,
+            .sampler        = *samplerIndex,
+            .transformation = *transformationIndex,
+        });
+
+    return true;
+}
+
+void DeferredDrawQueue::sortAndVisit(const Function<void(const Command&)>& visitor)
+{
+    // The command index breaks ties, so that sprites of the same state keep their order.
+    sort(
+        _sortEntries,
+        [](const SortEntry& lhs, const SortEntry& rhs)
+        { return lhs.key < rhs.key or (lhs.key == rhs.key and lhs.index < rhs.index); });
+
+    for (const auto& entry : _sortEntries)
+    {
+        visitor(_commands[entry.index]);
+    }
+}
+
+void DeferredDrawQueue::clear()
+{
+    _commands.clear();
+    _sortEntries.clear();
+    _shaders.clear();
+    _blendStates.clear();
+    _samplers.clear();
+    _transformations.clear();
+    _imageIndices.clear();
+    _lastImage      = nullptr;
+    _lastImageIndex = 0;
+}
+
+template<typename T>
+Maybe<u8> DeferredDrawQueue::indexOfState(List<T>& states, const T& state)
+{
+    // There are only a few distinct states per frame, and the most recent one is the most
+    // likely to be recorded again.
+    for (auto i = states.size(); i > 0; --i)
+    {
+        if (states[i - 1] == state)
+        {
+            return u8(i - 1);
+        }
+    }
+
+    if (states.size() == maxStateCount)
+    {
+        return none;
+    }
+
+    states.add(state);
+
+    return u8(states.size() - 1);
+}
+} // namespace Polly
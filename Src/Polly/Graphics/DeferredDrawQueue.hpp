@@ -0,0 +1,117 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/BlendState.hpp"
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Function.hpp"
+#include "Polly/Linalg.hpp"
+#include "Polly/List.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/Sampler.hpp"
+#include "Polly/Shader.hpp"
+#include "Polly/SortedMap.hpp"
+#include "Polly/Span.hpp"
+#include "Polly/Sprite.hpp"
+
+namespace Polly
+{
+// Records sprites along with the painter state they were drawn with, so that they can be
+// drawn sorted by state later, which merges sprites of the same state into fewer batches.
+//
+// Every sprite is assigned a 64-bit sort key, from the most to the least significant bits:
+//
+//   [ layer : 8 | shader : 8 | blend state : 8 | sampler : 8 | transformation : 8 | image : 24 ]
+//
+// Each state field is the index of that state in the order in which it was first recorded.
+// Sprites with equal keys keep the order in which they were recorded.
+class DeferredDrawQueue final
+{
+  public:
+    struct Command
+    {
+        Sprite sprite;
+        u8     shader         = 0;
+        u8     blendState     = 0;
+        u8     sampler        = 0;
+        u8     transformation = 0;
+    };
+
+    DeferredDrawQueue() = default;
+
+    DeleteCopyAndMove(DeferredDrawQueue);
+
+    ~DeferredDrawQueue() noexcept = default;
+
+    // Returns false if the sprite can't be recorded, because one of the state tables is full.
+    // In that case, the queue has to be submitted first.
+    [[nodiscard]]
+    bool record(
+        const Sprite&     sprite,
+        u8                layer,
+        const Shader&     shader,
+        const BlendState& blendState,
+        const Sampler&    sampler,
+        const Matrix&     transformation);
+
+    bool isEmpty() const
+    {
+        return _commands.isEmpty();
+    }
+
+    // Sorts the recorded commands and invokes the function for each of them, in sorted order.
+    void sortAndVisit(const Function<void(const Command&)>& visitor);
+
+    const Shader& shader(u8 index) const
+    {
+        return _shaders[index];
+    }
+
+    const BlendState& blendState(u8 index) const
+    {
+        return _blendStates[index];
+    }
+
+    const Sampler& sampler(u8 index) const
+    {
+        return _samplers[index];
+    }
+
+    const Matrix& transformation(u8 index) const
+    {
+        return _transformations[index];
+    }
+
+    Span<Shader> shaders() const
+    {
+        return _shaders;
+    }
+
+    void clear();
+
+  private:
+    static constexpr auto maxStateCount = 256u;
+    static constexpr auto maxImageCount = 1u << 24;
+
+    struct SortEntry
+    {
+        u64 key   = 0;
+        u32 index = 0;
+    };
+
+    template<typename T>
+    static Maybe<u8> indexOfState(List<T>& states, const T& state);
+
+    List<Command>                      _commands;
+    List<SortEntry>                    _sortEntries;
+    List<Shader>                       _shaders;
+    List<BlendState>                   _blendStates;
+    List<Sampler>                      _samplers;
+    List<Matrix>                       _transformations;
+    SortedMap<const Image::Impl*, u32> _imageIndices;
+    const Image::Impl*                 _lastImage      = nullptr;
+    u32                                _lastImageIndex = 0;
+};
+} // namespace Polly
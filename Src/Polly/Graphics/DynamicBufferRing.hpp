@@ -0,0 +1,112 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Assume.hpp"
+#include "Polly/Math.hpp"
+#include "Polly/Maybe.hpp"
+
+#include <bit>
+
+namespace Polly
+{
+// Hands out ranges of a dynamic vertex or index buffer that is written to during a frame.
+//
+// Ranges are handed out one after another. When a range doesn't fit into the rest of the
+// buffer anymore, the ring wraps around to the start of the buffer, and the backend has to
+// discard (orphan) the buffer's previous contents before writing to it.
+//
+// If a frame needed more than the buffer's capacity, the buffer should grow at the start of
+// the next frame, so that subsequent frames don't have to wrap around.
+//
+// All counts are in elements (vertices or indices), not bytes.
+class DynamicBufferRing final
+{
+  public:
+    struct Range
+    {
+        u32  offset      = 0;
+        bool mustDiscard = false;
+    };
+
+    DynamicBufferRing() = default;
+
+    explicit DynamicBufferRing(u32 capacity);
+
+    u32 capacity() const
+    {
+        return _capacity;
+    }
+
+    // The largest number of elements that was written to the buffer within a single frame.
+    u32 highWaterMark() const
+    {
+        return _highWaterMark;
+    }
+
+    // Starts a new frame. If the last frame needed more than the buffer's capacity,
+    // returns the capacity that the buffer has to be recreated with.
+    [[nodiscard]]
+    Maybe<u32> startFrame();
+
+    [[nodiscard]]
+    Range allocate(u32 count);
+
+  private:
+    u32 _capacity      = 0;
+    u32 _position      = 0;
+    u32 _frameUsage    = 0;
+    u32 _highWaterMark = 0;
+};
+
+inline DynamicBufferRing::DynamicBufferRing(u32 capacity)
+    : _capacity(capacity)
+{
+}
+
+inline Maybe<u32> DynamicBufferRing::startFrame()
+{
+    const auto lastFrameUsage = _frameUsage;
+
+    _position   = 0;
+    _frameUsage = 0;
+
+    if (lastFrameUsage <= _capacity)
+    {
+        return none;
+    }
+
+    _capacity = std::bit_ceil(lastFrameUsage);
+
+    return _capacity;
+}
+
+inline DynamicBufferRing::Range DynamicBufferRing::allocate(u32 count)
+{
+    // Batches are split by the painter so that each of them fits into the buffer.
+    assume(count <= _capacity);
+
+    // The first range of a frame discards the buffer as well, since the GPU may still
+    // be reading from it.
+    auto mustDiscard = _position == 0;
+
+    if (_position + count > _capacity)
+    {
+        _position   = 0;
+        mustDiscard = true;
+    }
+
+    const auto offset = _position;
+
+    _position += count;
+    _frameUsage += count;
+    _highWaterMark = max(_highWaterMark, _frameUsage);
+
+    return Range{
+        .offset      = offset,
+        .mustDiscard = mustDiscard,
+    };
+}
+} // namespace Polly
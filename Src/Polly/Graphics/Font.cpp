@@ -51,6 +51,36 @@ void Font::forEachGlyph(StringView text, float size, const GlyphAction& action)
         [&](char32_t codepoint, const Rectangle& rect) { return action(codepoint, rect); });
 }
 
+void Font::setDistanceFieldEnabled(bool value)
+{
+    PollyDeclareThisImpl;
+    impl->setDistanceFieldEnabled(value);
+}
+
+bool Font::isDistanceFieldEnabled() const
+{
+    PollyDeclareThisImpl;
+    return impl->isDistanceFieldEnabled();
+}
+
+FontAtlasStats Font::atlasStats() const
+{
+    PollyDeclareThisImpl;
+    return impl->atlasStats();
+}
+
+FontCacheOptions Font::cacheOptions() const
+{
+    PollyDeclareThisImpl;
+    return impl->cacheOptions();
+}
+
+void Font::setCacheOptions(const FontCacheOptions& options)
+{
+    PollyDeclareThisImpl;
+    impl->setCacheOptions(options);
+}
+
 StringView Font::assetName() const
 {
     PollyDeclareThisImpl;
@@ -8,7 +8,11 @@
 #include "Polly/Game/GameImpl.hpp"
 #include "Polly/Graphics/PainterImpl.hpp"
 #include "Polly/Logging.hpp"
+#include "Polly/Math.hpp"
 #include "Polly/Narrow.hpp"
+#include "Polly/Pair.hpp"
+#include "Polly/Profiler.hpp"
+#include "Polly/Util.hpp"
 
 #if polly_have_gfx_d3d11
 #include "Polly/Graphics/D3D11/D3D11Image.hpp"
@@ -23,19 +27,19 @@
 #include "Polly/Graphics/OpenGL/OpenGLImage.hpp"
 #endif
 
-#if polly_have_gfx_vulkan
-#include "Polly/Graphics/Vulkan/VulkanPainter.hpp"
-#endif
-
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "imstb_truetype.h"
 
 #include "Noto.ttf.hpp"
+#include <atomic>
 
 namespace Polly
 {
 static auto sBuiltInFontRegular = UniquePtr<Font::Impl>();
 
+// Fonts may be loaded on worker threads.
+static auto sLastFontId = std::atomic<u64>(0);
+
 Font::Impl::Impl(Span<u8> data, bool createCopyOfData, [[maybe_unused]] bool isBuiltin)
 #ifndef NDEBUG
     : _isBuiltin(isBuiltin)
@@ -108,29 +112,43 @@ const Font::Impl::FontPage& Font::Impl::page(u32 index) const
 
 const Font::Impl::RasterizedGlyph& Font::Impl::rasterizedGlyph(char32_t codepoint, float fontSize)
 {
-    if (!_initializedSizes.contains(fontSize))
+    const auto frame = currentFrame();
+
+    if (not _isDistanceFieldEnabled)
     {
-        // This is the first time we're encountering this font size.
+        fontSize = quantizedFontSize(fontSize);
 
-        for (char32_t c = 32; c < 255; ++c)
+        if (!_initializedSizes.contains(fontSize))
         {
-            std::ignore = rasterizeGlyph(
-                RasterizedGlyphKey{
+            // This is the first time we're encountering this font size.
+
+            for (char32_t c = 32; c < 255; ++c)
+            {
+                const auto key = GlyphCacheKey{
                     .codepoint = c,
                     .fontSize  = fontSize,
-                });
-        }
+                };
+
+                if (not _glyphCache.find(key))
+                {
+                    std::ignore = rasterizeGlyph(key);
+                }
+            }
 
-        _initializedSizes.add(fontSize);
+            _initializedSizes.add(fontSize);
+        }
     }
 
-    const auto key = RasterizedGlyphKey{
+    const auto key = GlyphCacheKey{
         .codepoint = codepoint,
-        .fontSize  = fontSize,
+        .fontSize  = _isDistanceFieldEnabled ? 0.0f : fontSize,
     };
 
-    if (const auto glyph = _rasterizedGlyphs.find(key))
+    if (auto glyph = _glyphCache.find(key))
     {
+        glyph->lastUsedFrame                   = frame;
+        _pages[glyph->pageIndex].lastUsedFrame = frame;
+
         return *glyph;
     }
 
@@ -147,8 +165,119 @@ float Font::Impl::lineHeight(float fontSize) const
     return float(ascent - descent + lineGap);
 }
 
+void Font::Impl::setDistanceFieldEnabled(bool value)
+{
+#if polly_have_gfx_software
+    // The software painter can't run the distance field shader, so glyphs stay bitmaps there.
+    if (value)
+    {
+        logWarning(
+            "Font '{}': The Software backend doesn't support distance fields; drawing bitmap glyphs instead",
+            assetName());
+
+        return;
+    }
+#endif
+
+    if (_isDistanceFieldEnabled != value)
+    {
+        _isDistanceFieldEnabled = value;
+        ++_shapingGeneration;
+    }
+}
+
+bool Font::Impl::isDistanceFieldEnabled() const
+{
+    return _isDistanceFieldEnabled;
+}
+
+Maybe<float> Font::Impl::distanceFieldScale(float fontSize) const
+{
+    if (not _isDistanceFieldEnabled)
+    {
+        return none;
+    }
+
+    return fontSize / distanceFieldReferenceSize;
+}
+
+FontAtlasStats Font::Impl::atlasStats() const
+{
+    auto stats = FontAtlasStats{
+        .pageCount               = _pages.size(),
+        .byteCount               = atlasByteCount(),
+        .glyphCount              = _glyphCache.size(),
+        .distanceFieldGlyphCount = _distanceFieldGlyphCount,
+        .usedPixelCount          = _usedAtlasPixelCount,
+        .evictedGlyphCount       = _evictedGlyphCount,
+        .recycledPageCount       = _recycledPageCount,
+    };
+
+    for (const auto& page : _pages)
+    {
+        stats.totalPixelCount += u64(page.width) * u64(page.height);
+    }
+
+    if (stats.totalPixelCount > 0)
+    {
+        stats.occupancy = double(stats.usedPixelCount) / double(stats.totalPixelCount);
+    }
+
+    return stats;
+}
+
+const FontCacheOptions& Font::Impl::cacheOptions() const
+{
+    return _cacheOptions;
+}
+
+void Font::Impl::setCacheOptions(const FontCacheOptions& options)
+{
+    _cacheOptions             = options;
+    _cacheOptions.sizeQuantum = max(_cacheOptions.sizeQuantum, 0.0f);
+    _hasExceededBudget        = false;
+
+    // The size quantum decides which glyphs text refers to.
+    ++_shapingGeneration;
+}
+
+u64 Font::Impl::id() const
+{
+    return _id;
+}
+
+u64 Font::Impl::shapingGeneration() const
+{
+    return _shapingGeneration;
+}
+
+void Font::Impl::markGlyphsAsUsed(Span<PreshapedGlyph> glyphs, float fontSize)
+{
+    const auto frame   = currentFrame();
+    const auto keySize = _isDistanceFieldEnabled ? 0.0f : quantizedFontSize(fontSize);
+
+    for (const auto& glyph : glyphs)
+    {
+        // Glyphs are refreshed individually, because recyclePage() keeps or evicts them
+        // depending on when they were last used.
+        auto cachedGlyph = _glyphCache.find(
+            GlyphCacheKey{
+                .codepoint = glyph.codepoint,
+                .fontSize  = keySize,
+            });
+
+        if (cachedGlyph)
+        {
+            cachedGlyph->lastUsedFrame                   = frame;
+            _pages[cachedGlyph->pageIndex].lastUsedFrame = frame;
+        }
+    }
+}
+
 void Font::Impl::initialize()
 {
+    _id = ++sLastFontId;
+
     const auto* data = _foreignFontData ? _foreignFontData : _ownedFontData.data();
 
     if (stbtt_InitFont(&_fontInfo, data, 0) == 0)
@@ -157,10 +286,90 @@ void Font::Impl::initialize()
     }
 
     stbtt_GetFontVMetrics(&_fontInfo, &_ascent, &_descent, &_lineGap);
+
+    for (u32 i = 0; i < _latinGlyphMetrics.size(); ++i)
+    {
+        _latinGlyphMetrics[i] = computeGlyphMetrics(char32_t(i));
+    }
+
+    _hasKerning = _fontInfo.kern != 0 or _fontInfo.gpos != 0;
+
+    if (_hasKerning)
+    {
+        buildAsciiKerningTable();
+    }
 }
 
-const Font::Impl::RasterizedGlyph& Font::Impl::rasterizeGlyph(const RasterizedGlyphKey& key)
+Font::Impl::GlyphMetrics Font::Impl::computeGlyphMetrics(char32_t codepoint) const
 {
+    auto metrics       = GlyphMetrics();
+    metrics.glyphIndex = stbtt_FindGlyphIndex(&_fontInfo, int(codepoint));
+
+    stbtt_GetGlyphHMetrics(&_fontInfo, metrics.glyphIndex, &metrics.advance, nullptr);
+
+    metrics.hasBox = stbtt_GetGlyphBox(
+                         &_fontInfo,
+                         metrics.glyphIndex,
+                         &metrics.boxLeft,
+                         &metrics.boxBottom,
+                         &metrics.boxRight,
+                         &metrics.boxTop)
+                     != 0;
+
+    return metrics;
+}
+
+Font::Impl::GlyphMetrics Font::Impl::nonLatinGlyphMetrics(char32_t codepoint) const
+{
+    const auto _ = std::lock_guard(_nonLatinGlyphMetricsMutex);
+
+    if (const auto metrics = _nonLatinGlyphMetrics.find(codepoint))
+    {
+        return *metrics;
+    }
+
+    const auto metrics = computeGlyphMetrics(codepoint);
+    _nonLatinGlyphMetrics.add(codepoint, metrics);
+
+    return metrics;
+}
+
+void Font::Impl::buildAsciiKerningTable()
+{
+    PollyProfileScope("Font::buildAsciiKerningTable");
+
+    _asciiKerning.resize(asciiKerningCharCount * asciiKerningCharCount);
+
+    for (u32 first = 0; first < asciiKerningCharCount; ++first)
+    {
+        const auto firstGlyphIndex = _latinGlyphMetrics[firstAsciiKerningChar + first].glyphIndex;
+
+        for (u32 second = 0; second < asciiKerningCharCount; ++second)
+        {
+            const auto secondGlyphIndex = _latinGlyphMetrics[firstAsciiKerningChar + second].glyphIndex;
+
+            _asciiKerning[(first * asciiKerningCharCount) + second] =
+                i16(stbtt_GetGlyphKernAdvance(&_fontInfo, firstGlyphIndex, secondGlyphIndex));
+        }
+    }
+}
+
+float Font::Impl::quantizedFontSize(float fontSize) const
+{
+    const auto quantum = _cacheOptions.sizeQuantum;
+
+    if (quantum <= 0.0f)
+    {
+        return fontSize;
+    }
+
+    return max(round(fontSize / quantum), 1.0f) * quantum;
+}
+
+const Font::Impl::RasterizedGlyph& Font::Impl::rasterizeGlyph(const GlyphCacheKey& key)
+{
+    PollyProfileScope("Font::rasterizeGlyph");
+
     if (_pages.isEmpty())
     {
         appendNewPage();
@@ -168,6 +377,50 @@ const Font::Impl::RasterizedGlyph& Font::Impl::rasterizeGlyph(const RasterizedGl
 
     assume(_currentPageIndex);
 
+    auto glyph = rasterizeIntoPage(key, *_currentPageIndex);
+
+    if (not glyph and tryRecycleLeastRecentlyUsedPage())
+    {
+        glyph = rasterizeIntoPage(key, *_currentPageIndex);
+    }
+
+    if (not glyph)
+    {
+        appendNewPage();
+        glyph = rasterizeIntoPage(key, *_currentPageIndex);
+    }
+
+    if (not glyph)
+    {
+        // Ok, it failed for real. The font size might just be too large (for now).
+        throw Error(formatString(
+            "Failed to rasterize a font glyph. The font size ({}) might be too large.",
+            key.fontSize));
+    }
+
+    const auto frame = currentFrame();
+
+    glyph->lastUsedFrame                   = frame;
+    _pages[glyph->pageIndex].lastUsedFrame = frame;
+
+    if (key.fontSize == 0.0f)
+    {
+        ++_distanceFieldGlyphCount;
+    }
+
+    return _glyphCache.add(key, *glyph);
+}
+
+Maybe<Font::Impl::RasterizedGlyph> Font::Impl::rasterizeIntoPage(const GlyphCacheKey& key, u32 pageIndex)
+{
+    return key.fontSize == 0.0f ? rasterizeDistanceFieldIntoPage(key.codepoint, pageIndex)
+                                : rasterizeBitmapIntoPage(key, pageIndex);
+}
+
+Maybe<Font::Impl::RasterizedGlyph> Font::Impl::rasterizeBitmapIntoPage(
+    const GlyphCacheKey& key,
+    u32                  pageIndex)
+{
     const auto fontSize = key.fontSize;
     const auto scale    = stbtt_ScaleForPixelHeight(&_fontInfo, fontSize);
 
@@ -178,42 +431,18 @@ const Font::Impl::RasterizedGlyph& Font::Impl::rasterizeGlyph(const RasterizedGl
 
     stbtt_GetCodepointBitmapBox(&_fontInfo, int(key.codepoint), scale, scale, &cx1, &cy1, &cx2, &cy2);
 
-    constexpr auto padding = 5;
-
     const auto bitmapWidth  = cx2 - cx1;
     const auto bitmapHeight = cy2 - cy1;
+    const auto insertedRect = insertIntoPage(bitmapWidth, bitmapHeight, pageIndex);
 
-    auto maybeInsertedRect =
-        _pages[*_currentPageIndex].pack.insert(bitmapWidth + padding, bitmapHeight + padding);
-
-    if (!maybeInsertedRect)
+    if (not insertedRect)
     {
-        appendNewPage();
-        maybeInsertedRect =
-            _pages[*_currentPageIndex].pack.insert(bitmapWidth + padding, bitmapHeight + padding);
-    }
-
-    if (!maybeInsertedRect)
-    {
-        // Ok, it failed for real. The font size might just be too large (for now).
-        throw Error(formatString(
-            "Failed to rasterize a font glyph. The font size ({}) might be too large.",
-            fontSize));
+        return none;
     }
 
-    auto insertedRect = *maybeInsertedRect;
-    insertedRect.width -= padding;
-    insertedRect.height -= padding;
-
     if (bitmapWidth > 0 && bitmapHeight > 0)
     {
-        auto&      page       = _pages[*_currentPageIndex];
-        const auto xInPage    = insertedRect.x;
-        const auto yInPage    = insertedRect.y;
-        const auto pixelCount = bitmapWidth * bitmapHeight;
-
-        _glyphBufferU8.resizeIfGreater(pixelCount);
-        _glyphBufferRGBA.resizeIfGreater(pixelCount);
+        _glyphBufferU8.resizeIfGreater(bitmapWidth * bitmapHeight);
 
         stbtt_MakeCodepointBitmap(
             &_fontInfo,
@@ -225,170 +454,322 @@ const Font::Impl::RasterizedGlyph& Font::Impl::rasterizeGlyph(const RasterizedGl
             scale,
             narrow<int>(key.codepoint));
 
-        _glyphBufferRGBA.clear();
+        uploadCoverage(_pages[pageIndex].atlas, *insertedRect, _glyphBufferU8.data());
+    }
+
+    return RasterizedGlyph{
+        .uvRect             = insertedRect->toRectf(),
+        .pageIndex          = pageIndex,
+        .distanceFieldInset = Vec2(),
+        .lastUsedFrame      = 0,
+    };
+}
+
+Maybe<Font::Impl::RasterizedGlyph> Font::Impl::rasterizeDistanceFieldIntoPage(
+    char32_t codepoint,
+    u32      pageIndex)
+{
+    PollyProfileScope("Font::rasterizeDistanceField");
+
+    const auto scale = stbtt_ScaleForPixelHeight(&_fontInfo, distanceFieldReferenceSize);
+
+    // Every pixel of distance moves the value by onEdgeValue / spread,
+    // so that the spread covers the whole value range.
+    constexpr auto pixelDistance = float(distanceFieldOnEdgeValue) / float(distanceFieldSpread);
+
+    auto width   = 0;
+    auto height  = 0;
+    auto offsetX = 0;
+    auto offsetY = 0;
+
+    auto* distanceField = stbtt_GetCodepointSDF(
+        &_fontInfo,
+        scale,
+        narrow<int>(codepoint),
+        distanceFieldSpread,
+        distanceFieldOnEdgeValue,
+        pixelDistance,
+        &width,
+        &height,
+        &offsetX,
+        &offsetY);
+
+    defer
+    {
+        stbtt_FreeSDF(distanceField, nullptr);
+    };
+
+    // Glyphs without an outline, such as spaces, don't have a distance field.
+    if (not distanceField)
+    {
+        width  = 0;
+        height = 0;
+    }
+
+    const auto insertedRect = insertIntoPage(width, height, pageIndex);
+
+    if (not insertedRect)
+    {
+        return none;
+    }
+
+    if (distanceField)
+    {
+        uploadCoverage(_pages[pageIndex].atlas, *insertedRect, distanceField);
+    }
+
+    // The inset is relative to the unrounded outline, so that glyphs line up exactly
+    // no matter how much they're scaled.
+    auto boxTop = 0;
+    stbtt_GetCodepointBox(&_fontInfo, narrow<int>(codepoint), nullptr, nullptr, nullptr, &boxTop);
+
+    return RasterizedGlyph{
+        .uvRect             = insertedRect->toRectf(),
+        .pageIndex          = pageIndex,
+        .distanceFieldInset = Vec2(float(-offsetX), -float(boxTop) * scale - float(offsetY)),
+        .lastUsedFrame      = 0,
+    };
+}
 
-        // Update the RGBA buffer.
+Maybe<BinPack::Rect> Font::Impl::insertIntoPage(int width, int height, u32 pageIndex)
+{
+    constexpr auto padding = 5;
+
+    auto& page         = _pages[pageIndex];
+    auto  insertedRect = page.pack.insert(width + padding, height + padding);
+
+    if (not insertedRect)
+    {
+        return none;
+    }
+
+    const auto pixelCount = u64(width + padding) * u64(height + padding);
+
+    page.usedPixelCount += pixelCount;
+    _usedAtlasPixelCount += pixelCount;
+
+    insertedRect->width -= padding;
+    insertedRect->height -= padding;
+
+    return insertedRect;
+}
+
+bool Font::Impl::tryRecycleLeastRecentlyUsedPage()
+{
+    const auto maxByteCount = _cacheOptions.maxAtlasByteCount;
+
+    // All pages have the same size.
+    const auto byteCount     = atlasByteCount();
+    const auto pageByteCount = byteCount / _pages.size();
+
+    if (maxByteCount == 0 or byteCount + pageByteCount <= maxByteCount)
+    {
+        // Another page still fits into the budget.
+        return false;
+    }
+
+    const auto frame = currentFrame();
+
+    // Glyphs of pages that were used during this frame may still be waiting to be drawn.
+    auto candidateIndex = Maybe<u32>();
+
+    for (u32 i = 0; i < _pages.size(); ++i)
+    {
+        const auto& page = _pages[i];
+
+        if (page.lastUsedFrame >= frame)
         {
-            const auto* src = _glyphBufferU8.data();
+            continue;
+        }
 
-            for (auto i = 0; i < pixelCount; ++i)
-            {
-                _glyphBufferRGBA.add(R8G8B8A8{255, 255, 255, *src});
-                ++src;
-            }
+        if (not candidateIndex or page.lastUsedFrame < _pages[*candidateIndex].lastUsedFrame)
+        {
+            candidateIndex = i;
         }
+    }
 
-#if defined(polly_have_gfx_metal) || defined(polly_have_gfx_opengl) || defined(polly_have_gfx_d3d11)
+    if (not candidateIndex)
+    {
+        return false;
+    }
 
-        page.atlas.updateData(xInPage, yInPage, bitmapWidth, bitmapHeight, _glyphBufferRGBA.data(), true);
+    recyclePage(*candidateIndex);
 
-#elif polly_have_gfx_vulkan
+    return true;
+}
 
-        auto& deviceImpl   = *Painter::Impl::instance();
-        auto& vulkanDevice = static_cast<VulkanPainter&>(deviceImpl);
-        auto  vmaAllocator = vulkanDevice.vmaAllocator();
-        auto& vulkanImage  = static_cast<VulkanImage&>(*page.atlas.impl());
-        auto  vkImage      = vulkanImage.vkImage();
+void Font::Impl::recyclePage(u32 pageIndex)
+{
+    PollyProfileScope("Font::recyclePage");
 
-        const auto dataSizeInBytes =
-            imageSlicePitch(vulkanImage.width(), vulkanImage.height(), vulkanImage.format());
+    const auto frame       = currentFrame();
+    const auto evictionAge = u64(_cacheOptions.evictionAge);
 
-        auto vkTransferBuffer           = VkBuffer();
-        auto vkTransferBufferAllocation = VmaAllocation();
+    // Glyphs that were used recently are kept and placed into the repacked page again.
+    auto keptGlyphs = List<Pair<GlyphCacheKey, u64>, 32>();
 
-        defer
+    const auto evictedCount = _glyphCache.removeWhere(
+        [&](const GlyphCacheKey& key, const RasterizedGlyph& glyph)
         {
-            vmaDestroyBuffer(vmaAllocator, vkTransferBuffer, vkTransferBufferAllocation);
-        };
-
-        auto bufferInfo        = VkBufferCreateInfo();
-        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferInfo.size        = VkDeviceSize(dataSizeInBytes);
-        bufferInfo.usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-        auto allocInfo  = VmaAllocationCreateInfo();
-        allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-        checkVkResult(
-            vmaCreateBuffer(
-                vmaAllocator,
-                &bufferInfo,
-                &allocInfo,
-                &vkTransferBuffer,
-                &vkTransferBufferAllocation,
-                nullptr),
-            "Failed to create an internal image buffer.");
-
-#ifndef NDEBUG
-        vmaSetAllocationName(vmaAllocator, vkTransferBufferAllocation, "Font transfer buffer");
-#endif
+            if (glyph.pageIndex != pageIndex)
+            {
+                return false;
+            }
 
-        void* mappedData = nullptr;
-        vmaMapMemory(vmaAllocator, vkTransferBufferAllocation, &mappedData);
-        std::memcpy(mappedData, page.atlasData.data(), dataSizeInBytes);
-        vmaUnmapMemory(vmaAllocator, vkTransferBufferAllocation);
+            if (glyph.lastUsedFrame + evictionAge >= frame)
+            {
+                keptGlyphs.add(Pair(key, glyph.lastUsedFrame));
+            }
+            else
+            {
+                // Sizes that lost glyphs have to be pre-rasterized again when they're used.
+                _initializedSizes.remove(key.fontSize);
+            }
 
-        vulkanDevice.submitImmediateGraphicsCommands(
-            [&](VkCommandBuffer cmd)
+            if (key.fontSize == 0.0f)
             {
-                auto range       = VkImageSubresourceRange();
-                range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                range.levelCount = 1;
-                range.layerCount = 1;
-
-                auto imageBarrierToTransfer             = VkImageMemoryBarrier();
-                imageBarrierToTransfer.sType            = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-                imageBarrierToTransfer.dstAccessMask    = VK_ACCESS_TRANSFER_WRITE_BIT;
-                imageBarrierToTransfer.oldLayout        = VK_IMAGE_LAYOUT_UNDEFINED;
-                imageBarrierToTransfer.newLayout        = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                imageBarrierToTransfer.image            = vkImage;
-                imageBarrierToTransfer.subresourceRange = range;
-
-                vkCmdPipelineBarrier(
-                    cmd,
-                    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT,
-                    0,
-                    0,
-                    nullptr,
-                    0,
-                    nullptr,
-                    1,
-                    &imageBarrierToTransfer);
-
-                auto copyRegion                        = VkBufferImageCopy();
-                copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                copyRegion.imageSubresource.layerCount = 1;
-                copyRegion.imageExtent.width           = vulkanImage.width();
-                copyRegion.imageExtent.height          = vulkanImage.height();
-                copyRegion.imageExtent.depth           = 1;
-
-                vkCmdCopyBufferToImage(
-                    cmd,
-                    vkTransferBuffer,
-                    vkImage,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    1,
-                    &copyRegion);
-
-                auto imageBarrierToReadable = imageBarrierToTransfer;
-
-                imageBarrierToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                imageBarrierToReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-                imageBarrierToReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-                imageBarrierToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-                vkCmdPipelineBarrier(
-                    cmd,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT,
-                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                    0,
-                    0,
-                    nullptr,
-                    0,
-                    nullptr,
-                    1,
-                    &imageBarrierToReadable);
-            });
+                --_distanceFieldGlyphCount;
+            }
 
-#else
-#error "Unsupported"
-#endif
+            return true;
+        });
+
+    auto& page = _pages[pageIndex];
+
+    _usedAtlasPixelCount -= page.usedPixelCount;
+
+    // Text objects may still refer to the previous image, so don't overwrite it.
+    page.pack           = BinPack(page.width, page.height);
+    page.atlas          = createPageImage(pageIndex);
+    page.usedPixelCount = 0;
+
+    auto keptCount = 0u;
+
+    for (const auto& [key, lastUsedFrame] : keptGlyphs)
+    {
+        auto glyph = rasterizeIntoPage(key, pageIndex);
+
+        if (not glyph)
+        {
+            _initializedSizes.remove(key.fontSize);
+            continue;
+        }
+
+        glyph->lastUsedFrame = lastUsedFrame;
+
+        if (key.fontSize == 0.0f)
+        {
+            ++_distanceFieldGlyphCount;
+        }
+
+        _glyphCache.add(key, *glyph);
+        ++keptCount;
     }
 
-    auto insertedPtr = _rasterizedGlyphs.add(
-        key,
-        RasterizedGlyph{
-            .uvRect    = insertedRect.toRectf(),
-            .pageIndex = *_currentPageIndex,
-        });
+    _evictedGlyphCount += evictedCount - keptCount;
+    ++_recycledPageCount;
+    ++_shapingGeneration;
 
-    assume(insertedPtr);
+    _currentPageIndex = pageIndex;
 
-    return insertedPtr->second;
+    logVerbose(
+        "Font '{}': Repacked atlas page {}, evicted {} glyph(s)",
+        assetName(),
+        pageIndex,
+        evictedCount - keptCount);
 }
 
 void Font::Impl::appendNewPage()
 {
     const auto caps = Painter::Impl::instance()->capabilities();
 
-    const auto width  = min(512u, caps.maxImageExtent);
-    const auto height = width;
+    const auto width     = min(512u, caps.maxImageExtent);
+    const auto height    = width;
+    const auto pageIndex = _pages.size();
 
-    auto page = FontPage{
-        .width  = width,
-        .height = height,
-        .pack   = BinPack(width, height),
-        .atlas  = Image(ImageUsage::Updatable, width, height, ImageFormat::R8G8B8A8UNorm, nullptr),
-    };
+    _pages.add(FontPage{
+        .width          = width,
+        .height         = height,
+        .pack           = BinPack(width, height),
+        .atlas          = createPageImage(pageIndex),
+        .usedPixelCount = 0,
+        .lastUsedFrame  = 0,
+    });
 
-    const auto imageLabel = formatString("{}_Page{}", assetName(), _pages.size());
-    page.atlas.setDebuggingLabel(imageLabel);
+    _currentPageIndex = pageIndex;
 
-    _pages.add(std::move(page));
+    const auto maxByteCount = _cacheOptions.maxAtlasByteCount;
 
-    _currentPageIndex = _pages.size() - 1;
+    if (maxByteCount > 0 and atlasByteCount() > maxByteCount and not _hasExceededBudget)
+    {
+        logWarning(
+            "Font '{}': The glyph atlas exceeds its budget of {}, because all of its glyphs are in use",
+            assetName(),
+            bytesDisplayString(maxByteCount));
+
+        _hasExceededBudget = true;
+    }
+}
+
+Image Font::Impl::createPageImage(u32 pageIndex) const
+{
+    auto&      painterImpl = *Painter::Impl::instance();
+    const auto caps        = painterImpl.capabilities();
+    const auto width       = min(512u, caps.maxImageExtent);
+    const auto height      = width;
+
+    // Prefer single-channel pages, which the sprite shaders see as white RGBA images.
+    // Backends that can't swizzle image channels get the RGBA equivalent.
+    auto image = Image();
+
+    if (auto coverageImage = painterImpl.createAlphaCoverageImage(width, height))
+    {
+        image = Image(coverageImage.release());
+    }
+    else
+    {
+        image = Image(ImageUsage::Updatable, width, height, ImageFormat::R8G8B8A8UNorm, nullptr);
+    }
+
+    image.setDebuggingLabel(formatString("{}_Page{}", assetName(), pageIndex));
+
+    return image;
+}
+
+void Font::Impl::uploadCoverage(Image& atlas, const BinPack::Rect& rect, const u8* coverage)
+{
+    if (atlas.format() == ImageFormat::R8Unorm)
+    {
+        atlas.updateData(rect.x, rect.y, rect.width, rect.height, coverage, true);
+        return;
+    }
+
+    const auto pixelCount = rect.width * rect.height;
+
+    _glyphBufferRGBA.resize(pixelCount);
+
+    for (auto i = 0; i < pixelCount; ++i)
+    {
+        _glyphBufferRGBA[i] = R8G8B8A8{255, 255, 255, coverage[i]};
+    }
+
+    atlas.updateData(rect.x, rect.y, rect.width, rect.height, _glyphBufferRGBA.data(), true);
+}
+
+u64 Font::Impl::atlasByteCount() const
+{
+    auto result = u64(0);
+
+    for (const auto& page : _pages)
+    {
+        result += imageSlicePitch(page.width, page.height, page.atlas.format());
+    }
+
+    return result;
+}
+
+u64 Font::Impl::currentFrame()
+{
+    return Painter::Impl::instance()->frameNumber();
 }
 } // namespace Polly
@@ -5,16 +5,22 @@
 #pragma once
 
 #include "imstb_truetype.h"
+#include "Polly/Array.hpp"
 #include "Polly/BitColors.hpp"
 #include "Polly/ContentManagement/Asset.hpp"
 #include "Polly/Core/BinPack.hpp"
 #include "Polly/Core/Object.hpp"
 #include "Polly/Core/utf8.hpp"
 #include "Polly/Font.hpp"
+#include "Polly/Graphics/GlyphCache.hpp"
 #include "Polly/Image.hpp"
+#include "Polly/Linalg.hpp"
 #include "Polly/List.hpp"
 #include "Polly/SortedMap.hpp"
 #include "Polly/SortedSet.hpp"
+#include "Polly/Span.hpp"
+#include "Polly/Text.hpp"
+#include <mutex>
 
 namespace Polly
 {
@@ -22,11 +28,17 @@ class Font::Impl final : public Object,
                          public Asset
 {
   public:
-    struct RasterizedGlyph
-    {
-        Rectangle uvRect;
-        u32       pageIndex = 0;
-    };
+    // Distance field glyphs are rasterized once at this size and scaled from there.
+    static constexpr auto distanceFieldReferenceSize = 48.0f;
+
+    // The distance, in pixels at the reference size, that a distance field covers
+    // on each side of a glyph's outline.
+    static constexpr auto distanceFieldSpread = 8;
+
+    // The distance field value of a glyph's outline. Values increase towards the inside.
+    static constexpr auto distanceFieldOnEdgeValue = u8(128);
+
+    using RasterizedGlyph = CachedGlyph;
 
     struct FontPage
     {
@@ -34,6 +46,23 @@ class Font::Impl final : public Object,
         u32     height;
         BinPack pack;
         Image   atlas;
+        u64     usedPixelCount = 0;
+        u64     lastUsedFrame  = 0;
+    };
+
+    // The size-independent metrics of a glyph, in font units.
+    // They're scaled to a specific font size when text is laid out.
+    struct GlyphMetrics
+    {
+        int glyphIndex = 0;
+        int advance    = 0;
+
+        // The glyph's outline box. Glyphs without an outline, such as spaces, don't have one.
+        bool hasBox    = false;
+        int  boxLeft   = 0;
+        int  boxBottom = 0;
+        int  boxRight  = 0;
+        int  boxTop    = 0;
     };
 
     struct GlyphIterationExtras
@@ -79,6 +108,8 @@ class Font::Impl final : public Object,
             codepoint = *it;
         }
 
+        auto metrics = glyphMetrics(codepoint);
+
         const auto lineIncrement = ascent - descent + lineGap;
 
         auto extras = GlyphIterationExtras();
@@ -104,6 +135,7 @@ class Font::Impl final : public Object,
                 if (it != itEnd)
                 {
                     codepoint = *it;
+                    metrics   = glyphMetrics(codepoint);
                 }
 
                 if constexpr (ComputeExtras)
@@ -119,22 +151,19 @@ class Font::Impl final : public Object,
             auto boxRight  = 0;
             auto boxBottom = 0;
 
-            stbtt_GetCodepointBitmapBox(
-                &_fontInfo,
-                int(codepoint),
-                scale,
-                scale,
-                &boxLeft,
-                &boxTop,
-                &boxRight,
-                &boxBottom);
+            // The same rounding as stbtt_GetCodepointBitmapBox(), whose y-axis points down.
+            if (metrics.hasBox)
+            {
+                boxLeft   = int(floor(float(metrics.boxLeft) * scale));
+                boxTop    = int(floor(float(-metrics.boxTop) * scale));
+                boxRight  = int(ceil(float(metrics.boxRight) * scale));
+                boxBottom = int(ceil(float(-metrics.boxBottom) * scale));
+            }
 
             const auto x = float(penX);
             const auto y = float(penY + ascent + boxTop);
 
-            auto advanceX = 0;
-
-            stbtt_GetCodepointHMetrics(&_fontInfo, int(codepoint), &advanceX, nullptr);
+            const auto advanceX = metrics.advance;
 
             const auto width  = float(boxRight - boxLeft);
             const auto height = float(boxBottom - boxTop);
@@ -160,6 +189,7 @@ class Font::Impl final : public Object,
             ++it;
             const auto isLast        = it == itEnd;
             const auto nextCodepoint = isLast ? 0 : *it;
+            const auto nextMetrics   = isLast ? GlyphMetrics() : glyphMetrics(nextCodepoint);
 
             if constexpr (ComputeExtras)
             {
@@ -179,14 +209,46 @@ class Font::Impl final : public Object,
 
             if (not isLast)
             {
-                const auto kern =
-                    stbtt_GetCodepointKernAdvance(&_fontInfo, int(codepoint), int(nextCodepoint));
+                const auto kern = kernAdvance(codepoint, metrics, nextCodepoint, nextMetrics);
 
                 penX += float(kern) * scale;
             }
 
             codepoint = nextCodepoint;
+            metrics   = nextMetrics;
+        }
+    }
+
+    GlyphMetrics glyphMetrics(char32_t codepoint) const
+    {
+        if (codepoint < _latinGlyphMetrics.size())
+        {
+            return _latinGlyphMetrics[codepoint];
+        }
+
+        return nonLatinGlyphMetrics(codepoint);
+    }
+
+    // Equivalent to stbtt_GetCodepointKernAdvance(), in font units.
+    int kernAdvance(
+        char32_t            first,
+        const GlyphMetrics& firstMetrics,
+        char32_t            second,
+        const GlyphMetrics& secondMetrics) const
+    {
+        if (not _hasKerning)
+        {
+            return 0;
         }
+
+        if (isInAsciiKerningTable(first) and isInAsciiKerningTable(second))
+        {
+            return _asciiKerning[((first - firstAsciiKerningChar) * asciiKerningCharCount)
+                                 + (second - firstAsciiKerningChar)];
+        }
+
+        // This still saves the lookups of the glyph indices.
+        return stbtt_GetGlyphKernAdvance(&_fontInfo, firstMetrics.glyphIndex, secondMetrics.glyphIndex);
     }
 
     const FontPage& page(u32 index) const;
@@ -195,23 +257,82 @@ class Font::Impl final : public Object,
 
     float lineHeight(float fontSize) const;
 
+    void setDistanceFieldEnabled(bool value);
+
+    bool isDistanceFieldEnabled() const;
+
+    // The factor by which distance field glyphs are scaled to be drawn at a specific size,
+    // or none if the font isn't in distance field mode.
+    Maybe<float> distanceFieldScale(float fontSize) const;
+
+    FontAtlasStats atlasStats() const;
+
+    const FontCacheOptions& cacheOptions() const;
+
+    void setCacheOptions(const FontCacheOptions& options);
+
+    // Identifies the font for as long as the process runs. Unlike the font's address,
+    // it isn't reused by fonts that are created later.
+    u64 id() const;
+
+    // Changes whenever text that was shaped using this font may refer to outdated glyphs,
+    // for example after an atlas page was repacked.
+    u64 shapingGeneration() const;
+
+    // Marks previously shaped glyphs and their atlas pages as used during the current frame,
+    // just like drawing them after shaping them again would.
+    void markGlyphsAsUsed(Span<PreshapedGlyph> glyphs, float fontSize);
+
   private:
-    struct RasterizedGlyphKey
+    // Kerning between printable ASCII characters is looked up in a flat table.
+    static constexpr auto firstAsciiKerningChar = char32_t(32);
+    static constexpr auto asciiKerningCharCount = 95u;
+
+    static bool isInAsciiKerningTable(char32_t codepoint)
     {
-        char32_t codepoint;
-        float    fontSize;
+        return codepoint - firstAsciiKerningChar < asciiKerningCharCount;
+    }
 
-        auto operator<=>(const RasterizedGlyphKey&) const = default;
-    };
+    void initialize();
 
-    using RasterizedGlyphsMap = SortedMap<RasterizedGlyphKey, RasterizedGlyph>;
+    GlyphMetrics computeGlyphMetrics(char32_t codepoint) const;
 
-    void initialize();
+    GlyphMetrics nonLatinGlyphMetrics(char32_t codepoint) const;
+
+    void buildAsciiKerningTable();
 
-    const RasterizedGlyph& rasterizeGlyph(const RasterizedGlyphKey& key);
+    // The size at which glyphs of a specific font size are rasterized.
+    float quantizedFontSize(float fontSize) const;
+
+    const RasterizedGlyph& rasterizeGlyph(const GlyphCacheKey& key);
+
+    // Rasterizes a glyph into a specific page. Returns none if the page is out of space.
+    Maybe<RasterizedGlyph> rasterizeIntoPage(const GlyphCacheKey& key, u32 pageIndex);
+
+    Maybe<RasterizedGlyph> rasterizeBitmapIntoPage(const GlyphCacheKey& key, u32 pageIndex);
+
+    Maybe<RasterizedGlyph> rasterizeDistanceFieldIntoPage(char32_t codepoint, u32 pageIndex);
+
+    Maybe<BinPack::Rect> insertIntoPage(int width, int height, u32 pageIndex);
+
+    // Makes room within the atlas budget by repacking the least recently used page.
+    // Returns false if there's no budget or no page that may be repacked.
+    bool tryRecycleLeastRecentlyUsedPage();
+
+    void recyclePage(u32 pageIndex);
 
     void appendNewPage();
 
+    Image createPageImage(u32 pageIndex) const;
+
+    // Writes 8-bit coverage (or distance) values into a page, expanding them to white RGBA
+    // pixels if the page isn't single-channel.
+    void uploadCoverage(Image& atlas, const BinPack::Rect& rect, const u8* coverage);
+
+    u64 atlasByteCount() const;
+
+    static u64 currentFrame();
+
     void updatePageTexture();
 
     const u8*           _foreignFontData = nullptr;
@@ -220,12 +341,34 @@ class Font::Impl final : public Object,
     int                 _ascent   = 0;
     int                 _descent  = 0;
     int                 _lineGap  = 0;
-    RasterizedGlyphsMap _rasterizedGlyphs;
+
+    // Metrics of the Latin-1 range, which most text consists of, and of all other
+    // codepoints that were laid out so far. Since const functions such as measure()
+    // may be called from any thread, the latter are guarded by a mutex.
+    Array<GlyphMetrics, 256>                  _latinGlyphMetrics;
+    mutable SortedMap<char32_t, GlyphMetrics> _nonLatinGlyphMetrics;
+    mutable std::mutex                        _nonLatinGlyphMetricsMutex;
+
+    // Kerning between printable ASCII characters, built when the font is loaded.
+    // Empty if the font has no kerning.
+    bool      _hasKerning = false;
+    List<i16> _asciiKerning;
+
+    u64                 _id                      = 0;
+    GlyphCache          _glyphCache;
     List<FontPage, 2>   _pages;
     Maybe<u32>          _currentPageIndex;
     SortedSet<float>    _initializedSizes;
     List<u8>            _glyphBufferU8;
     List<R8G8B8A8>      _glyphBufferRGBA;
+    bool                _isDistanceFieldEnabled  = false;
+    u32                 _distanceFieldGlyphCount = 0;
+    u64                 _usedAtlasPixelCount     = 0;
+    FontCacheOptions    _cacheOptions;
+    u32                 _evictedGlyphCount       = 0;
+    u32                 _recycledPageCount       = 0;
+    bool                _hasExceededBudget       = false;
+    u64                 _shapingGeneration       = 0;
 
 #ifndef NDEBUG
     bool _isBuiltin = false;
@@ -0,0 +1,88 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/GlyphCache.hpp"
+
+namespace Polly
+{
+// Enough for the glyphs that a font pre-rasterizes for its first size.
+static constexpr auto initialCapacity = 512u;
+
+GlyphCache::GlyphCache()
+{
+    rehash(initialCapacity);
+}
+
+CachedGlyph& GlyphCache::add(const GlyphCacheKey& key, const CachedGlyph& glyph)
+{
+    // Keep the load factor below 3/4, so that probe sequences stay short.
+    if ((_size + 1) * 4 > _slots.size() * 3)
+    {
+        rehash(_slots.size() * 2);
+    }
+
+    auto index = homeIndex(key);
+
+    while (_slots[index].isOccupied)
+    {
+        assume(_slots[index].key != key);
+        index = (index + 1) & _mask;
+    }
+
+    auto& slot      = _slots[index];
+    slot.key        = key;
+    slot.glyph      = glyph;
+    slot.isOccupied = true;
+
+    ++_size;
+
+    return slot.glyph;
+}
+
+void GlyphCache::removeAt(u32 index)
+{
+    auto hole = index;
+    auto next = (hole + 1) & _mask;
+
+    // Move every following glyph of the probe sequence into the hole, unless that would
+    // put it in front of its home slot.
+    while (_slots[next].isOccupied)
+    {
+        const auto home = homeIndex(_slots[next].key);
+
+        if (((next - home) & _mask) >= ((next - hole) & _mask))
+        {
+            _slots[hole] = _slots[next];
+            hole         = next;
+        }
+
+        next = (next + 1) & _mask;
+    }
+
+    _slots[hole].isOccupied = false;
+
+    --_size;
+}
+
+void GlyphCache::rehash(u32 capacity)
+{
+    assume(std::has_single_bit(capacity));
+
+    auto oldSlots = std::move(_slots);
+
+    _slots = List<Slot>();
+    _slots.resize(capacity);
+    _size  = 0;
+    _mask  = capacity - 1;
+    _shift = 64 - u32(std::countr_zero(capacity));
+
+    for (const auto& slot : oldSlots)
+    {
+        if (slot.isOccupied)
+        {
+            add(slot.key, slot.glyph);
+        }
+    }
+}
+} // namespace Polly
@@ -0,0 +1,124 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Linalg.hpp"
+#include "Polly/List.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/Rectangle.hpp"
+#include <bit>
+#include <utility>
+
+namespace Polly
+{
+struct GlyphCacheKey
+{
+    char32_t codepoint = 0;
+
+    // Zero for distance field glyphs, since they're independent of the size.
+    float fontSize = 0.0f;
+
+    bool operator==(const GlyphCacheKey&) const = default;
+};
+
+struct CachedGlyph
+{
+    Rectangle uvRect;
+    u32       pageIndex = 0;
+
+    // Distance field glyphs only: the position of the pen origin (x) and the top
+    // of the glyph's outline (y) within the distance field, in pixels at the reference size.
+    Vec2 distanceFieldInset;
+
+    u64 lastUsedFrame = 0;
+};
+
+// Maps the glyphs of a font to their place in the font's atlas.
+//
+// This is an open-addressing hash table with linear probing. Glyphs are removed using
+// backward shifting, so that lookups never have to skip over deleted slots.
+class GlyphCache final
+{
+  public:
+    GlyphCache();
+
+    Maybe<CachedGlyph&> find(const GlyphCacheKey& key)
+    {
+        auto index = homeIndex(key);
+
+        while (_slots[index].isOccupied)
+        {
+            if (_slots[index].key == key)
+            {
+                return _slots[index].glyph;
+            }
+
+            index = (index + 1) & _mask;
+        }
+
+        return none;
+    }
+
+    // The key must not be part of the cache yet.
+    CachedGlyph& add(const GlyphCacheKey& key, const CachedGlyph& glyph);
+
+    // Removes all glyphs for which the predicate returns true.
+    // Returns the number of removed glyphs.
+    template<typename Predicate>
+    u32 removeWhere(Predicate&& predicate)
+    {
+        auto removedCount = 0u;
+        auto index        = 0u;
+
+        while (index < _slots.size())
+        {
+            auto& slot = _slots[index];
+
+            if (slot.isOccupied and predicate(std::as_const(slot.key), std::as_const(slot.glyph)))
+            {
+                // Another glyph might be shifted into this slot, so look at it again.
+                removeAt(index);
+                ++removedCount;
+            }
+            else
+            {
+                ++index;
+            }
+        }
+
+        return removedCount;
+    }
+
+    u32 size() const
+    {
+        return _size;
+    }
+
+  private:
+    struct Slot
+    {
+        GlyphCacheKey key;
+        CachedGlyph   glyph;
+        bool          isOccupied = false;
+    };
+
+    u32 homeIndex(const GlyphCacheKey& key) const
+    {
+        const auto bits = (u64(key.codepoint) << 32) | u64(std::bit_cast<u32>(key.fontSize));
+
+        // Fibonacci hashing, which spreads consecutive codepoints well.
+        return u32((bits * 0x9E3779B97F4A7C15ull) >> _shift);
+    }
+
+    void removeAt(u32 index);
+
+    void rehash(u32 capacity);
+
+    List<Slot> _slots;
+    u32        _size  = 0;
+    u32        _mask  = 0;
+    u32        _shift = 0;
+};
+} // namespace Polly
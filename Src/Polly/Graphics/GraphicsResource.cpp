@@ -6,6 +6,7 @@
 
 #include "Polly/Graphics/ImageImpl.hpp"
 #include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Graphics/StaticSpriteBatchImpl.hpp"
 
 namespace Polly
 {
@@ -45,6 +46,11 @@ String GraphicsResource::displayString() const
                 return formatString("Image @ {}x{}", meAsImage->width(), meAsImage->height());
             }
             case GraphicsResourceType::Shader: return "Shader";
+            case GraphicsResourceType::StaticSpriteBatch: {
+                const auto* meAsBatch = static_cast<const StaticSpriteBatch::Impl*>(this);
+
+                return formatString("StaticSpriteBatch @ {} sprites", meAsBatch->spriteCount());
+            }
         }
         return "<unknown>";
     }();
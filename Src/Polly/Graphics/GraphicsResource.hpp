@@ -13,8 +13,9 @@ namespace Polly
 {
 enum class GraphicsResourceType
 {
-    Image  = 1,
-    Shader = 2,
+    Image             = 1,
+    Shader            = 2,
+    StaticSpriteBatch = 3,
 };
 
 class GraphicsResource : public Object,
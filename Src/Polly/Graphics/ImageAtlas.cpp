@@ -0,0 +1,314 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/ImageAtlas.hpp"
+
+#include "Polly/Algorithm.hpp"
+#include "Polly/Format.hpp"
+#include "Polly/Graphics/ImageImpl.hpp"
+#include "Polly/Logging.hpp"
+#include "Polly/Math.hpp"
+#include <cstring>
+
+namespace Polly
+{
+static constexpr auto bytesPerPixel = 4u;
+
+ImageAtlas::ImageAtlas(const ImageAtlasOptions& options)
+    : _options(options)
+{
+    if (_options.pageSize == 0 or _options.maxPageCount == 0)
+    {
+        throw Error(formatString(
+            "Invalid image atlas options specified (pageSize={}; maxPageCount={}).",
+            _options.pageSize,
+            _options.maxPageCount));
+    }
+
+    // An image must always fit into an empty page, including its padding.
+    _options.maxImageExtent = min(_options.maxImageExtent, _options.pageSize - (2 * padding));
+
+    logVerbose(
+        "Creating ImageAtlas with pageSize={}; maxPageCount={}; maxImageExtent={}",
+        _options.pageSize,
+        _options.maxPageCount,
+        _options.maxImageExtent);
+}
+
+ImageAtlas::~ImageAtlas() noexcept
+{
+    logVerbose("Destroying ImageAtlas");
+
+    // Images may outlive the atlas, so they must not refer to their entries anymore.
+    for (const auto& entry : _entries)
+    {
+        entry->image->setAtlasEntry(nullptr);
+    }
+}
+
+void ImageAtlas::registerImage(Image::Impl& image, const void* data)
+{
+    assume(not image.atlasEntry());
+
+    if (image.usage() != ImageUsage::Immutable
+        or image.format() != ImageFormat::R8G8B8A8UNorm
+        or image.width() > _options.maxImageExtent
+        or image.height() > _options.maxImageExtent)
+    {
+        return;
+    }
+
+    const auto sizeInBytes = imageSlicePitch(image.width(), image.height(), image.format());
+
+    auto entry           = makeUnique<ImageAtlasEntry>();
+    entry->image         = &image;
+    entry->width         = image.width();
+    entry->height        = image.height();
+    entry->lastUsedFrame = _currentFrame;
+    entry->pixels.resize(sizeInBytes);
+
+    std::memcpy(entry->pixels.data(), data, sizeInBytes);
+
+    image.setAtlasEntry(entry.get());
+
+    // Place the image right away, so that its upload doesn't happen during drawing.
+    tryPlace(*entry);
+
+    _entries.add(std::move(entry));
+}
+
+void ImageAtlas::unregisterImage(Image::Impl& image)
+{
+    auto* entry = image.atlasEntry();
+    assume(entry);
+
+    // The space of the image is reclaimed when its page is repacked. It can't be reused
+    // right away, because sprites that refer to it might still be queued.
+    if (entry->page)
+    {
+        unplace(*entry);
+    }
+
+    image.setAtlasEntry(nullptr);
+
+    _entries.removeFirstWhere([entry](const auto& e) { return e.get() == entry; });
+}
+
+void ImageAtlas::onFrameStarted()
+{
+    ++_currentFrame;
+
+    if (_wasOutOfSpace)
+    {
+        evictStaleEntries();
+    }
+
+    for (auto& page : _pages)
+    {
+        // Space of evicted and unregistered images is only reclaimed by repacking the page.
+        // When the atlas ran out of space, every page that has such space is repacked.
+        const auto minLiveArea = _wasOutOfSpace
+                                     ? float(page.allocatedArea)
+                                     : float(page.allocatedArea) * _options.defragmentationThreshold;
+
+        if (page.liveArea > 0 and float(page.liveArea) < minLiveArea)
+        {
+            defragment(page);
+        }
+    }
+
+    // Release pages that don't contain any images anymore.
+    _pages.removeAllWhere([](const Page& page) { return page.liveArea == 0; });
+
+    _isOutOfSpace  = false;
+    _wasOutOfSpace = false;
+}
+
+ImageAtlasStats ImageAtlas::stats() const
+{
+    auto stats      = ImageAtlasStats();
+    stats.pageCount = _pages.size();
+
+    for (const auto& entry : _entries)
+    {
+        if (entry->page)
+        {
+            ++stats.placedImageCount;
+        }
+        else
+        {
+            ++stats.unplacedImageCount;
+        }
+    }
+
+    if (not _pages.isEmpty())
+    {
+        const auto pageArea  = double(_options.pageSize) * double(_options.pageSize);
+        const auto totalArea = pageArea * double(_pages.size());
+        const auto liveArea  = sumBy(_pages, [](const Page& page) { return double(page.liveArea); });
+
+        stats.occupancy = liveArea / totalArea;
+    }
+
+    stats.evictionCount        = _evictionCount;
+    stats.defragmentationCount = _defragmentationCount;
+
+    return stats;
+}
+
+bool ImageAtlas::placeIntoFreeSpace(ImageAtlasEntry& entry)
+{
+    for (auto& page : _pages)
+    {
+        if (tryPlaceInPage(entry, page))
+        {
+            return true;
+        }
+    }
+
+    if (_pages.size() < _options.maxPageCount and tryPlaceInPage(entry, appendPage()))
+    {
+        return true;
+    }
+
+    _isOutOfSpace  = true;
+    _wasOutOfSpace = true;
+
+    return false;
+}
+
+bool ImageAtlas::tryPlaceInPage(ImageAtlasEntry& entry, Page& page)
+{
+    const auto rect = page.pack.insert(int(entry.width + (2 * padding)), int(entry.height + (2 * padding)));
+
+    if (not rect)
+    {
+        return false;
+    }
+
+    const auto area = paddedArea(entry);
+    page.allocatedArea += area;
+    page.liveArea += area;
+
+    entry.page     = page.image.impl();
+    entry.position = Vec2(float(u32(rect->x) + padding), float(u32(rect->y) + padding));
+
+    upload(entry, page, *rect);
+
+    return true;
+}
+
+void ImageAtlas::unplace(ImageAtlasEntry& entry)
+{
+    auto& page = pageOf(entry);
+
+    page.liveArea -= paddedArea(entry);
+    entry.page = nullptr;
+}
+
+void ImageAtlas::evictStaleEntries()
+{
+    for (auto& entry : _entries)
+    {
+        if (entry->page and entry->lastUsedFrame + _options.evictionAge < _currentFrame)
+        {
+            unplace(*entry);
+            ++_evictionCount;
+        }
+    }
+}
+
+void ImageAtlas::defragment(Page& page)
+{
+    auto entriesInPage = List<ImageAtlasEntry*>();
+
+    for (auto& entry : _entries)
+    {
+        if (entry->page == page.image.impl())
+        {
+            entriesInPage.add(entry.get());
+        }
+    }
+
+    // Packing the tallest images first leaves less unusable space behind.
+    sort(entriesInPage, [](const auto* lhs, const auto* rhs) { return lhs->height > rhs->height; });
+
+    page.pack          = BinPack(_options.pageSize, _options.pageSize);
+    page.allocatedArea = 0;
+    page.liveArea      = 0;
+
+    for (auto* entry : entriesInPage)
+    {
+        entry->page = nullptr;
+
+        // An image that doesn't fit anymore is placed again as soon as it's drawn.
+        tryPlaceInPage(*entry, page);
+    }
+
+    ++_defragmentationCount;
+}
+
+void ImageAtlas::upload(const ImageAtlasEntry& entry, Page& page, const BinPack::Rect& rect)
+{
+    const auto width    = u32(rect.width);
+    const auto height   = u32(rect.height);
+    const auto rowPitch = width * bytesPerPixel;
+
+    _uploadBuffer.resize(rowPitch * height);
+
+    const auto srcRowPitch     = entry.width * bytesPerPixel;
+    const auto lastColumn      = (entry.width - 1) * bytesPerPixel;
+    const auto rightPaddingPos = (padding + entry.width) * bytesPerPixel;
+
+    for (auto y = 0u; y < height; ++y)
+    {
+        // Rows and columns of the padding repeat the image's nearest edge pixels.
+        const auto srcY   = u32(clamp(int(y) - int(padding), 0, int(entry.height) - 1));
+        const auto srcRow = entry.pixels.data() + (srcY * srcRowPitch);
+        auto*      dstRow = _uploadBuffer.data() + (y * rowPitch);
+
+        for (auto x = 0u; x < padding; ++x)
+        {
+            std::memcpy(dstRow + (x * bytesPerPixel), srcRow, bytesPerPixel);
+            std::memcpy(dstRow + rightPaddingPos + (x * bytesPerPixel), srcRow + lastColumn, bytesPerPixel);
+        }
+
+        std::memcpy(dstRow + (padding * bytesPerPixel), srcRow, srcRowPitch);
+    }
+
+    page.image.updateData(u32(rect.x), u32(rect.y), width, height, _uploadBuffer.data(), true);
+}
+
+ImageAtlas::Page& ImageAtlas::appendPage()
+{
+    const auto size = _options.pageSize;
+
+    auto& page = _pages.emplace(
+        Page{
+            .image         = Image(ImageUsage::Updatable, size, size, ImageFormat::R8G8B8A8UNorm, nullptr),
+            .pack          = BinPack(size, size),
+            .allocatedArea = 0,
+            .liveArea      = 0,
+        });
+
+    page.image.setDebuggingLabel("ImageAtlasPage");
+
+    logVerbose("Appended image atlas page (now {} pages)", _pages.size());
+
+    return page;
+}
+
+ImageAtlas::Page& ImageAtlas::pageOf(const ImageAtlasEntry& entry)
+{
+    const auto index = indexOfWhere(_pages, [&entry](const Page& p) { return p.image.impl() == entry.page; });
+    assume(index);
+
+    return _pages[*index];
+}
+
+u32 ImageAtlas::paddedArea(const ImageAtlasEntry& entry)
+{
+    return (entry.width + (2 * padding)) * (entry.height + (2 * padding));
+}
+} // namespace Polly
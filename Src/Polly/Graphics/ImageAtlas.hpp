@@ -0,0 +1,128 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Core/BinPack.hpp"
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Image.hpp"
+#include "Polly/ImageAtlasOptions.hpp"
+#include "Polly/Linalg.hpp"
+#include "Polly/List.hpp"
+#include "Polly/Painter.hpp"
+#include "Polly/UniquePtr.hpp"
+
+namespace Polly
+{
+// An image that is known to the ImageAtlas.
+// Images refer to their entry via Image::Impl::atlasEntry().
+struct ImageAtlasEntry
+{
+    Image::Impl* image = nullptr;
+    u32          width  = 0;
+    u32          height = 0;
+
+    // A copy of the image's pixels, kept around so that the image can be
+    // moved between pages and placed again after an eviction.
+    List<u8> pixels;
+
+    // The page that currently contains the image, or null if the image is
+    // drawn from its own texture.
+    Image::Impl* page = nullptr;
+
+    // The position of the image's top-left pixel inside its page.
+    Vec2 position;
+
+    u64 lastUsedFrame = 0;
+};
+
+// Packs small, immutable images into shared pages, so that sprites of different
+// images can be drawn as part of the same batch.
+//
+// While a frame is in progress, images are only ever placed into free page space.
+// Evicting and moving images (defragmentation) happens at the start of a frame,
+// where no queued sprite can refer to an old position anymore.
+class ImageAtlas final
+{
+  public:
+    explicit ImageAtlas(const ImageAtlasOptions& options);
+
+    DeleteCopyAndMove(ImageAtlas);
+
+    ~ImageAtlas() noexcept;
+
+    // Makes an image known to the atlas, if it's eligible.
+    // The data is expected to be the image's R8G8B8A8 pixels.
+    void registerImage(Image::Impl& image, const void* data);
+
+    void unregisterImage(Image::Impl& image);
+
+    // Ensures that the entry is part of a page, if possible.
+    bool tryPlace(ImageAtlasEntry& entry)
+    {
+        if (entry.page)
+        {
+            return true;
+        }
+
+        // Don't search the pages over and over again within the same frame.
+        if (_isOutOfSpace)
+        {
+            return false;
+        }
+
+        return placeIntoFreeSpace(entry);
+    }
+
+    void onFrameStarted();
+
+    u64 currentFrame() const
+    {
+        return _currentFrame;
+    }
+
+    ImageAtlasStats stats() const;
+
+  private:
+    // Every image is surrounded by a border of its own edge pixels, which prevents
+    // neighboring images from bleeding into each other when sampled bilinearly.
+    static constexpr auto padding = 1u;
+
+    struct Page
+    {
+        Image   image;
+        BinPack pack;
+        u32     allocatedArea = 0;
+        u32     liveArea      = 0;
+    };
+
+    bool placeIntoFreeSpace(ImageAtlasEntry& entry);
+
+    bool tryPlaceInPage(ImageAtlasEntry& entry, Page& page);
+
+    void unplace(ImageAtlasEntry& entry);
+
+    void evictStaleEntries();
+
+    void defragment(Page& page);
+
+    void upload(const ImageAtlasEntry& entry, Page& page, const BinPack::Rect& rect);
+
+    Page& appendPage();
+
+    Page& pageOf(const ImageAtlasEntry& entry);
+
+    static u32 paddedArea(const ImageAtlasEntry& entry);
+
+    ImageAtlasOptions                _options;
+    List<Page, 4>                    _pages;
+    List<UniquePtr<ImageAtlasEntry>> _entries;
+    u64                              _currentFrame         = 0;
+    bool                             _isOutOfSpace         = false;
+    bool                             _wasOutOfSpace        = false;
+    u32                              _evictionCount        = 0;
+    u32                              _defragmentationCount = 0;
+    List<u8>                         _uploadBuffer;
+};
+} // namespace Polly
@@ -4,6 +4,9 @@
 
 #include "Polly/Graphics/ImageImpl.hpp"
 
+#include "Polly/Graphics/ImageAtlas.hpp"
+#include "Polly/Graphics/PainterImpl.hpp"
+
 namespace Polly
 {
 Image::Impl::Impl(
@@ -22,6 +25,14 @@ Image::Impl::Impl(
 {
 }
 
+Image::Impl::~Impl() noexcept
+{
+    if (_atlasEntry)
+    {
+        painter().imageAtlas()->unregisterImage(*this);
+    }
+}
+
 ImageUsage Image::Impl::usage() const
 {
     return _usage;
@@ -46,4 +57,9 @@ bool Image::Impl::supportsImmediateUpdate() const
 {
     return _supportsImmediateUpdate;
 }
+
+void Image::Impl::setAtlasEntry(ImageAtlasEntry* entry)
+{
+    _atlasEntry = entry;
+}
 } // namespace Polly
@@ -10,6 +10,7 @@
 namespace Polly
 {
 enum class ImageFormat;
+struct ImageAtlasEntry;
 
 class Image::Impl : public GraphicsResource
 {
@@ -22,6 +23,8 @@ class Image::Impl : public GraphicsResource
         ImageFormat    format,
         bool           supportsImmediateUpdate);
 
+    ~Impl() noexcept override;
+
     ImageUsage usage() const;
 
     u32 width() const;
@@ -42,11 +45,20 @@ class Image::Impl : public GraphicsResource
 
     virtual void updateFromEnqueuedData(u32 x, u32 y, u32 width, u32 height, const void* data) = 0;
 
+    // Non-null if the image is known to the painter's image atlas.
+    ImageAtlasEntry* atlasEntry() const
+    {
+        return _atlasEntry;
+    }
+
+    void setAtlasEntry(ImageAtlasEntry* entry);
+
   private:
-    ImageUsage  _usage;
-    u32         _width  = 0;
-    u32         _height = 0;
-    ImageFormat _format;
-    bool        _supportsImmediateUpdate = false;
+    ImageUsage       _usage;
+    u32              _width  = 0;
+    u32              _height = 0;
+    ImageFormat      _format;
+    bool             _supportsImmediateUpdate = false;
+    ImageAtlasEntry* _atlasEntry              = nullptr;
 };
 } // namespace Polly
@@ -6,6 +6,7 @@
 
 #include "Polly/Color.hpp"
 #include "Polly/Linalg.hpp"
+#include "Polly/Math.hpp"
 
 namespace Polly
 {
@@ -21,4 +22,67 @@ struct alignas(16) SpriteVertex
     Vec4  positionAndUV;
     Color color;
 };
+
+// Used by backends that are able to reference multiple images in a single sprite batch.
+struct MultiImageSpriteVertex
+{
+    Vec4  positionAndUV;
+    Color color;
+    float imageSlot = 0.0f;
+};
+
+// Converts a color to four normalized 8-bit channels, as read by VertexElement::UByte4Normalized.
+// The channels are stored in memory in RGBA order, assuming a little-endian host.
+constexpr u32 packColor(const Color& color)
+{
+    const auto toUnorm8 = [](float value)
+    {
+        return u32(clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+
+    return toUnorm8(color.r)
+           | (toUnorm8(color.g) << 8)
+           | (toUnorm8(color.b) << 16)
+           | (toUnorm8(color.a) << 24);
+}
+
+// Compact counterparts of SpriteVertex, MultiImageSpriteVertex and MeshVertex, used by backends
+// that support VertexElement::UByte4Normalized. Texture coordinates stay 32-bit floats, since
+// repeating samplers and large images need their range and precision.
+struct PackedSpriteVertex
+{
+    Vec2 position;
+    Vec2 uv;
+    u32  color = 0;
+};
+
+struct PackedMultiImageSpriteVertex
+{
+    Vec2  position;
+    Vec2  uv;
+    u32   color     = 0;
+    float imageSlot = 0.0f;
+};
+
+using PackedMeshVertex = PackedSpriteVertex;
+
+static_assert(sizeof(PackedSpriteVertex) == 20);
+static_assert(sizeof(PackedMultiImageSpriteVertex) == 24);
+
+// Used by backends that expand sprite quads in their vertex shader, with one instance per sprite.
+// Keep this in sync with the instanced sprite vertex shaders!
+struct SpriteInstance
+{
+    // Top-left position and size of the destination rectangle.
+    Vec4 dst;
+
+    // Top-left texture coordinate and size of the source rectangle.
+    // Flipped sprites have a negative width or height.
+    Vec4 src;
+
+    Color color;
+
+    // The origin is normalized to the sprite's size; the rotation is in radians.
+    Vec4 originRotationAndImageSlot;
+};
 } // namespace Polly
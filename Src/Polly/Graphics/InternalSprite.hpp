@@ -0,0 +1,28 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Color.hpp"
+#include "Polly/Linalg.hpp"
+#include "Polly/Radians.hpp"
+#include "Polly/Rectangle.hpp"
+#include "Polly/Sprite.hpp"
+
+namespace Polly
+{
+struct InternalSprite
+{
+    Rectangle  dst;
+    Rectangle  src;
+    Color      color;
+    Vec2       origin;
+    Radians    rotation;
+    SpriteFlip flip = SpriteFlip::None;
+    bool       isCanvas;
+
+    // Index into the images that are referenced by the current sprite batch.
+    u8 imageSlot = 0;
+};
+} // namespace Polly
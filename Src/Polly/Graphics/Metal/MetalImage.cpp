@@ -17,7 +17,8 @@ MetalImage::MetalImage(
     u32            width,
     u32            height,
     ImageFormat    format,
-    const void*    data)
+    const void*    data,
+    bool           isAlphaCoverage)
     : Impl(painter, usage, width, height, format, true)
 {
     auto& metalPainter = static_cast<MetalPainter&>(painter);
@@ -36,6 +37,17 @@ MetalImage::MetalImage(
     desc->setSampleCount(1);
     desc->setArrayLength(1);
 
+    if (isAlphaCoverage)
+    {
+        assume(format == ImageFormat::R8Unorm);
+
+        desc->setSwizzle(MTL::TextureSwizzleChannels{
+            .red   = MTL::TextureSwizzleOne,
+            .green = MTL::TextureSwizzleOne,
+            .blue  = MTL::TextureSwizzleOne,
+            .alpha = MTL::TextureSwizzleRed,
+        });
+    }
 
     switch (usage)
     {
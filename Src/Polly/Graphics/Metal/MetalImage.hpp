@@ -18,7 +18,8 @@ class MetalImage final : public Image::Impl
         u32            width,
         u32            height,
         ImageFormat    format,
-        const void*    data);
+        const void*    data,
+        bool           isAlphaCoverage);
 
     DeleteCopyAndMove(MetalImage);
 
@@ -19,9 +19,11 @@
 #include "Polly/Graphics/Metal/MetalImage.hpp"
 #include "Polly/Graphics/Metal/MetalUserShader.hpp"
 #include "Polly/Graphics/Metal/MetalWindow.hpp"
+#include "Polly/Graphics/PrecompiledShader.hpp"
 #include "Polly/Graphics/Tessellation2D.hpp"
 #include "Polly/ImGui.hpp"
 #include "Polly/Logging.hpp"
+#include "Polly/Profiler.hpp"
 #include "Polly/ShaderCompiler/Ast.hpp"
 #include "Polly/ShaderCompiler/MetalShaderGenerator.hpp"
 #include "Resources/MetalCppCommonStuff.hpp"
@@ -108,7 +110,7 @@ MetalPainter::MetalPainter(Window::Impl& windowImpl, GamePerformanceStats& perfo
 
     _semaphore = dispatch_semaphore_create(maxFramesInFlight);
 
-    postInit(caps, maxFramesInFlight, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices);
+    postInit(caps, maxFramesInFlight, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices, maxMeshIndices);
 
     if (!ImGui_ImplSDL3_InitForMetal(windowImpl.sdlWindow()))
     {
@@ -124,6 +126,7 @@ MetalPainter::MetalPainter(Window::Impl& windowImpl, GamePerformanceStats& perfo
     logVerbose("  maxSpriteBatchSize: {}", maxSpriteBatchSize);
     logVerbose("  maxPolyVertices:    {}", maxPolyVertices);
     logVerbose("  maxMeshVertices:    {}", maxMeshVertices);
+    logVerbose("  maxMeshIndices:     {}", maxMeshIndices);
 }
 
 MetalPainter::~MetalPainter() noexcept
@@ -149,6 +152,8 @@ MetalPainter::~MetalPainter() noexcept
 
 void MetalPainter::onFrameStarted()
 {
+    PollyProfileScope("MetalPainter::onFrameStarted");
+
     auto arp = NS::TransferPtr(NS::AutoreleasePool::alloc()->init());
 
     auto& frameData = currentFrameData();
@@ -244,11 +249,15 @@ void MetalPainter::onFrameStarted()
 
 void MetalPainter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc)
 {
+    PollyProfileScope("MetalPainter::onFrameEnded");
+
     auto& frameData = currentFrameData();
 
     // ImGui
     if (imGuiDrawFunc)
     {
+        PollyProfileScope("ImGui");
+
         setCanvas(none, none, false);
 
         ImGui_ImplMetal_NewFrame(frameData.currentRenderPassDescriptor);
@@ -408,7 +417,19 @@ UniquePtr<Image::Impl> MetalPainter::createImage(
     ImageFormat format,
     const void* data)
 {
-    return makeUnique<MetalImage>(*this, usage, width, height, format, data);
+    return makeUnique<MetalImage>(*this, usage, width, height, format, data, false);
+}
+
+UniquePtr<Image::Impl> MetalPainter::createAlphaCoverageImage(u32 width, u32 height)
+{
+    return makeUnique<MetalImage>(
+        *this,
+        ImageUsage::Updatable,
+        width,
+        height,
+        ImageFormat::R8Unorm,
+        nullptr,
+        true);
 }
 
 void MetalPainter::spriteQueueLimitReached()
@@ -440,6 +461,61 @@ void MetalPainter::spriteQueueLimitReached()
         spriteVerticesBufferSlot);
 }
 
+UniquePtr<StaticSpriteBatch::Impl::Buffer> MetalPainter::createStaticSpriteBuffer(u32 spriteCount)
+{
+    const auto sizeInBytes = sizeof(SpriteVertex) * spriteCount * verticesPerSprite;
+
+    auto buffer = makeUnique<StaticSpriteBuffer>();
+
+    buffer->vertexBuffer = NS::TransferPtr(
+        _mtlDevice->newBuffer(static_cast<NS::UInteger>(sizeInBytes), MTL::ResourceStorageModeShared));
+
+    if (!buffer->vertexBuffer)
+    {
+        throw Error("Failed to create a vertex buffer for static sprite drawing.");
+    }
+
+    buffer->vertexBuffer->setLabel(NSStringLiteral("StaticSpriteVertexBuffer"));
+
+    return buffer;
+}
+
+void MetalPainter::updateStaticSpriteBuffer(
+    StaticSpriteBatch::Impl::Buffer& buffer,
+    u32                              offset,
+    Span<InternalSprite>             sprites,
+    const Rectangle&                 imageSizeAndInverse)
+{
+    auto& staticBuffer = static_cast<StaticSpriteBuffer&>(buffer);
+
+    if (staticBuffer.isInUse)
+    {
+        // Frames in flight may still read the current contents, so write to a copy instead.
+        // The previous buffer is kept alive by the command buffers that reference it.
+        auto* previousBuffer = staticBuffer.vertexBuffer.get();
+
+        auto newBuffer = NS::TransferPtr(_mtlDevice->newBuffer(
+            previousBuffer->contents(),
+            previousBuffer->length(),
+            MTL::ResourceStorageModeShared));
+
+        if (!newBuffer)
+        {
+            throw Error("Failed to create a vertex buffer for static sprite drawing.");
+        }
+
+        newBuffer->setLabel(NSStringLiteral("StaticSpriteVertexBuffer"));
+
+        staticBuffer.vertexBuffer = std::move(newBuffer);
+        staticBuffer.isInUse      = false;
+    }
+
+    auto* dstVertices =
+        static_cast<SpriteVertex*>(staticBuffer.vertexBuffer->contents()) + (offset * verticesPerSprite);
+
+    fillSpriteVertices<false>(dstVertices, sprites, Span(&imageSizeAndInverse, 1));
+}
+
 void MetalPainter::requestFrameCapture()
 {
 #if !TARGET_OS_IOS
@@ -491,6 +567,25 @@ UniquePtr<Shader::Impl> MetalPainter::onCreateNativeUserShader(
         cbufferSize);
 }
 
+UniquePtr<Shader::Impl> MetalPainter::onCreatePrecompiledUserShader(
+    const PrecompiledShader& shader,
+    StringView               filenameHint)
+{
+    if (shader.metalCode.isEmpty())
+    {
+        return Impl::onCreatePrecompiledUserShader(shader, filenameHint);
+    }
+
+    return makeUnique<MetalUserShader>(
+        *this,
+        shader.type,
+        shader.sourceCode,
+        shader.metalCode,
+        shader.reflection.parameters,
+        shader.reflection.flags,
+        shader.reflection.cbufferSize);
+}
+
 void MetalPainter::endCurrentRenderEncoder()
 {
     auto& frameData = currentFrameData();
@@ -679,13 +774,15 @@ int MetalPainter::prepareDrawCall()
 void MetalPainter::flushSprites(
     Span<InternalSprite>  sprites,
     GamePerformanceStats& stats,
-    Rectangle             imageSizeAndInverse)
+    Span<Rectangle>       imageSizesAndInverse)
 {
+    PollyProfileScope("MetalPainter::flushSprites");
+
     auto& frameData    = currentFrameData();
     auto* vertexBuffer = frameData.spriteVertexBuffers[frameData.currentSpriteVertexBufferIndex].get();
     auto* dstVertices  = static_cast<SpriteVertex*>(vertexBuffer->contents()) + frameData.spriteVertexCounter;
 
-    fillSpriteVertices<false>(dstVertices, sprites, imageSizeAndInverse);
+    fillSpriteVertices<false>(dstVertices, sprites, imageSizesAndInverse);
 
     const auto vertexCount = sprites.size() * verticesPerSprite;
     const auto indexCount  = sprites.size() * indicesPerSprite;
@@ -704,18 +801,49 @@ void MetalPainter::flushSprites(
     frameData.spriteIndexCounter += indexCount;
 }
 
+void MetalPainter::drawStaticSprites(
+    StaticSpriteBatch::Impl::Buffer& buffer,
+    u32                              offset,
+    u32                              count,
+    GamePerformanceStats&            stats)
+{
+    auto& frameData    = currentFrameData();
+    auto& staticBuffer = static_cast<StaticSpriteBuffer&>(buffer);
+
+    // The painter marks vertex buffers as dirty afterwards, which binds the frame's sprite
+    // vertex buffer again.
+    frameData.renderEncoder->setVertexBuffer(
+        staticBuffer.vertexBuffer.get(),
+        static_cast<NS::UInteger>(offset) * verticesPerSprite * sizeof(SpriteVertex),
+        spriteVerticesBufferSlot);
+
+    frameData.renderEncoder->drawIndexedPrimitives(
+        MTL::PrimitiveTypeTriangle,
+        count * indicesPerSprite,
+        MTL::IndexTypeUInt16,
+        _spriteIndexBuffer.get(),
+        0);
+
+    staticBuffer.isInUse = true;
+
+    ++stats.drawCallCount;
+    stats.vertexCount += count * verticesPerSprite;
+}
+
 void MetalPainter::flushPolys(
     Span<Tessellation2D::Command> polys,
     Span<u32>                     polyCmdVertexCounts,
     u32                           numberOfVerticesToDraw,
     GamePerformanceStats&         stats)
 {
+    PollyProfileScope("MetalPainter::flushPolys");
+
     auto& frameData = currentFrameData();
 
     auto* dstVertices = static_cast<Tessellation2D::PolyVertex*>(frameData.polyVertexBuffer->contents())
                         + frameData.polyVertexCounter;
 
-    Tessellation2D::processPolyQueue(polys, dstVertices, polyCmdVertexCounts);
+    fillPolyVertices(polys, dstVertices, polyCmdVertexCounts, numberOfVerticesToDraw);
 
     frameData.renderEncoder->drawPrimitives(
         MTL::PrimitiveTypeTriangleStrip,
@@ -730,6 +858,8 @@ void MetalPainter::flushPolys(
 
 void MetalPainter::flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats)
 {
+    PollyProfileScope("MetalPainter::flushMeshes");
+
     auto& frameData   = currentFrameData();
     auto  baseVertex  = frameData.meshVertexCounter;
     auto* dstVertices = static_cast<MeshVertex*>(frameData.meshVertexBuffer->contents()) + baseVertex;
@@ -858,7 +988,7 @@ void MetalPainter::createMeshRenderingResources(MTL::Library* shaderLib)
 
         // Index buffer
         {
-            constexpr auto ibSizeInBytes = sizeof(uint16_t) * maxMeshVertices;
+            constexpr auto ibSizeInBytes = sizeof(uint16_t) * maxMeshIndices;
 
             data.meshIndexBuffer = NS::TransferPtr(_mtlDevice->newBuffer(
                 static_cast<NS::UInteger>(ibSizeInBytes),
@@ -55,8 +55,18 @@ class MetalPainter final : public Painter::Impl
         ImageFormat format,
         const void* data) override;
 
+    UniquePtr<Image::Impl> createAlphaCoverageImage(u32 width, u32 height) override;
+
     void spriteQueueLimitReached() override;
 
+    UniquePtr<StaticSpriteBatch::Impl::Buffer> createStaticSpriteBuffer(u32 spriteCount) override;
+
+    void updateStaticSpriteBuffer(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        Span<InternalSprite>             sprites,
+        const Rectangle&                 imageSizeAndInverse) override;
+
     void requestFrameCapture() override;
 
     MTL::Device* mtlDevice();
@@ -76,6 +86,16 @@ class MetalPainter final : public Painter::Impl
     static constexpr auto maxSpriteBatchSize = std::numeric_limits<uint16_t>::max() / verticesPerSprite;
     static constexpr auto maxPolyVertices    = std::numeric_limits<uint16_t>::max();
     static constexpr auto maxMeshVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshIndices     = maxMeshVertices * 3;
+
+    class StaticSpriteBuffer final : public StaticSpriteBatch::Impl::Buffer
+    {
+      public:
+        NS::SharedPtr<MTL::Buffer> vertexBuffer;
+
+        // Whether the buffer may be referenced by a frame that's still in flight.
+        bool isInUse = false;
+    };
 
     struct FrameData
     {
@@ -124,6 +144,10 @@ class MetalPainter final : public Painter::Impl
         UserShaderFlags                     flags,
         u16                                 cbufferSize) override;
 
+    UniquePtr<Shader::Impl> onCreatePrecompiledUserShader(
+        const PrecompiledShader& shader,
+        StringView               filenameHint) override;
+
     void endCurrentRenderEncoder();
 
     int prepareDrawCall() override;
@@ -131,7 +155,7 @@ class MetalPainter final : public Painter::Impl
     void flushSprites(
         Span<InternalSprite>  sprites,
         GamePerformanceStats& stats,
-        Rectangle             imageSizeAndInverse) override;
+        Span<Rectangle>       imageSizesAndInverse) override;
 
     void flushPolys(
         Span<Tessellation2D::Command> polys,
@@ -141,6 +165,12 @@ class MetalPainter final : public Painter::Impl
 
     void flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats) override;
 
+    void drawStaticSprites(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        u32                              count,
+        GamePerformanceStats&            stats) override;
+
     void createSpriteRenderingResources(MTL::Library* shaderLib);
 
     void createPolyRenderingResources(MTL::Library* shaderLib);
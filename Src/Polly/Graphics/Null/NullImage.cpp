@@ -0,0 +1,34 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Null/NullImage.hpp"
+
+namespace Polly
+{
+NullImage::NullImage(Painter::Impl& painter, ImageUsage usage, u32 width, u32 height, ImageFormat format)
+    : Impl(painter, usage, width, height, format, true)
+{
+}
+
+void NullImage::updateData(
+    [[maybe_unused]] u32         x,
+    [[maybe_unused]] u32         y,
+    [[maybe_unused]] u32         width,
+    [[maybe_unused]] u32         height,
+    [[maybe_unused]] const void* data,
+    [[maybe_unused]] bool        shouldUpdateImmediately)
+{
+    // Nothing to do.
+}
+
+void NullImage::updateFromEnqueuedData(
+    [[maybe_unused]] u32         x,
+    [[maybe_unused]] u32         y,
+    [[maybe_unused]] u32         width,
+    [[maybe_unused]] u32         height,
+    [[maybe_unused]] const void* data)
+{
+    // Nothing to do.
+}
+} // namespace Polly
@@ -0,0 +1,24 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/ImageImpl.hpp"
+
+namespace Polly
+{
+// An image that only keeps its description around. Its pixel data is discarded.
+class NullImage final : public Image::Impl
+{
+  public:
+    explicit NullImage(Painter::Impl& painter, ImageUsage usage, u32 width, u32 height, ImageFormat format);
+
+    DeleteCopyAndMove(NullImage);
+
+    void updateData(u32 x, u32 y, u32 width, u32 height, const void* data, bool shouldUpdateImmediately)
+        override;
+
+    void updateFromEnqueuedData(u32 x, u32 y, u32 width, u32 height, const void* data) override;
+};
+} // namespace Polly
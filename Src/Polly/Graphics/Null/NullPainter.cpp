@@ -0,0 +1,253 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Null/NullPainter.hpp"
+
+#include "Polly/Defer.hpp"
+#include "Polly/Game/WindowImpl.hpp"
+#include "Polly/GamePerformanceStats.hpp"
+#include "Polly/Graphics/Null/NullImage.hpp"
+#include "Polly/Graphics/Null/NullUserShader.hpp"
+#include "Polly/ImGui.hpp"
+#include "Polly/Logging.hpp"
+#include "Polly/Profiler.hpp"
+#include "Polly/ShaderCompiler/Ast.hpp"
+
+#include <imgui.h>
+
+#include <backends/imgui_impl_sdl3.h>
+
+namespace Polly
+{
+static constexpr auto imGuiBackendFlags =
+    ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures;
+
+NullPainter::NullPainter(Window::Impl& windowImpl, GamePerformanceStats& performanceStats)
+    : Impl(windowImpl, performanceStats)
+{
+    auto caps                 = PainterCapabilities();
+    caps.maxImageExtent       = maxImageExtent;
+    caps.maxCanvasWidth       = maxImageExtent;
+    caps.maxCanvasHeight      = maxImageExtent;
+    caps.maxScissorRects      = 1;
+    caps.maxSpriteBatchImages = maxSpriteBatchImages;
+
+    postInit(caps, 1, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices, maxMeshIndices);
+
+    if (!ImGui_ImplSDL3_InitForOther(windowImpl.sdlWindow()))
+    {
+        throw Error("Failed to initialize ImGui for SDL3.");
+    }
+
+    auto& io               = ::ImGui::GetIO();
+    io.BackendRendererName = "Polly_Null";
+    io.BackendFlags |= imGuiBackendFlags;
+}
+
+NullPainter::~NullPainter() noexcept
+{
+    logVerbose("Destroying NullPainter");
+    preBackendDtor();
+
+    for (auto* texture : ::ImGui::GetPlatformIO().Textures)
+    {
+        if (texture->RefCount == 1)
+        {
+            texture->SetTexID(ImTextureID_Invalid);
+            texture->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+
+    auto& io               = ::ImGui::GetIO();
+    io.BackendRendererName = nullptr;
+    io.BackendFlags &= ~imGuiBackendFlags;
+}
+
+void NullPainter::onFrameStarted()
+{
+    // Nothing to do.
+}
+
+void NullPainter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc)
+{
+    PollyProfileScope("NullPainter::onFrameEnded");
+
+    if (imGuiDrawFunc)
+    {
+        PollyProfileScope("ImGui");
+
+        setCanvas({}, none, false);
+
+        defer
+        {
+            ::ImGui::Render();
+            acknowledgeImGuiTextures(*::ImGui::GetDrawData());
+        };
+
+        ImGui_ImplSDL3_NewFrame();
+        ::ImGui::NewFrame();
+        imGuiDrawFunc(imgui);
+        ::ImGui::EndFrame();
+    }
+}
+
+void NullPainter::onBeforeCanvasChanged(
+    [[maybe_unused]] Image     oldCanvas,
+    [[maybe_unused]] Rectangle oldViewport)
+{
+    // Nothing to do.
+}
+
+void NullPainter::onAfterCanvasChanged(
+    [[maybe_unused]] Image        newCanvas,
+    [[maybe_unused]] Maybe<Color> clearColor,
+    [[maybe_unused]] Rectangle    viewport)
+{
+    setDirtyFlags(
+        dirtyFlags()
+        | DF_GlobalCBufferParams
+        | DF_SpriteImage
+        | DF_MeshImage
+        | DF_Sampler
+        | DF_VertexBuffers
+        | DF_PipelineState);
+}
+
+void NullPainter::onSetScissorRects([[maybe_unused]] Span<Rectangle> scissorRects)
+{
+    flush();
+}
+
+void NullPainter::requestFrameCapture()
+{
+    throw Error("Frame capturing is not supported in headless mode.");
+}
+
+UniquePtr<Image::Impl> NullPainter::createImage(
+    ImageUsage                   usage,
+    u32                          width,
+    u32                          height,
+    ImageFormat                  format,
+    [[maybe_unused]] const void* data)
+{
+    return makeUnique<NullImage>(*this, usage, width, height, format);
+}
+
+UniquePtr<Shader::Impl> NullPainter::onCreateNativeUserShader(
+    const ShaderCompiler::Ast&                           ast,
+    [[maybe_unused]] const ShaderCompiler::SemaContext&  context,
+    [[maybe_unused]] const ShaderCompiler::FunctionDecl* entryPoint,
+    StringView                                           sourceCode,
+    Shader::Impl::ParameterList                          params,
+    UserShaderFlags                                      flags,
+    u16                                                  cbufferSize)
+{
+    return makeUnique<NullUserShader>(
+        *this,
+        ast.shaderType(),
+        sourceCode,
+        std::move(params),
+        flags,
+        cbufferSize);
+}
+
+int NullPainter::prepareDrawCall()
+{
+    const auto df = dirtyFlags();
+
+    if ((df & DF_SpriteImage) || (df & DF_MeshImage))
+    {
+        ++performanceStats().textureChangeCount;
+    }
+
+    return DF_None;
+}
+
+void NullPainter::flushSprites(
+    Span<InternalSprite>  sprites,
+    GamePerformanceStats& stats,
+    Span<Rectangle>       imageSizesAndInverse)
+{
+    PollyProfileScope("NullPainter::flushSprites");
+
+    const auto vertexCount = sprites.size() * verticesPerSprite;
+
+    _spriteVertices.resize(vertexCount);
+    fillSpriteVertices<false>(_spriteVertices.data(), sprites, imageSizesAndInverse);
+
+    ++stats.drawCallCount;
+    stats.vertexCount += vertexCount;
+}
+
+void NullPainter::flushPolys(
+    Span<Tessellation2D::Command> polys,
+    Span<u32>                     polyCmdVertexCounts,
+    u32                           numberOfVerticesToDraw,
+    GamePerformanceStats&         stats)
+{
+    PollyProfileScope("NullPainter::flushPolys");
+
+    _polyVertices.resize(numberOfVerticesToDraw, Tessellation2D::PolyVertex(Vec2(), transparent));
+    fillPolyVertices(polys, _polyVertices.data(), polyCmdVertexCounts, numberOfVerticesToDraw);
+
+    ++stats.drawCallCount;
+    stats.vertexCount += numberOfVerticesToDraw;
+}
+
+void NullPainter::flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats)
+{
+    PollyProfileScope("NullPainter::flushMeshes");
+
+    auto vertexCount = 0u;
+    auto indexCount  = 0u;
+
+    for (const auto& entry : meshes)
+    {
+        vertexCount += entry.vertices.size();
+        indexCount += entry.indices.size();
+    }
+
+    _meshVertices.resize(vertexCount);
+    _meshIndices.resize(indexCount);
+
+    const auto [totalVertexCount, totalIndexCount] =
+        fillMeshVertices(meshes, _meshVertices.data(), _meshIndices.data(), 0);
+
+    ++stats.drawCallCount;
+    stats.vertexCount += totalVertexCount;
+}
+
+void NullPainter::spriteQueueLimitReached()
+{
+    flush();
+}
+
+void NullPainter::acknowledgeImGuiTextures(const ImDrawData& drawData)
+{
+    // ImGui expects its textures to be created, updated and destroyed by the renderer.
+    // Only report these as done, without keeping any pixel data.
+    if (!drawData.Textures)
+    {
+        return;
+    }
+
+    for (auto* texture : *drawData.Textures)
+    {
+        if (texture->Status == ImTextureStatus_WantCreate)
+        {
+            texture->SetTexID(ImTextureID(1));
+            texture->SetStatus(ImTextureStatus_OK);
+        }
+        else if (texture->Status == ImTextureStatus_WantUpdates)
+        {
+            texture->SetStatus(ImTextureStatus_OK);
+        }
+        else if (texture->Status == ImTextureStatus_WantDestroy and texture->UnusedFrames > 0)
+        {
+            texture->SetTexID(ImTextureID_Invalid);
+            texture->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+}
+} // namespace Polly
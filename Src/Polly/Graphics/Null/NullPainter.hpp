@@ -0,0 +1,90 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Graphics/Tessellation2D.hpp"
+#include "Polly/List.hpp"
+
+struct ImDrawData;
+
+namespace Polly
+{
+// The painter of a headless game.
+//
+// It accepts every draw call and runs the complete queueing, batching and vertex
+// generation logic of Painter::Impl, including performance stats. The generated vertices
+// are written to system memory and then discarded; no graphics API is ever involved.
+class NullPainter final : public Painter::Impl
+{
+  public:
+    explicit NullPainter(Window::Impl& windowImpl, GamePerformanceStats& performanceStats);
+
+    DeleteCopyAndMove(NullPainter);
+
+    ~NullPainter() noexcept override;
+
+    void onFrameStarted() override;
+
+    void onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc) override;
+
+    void onBeforeCanvasChanged(Image oldCanvas, Rectangle oldViewport) override;
+
+    void onAfterCanvasChanged(Image newCanvas, Maybe<Color> clearColor, Rectangle viewport) override;
+
+    void onSetScissorRects(Span<Rectangle> scissorRects) override;
+
+    void requestFrameCapture() override;
+
+    UniquePtr<Image::Impl> createImage(
+        ImageUsage  usage,
+        u32         width,
+        u32         height,
+        ImageFormat format,
+        const void* data) override;
+
+    UniquePtr<Shader::Impl> onCreateNativeUserShader(
+        const ShaderCompiler::Ast&          ast,
+        const ShaderCompiler::SemaContext&  context,
+        const ShaderCompiler::FunctionDecl* entryPoint,
+        StringView                          sourceCode,
+        Shader::Impl::ParameterList         params,
+        UserShaderFlags                     flags,
+        u16                                 cbufferSize) override;
+
+  private:
+    // Same limits as the GPU backends, so that batching behaves (and is counted) identically.
+    static constexpr auto maxSpriteBatchSize = std::numeric_limits<uint16_t>::max() / verticesPerSprite;
+    static constexpr auto maxPolyVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshIndices     = maxMeshVertices * 3;
+    static constexpr auto maxImageExtent     = 16384u;
+
+    int prepareDrawCall() override;
+
+    void flushSprites(
+        Span<InternalSprite>  sprites,
+        GamePerformanceStats& stats,
+        Span<Rectangle>       imageSizesAndInverse) override;
+
+    void flushPolys(
+        Span<Tessellation2D::Command> polys,
+        Span<u32>                     polyCmdVertexCounts,
+        u32                           numberOfVerticesToDraw,
+        GamePerformanceStats&         stats) override;
+
+    void flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats) override;
+
+    void spriteQueueLimitReached() override;
+
+    static void acknowledgeImGuiTextures(const ImDrawData& drawData);
+
+    // Scratch buffers that receive the generated vertices, reused across flushes
+    List<MultiImageSpriteVertex>     _spriteVertices;
+    List<Tessellation2D::PolyVertex> _polyVertices;
+    List<MeshVertex>                 _meshVertices;
+    List<u16>                        _meshIndices;
+};
+} // namespace Polly
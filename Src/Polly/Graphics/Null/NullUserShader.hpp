@@ -0,0 +1,23 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/ShaderImpl.hpp"
+
+namespace Polly
+{
+// A shader that is never executed. Its parameters can still be set and queried.
+class NullUserShader final : public Shader::Impl
+{
+  public:
+    explicit NullUserShader(
+        Painter::Impl&  painter,
+        ShaderType      shaderType,
+        StringView      sourceCode,
+        ParameterList   parameters,
+        UserShaderFlags flags,
+        u16             cbufferSize);
+};
+} // namespace Polly
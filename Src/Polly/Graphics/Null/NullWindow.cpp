@@ -0,0 +1,21 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Null/NullWindow.hpp"
+
+#include "Polly/Logging.hpp"
+
+namespace Polly
+{
+NullWindow::NullWindow(StringView title, Maybe<Vec2> initialWindowSize)
+    : Impl(title)
+{
+    createSDLWindow(SDL_WINDOW_HIDDEN, initialWindowSize, none, {});
+}
+
+NullWindow::~NullWindow() noexcept
+{
+    logVerbose("Destroying NullWindow");
+}
+} // namespace Polly
@@ -0,0 +1,24 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Game/WindowImpl.hpp"
+
+namespace Polly
+{
+// The window of a headless game.
+//
+// It's backed by a hidden SDL window of the "dummy" video driver, so that everything that
+// queries window state (size, pixel ratio, focus, ...) keeps working without a display.
+class NullWindow final : public Window::Impl
+{
+  public:
+    explicit NullWindow(StringView title, Maybe<Vec2> initialWindowSize);
+
+    DeleteCopyAndMove(NullWindow);
+
+    ~NullWindow() noexcept override;
+};
+} // namespace Polly
@@ -23,36 +23,49 @@ static Maybe<GLenum> convertBufferTypeToBindingSlotType(GLenum type)
 }
 
 OpenGLBuffer::OpenGLBuffer(u32 sizeInBytes, GLenum type, GLenum usage, const void* data, StringView debugName)
-    : _handleGL(0)
-    , _sizeInBytes(sizeInBytes)
+    : _sizeInBytes(sizeInBytes)
 {
-    assume(sizeInBytes > 0);
-
-    glGenBuffers(1, &_handleGL);
-
-    if (_handleGL == 0)
-    {
-        throw Error("Failed to generate an OpenGL buffer handle.");
-    }
-
-    const auto bindingSlot    = *convertBufferTypeToBindingSlotType(type);
-    auto       previousBuffer = GLint();
-    glGetIntegerv(bindingSlot, &previousBuffer);
-
-    defer
-    {
-        glBindBuffer(type, static_cast<GLuint>(previousBuffer));
-    };
-
-    glBindBuffer(type, _handleGL);
-    glBufferData(type, static_cast<GLsizeiptr>(sizeInBytes), data, usage);
+    create(
+        type,
+        debugName,
+        [&]
+        {
+            glBufferData(type, static_cast<GLsizeiptr>(sizeInBytes), data, usage);
+        });
+}
 
-    setOpenGLObjectLabel(_handleGL, debugName);
+OpenGLBuffer::OpenGLBuffer(u32 sizeInBytes, GLenum type, GLbitfield storageFlags, StringView debugName)
+    : _sizeInBytes(sizeInBytes)
+{
+    assume(glBufferStorage);
+
+    create(
+        type,
+        debugName,
+        [&]
+        {
+            glBufferStorage(type, static_cast<GLsizeiptr>(sizeInBytes), nullptr, storageFlags);
+
+            if ((storageFlags & GL_MAP_PERSISTENT_BIT) != 0)
+            {
+                // The remaining storage flags are valid access flags as well.
+                const auto accessFlags = storageFlags & ~(GL_DYNAMIC_STORAGE_BIT | GL_CLIENT_STORAGE_BIT);
+
+                _persistentData =
+                    glMapBufferRange(type, 0, static_cast<GLsizeiptr>(sizeInBytes), accessFlags);
+
+                if (!_persistentData)
+                {
+                    throw Error(formatString("Failed to persistently map OpenGL buffer '{}'.", debugName));
+                }
+            }
+        });
 }
 
 OpenGLBuffer::OpenGLBuffer(OpenGLBuffer&& moveFrom) noexcept
     : _handleGL(std::exchange(moveFrom._handleGL, 0))
     , _sizeInBytes(moveFrom._sizeInBytes)
+    , _persistentData(std::exchange(moveFrom._persistentData, nullptr))
 {
 }
 
@@ -61,8 +74,9 @@ OpenGLBuffer& OpenGLBuffer::operator=(OpenGLBuffer&& moveFrom) noexcept
     if (&moveFrom != this)
     {
         destroy();
-        _handleGL    = std::exchange(moveFrom._handleGL, 0);
-        _sizeInBytes = moveFrom._sizeInBytes;
+        _handleGL       = std::exchange(moveFrom._handleGL, 0);
+        _sizeInBytes    = moveFrom._sizeInBytes;
+        _persistentData = std::exchange(moveFrom._persistentData, nullptr);
     }
 
     return *this;
@@ -83,12 +97,46 @@ u32 OpenGLBuffer::sizeInBytes() const
     return _sizeInBytes;
 }
 
+void* OpenGLBuffer::persistentData() const
+{
+    return _persistentData;
+}
+
+template<typename Func>
+void OpenGLBuffer::create(GLenum type, StringView debugName, const Func& allocateStorage)
+{
+    assume(_sizeInBytes > 0);
+
+    glGenBuffers(1, &_handleGL);
+
+    if (_handleGL == 0)
+    {
+        throw Error("Failed to generate an OpenGL buffer handle.");
+    }
+
+    const auto bindingSlot    = *convertBufferTypeToBindingSlotType(type);
+    auto       previousBuffer = GLint();
+    glGetIntegerv(bindingSlot, &previousBuffer);
+
+    defer
+    {
+        glBindBuffer(type, static_cast<GLuint>(previousBuffer));
+    };
+
+    glBindBuffer(type, _handleGL);
+    allocateStorage();
+
+    setOpenGLObjectLabel(_handleGL, debugName);
+}
+
 void OpenGLBuffer::destroy()
 {
     if (_handleGL != 0)
     {
+        // Deleting a buffer implicitly unmaps it.
         glDeleteBuffers(1, &_handleGL);
-        _handleGL = 0;
+        _handleGL       = 0;
+        _persistentData = nullptr;
     }
 }
 } // namespace Polly
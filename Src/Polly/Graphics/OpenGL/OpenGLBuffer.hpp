@@ -16,6 +16,11 @@ class OpenGLBuffer
 
     explicit OpenGLBuffer(u32 sizeInBytes, GLenum type, GLenum usage, const void* data, StringView debugName);
 
+    // Creates a buffer with immutable storage (OpenGL 4.4 / GL_ARB_buffer_storage).
+    // If storageFlags contains GL_MAP_PERSISTENT_BIT, the entire buffer is mapped once and stays
+    // mapped for its lifetime, see persistentData().
+    explicit OpenGLBuffer(u32 sizeInBytes, GLenum type, GLbitfield storageFlags, StringView debugName);
+
     DeleteCopy(OpenGLBuffer);
 
     OpenGLBuffer(OpenGLBuffer&& moveFrom) noexcept;
@@ -28,10 +33,17 @@ class OpenGLBuffer
 
     u32 sizeInBytes() const;
 
+    // The persistently mapped memory of the buffer, or null if it isn't persistently mapped.
+    void* persistentData() const;
+
   private:
+    template<typename Func>
+    void create(GLenum type, StringView debugName, const Func& allocateStorage);
+
     void destroy();
 
-    GLuint _handleGL    = 0;
-    u32    _sizeInBytes = 0;
+    GLuint _handleGL       = 0;
+    u32    _sizeInBytes    = 0;
+    void*  _persistentData = nullptr;
 };
 } // namespace Polly
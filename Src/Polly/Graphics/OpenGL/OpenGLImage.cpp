@@ -35,13 +35,26 @@ static Maybe<GLenum> convert(ImageFilter filter)
     return none;
 }
 
+// Image data is tightly packed, but OpenGL expects rows to be 4-byte aligned by default.
+// That only matters for single-channel images, whose rows can have any length.
+// Returns the previous alignment, so that it can be restored after the upload.
+static GLint setTightUnpackAlignment()
+{
+    auto previousAlignment = GLint();
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    return previousAlignment;
+}
+
 OpenGLImage::OpenGLImage(
     Painter::Impl& painter,
     ImageUsage     usage,
     u32            width,
     uint32_t       height,
     ImageFormat    format,
-    const void*    data)
+    const void*    data,
+    bool           isAlphaCoverage)
     : Impl(painter, usage, width, height, format, false)
 {
     auto previousTextureHandle = GLint();
@@ -65,6 +78,21 @@ OpenGLImage::OpenGLImage(
 
     applySampler(Sampler(), true);
 
+    if (isAlphaCoverage)
+    {
+        assume(format == ImageFormat::R8Unorm);
+
+        const GLint swizzle[] = {GL_ONE, GL_ONE, GL_ONE, GL_RED};
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+
+    const auto previousUnpackAlignment = setTightUnpackAlignment();
+
+    defer
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, previousUnpackAlignment);
+    };
+
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
@@ -167,6 +195,13 @@ void OpenGLImage::updateData(
         }
     };
 
+    const auto previousUnpackAlignment = setTightUnpackAlignment();
+
+    defer
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, previousUnpackAlignment);
+    };
+
     glTexSubImage2D(
         GL_TEXTURE_2D,
         0,
@@ -19,7 +19,8 @@ class OpenGLImage final : public Image::Impl
         u32            width,
         u32            height,
         ImageFormat    format,
-        const void*    data);
+        const void*    data,
+        bool           isAlphaCoverage);
 
     DeleteCopyAndMove(OpenGLImage);
 
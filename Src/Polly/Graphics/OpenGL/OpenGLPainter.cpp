@@ -10,10 +10,12 @@
 #include "Polly/GamePerformanceStats.hpp"
 #include "Polly/Graphics/InternalSharedShaderStructs.hpp"
 #include "Polly/Graphics/OpenGL/OpenGLWindow.hpp"
+#include "Polly/Graphics/PrecompiledShader.hpp"
 #include "Polly/Graphics/VertexElement.hpp"
 #include "Polly/ImGui.hpp"
 #include "Polly/List.hpp"
 #include "Polly/Logging.hpp"
+#include "Polly/Profiler.hpp"
 #include "Polly/ShaderCompiler/Ast.hpp"
 #include "Polly/Util.hpp"
 
@@ -22,6 +24,7 @@
 
 #include "MeshOpenGL.vert.hpp"
 #include "PolyOpenGL.vert.hpp"
+#include "SpriteBatchInstancedOpenGL.vert.hpp"
 #include "SpriteBatchOpenGL.vert.hpp"
 
 namespace Polly
@@ -72,9 +75,28 @@ static void openGLDebugMessageCallback(
 }
 #endif
 
+// Persistent buffer mappings require immutable buffer storage, which is core since OpenGL 4.4.
+// Older drivers may still provide it via GL_ARB_buffer_storage.
+static bool supportsPersistentBufferMapping()
+{
+    if (GLAD_GL_VERSION_4_4)
+    {
+        return true;
+    }
+
+    if (SDL_GL_ExtensionSupported("GL_ARB_buffer_storage"))
+    {
+        // The loader only loads core functions, so the extension's function is loaded manually.
+        glad_glBufferStorage =
+            reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(SDL_GL_GetProcAddress("glBufferStorage"));
+    }
+
+    return glBufferStorage != nullptr;
+}
+
 OpenGLPainter::OpenGLPainter(Window::Impl& windowImpl, GamePerformanceStats& performanceStats)
     : Impl(windowImpl, performanceStats)
-    , _glslShaderGenerator(/*shouldGenerateForVulkan:*/ false)
+    , _glslShaderGenerator(/*shouldGenerateForVulkan:*/ false, maxSpriteBatchImages)
 {
     auto& openGLWindow = static_cast<OpenGLWindow&>(windowImpl);
     openGLWindow.makeContextCurrent();
@@ -99,13 +121,25 @@ OpenGLPainter::OpenGLPainter(Window::Impl& windowImpl, GamePerformanceStats& per
 
     verifyOpenGLState();
 
+    _usePersistentBufferMapping = supportsPersistentBufferMapping();
+
+    logVerbose(
+        "OpenGL per-frame buffers are {}",
+        _usePersistentBufferMapping ? "persistently mapped" : "mapped per draw call");
+
     setupOpenGLDebugCallback();
     createUniformBuffers();
     createSpriteRenderingResources();
     createPolyRenderingResources();
     createMeshRenderingResources();
 
-    postInit(determineCapabilities(), 1, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices);
+    postInit(
+        determineCapabilities(),
+        1,
+        maxSpriteBatchSize,
+        maxPolyVertices,
+        maxMeshVertices,
+        maxMeshIndices);
 
     if (!ImGui_ImplSDL3_InitForOpenGL(openGLWindow.sdlWindow(), openGLWindow.openGLContext()))
     {
@@ -127,6 +161,8 @@ OpenGLPainter::~OpenGLPainter() noexcept
 
 void OpenGLPainter::onFrameStarted()
 {
+    PollyProfileScope("OpenGLPainter::onFrameStarted");
+
     // auto& openGLWindow = static_cast<OpenGLWindow&>(window());
 
     glBindBufferBase(GL_UNIFORM_BUFFER, 0, _globalUBO.handleGL());
@@ -134,13 +170,29 @@ void OpenGLPainter::onFrameStarted()
     glEnable(GL_BLEND);
     glBlendColor(1.0f, 1.0f, 1.0f, 1.0f);
 
-    _spriteVertexCounter = 0;
-    _spriteIndexCounter  = 0;
-    _polyVertexCounter   = 0;
-    _meshVertexCounter   = 0;
-    _meshIndexCounter    = 0;
+    // Grow the per-frame buffers if the last frame didn't fit into them. Persistently mapped
+    // buffers also wait here until the GPU is done with the frame that last used their region.
+    if (_spriteInstanceBuffer.startFrame())
+    {
+        createSpriteInstanceVAO();
+    }
+
+    if (_polyVertexBuffer.startFrame())
+    {
+        createPolyVAO();
+    }
+
+    const auto hasMeshVertexBufferGrown = _meshVertexBuffer.startFrame();
+    const auto hasMeshIndexBufferGrown  = _meshIndexBuffer.startFrame();
 
-    _lastBoundOpenGLImage   = nullptr;
+    if (hasMeshVertexBufferGrown or hasMeshIndexBufferGrown)
+    {
+        createMeshVAO();
+    }
+
+    updateBufferHighWaterMarks(performanceStats());
+
+    _lastBoundOpenGLImages.clear();
     _lastSetBlendingEnabled = true;
     _lastSetColorMask       = Array{GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
     _lastSetBlendColor      = white;
@@ -148,9 +200,19 @@ void OpenGLPainter::onFrameStarted()
 
 void OpenGLPainter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc)
 {
+    PollyProfileScope("OpenGLPainter::onFrameEnded");
+
+    // The painter has flushed everything at this point, so no more draw calls read from these.
+    _spriteInstanceBuffer.endFrame();
+    _polyVertexBuffer.endFrame();
+    _meshVertexBuffer.endFrame();
+    _meshIndexBuffer.endFrame();
+
     // ImGui
     if (imGuiDrawFunc)
     {
+        PollyProfileScope("ImGui");
+
         setCanvas({}, none, false);
 
         ImGui_ImplOpenGL3_NewFrame();
@@ -285,7 +347,19 @@ UniquePtr<Image::Impl> OpenGLPainter::createImage(
     ImageFormat format,
     const void* data)
 {
-    return makeUnique<OpenGLImage>(*this, usage, width, height, format, data);
+    return makeUnique<OpenGLImage>(*this, usage, width, height, format, data, false);
+}
+
+UniquePtr<Image::Impl> OpenGLPainter::createAlphaCoverageImage(u32 width, u32 height)
+{
+    return makeUnique<OpenGLImage>(
+        *this,
+        ImageUsage::Updatable,
+        width,
+        height,
+        ImageFormat::R8Unorm,
+        nullptr,
+        true);
 }
 
 UniquePtr<Shader::Impl> OpenGLPainter::onCreateNativeUserShader(
@@ -309,6 +383,25 @@ UniquePtr<Shader::Impl> OpenGLPainter::onCreateNativeUserShader(
         cbufferSize);
 }
 
+UniquePtr<Shader::Impl> OpenGLPainter::onCreatePrecompiledUserShader(
+    const PrecompiledShader& shader,
+    StringView               filenameHint)
+{
+    if (shader.glslCode.isEmpty())
+    {
+        return Impl::onCreatePrecompiledUserShader(shader, filenameHint);
+    }
+
+    return makeUnique<OpenGLUserShader>(
+        *this,
+        shader.type,
+        shader.sourceCode,
+        shader.glslCode,
+        shader.reflection.parameters,
+        shader.reflection.flags,
+        shader.reflection.cbufferSize);
+}
+
 void OpenGLPainter::notifyResourceDestroyed(GraphicsResource& resource)
 {
     Impl::notifyResourceDestroyed(resource);
@@ -330,7 +423,7 @@ int OpenGLPainter::prepareDrawCall()
 
         switch (currentBatchMode)
         {
-            case BatchMode::Sprites: vertexShaderHandleGL = _spriteVs.handleGL(); break;
+            case BatchMode::Sprites: vertexShaderHandleGL = _spriteInstancedVs.handleGL(); break;
             case BatchMode::Polygons: vertexShaderHandleGL = _polyVs.handleGL(); break;
             case BatchMode::Mesh: vertexShaderHandleGL = _meshVs.handleGL(); break;
         }
@@ -401,9 +494,8 @@ int OpenGLPainter::prepareDrawCall()
         switch (currentBatchMode)
         {
             case BatchMode::Sprites:
-                vaoHandleGL          = _spriteVAO.handleGL();
-                vertexBufferHandleGL = _spriteVertexBuffer.handleGL();
-                indexBufferHandleGL  = _spriteIndexBuffer.handleGL();
+                vaoHandleGL          = _spriteInstanceVAO.handleGL();
+                vertexBufferHandleGL = _spriteInstanceBuffer.handleGL();
                 break;
             case BatchMode::Polygons:
                 vaoHandleGL          = _polyVAO.handleGL();
@@ -447,23 +539,43 @@ int OpenGLPainter::prepareDrawCall()
 
     if ((df & DF_SpriteImage) || (df & DF_MeshImage))
     {
-        auto* image = static_cast<OpenGLImage*>(
-            currentBatchMode == BatchMode::Sprites ? spriteBatchImage()
-            : currentBatchMode == BatchMode::Mesh  ? meshBatchImage()
-                                                   : nullptr);
+        const auto hadBoundImages = !_lastBoundOpenGLImages.isEmpty();
+
+        _lastBoundOpenGLImages.clear();
 
-        if (image)
+        if (currentBatchMode == BatchMode::Sprites)
         {
-            glActiveTexture(GL_TEXTURE0);
+            for (auto* image : spriteBatchImages())
+            {
+                _lastBoundOpenGLImages.add(static_cast<OpenGLImage*>(image));
+            }
+        }
+        else if (currentBatchMode == BatchMode::Mesh)
+        {
+            if (auto* image = meshBatchImage())
+            {
+                _lastBoundOpenGLImages.add(static_cast<OpenGLImage*>(image));
+            }
+        }
+
+        // Image i of a sprite batch is bound to texture unit i, see OpenGLShaderProgram.
+        for (auto i = 0u; auto* image : _lastBoundOpenGLImages)
+        {
+            glActiveTexture(GL_TEXTURE0 + i);
             glBindTexture(GL_TEXTURE_2D, image->textureHandleGL());
 
-            if (!_lastBoundOpenGLImage)
+            if (!hadBoundImages or i > 0)
             {
                 image->applySampler(currentSampler(), false);
             }
+
+            ++i;
         }
 
-        _lastBoundOpenGLImage = image;
+        if (_lastBoundOpenGLImages.size() > 1)
+        {
+            glActiveTexture(GL_TEXTURE0);
+        }
 
         ++perfStats.textureChangeCount;
 
@@ -473,10 +585,11 @@ int OpenGLPainter::prepareDrawCall()
 
     if (df & DF_Sampler)
     {
-        if (_lastBoundOpenGLImage)
+        for (auto* image : _lastBoundOpenGLImages)
         {
-            _lastBoundOpenGLImage->applySampler(currentSampler(), false);
+            image->applySampler(currentSampler(), false);
         }
+
         df &= ~DF_Sampler;
     }
 
@@ -504,33 +617,28 @@ int OpenGLPainter::prepareDrawCall()
 void OpenGLPainter::flushSprites(
     Span<InternalSprite>  sprites,
     GamePerformanceStats& stats,
-    Rectangle             imageSizeAndInverse)
+    Span<Rectangle>       imageSizesAndInverse)
 {
-    auto* dstVertices =
-        static_cast<SpriteVertex*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY)) + _spriteVertexCounter;
+    PollyProfileScope("OpenGLPainter::flushSprites");
 
-    if (!dstVertices)
-    {
-        throw Error("Failed to map the sprite vertex buffer.");
-    }
+    const auto mapping = _spriteInstanceBuffer.map(sprites.size());
 
-    fillSpriteVertices<true>(dstVertices, sprites, imageSizeAndInverse);
+    fillSpriteInstances<true>(static_cast<SpriteInstance*>(mapping.data), sprites, imageSizesAndInverse);
 
-    glUnmapBuffer(GL_ARRAY_BUFFER);
+    _spriteInstanceBuffer.unmap();
 
-    const auto vertexCount = sprites.size() * verticesPerSprite;
-    const auto indexCount  = sprites.size() * indicesPerSprite;
+    // The vertex shader expands each instance to a quad.
+    _spriteInstanceVAO.setVertexBufferOffset(mapping.offset * u32(sizeof(SpriteInstance)));
 
-    glDrawElements(
-        GL_TRIANGLES,
-        indexCount,
-        GL_UNSIGNED_SHORT,
-        reinterpret_cast<const void*>(uintptr_t(_spriteIndexCounter) * sizeof(u16)));
+    glDrawArraysInstanced(
+        GL_TRIANGLE_STRIP,
+        0,
+        static_cast<GLsizei>(verticesPerSprite),
+        static_cast<GLsizei>(sprites.size()));
 
     ++stats.drawCallCount;
-    stats.vertexCount += vertexCount;
-    _spriteVertexCounter += vertexCount;
-    _spriteIndexCounter += indexCount;
+    stats.vertexCount += sprites.size() * verticesPerSprite;
+    updateBufferHighWaterMarks(stats);
 }
 
 void OpenGLPainter::flushPolys(
@@ -539,58 +647,140 @@ void OpenGLPainter::flushPolys(
     u32                           numberOfVerticesToDraw,
     GamePerformanceStats&         stats)
 {
-    auto* dstVertices = static_cast<Tessellation2D::PolyVertex*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY))
-                        + _polyVertexCounter;
+    PollyProfileScope("OpenGLPainter::flushPolys");
 
-    if (!dstVertices)
-    {
-        throw Error("Failed to map the polygon vertex buffer.");
-    }
+    const auto mapping = _polyVertexBuffer.map(numberOfVerticesToDraw);
+
+    fillPolyVertices(
+        polys,
+        static_cast<Tessellation2D::PackedPolyVertex*>(mapping.data),
+        polyCmdVertexCounts,
+        numberOfVerticesToDraw);
 
-    Tessellation2D::processPolyQueue(polys, dstVertices, polyCmdVertexCounts);
+    _polyVertexBuffer.unmap();
 
-    glUnmapBuffer(GL_ARRAY_BUFFER);
-    glDrawArrays(GL_TRIANGLE_STRIP, _polyVertexCounter, numberOfVerticesToDraw);
+    glDrawArrays(GL_TRIANGLE_STRIP, GLint(mapping.offset), GLsizei(numberOfVerticesToDraw));
 
     ++stats.drawCallCount;
     stats.vertexCount += numberOfVerticesToDraw;
-    _polyVertexCounter += numberOfVerticesToDraw;
+    updateBufferHighWaterMarks(stats);
 }
 
 void OpenGLPainter::flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats)
 {
-    auto* dstVertices =
-        static_cast<MeshVertex*>(glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY)) + _meshVertexCounter;
+    PollyProfileScope("OpenGLPainter::flushMeshes");
 
-    if (!dstVertices)
-    {
-        throw Error("Failed to map the mesh vertex buffer.");
-    }
-
-    auto* dstIndices =
-        static_cast<u16*>(glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY)) + _meshIndexCounter;
+    const auto vertexCount = sumBy(meshes, [](const MeshEntry& entry) { return entry.vertices.size(); });
+    const auto indexCount  = sumBy(meshes, [](const MeshEntry& entry) { return entry.indices.size(); });
+    const auto vertexMapping = _meshVertexBuffer.map(vertexCount);
+    const auto indexMapping  = _meshIndexBuffer.map(indexCount);
 
-    const auto [totalVertexCount, totalIndexCount] =
-        fillMeshVertices(meshes, dstVertices, dstIndices, _meshVertexCounter);
+    // Indices are 32-bit, since they're offset by the position of their mesh in the vertex buffer,
+    // which may exceed the 16-bit range.
+    const auto [totalVertexCount, totalIndexCount] = fillMeshVertices(
+        meshes,
+        static_cast<PackedMeshVertex*>(vertexMapping.data),
+        static_cast<u32*>(indexMapping.data),
+        vertexMapping.offset);
 
-    glUnmapBuffer(GL_ARRAY_BUFFER);
-    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    _meshVertexBuffer.unmap();
+    _meshIndexBuffer.unmap();
 
     glDrawElements(
         GL_TRIANGLES,
-        totalIndexCount,
-        GL_UNSIGNED_SHORT,
-        reinterpret_cast<const void*>(uintptr_t(_meshIndexCounter) * sizeof(u16)));
+        GLsizei(totalIndexCount),
+        GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(uintptr_t(indexMapping.offset) * sizeof(u32)));
 
-    _meshVertexCounter += totalVertexCount;
-    _meshIndexCounter += totalIndexCount;
     ++stats.drawCallCount;
     stats.vertexCount += totalVertexCount;
+    updateBufferHighWaterMarks(stats);
+}
+
+UniquePtr<StaticSpriteBatch::Impl::Buffer> OpenGLPainter::createStaticSpriteBuffer(u32 spriteCount)
+{
+    auto buffer = makeUnique<StaticSpriteBuffer>();
+
+    buffer->vertexBuffer = OpenGLBuffer(
+        spriteCount * verticesPerSprite * sizeof(PackedMultiImageSpriteVertex),
+        GL_ARRAY_BUFFER,
+        GL_STATIC_DRAW,
+        nullptr,
+        "StaticSpriteVertexBuffer"_sv);
+
+    // Sprites are drawn in chunks of at most maxSpriteBatchSize using a base vertex,
+    // so the regular sprite index buffer can be shared.
+    buffer->vao = OpenGLVAO(
+        buffer->vertexBuffer.handleGL(),
+        _spriteIndexBuffer.handleGL(),
+        Array{
+            VertexElement::Vec2,
+            VertexElement::Vec2,
+            VertexElement::UByte4Normalized,
+            VertexElement::Float,
+        },
+        "StaticSpriteVAO"_sv);
+
+    verifyOpenGLState();
+
+    return buffer;
+}
+
+void OpenGLPainter::updateStaticSpriteBuffer(
+    StaticSpriteBatch::Impl::Buffer& buffer,
+    u32                              offset,
+    Span<InternalSprite>             sprites,
+    const Rectangle&                 imageSizeAndInverse)
+{
+    auto& staticBuffer = static_cast<StaticSpriteBuffer&>(buffer);
+
+    _staticSpriteVertices.resize(sprites.size() * verticesPerSprite);
+
+    fillSpriteVertices<true>(_staticSpriteVertices.data(), sprites, Span(&imageSizeAndInverse, 1));
+
+    // This replaces the bound sprite vertex buffer; the painter marks vertex buffers as dirty afterwards.
+    glBindBuffer(GL_ARRAY_BUFFER, staticBuffer.vertexBuffer.handleGL());
+
+    glBufferSubData(
+        GL_ARRAY_BUFFER,
+        static_cast<GLintptr>(offset * verticesPerSprite * sizeof(PackedMultiImageSpriteVertex)),
+        static_cast<GLsizeiptr>(_staticSpriteVertices.size() * sizeof(PackedMultiImageSpriteVertex)),
+        _staticSpriteVertices.data());
+}
+
+void OpenGLPainter::drawStaticSprites(
+    StaticSpriteBatch::Impl::Buffer& buffer,
+    u32                              offset,
+    u32                              count,
+    GamePerformanceStats&            stats)
+{
+    const auto& staticBuffer = static_cast<const StaticSpriteBuffer&>(buffer);
+    const auto  vertexCount  = count * verticesPerSprite;
+
+    // Static sprites are stored as vertices, so they're drawn using the non-instanced vertex shader.
+    const auto& fragmentShader =
+        static_cast<const OpenGLUserShader&>(*currentShader(BatchMode::Sprites).impl());
+
+    glUseProgram(
+        _shaderProgramCache.get(_spriteVs.handleGL(), fragmentShader.fragmentShaderHandleGL()).handleGL());
+
+    glBindVertexArray(staticBuffer.vao.handleGL());
+
+    glDrawElementsBaseVertex(
+        GL_TRIANGLES,
+        static_cast<GLsizei>(count * indicesPerSprite),
+        GL_UNSIGNED_SHORT,
+        nullptr,
+        static_cast<GLint>(offset * verticesPerSprite));
+
+    ++stats.drawCallCount;
+    stats.vertexCount += vertexCount;
 }
 
 void OpenGLPainter::spriteQueueLimitReached()
 {
-    throw Error("Sprite queue limit reached.");
+    // The instance buffer is a ring that grows as needed, so just draw what we have so far.
+    flush();
 }
 
 void OpenGLPainter::setupOpenGLDebugCallback()
@@ -625,17 +815,19 @@ void OpenGLPainter::createUniformBuffers()
 void OpenGLPainter::createSpriteRenderingResources()
 {
     // Shaders
-    _spriteVs = OpenGLShader(SpriteBatchOpenGL_vertStringView(), GL_VERTEX_SHADER);
+    _spriteVs          = OpenGLShader(SpriteBatchOpenGL_vertStringView(), GL_VERTEX_SHADER);
+    _spriteInstancedVs = OpenGLShader(SpriteBatchInstancedOpenGL_vertStringView(), GL_VERTEX_SHADER);
 
-    // Vertex buffer
-    _spriteVertexBuffer = OpenGLBuffer(
-        maxSpriteBatchSize * verticesPerSprite * sizeof(SpriteVertex),
+    _spriteInstanceBuffer = OpenGLStreamBuffer(
         GL_ARRAY_BUFFER,
-        GL_DYNAMIC_DRAW,
-        nullptr,
-        "SpriteVertexBuffer"_sv);
+        sizeof(SpriteInstance),
+        maxSpriteBatchSize,
+        _usePersistentBufferMapping,
+        "SpriteInstanceBuffer"_sv);
+
+    createSpriteInstanceVAO();
 
-    // Index buffer
+    // Index buffer, used by static sprite batches
     {
         const auto indices = createSpriteIndicesList<maxSpriteBatchSize>();
 
@@ -647,15 +839,6 @@ void OpenGLPainter::createSpriteRenderingResources()
             "SpriteIndexBuffer"_sv);
     }
 
-    _spriteVAO = OpenGLVAO(
-        _spriteVertexBuffer.handleGL(),
-        _spriteIndexBuffer.handleGL(),
-        Array{
-            VertexElement::Vec4,
-            VertexElement::Vec4,
-        },
-        "SpriteVAO"_sv);
-
     verifyOpenGLState();
 }
 
@@ -664,22 +847,14 @@ void OpenGLPainter::createPolyRenderingResources()
     // Shaders
     _polyVs = OpenGLShader(PolyOpenGL_vertStringView(), GL_VERTEX_SHADER);
 
-    // Vertex buffer
-    _polyVertexBuffer = OpenGLBuffer(
-        sizeof(Tessellation2D::PolyVertex) * maxPolyVertices,
+    _polyVertexBuffer = OpenGLStreamBuffer(
         GL_ARRAY_BUFFER,
-        GL_DYNAMIC_DRAW,
-        nullptr,
+        sizeof(Tessellation2D::PackedPolyVertex),
+        maxPolyVertices,
+        _usePersistentBufferMapping,
         "PolyVertexBuffer"_sv);
 
-    _polyVAO = OpenGLVAO(
-        _polyVertexBuffer.handleGL(),
-        0,
-        Array{
-            VertexElement::Vec4,
-            VertexElement::Vec4,
-        },
-        "PolyVAO"_sv);
+    createPolyVAO();
 }
 
 void OpenGLPainter::createMeshRenderingResources()
@@ -687,31 +862,74 @@ void OpenGLPainter::createMeshRenderingResources()
     // Shaders
     _meshVs = OpenGLShader(MeshOpenGL_vertStringView(), GL_VERTEX_SHADER);
 
-    // Buffers
-    _meshVertexBuffer = OpenGLBuffer(
-        sizeof(MeshVertex) * maxMeshVertices,
+    _meshVertexBuffer = OpenGLStreamBuffer(
         GL_ARRAY_BUFFER,
-        GL_DYNAMIC_DRAW,
-        nullptr,
+        sizeof(PackedMeshVertex),
+        maxMeshVertices,
+        _usePersistentBufferMapping,
         "MeshVertexBuffer"_sv);
 
-    _meshIndexBuffer = OpenGLBuffer(
-        sizeof(u16) * maxMeshVertices * 3,
+    _meshIndexBuffer = OpenGLStreamBuffer(
         GL_ELEMENT_ARRAY_BUFFER,
-        GL_DYNAMIC_DRAW,
-        nullptr,
+        sizeof(u32),
+        maxMeshIndices,
+        _usePersistentBufferMapping,
         "MeshIndexBuffer"_sv);
 
+    createMeshVAO();
+}
+
+void OpenGLPainter::createSpriteInstanceVAO()
+{
+    _spriteInstanceVAO = OpenGLVAO(
+        _spriteInstanceBuffer.handleGL(),
+        0,
+        Array{
+            VertexElement::Vec4,
+            VertexElement::Vec4,
+            VertexElement::Vec4,
+            VertexElement::Vec4,
+        },
+        "SpriteInstanceVAO"_sv,
+        true);
+}
+
+void OpenGLPainter::createPolyVAO()
+{
+    _polyVAO = OpenGLVAO(
+        _polyVertexBuffer.handleGL(),
+        0,
+        Array{
+            VertexElement::Vec2,
+            VertexElement::UByte4Normalized,
+        },
+        "PolyVAO"_sv);
+}
+
+void OpenGLPainter::createMeshVAO()
+{
     _meshVAO = OpenGLVAO(
         _meshVertexBuffer.handleGL(),
         _meshIndexBuffer.handleGL(),
         Array{
-            VertexElement::Vec4,
-            VertexElement::Vec4,
+            VertexElement::Vec2,
+            VertexElement::Vec2,
+            VertexElement::UByte4Normalized,
         },
         "MeshVAO"_sv);
 }
 
+void OpenGLPainter::updateBufferHighWaterMarks(GamePerformanceStats& stats) const
+{
+    stats.spriteBufferHighWaterMark = _spriteInstanceBuffer.highWaterMark() * u32(sizeof(SpriteInstance));
+
+    stats.polygonBufferHighWaterMark =
+        _polyVertexBuffer.highWaterMark() * u32(sizeof(Tessellation2D::PackedPolyVertex));
+
+    stats.meshVertexBufferHighWaterMark = _meshVertexBuffer.highWaterMark() * u32(sizeof(PackedMeshVertex));
+    stats.meshIndexBufferHighWaterMark  = _meshIndexBuffer.highWaterMark() * u32(sizeof(u32));
+}
+
 PainterCapabilities OpenGLPainter::determineCapabilities() const
 {
     auto caps = PainterCapabilities();
@@ -731,6 +949,9 @@ PainterCapabilities OpenGLPainter::determineCapabilities() const
         caps.maxScissorRects = u32(value);
     }
 
+    // OpenGL 3.3 guarantees at least 16 fragment texture units, so this is always available.
+    caps.maxSpriteBatchImages = maxSpriteBatchImages;
+
     return caps;
 }
 
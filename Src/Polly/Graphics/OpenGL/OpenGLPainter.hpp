@@ -10,6 +10,7 @@
 #include "Polly/Graphics/OpenGL/OpenGLShader.hpp"
 #include "Polly/Graphics/OpenGL/OpenGLShaderProgram.hpp"
 #include "Polly/Graphics/OpenGL/OpenGLShaderProgramCache.hpp"
+#include "Polly/Graphics/OpenGL/OpenGLStreamBuffer.hpp"
 #include "Polly/Graphics/OpenGL/OpenGLUserShader.hpp"
 #include "Polly/Graphics/OpenGL/OpenGLVAO.hpp"
 #include "Polly/Graphics/PainterImpl.hpp"
@@ -47,6 +48,8 @@ class OpenGLPainter final : public Painter::Impl
         ImageFormat format,
         const void* data) override;
 
+    UniquePtr<Image::Impl> createAlphaCoverageImage(u32 width, u32 height) override;
+
     UniquePtr<Shader::Impl> onCreateNativeUserShader(
         const ShaderCompiler::Ast&          ast,
         const ShaderCompiler::SemaContext&  context,
@@ -56,11 +59,34 @@ class OpenGLPainter final : public Painter::Impl
         UserShaderFlags                     flags,
         u16                                 cbufferSize) override;
 
+    UniquePtr<Shader::Impl> onCreatePrecompiledUserShader(
+        const PrecompiledShader& shader,
+        StringView               filenameHint) override;
+
+    UniquePtr<StaticSpriteBatch::Impl::Buffer> createStaticSpriteBuffer(u32 spriteCount) override;
+
+    void updateStaticSpriteBuffer(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        Span<InternalSprite>             sprites,
+        const Rectangle&                 imageSizeAndInverse) override;
+
   private:
-    // Limit vertex counts to 16 bit, because we're using 16 bit index buffers.
+    class StaticSpriteBuffer final : public StaticSpriteBatch::Impl::Buffer
+    {
+      public:
+        OpenGLBuffer vertexBuffer;
+        OpenGLVAO    vao;
+    };
+
+    // These limit the size of a single batch; larger batches are split by the painter.
+    // Regular sprites are drawn as instances without indices, but static sprite batches
+    // are stored as vertices and use the 16-bit sprite index buffer.
+    // The per-frame buffers start at these sizes and grow when a frame needs more.
     static constexpr auto maxSpriteBatchSize = std::numeric_limits<uint16_t>::max() / verticesPerSprite;
     static constexpr auto maxPolyVertices    = std::numeric_limits<uint16_t>::max();
     static constexpr auto maxMeshVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshIndices     = maxMeshVertices * 3;
 
     // Same strategy as in D3D11.
     static constexpr auto userShaderParamsUBOSizes = Array{
@@ -80,7 +106,7 @@ class OpenGLPainter final : public Painter::Impl
     void flushSprites(
         Span<InternalSprite>  sprites,
         GamePerformanceStats& stats,
-        Rectangle             imageSizeAndInverse) override;
+        Span<Rectangle>       imageSizesAndInverse) override;
 
     void flushPolys(
         Span<Tessellation2D::Command> polys,
@@ -90,6 +116,12 @@ class OpenGLPainter final : public Painter::Impl
 
     void flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats) override;
 
+    void drawStaticSprites(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        u32                              count,
+        GamePerformanceStats&            stats) override;
+
     void spriteQueueLimitReached() override;
 
     void setupOpenGLDebugCallback();
@@ -102,6 +134,14 @@ class OpenGLPainter final : public Painter::Impl
 
     void createMeshRenderingResources();
 
+    void createSpriteInstanceVAO();
+
+    void createPolyVAO();
+
+    void createMeshVAO();
+
+    void updateBufferHighWaterMarks(GamePerformanceStats& stats) const;
+
     [[nodiscard]]
     PainterCapabilities determineCapabilities() const;
 
@@ -115,29 +155,30 @@ class OpenGLPainter final : public Painter::Impl
     OpenGLShaderProgramCache _shaderProgramCache;
 
     OpenGLShader _spriteVs;
+    OpenGLShader _spriteInstancedVs;
     OpenGLShader _polyVs;
     OpenGLShader _meshVs;
 
-    OpenGLBuffer _spriteVertexBuffer;
-    OpenGLBuffer _spriteIndexBuffer;
-    OpenGLVAO    _spriteVAO;
+    // Whether the per-frame buffers are persistently mapped, see OpenGLStreamBuffer.
+    bool _usePersistentBufferMapping = false;
+
+    OpenGLStreamBuffer _spriteInstanceBuffer;
+    OpenGLVAO          _spriteInstanceVAO;
+    OpenGLBuffer       _spriteIndexBuffer;
 
-    OpenGLBuffer _polyVertexBuffer;
-    OpenGLVAO    _polyVAO;
+    OpenGLStreamBuffer _polyVertexBuffer;
+    OpenGLVAO          _polyVAO;
 
-    OpenGLBuffer _meshVertexBuffer;
-    OpenGLBuffer _meshIndexBuffer;
-    OpenGLVAO    _meshVAO;
+    OpenGLStreamBuffer _meshVertexBuffer;
+    OpenGLStreamBuffer _meshIndexBuffer;
+    OpenGLVAO          _meshVAO;
 
-    u32 _spriteVertexCounter = 0;
-    u32 _spriteIndexCounter  = 0;
-    u32 _polyVertexCounter   = 0;
-    u32 _meshVertexCounter   = 0;
-    u32 _meshIndexCounter    = 0;
+    // Temporary storage for vertices that are uploaded to static sprite buffers.
+    List<PackedMultiImageSpriteVertex> _staticSpriteVertices;
 
-    OpenGLImage*  _lastBoundOpenGLImage   = nullptr;
-    bool          _lastSetBlendingEnabled = false;
-    Array<int, 4> _lastSetColorMask{};
-    Color         _lastSetBlendColor = transparent;
+    List<OpenGLImage*, maxSpriteBatchImages> _lastBoundOpenGLImages;
+    bool                                     _lastSetBlendingEnabled = false;
+    Array<int, 4>                            _lastSetColorMask{};
+    Color                                    _lastSetBlendColor = transparent;
 };
 } // namespace Polly
@@ -7,6 +7,7 @@
 #include "Polly/Array.hpp"
 #include "Polly/Error.hpp"
 #include "Polly/Format.hpp"
+#include "Polly/Graphics/PainterImpl.hpp"
 #include "Polly/ShaderCompiler/GLSLShaderGenerator.hpp"
 
 namespace Polly
@@ -64,6 +65,41 @@ OpenGLShaderProgram::OpenGLShaderProgram(GLuint vertexShaderHandleGL, GLuint fra
         ++index;
     }
 
+    // Multi-image sprite batches sample from an array of images. Each array element is bound
+    // to the texture unit of the same index, which has to be told to the program explicitly.
+    {
+        auto previousProgramHandleGL = GLint();
+        glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgramHandleGL);
+
+        auto isProgramBound = false;
+
+        for (auto i = 0u; i < maxSpriteBatchImages; ++i)
+        {
+            const auto uniformName =
+                formatString("{}[{}]", ShaderCompiler::GLSLShaderGenerator::spriteImagesName, i);
+
+            const auto location = glGetUniformLocation(_handleGL, uniformName.cstring());
+
+            if (location < 0)
+            {
+                continue;
+            }
+
+            if (!isProgramBound)
+            {
+                glUseProgram(_handleGL);
+                isProgramBound = true;
+            }
+
+            glUniform1i(location, GLint(i));
+        }
+
+        if (isProgramBound)
+        {
+            glUseProgram(GLuint(previousProgramHandleGL));
+        }
+    }
+
     verifyOpenGLState();
 }
 
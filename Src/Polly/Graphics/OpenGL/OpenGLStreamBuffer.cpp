@@ -0,0 +1,289 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/OpenGL/OpenGLStreamBuffer.hpp"
+
+#include "Polly/Error.hpp"
+#include "Polly/Format.hpp"
+
+namespace Polly
+{
+static void waitForFence(GLsync& fence)
+{
+    if (!fence)
+    {
+        return;
+    }
+
+    // The first wait flushes pending commands, so that the fence is guaranteed to be signaled eventually.
+    auto flags = GLbitfield(GL_SYNC_FLUSH_COMMANDS_BIT);
+
+    while (true)
+    {
+        const auto result = glClientWaitSync(fence, flags, 1'000'000'000);
+
+        if (result == GL_ALREADY_SIGNALED or result == GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+
+        if (result == GL_WAIT_FAILED)
+        {
+            throw Error("Failed to wait for an OpenGL fence.");
+        }
+
+        flags = 0;
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+OpenGLStreamBuffer::OpenGLStreamBuffer(
+    GLenum     type,
+    u32        elementSize,
+    u32        capacity,
+    bool       isPersistentlyMapped,
+    StringView debugName)
+    : _type(type)
+    , _elementSize(elementSize)
+    , _isPersistentlyMapped(isPersistentlyMapped)
+    , _debugName(debugName)
+    , _ring(capacity)
+{
+    createBuffer();
+}
+
+OpenGLStreamBuffer::OpenGLStreamBuffer(OpenGLStreamBuffer&& moveFrom) noexcept
+    : _type(moveFrom._type)
+    , _elementSize(moveFrom._elementSize)
+    , _isPersistentlyMapped(moveFrom._isPersistentlyMapped)
+    , _debugName(std::move(moveFrom._debugName))
+    , _ring(moveFrom._ring)
+    , _buffer(std::move(moveFrom._buffer))
+    , _head(moveFrom._head)
+    , _segmentBegin(moveFrom._segmentBegin)
+    , _segments(std::exchange(moveFrom._segments, {}))
+{
+}
+
+OpenGLStreamBuffer& OpenGLStreamBuffer::operator=(OpenGLStreamBuffer&& moveFrom) noexcept
+{
+    if (&moveFrom != this)
+    {
+        destroyFences();
+        _type                 = moveFrom._type;
+        _elementSize          = moveFrom._elementSize;
+        _isPersistentlyMapped = moveFrom._isPersistentlyMapped;
+        _debugName            = std::move(moveFrom._debugName);
+        _ring                 = moveFrom._ring;
+        _buffer               = std::move(moveFrom._buffer);
+        _head                 = moveFrom._head;
+        _segmentBegin         = moveFrom._segmentBegin;
+        _segments             = std::exchange(moveFrom._segments, {});
+    }
+
+    return *this;
+}
+
+OpenGLStreamBuffer::~OpenGLStreamBuffer() noexcept
+{
+    destroyFences();
+}
+
+GLuint OpenGLStreamBuffer::handleGL() const
+{
+    return _buffer.handleGL();
+}
+
+bool OpenGLStreamBuffer::isPersistentlyMapped() const
+{
+    return _isPersistentlyMapped;
+}
+
+u32 OpenGLStreamBuffer::highWaterMark() const
+{
+    return _ring.highWaterMark();
+}
+
+bool OpenGLStreamBuffer::startFrame()
+{
+    if (_ring.startFrame())
+    {
+        // Draw calls of previous frames keep the old buffer alive until they're done with it.
+        createBuffer();
+        return true;
+    }
+
+    if (_isPersistentlyMapped)
+    {
+        releaseSignaledSegments();
+    }
+
+    return false;
+}
+
+void OpenGLStreamBuffer::endFrame()
+{
+    if (_isPersistentlyMapped)
+    {
+        endSegment();
+    }
+}
+
+OpenGLStreamBuffer::Mapping OpenGLStreamBuffer::map(u32 count)
+{
+    const auto range = _ring.allocate(count);
+
+    if (_isPersistentlyMapped)
+    {
+        if (_head + count > persistentCapacity())
+        {
+            endSegment();
+            _head         = 0;
+            _segmentBegin = 0;
+        }
+
+        // Usually, the overlapping segments belong to frames that the GPU has finished already.
+        // The current frame is only waited on if it alone needs more than the whole buffer,
+        // which stops once the buffer has grown at the next frame.
+        waitForSegmentsOverlapping(_head, _head + count);
+
+        const auto offset = _head;
+        _head += count;
+
+        return Mapping{
+            .data   = static_cast<std::byte*>(_buffer.persistentData()) + (offset * _elementSize),
+            .offset = offset,
+        };
+    }
+
+    const auto access =
+        GL_MAP_WRITE_BIT
+        | (range.mustDiscard ? GL_MAP_INVALIDATE_BUFFER_BIT
+                             : GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+    auto* data = glMapBufferRange(
+        _type,
+        static_cast<GLintptr>(range.offset * _elementSize),
+        static_cast<GLsizeiptr>(count * _elementSize),
+        access);
+
+    if (!data)
+    {
+        throw Error(formatString("Failed to map OpenGL buffer '{}'.", _debugName));
+    }
+
+    return Mapping{
+        .data   = data,
+        .offset = range.offset,
+    };
+}
+
+void OpenGLStreamBuffer::unmap()
+{
+    if (!_isPersistentlyMapped)
+    {
+        glUnmapBuffer(_type);
+    }
+}
+
+void OpenGLStreamBuffer::createBuffer()
+{
+    destroyFences();
+
+    _head         = 0;
+    _segmentBegin = 0;
+
+    if (_isPersistentlyMapped)
+    {
+        _buffer = OpenGLBuffer(
+            persistentCapacity() * _elementSize,
+            _type,
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT,
+            _debugName);
+    }
+    else
+    {
+        _buffer = OpenGLBuffer(_ring.capacity() * _elementSize, _type, GL_STREAM_DRAW, nullptr, _debugName);
+    }
+}
+
+u32 OpenGLStreamBuffer::persistentCapacity() const
+{
+    return _ring.capacity() * maxFramesInFlight;
+}
+
+void OpenGLStreamBuffer::endSegment()
+{
+    if (_head == _segmentBegin)
+    {
+        return;
+    }
+
+    _segments.add(
+        Segment{
+            .begin = _segmentBegin,
+            .end   = _head,
+            .fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0),
+        });
+
+    _segmentBegin = _head;
+}
+
+void OpenGLStreamBuffer::waitForSegmentsOverlapping(u32 begin, u32 end)
+{
+    auto newestOverlappingIndex = Maybe<u32>();
+
+    for (auto i = 0u; i < _segments.size(); ++i)
+    {
+        if (_segments[i].begin < end and begin < _segments[i].end)
+        {
+            newestOverlappingIndex = i;
+        }
+    }
+
+    if (not newestOverlappingIndex)
+    {
+        return;
+    }
+
+    // Fences are signaled in submission order, so all older segments are done as well.
+    waitForFence(_segments[*newestOverlappingIndex].fence);
+
+    for (auto i = 0u; i < *newestOverlappingIndex; ++i)
+    {
+        glDeleteSync(_segments.first().fence);
+        _segments.removeFirst();
+    }
+
+    _segments.removeFirst();
+}
+
+void OpenGLStreamBuffer::releaseSignaledSegments()
+{
+    while (not _segments.isEmpty())
+    {
+        const auto result = glClientWaitSync(_segments.first().fence, 0, 0);
+
+        if (result != GL_ALREADY_SIGNALED and result != GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+
+        glDeleteSync(_segments.first().fence);
+        _segments.removeFirst();
+    }
+}
+
+void OpenGLStreamBuffer::destroyFences()
+{
+    for (const auto& segment : _segments)
+    {
+        glDeleteSync(segment.fence);
+    }
+
+    _segments.clear();
+}
+} // namespace Polly
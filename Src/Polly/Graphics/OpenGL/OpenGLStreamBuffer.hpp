@@ -0,0 +1,111 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/DynamicBufferRing.hpp"
+#include "Polly/Graphics/OpenGL/OpenGLBuffer.hpp"
+#include "Polly/List.hpp"
+#include "Polly/String.hpp"
+
+namespace Polly
+{
+// A dynamic vertex or index buffer that the painter streams data into during a frame.
+//
+// If the system supports immutable buffer storage (OpenGL 4.4 or GL_ARB_buffer_storage), the
+// buffer is mapped persistently and coherently once, with room for the data of several frames.
+// Writing to it then doesn't involve the driver at all. Writes go around the buffer as a ring,
+// and are grouped into segments that end at a frame boundary or a wrap-around. Each segment is
+// fenced when it ends, and before a range is written to again, only the segments that overlap
+// it are waited on. These are the oldest ones, which the GPU has usually finished already.
+//
+// Otherwise, each write maps its range via glMapBufferRange. The first range of a frame and ranges
+// after a wrap-around invalidate the buffer, and all other ranges are mapped unsynchronized, since
+// no draw call of the frame reads from them yet.
+//
+// All counts and offsets are in elements (vertices or indices), not bytes.
+class OpenGLStreamBuffer final
+{
+  public:
+    struct Mapping
+    {
+        void* data   = nullptr;
+        u32   offset = 0;
+    };
+
+    OpenGLStreamBuffer() = default;
+
+    explicit OpenGLStreamBuffer(
+        GLenum     type,
+        u32        elementSize,
+        u32        capacity,
+        bool       isPersistentlyMapped,
+        StringView debugName);
+
+    DeleteCopy(OpenGLStreamBuffer);
+
+    OpenGLStreamBuffer(OpenGLStreamBuffer&& moveFrom) noexcept;
+
+    OpenGLStreamBuffer& operator=(OpenGLStreamBuffer&& moveFrom) noexcept;
+
+    ~OpenGLStreamBuffer() noexcept;
+
+    GLuint handleGL() const;
+
+    bool isPersistentlyMapped() const;
+
+    // The largest number of elements that was written to the buffer within a single frame.
+    u32 highWaterMark() const;
+
+    // Starts a new frame. Returns true if the buffer had to grow, in which case it was recreated
+    // and objects that refer to it (such as VAOs) have to be recreated as well.
+    [[nodiscard]]
+    bool startFrame();
+
+    // Called after the last draw call of a frame that reads from the buffer.
+    void endFrame();
+
+    // Reserves room for count elements and returns where to write them. The offset is relative
+    // to the start of the buffer and is what draw calls use to refer to the elements.
+    // The buffer must be bound, and every map() has to be followed by an unmap().
+    [[nodiscard]]
+    Mapping map(u32 count);
+
+    void unmap();
+
+  private:
+    // The number of frames the driver may queue up before it blocks a swap.
+    static constexpr auto maxFramesInFlight = 3u;
+
+    // A range of the persistently mapped buffer that draw calls may still read from.
+    struct Segment
+    {
+        u32    begin = 0;
+        u32    end   = 0;
+        GLsync fence = nullptr;
+    };
+
+    void createBuffer();
+
+    u32 persistentCapacity() const;
+
+    void endSegment();
+
+    void waitForSegmentsOverlapping(u32 begin, u32 end);
+
+    void releaseSignaledSegments();
+
+    void destroyFences();
+
+    GLenum                               _type                 = 0;
+    u32                                  _elementSize          = 0;
+    bool                                 _isPersistentlyMapped = false;
+    String                               _debugName;
+    DynamicBufferRing                    _ring;
+    OpenGLBuffer                         _buffer;
+    u32                                  _head                 = 0;
+    u32                                  _segmentBegin         = 0;
+    List<Segment, 2 * maxFramesInFlight> _segments;
+};
+} // namespace Polly
@@ -12,9 +12,10 @@ namespace Polly
 {
 struct VertexElementInfo
 {
-    u32    componentCount = 0;
-    u32    sizeInBytes    = 0;
-    GLenum type           = 0;
+    u32       componentCount = 0;
+    u32       sizeInBytes    = 0;
+    GLenum    type           = 0;
+    GLboolean isNormalized   = GL_FALSE;
 };
 
 static Maybe<VertexElementInfo> vertexElementInfo(VertexElement element)
@@ -51,6 +52,13 @@ static Maybe<VertexElementInfo> vertexElementInfo(VertexElement element)
                 .sizeInBytes    = sizeof(float) * 4,
                 .type           = GL_FLOAT,
             };
+        case VertexElement::UByte4Normalized:
+            return VertexElementInfo{
+                .componentCount = 4,
+                .sizeInBytes    = sizeof(u8) * 4,
+                .type           = GL_UNSIGNED_BYTE,
+                .isNormalized   = GL_TRUE,
+            };
     }
 
     return none;
@@ -60,11 +68,13 @@ OpenGLVAO::OpenGLVAO(
     GLuint              vertexBufferHandleGL,
     GLuint              indexBufferHandleGL,
     Span<VertexElement> vertexElements,
-    StringView          debugName)
+    StringView          debugName,
+    bool                isPerInstance)
+    : _vertexElements(vertexElements)
+    , _isPerInstance(isPerInstance)
 #ifndef NDEBUG
-    : _vertexBufferHandleGL(vertexBufferHandleGL)
+    , _vertexBufferHandleGL(vertexBufferHandleGL)
     , _indexBufferHandleGL(indexBufferHandleGL)
-    , _vertexElements(vertexElements)
 #endif
 {
     assume(vertexBufferHandleGL != 0);
@@ -104,28 +114,16 @@ OpenGLVAO::OpenGLVAO(
 
     glBindBuffer(GL_ARRAY_BUFFER, vertexBufferHandleGL);
 
-    auto vertexStride = u32();
-    for (const auto element : vertexElements)
-    {
-        vertexStride += vertexElementInfo(element)->sizeInBytes;
-    }
+    specifyVertexAttributes(0);
 
-    for (auto index = 0u, offset = 0u; const auto element : vertexElements)
+    for (auto index = 0u; index < vertexElements.size(); ++index)
     {
-        const auto elementInfo = *vertexElementInfo(element);
-
-        glVertexAttribPointer(
-            index,
-            narrow<GLint>(elementInfo.componentCount),
-            elementInfo.type,
-            GL_FALSE,
-            vertexStride,
-            reinterpret_cast<const void*>(static_cast<uintptr_t>(offset)));
-
         glEnableVertexAttribArray(static_cast<GLuint>(index));
 
-        ++index;
-        offset += elementInfo.sizeInBytes;
+        if (isPerInstance)
+        {
+            glVertexAttribDivisor(static_cast<GLuint>(index), 1);
+        }
     }
 
     if (indexBufferHandleGL != 0)
@@ -140,10 +138,11 @@ OpenGLVAO::OpenGLVAO(
 
 OpenGLVAO::OpenGLVAO(OpenGLVAO&& moveFrom) noexcept
     : _handleGL(std::exchange(moveFrom._handleGL, 0))
+    , _vertexElements(moveFrom._vertexElements)
+    , _isPerInstance(moveFrom._isPerInstance)
 #ifndef NDEBUG
     , _vertexBufferHandleGL(moveFrom._vertexBufferHandleGL)
     , _indexBufferHandleGL(moveFrom._indexBufferHandleGL)
-    , _vertexElements(moveFrom._vertexElements)
 #endif
 {
 }
@@ -154,12 +153,13 @@ OpenGLVAO& OpenGLVAO::operator=(OpenGLVAO&& moveFrom) noexcept
     {
         destroy();
 
-        _handleGL = std::exchange(moveFrom._handleGL, 0);
+        _handleGL       = std::exchange(moveFrom._handleGL, 0);
+        _vertexElements = moveFrom._vertexElements;
+        _isPerInstance  = moveFrom._isPerInstance;
 
 #ifndef NDEBUG
         _vertexBufferHandleGL = moveFrom._vertexBufferHandleGL;
         _indexBufferHandleGL  = moveFrom._indexBufferHandleGL;
-        _vertexElements       = moveFrom._vertexElements;
 #endif
     }
 
@@ -176,6 +176,42 @@ GLuint OpenGLVAO::handleGL() const
     return _handleGL;
 }
 
+void OpenGLVAO::setVertexBufferOffset(u32 offset)
+{
+#ifndef NDEBUG
+    auto boundVAO = GLint();
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &boundVAO);
+    assume(GLuint(boundVAO) == _handleGL);
+#endif
+
+    specifyVertexAttributes(offset);
+}
+
+void OpenGLVAO::specifyVertexAttributes(u32 baseOffset)
+{
+    auto vertexStride = u32();
+    for (const auto element : _vertexElements)
+    {
+        vertexStride += vertexElementInfo(element)->sizeInBytes;
+    }
+
+    for (auto index = 0u, offset = baseOffset; const auto element : _vertexElements)
+    {
+        const auto elementInfo = *vertexElementInfo(element);
+
+        glVertexAttribPointer(
+            index,
+            narrow<GLint>(elementInfo.componentCount),
+            elementInfo.type,
+            elementInfo.isNormalized,
+            vertexStride,
+            reinterpret_cast<const void*>(static_cast<uintptr_t>(offset)));
+
+        ++index;
+        offset += elementInfo.sizeInBytes;
+    }
+}
+
 void OpenGLVAO::destroy()
 {
     if (_handleGL != 0)
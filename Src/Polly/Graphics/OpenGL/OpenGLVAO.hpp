@@ -5,11 +5,8 @@
 #pragma once
 
 #include "Polly/Graphics/OpenGL/OpenGLPrerequisites.hpp"
-#include "Polly/Span.hpp"
-
-#ifndef NDEBUG
 #include "Polly/List.hpp"
-#endif
+#include "Polly/Span.hpp"
 
 namespace Polly
 {
@@ -20,11 +17,13 @@ class OpenGLVAO final
   public:
     OpenGLVAO() = default;
 
+    // If isPerInstance is true, the vertex elements advance once per instance instead of once per vertex.
     OpenGLVAO(
         GLuint              vertexBufferHandleGL,
         GLuint              indexBufferHandleGL,
         Span<VertexElement> vertexElements,
-        StringView          debugName);
+        StringView          debugName,
+        bool                isPerInstance = false);
 
     DeleteCopy(OpenGLVAO);
 
@@ -36,15 +35,23 @@ class OpenGLVAO final
 
     GLuint handleGL() const;
 
+    // Lets the vertex elements start at a byte offset into the vertex buffer.
+    // This is how instanced draws select their first instance, since OpenGL 3.3 has no base instance.
+    // The VAO and its vertex buffer must be bound.
+    void setVertexBufferOffset(u32 offset);
+
   private:
+    void specifyVertexAttributes(u32 baseOffset);
+
     void destroy();
 
-    GLuint _handleGL = 0;
+    GLuint                 _handleGL = 0;
+    List<VertexElement, 4> _vertexElements;
+    bool                   _isPerInstance = false;
 
 #ifndef NDEBUG
-    GLuint                 _vertexBufferHandleGL = 0;
-    GLuint                 _indexBufferHandleGL  = 0;
-    List<VertexElement, 4> _vertexElements;
+    GLuint _vertexBufferHandleGL = 0;
+    GLuint _indexBufferHandleGL  = 0;
 #endif
 };
 } // namespace Polly
@@ -0,0 +1,35 @@
+#version 330
+
+layout (std140) uniform Constants
+{
+    mat4 transformation;
+};
+
+// One instance per sprite, see SpriteInstance.
+layout (location = 0) in vec4 vsin_dst;
+layout (location = 1) in vec4 vsin_src;
+layout (location = 2) in vec4 vsin_color;
+layout (location = 3) in vec4 vsin_originRotationAndImageSlot;
+
+out vec4 pl_v2f_color;
+out vec2 pl_v2f_uv;
+flat out float pl_v2f_imageSlot;
+
+void main()
+{
+    // The quad is drawn as a triangle strip with the corners (0, 0), (1, 0), (0, 1) and (1, 1).
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+
+    vec2 origin = vsin_originRotationAndImageSlot.xy;
+    float rotation = vsin_originRotationAndImageSlot.z;
+    float s = sin(rotation);
+    float c = cos(rotation);
+
+    vec2 offset = (corner - origin) * vsin_dst.zw;
+    vec2 position = vsin_dst.xy + (offset.x * vec2(c, s)) + (offset.y * vec2(-s, c));
+
+    gl_Position = transformation * vec4(position, 0, 1);
+    pl_v2f_color = vsin_color;
+    pl_v2f_uv = vsin_src.xy + (corner * vsin_src.zw);
+    pl_v2f_imageSlot = vsin_originRotationAndImageSlot.w;
+}
@@ -4,9 +4,12 @@
 
 #include "Polly/Defer.hpp"
 #include "Polly/Direction.hpp"
+#include "Polly/DrawStateCombination.hpp"
 #include "Polly/Font.hpp"
 #include "Polly/Game/GameImpl.hpp"
+#include "Polly/Graphics/PainterCommandListImpl.hpp"
 #include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Graphics/StaticSpriteBatchImpl.hpp"
 #include "Polly/Image.hpp"
 #include "Polly/ParticleSystem.hpp"
 #include "Polly/Spine.hpp"
@@ -122,6 +125,48 @@ void Painter::setBlendState(BlendState blendState)
     impl->setBlendState(blendState);
 }
 
+void Painter::beginDeferredDrawing()
+{
+    PollyDeclareThisImpl;
+    impl->beginDeferredDrawing();
+}
+
+void Painter::submitDeferredDrawing()
+{
+    PollyDeclareThisImpl;
+    impl->submitDeferredDrawing();
+}
+
+bool Painter::isDrawingDeferred() const
+{
+    PollyDeclareThisImpl;
+    return impl->isDrawingDeferred();
+}
+
+u8 Painter::drawLayer() const
+{
+    PollyDeclareThisImpl;
+    return impl->drawLayer();
+}
+
+void Painter::setDrawLayer(u8 layer)
+{
+    PollyDeclareThisImpl;
+    impl->setDrawLayer(layer);
+}
+
+DistanceFieldTextStyle Painter::distanceFieldTextStyle() const
+{
+    PollyDeclareThisImpl;
+    return impl->distanceFieldTextStyle();
+}
+
+void Painter::setDistanceFieldTextStyle(const DistanceFieldTextStyle& style)
+{
+    PollyDeclareThisImpl;
+    impl->setDistanceFieldTextStyle(style);
+}
+
 void Painter::drawSprite(Image image, Vec2 position, Color color)
 {
     if (!image)
@@ -166,6 +211,116 @@ void Painter::drawSprites(Span<Sprite> sprites)
     }
 }
 
+void Painter::drawStaticSpriteBatch(StaticSpriteBatch batch)
+{
+    if (!batch)
+    {
+        return;
+    }
+
+    PollyDeclareThisImpl;
+    impl->drawStaticSpriteBatch(*batch.impl());
+}
+
+void Painter::submitCommandList(const CommandList& list)
+{
+    using CommandType = CommandList::Impl::CommandType;
+
+    PollyDeclareThisImpl;
+
+    const auto& listImpl = *list.impl();
+
+    // Command lists don't reference the objects they store, so that they can be recorded on
+    // any thread. Now that we're on the main thread, it's safe to reference them again.
+    // The objects themselves are never modified.
+    const auto toImage = [](const Image::Impl* image) { return Image(const_cast<Image::Impl*>(image)); };
+    const auto toFont  = [](const Font::Impl* font) { return Font(const_cast<Font::Impl*>(font)); };
+    const auto toText  = [](const Text::Impl* text) { return Text(const_cast<Text::Impl*>(text)); };
+
+    const auto drawSprites = [&](Span<CommandList::Impl::RecordedSprite> sprites)
+    {
+        impl->prepareForMultipleSprites();
+
+        // Consecutive sprites usually share the same image.
+        auto image = Image();
+
+        for (const auto& sprite : sprites)
+        {
+            if (sprite.image != image.impl())
+            {
+                image = toImage(sprite.image);
+            }
+
+            impl->drawSprite<true, false, true>(Sprite{
+                .image    = image,
+                .dstRect  = sprite.dstRect,
+                .srcRect  = sprite.srcRect,
+                .color    = sprite.color,
+                .rotation = sprite.rotation,
+                .origin   = sprite.origin,
+                .flip     = sprite.flip,
+            });
+        }
+    };
+
+    const auto drawCommand = [&](const CommandList::Impl::Command& command)
+    {
+        switch (command.type)
+        {
+            // Sprites are passed to drawSprites().
+            case CommandType::Sprites: break;
+            case CommandType::String:
+                drawString(
+                    listImpl.chars(command.offset, command.count),
+                    toFont(command.font),
+                    command.fontSize,
+                    command.position,
+                    command.color,
+                    command.decoration);
+                break;
+            case CommandType::Text: drawText(toText(command.text), command.position, command.color); break;
+            case CommandType::Line:
+                drawLine(command.position, command.size, command.color, command.strokeWidth);
+                break;
+            case CommandType::Rectangle:
+                drawRectangle(command.rectangle, command.color, command.strokeWidth);
+                break;
+            case CommandType::FillRectangle: fillRectangle(command.rectangle, command.color); break;
+            case CommandType::RoundedRectangle:
+                drawRoundedRectangle(
+                    command.rectangle,
+                    command.cornerRadius,
+                    command.color,
+                    command.strokeWidth);
+                break;
+            case CommandType::FillRoundedRectangle:
+                fillRoundedRectangle(command.rectangle, command.cornerRadius, command.color);
+                break;
+            case CommandType::Ellipse:
+                drawEllipse(command.position, command.size, command.color, command.strokeWidth);
+                break;
+            case CommandType::FillEllipse: fillEllipse(command.position, command.size, command.color); break;
+            case CommandType::Polygon:
+                drawPolygon(
+                    listImpl.polygonVertices(command.offset, command.count),
+                    command.color,
+                    command.strokeWidth);
+                break;
+            case CommandType::FillPolygon:
+                fillPolygon(listImpl.polygonVertices(command.offset, command.count), command.color);
+                break;
+            case CommandType::Mesh:
+                drawMesh(
+                    listImpl.meshVertices(command.offset, command.count),
+                    listImpl.meshIndices(command.indexOffset, command.indexCount),
+                    toImage(command.image));
+                break;
+        }
+    };
+
+    listImpl.replay(drawSprites, drawCommand);
+}
+
 void Painter::drawString(
     StringView            text,
     Font                  font,
@@ -196,23 +351,25 @@ void Painter::drawStringWithBasicShadow(
         impl->setShader(BatchMode::Sprites, shader);
     };
 
-    auto& tmpGlyphs          = impl->tmpGlyphs;
-    auto& tmpDecorationRects = impl->tmpDecorationRects;
-
     // This is the same as Painter::pushStringToQueue().
     // But instead of calling it twice (and therefore shaping the text twice),
     // we shape the text once here.
-    shapeText(text, font, fontSize, decoration, tmpGlyphs, tmpDecorationRects);
-
-    const auto pixelRatio = impl->pixelRatio();
+    const auto& shapedText = impl->shapeString(text, font, fontSize, decoration);
+    const auto  pixelRatio = impl->pixelRatio();
 
     impl->doInternalPushTextToQueue(
-        tmpGlyphs,
-        tmpDecorationRects,
+        shapedText.glyphs,
+        shapedText.decorationRects,
         position + Vec2(pixelRatio),
-        black.withAlpha(color.a));
+        black.withAlpha(color.a),
+        shapedText.distanceFieldScale);
 
-    impl->doInternalPushTextToQueue(tmpGlyphs, tmpDecorationRects, position, color);
+    impl->doInternalPushTextToQueue(
+        shapedText.glyphs,
+        shapedText.decorationRects,
+        position,
+        color,
+        shapedText.distanceFieldScale);
 }
 
 void Painter::drawText(Text text, Vec2 position, Color color)
@@ -463,9 +620,32 @@ PainterCapabilities Painter::capabilities() const
     return impl->capabilities();
 }
 
+ImageAtlasStats Painter::imageAtlasStats() const
+{
+    PollyDeclareThisImpl;
+    const auto* atlas = impl->imageAtlas();
+    return atlas ? atlas->stats() : ImageAtlasStats();
+}
+
+void Painter::prepareDrawStates(Span<DrawStateCombination> combinations)
+{
+    for (const auto& combination : combinations)
+    {
+        if (combination.shader and combination.shader.impl()->shaderType() != combination.objectType)
+        {
+            throw Error("The shader of a draw state combination doesn't match its kind of object.");
+        }
+    }
+
+    PollyDeclareThisImpl;
+    impl->prepareDrawStates(combinations);
+}
+
 StringView Painter::backendName()
 {
-#ifdef __APPLE__
+#if defined(polly_have_gfx_software)
+    return "Software";
+#elif defined(__APPLE__)
     return "Metal";
 #else
     return "Vulkan";
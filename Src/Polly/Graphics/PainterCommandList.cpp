@@ -0,0 +1,356 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/PainterCommandList.hpp"
+
+#include "Polly/Graphics/PainterCommandListImpl.hpp"
+
+namespace Polly
+{
+using CommandType = Painter::CommandList::Impl::CommandType;
+using Command     = Painter::CommandList::Impl::Command;
+
+Painter::CommandList::CommandList()
+    : _impl(makeUnique<Impl>())
+{
+}
+
+Painter::CommandList::CommandList(CommandList&&) noexcept = default;
+
+Painter::CommandList& Painter::CommandList::operator=(CommandList&&) noexcept = default;
+
+Painter::CommandList::~CommandList() noexcept = default;
+
+void Painter::CommandList::drawSprite(const Image& image, Vec2 position, Color color)
+{
+    if (not image)
+    {
+        return;
+    }
+
+    _impl->addSprite(Impl::RecordedSprite{
+        .image   = image.impl(),
+        .dstRect = Rectangle(position, image.size()),
+        .color   = color,
+    });
+}
+
+void Painter::CommandList::drawSprite(
+    const Image&     image,
+    Rectangle        dstRect,
+    Maybe<Rectangle> srcRect,
+    Color            color,
+    Radians          rotation,
+    Vec2             origin,
+    SpriteFlip       flip)
+{
+    if (not image)
+    {
+        return;
+    }
+
+    _impl->addSprite(Impl::RecordedSprite{
+        .image    = image.impl(),
+        .dstRect  = dstRect,
+        .srcRect  = srcRect,
+        .color    = color,
+        .rotation = rotation,
+        .origin   = origin,
+        .flip     = flip,
+    });
+}
+
+void Painter::CommandList::drawSprite(const Sprite& sprite)
+{
+    if (sprite.image)
+    {
+        _impl->addSprite(sprite);
+    }
+}
+
+void Painter::CommandList::drawSprites(Span<Sprite> sprites)
+{
+    for (const auto& sprite : sprites)
+    {
+        if (sprite.image)
+        {
+            _impl->addSprite(sprite);
+        }
+    }
+}
+
+void Painter::CommandList::drawString(
+    StringView            text,
+    const Font&           font,
+    float                 fontSize,
+    Vec2                  position,
+    Color                 color,
+    Maybe<TextDecoration> decoration)
+{
+    if (text.isEmpty() or not font)
+    {
+        return;
+    }
+
+    const auto offset = _impl->addChars(text);
+
+    _impl->addCommand(Command{
+        .type       = CommandType::String,
+        .offset     = offset,
+        .count      = text.size(),
+        .font       = font.impl(),
+        .position   = position,
+        .color      = color,
+        .fontSize   = fontSize,
+        .decoration = decoration,
+    });
+}
+
+void Painter::CommandList::drawText(const Text& text, Vec2 position, Color color)
+{
+    if (not text)
+    {
+        return;
+    }
+
+    _impl->addCommand(Command{
+        .type     = CommandType::Text,
+        .text     = text.impl(),
+        .position = position,
+        .color    = color,
+    });
+}
+
+void Painter::CommandList::drawLine(Vec2 start, Vec2 end, Color color, float strokeWidth)
+{
+    _impl->addCommand(Command{
+        .type        = CommandType::Line,
+        .position    = start,
+        .size        = end,
+        .color       = color,
+        .strokeWidth = strokeWidth,
+    });
+}
+
+void Painter::CommandList::drawRectangle(Rectangle rectangle, Color color, float strokeWidth)
+{
+    _impl->addCommand(Command{
+        .type        = CommandType::Rectangle,
+        .rectangle   = rectangle,
+        .color       = color,
+        .strokeWidth = strokeWidth,
+    });
+}
+
+void Painter::CommandList::fillRectangle(Rectangle rectangle, Color color)
+{
+    _impl->addCommand(Command{
+        .type      = CommandType::FillRectangle,
+        .rectangle = rectangle,
+        .color     = color,
+    });
+}
+
+void Painter::CommandList::drawRoundedRectangle(
+    Rectangle rectangle,
+    float     cornerRadius,
+    Color     color,
+    float     strokeWidth)
+{
+    _impl->addCommand(Command{
+        .type         = CommandType::RoundedRectangle,
+        .rectangle    = rectangle,
+        .color        = color,
+        .strokeWidth  = strokeWidth,
+        .cornerRadius = cornerRadius,
+    });
+}
+
+void Painter::CommandList::fillRoundedRectangle(Rectangle rectangle, float cornerRadius, Color color)
+{
+    _impl->addCommand(Command{
+        .type         = CommandType::FillRoundedRectangle,
+        .rectangle    = rectangle,
+        .color        = color,
+        .cornerRadius = cornerRadius,
+    });
+}
+
+void Painter::CommandList::drawEllipse(Vec2 center, Vec2 radius, Color color, float strokeWidth)
+{
+    _impl->addCommand(Command{
+        .type        = CommandType::Ellipse,
+        .position    = center,
+        .size        = radius,
+        .color       = color,
+        .strokeWidth = strokeWidth,
+    });
+}
+
+void Painter::CommandList::fillEllipse(Vec2 center, Vec2 radius, Color color)
+{
+    _impl->addCommand(Command{
+        .type     = CommandType::FillEllipse,
+        .position = center,
+        .size     = radius,
+        .color    = color,
+    });
+}
+
+void Painter::CommandList::drawPolygon(Span<Vec2> vertices, Color color, float strokeWidth)
+{
+    if (vertices.isEmpty())
+    {
+        return;
+    }
+
+    _impl->addCommand(Command{
+        .type        = CommandType::Polygon,
+        .offset      = _impl->addPolygonVertices(vertices),
+        .count       = vertices.size(),
+        .color       = color,
+        .strokeWidth = strokeWidth,
+    });
+}
+
+void Painter::CommandList::fillPolygon(Span<Vec2> vertices, Color color)
+{
+    if (vertices.isEmpty())
+    {
+        return;
+    }
+
+    _impl->addCommand(Command{
+        .type   = CommandType::FillPolygon,
+        .offset = _impl->addPolygonVertices(vertices),
+        .count  = vertices.size(),
+        .color  = color,
+    });
+}
+
+void Painter::CommandList::drawMesh(Span<MeshVertex> vertices, Span<uint16_t> indices, const Image& image)
+{
+    if (vertices.isEmpty() or indices.isEmpty())
+    {
+        return;
+    }
+
+    const auto offsets = _impl->addMeshData(vertices, indices);
+
+    _impl->addCommand(Command{
+        .type        = CommandType::Mesh,
+        .offset      = offsets.first,
+        .count       = vertices.size(),
+        .indexOffset = offsets.second,
+        .indexCount  = indices.size(),
+        .image       = image.impl(),
+    });
+}
+
+bool Painter::CommandList::isEmpty() const
+{
+    return _impl->isEmpty();
+}
+
+void Painter::CommandList::clear()
+{
+    _impl->clear();
+}
+
+void Painter::CommandList::Impl::addSprite(const Sprite& sprite)
+{
+    addSprite(RecordedSprite{
+        .image    = sprite.image.impl(),
+        .dstRect  = sprite.dstRect,
+        .srcRect  = sprite.srcRect,
+        .color    = sprite.color,
+        .rotation = sprite.rotation,
+        .origin   = sprite.origin,
+        .flip     = sprite.flip,
+    });
+}
+
+void Painter::CommandList::Impl::addSprite(const RecordedSprite& sprite)
+{
+    // Consecutive sprites are merged into a single command.
+    if (not _commands.isEmpty() and _commands.last().type == CommandType::Sprites)
+    {
+        ++_commands.last().count;
+    }
+    else
+    {
+        _commands.add(Command{
+            .type   = CommandType::Sprites,
+            .offset = _sprites.size(),
+            .count  = 1,
+        });
+    }
+
+    _sprites.add(sprite);
+}
+
+void Painter::CommandList::Impl::addCommand(const Command& command)
+{
+    _commands.add(command);
+}
+
+u32 Painter::CommandList::Impl::addChars(StringView chars)
+{
+    const auto offset = _chars.size();
+
+    _chars.reserve(offset + chars.size());
+
+    for (const auto ch : chars)
+    {
+        _chars.add(ch);
+    }
+
+    return offset;
+}
+
+u32 Painter::CommandList::Impl::addPolygonVertices(Span<Vec2> vertices)
+{
+    const auto offset = _polygonVertices.size();
+
+    _polygonVertices.reserve(offset + vertices.size());
+
+    for (const auto& vertex : vertices)
+    {
+        _polygonVertices.add(vertex);
+    }
+
+    return offset;
+}
+
+Pair<u32, u32> Painter::CommandList::Impl::addMeshData(Span<MeshVertex> vertices, Span<uint16_t> indices)
+{
+    const auto vertexOffset = _meshVertices.size();
+    const auto indexOffset  = _meshIndices.size();
+
+    _meshVertices.reserve(vertexOffset + vertices.size());
+    _meshIndices.reserve(indexOffset + indices.size());
+
+    for (const auto& vertex : vertices)
+    {
+        _meshVertices.add(vertex);
+    }
+
+    for (const auto index : indices)
+    {
+        _meshIndices.add(index);
+    }
+
+    return Pair(vertexOffset, indexOffset);
+}
+
+void Painter::CommandList::Impl::clear()
+{
+    _commands.clear();
+    _sprites.clear();
+    _chars.clear();
+    _polygonVertices.clear();
+    _meshVertices.clear();
+    _meshIndices.clear();
+}
+} // namespace Polly
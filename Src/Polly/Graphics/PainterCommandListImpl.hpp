@@ -0,0 +1,150 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Font.hpp"
+#include "Polly/Image.hpp"
+#include "Polly/List.hpp"
+#include "Polly/PainterCommandList.hpp"
+#include "Polly/Pair.hpp"
+#include "Polly/Radians.hpp"
+#include "Polly/Sprite.hpp"
+#include "Polly/Text.hpp"
+
+namespace Polly
+{
+// The recorded commands only store raw pointers to the implementations of the objects they
+// reference, so that recording never modifies a reference count. The objects are turned back
+// into regular objects when the list is submitted on the main thread.
+class Painter::CommandList::Impl final
+{
+  public:
+    enum class CommandType : u8
+    {
+        Sprites,
+        String,
+        Text,
+        Line,
+        Rectangle,
+        FillRectangle,
+        RoundedRectangle,
+        FillRoundedRectangle,
+        Ellipse,
+        FillEllipse,
+        Polygon,
+        FillPolygon,
+        Mesh,
+    };
+
+    struct RecordedSprite
+    {
+        const Image::Impl* image    = nullptr;
+        Rectangle          dstRect  = Rectangle();
+        Maybe<Rectangle>   srcRect  = none;
+        Color              color    = white;
+        Radians            rotation = Radians(0);
+        Vec2               origin   = Vec2(0, 0);
+        SpriteFlip         flip     = SpriteFlip::None;
+    };
+
+    // Depending on the type, offset and count refer to a range of sprites, characters,
+    // polygon vertices or mesh vertices.
+    struct Command
+    {
+        CommandType           type         = CommandType::Sprites;
+        u32                   offset       = 0;
+        u32                   count        = 0;
+        u32                   indexOffset  = 0;
+        u32                   indexCount   = 0;
+        const Image::Impl*    image        = nullptr;
+        const Font::Impl*     font         = nullptr;
+        const Text::Impl*     text         = nullptr;
+        Rectangle             rectangle    = Rectangle();
+        Vec2                  position     = Vec2(0, 0);
+        Vec2                  size         = Vec2(0, 0);
+        Color                 color        = white;
+        float                 strokeWidth  = 0.0f;
+        float                 fontSize     = 0.0f;
+        float                 cornerRadius = 0.0f;
+        Maybe<TextDecoration> decoration   = none;
+    };
+
+    void addSprite(const Sprite& sprite);
+
+    void addSprite(const RecordedSprite& sprite);
+
+    void addCommand(const Command& command);
+
+    u32 addChars(StringView chars);
+
+    u32 addPolygonVertices(Span<Vec2> vertices);
+
+    // Returns the offset of the first vertex and the offset of the first index.
+    Pair<u32, u32> addMeshData(Span<MeshVertex> vertices, Span<uint16_t> indices);
+
+    Span<Command> commands() const
+    {
+        return _commands;
+    }
+
+    Span<RecordedSprite> sprites() const
+    {
+        return _sprites;
+    }
+
+    StringView chars(u32 offset, u32 count) const
+    {
+        return StringView(_chars.data() + offset, count);
+    }
+
+    Span<Vec2> polygonVertices(u32 offset, u32 count) const
+    {
+        return Span<Vec2>(_polygonVertices.data() + offset, count);
+    }
+
+    Span<MeshVertex> meshVertices(u32 offset, u32 count) const
+    {
+        return Span<MeshVertex>(_meshVertices.data() + offset, count);
+    }
+
+    Span<uint16_t> meshIndices(u32 offset, u32 count) const
+    {
+        return Span<uint16_t>(_meshIndices.data() + offset, count);
+    }
+
+    bool isEmpty() const
+    {
+        return _commands.isEmpty();
+    }
+
+    // Visits the recorded commands in the order they were recorded. Consecutive sprites are
+    // passed to drawSprites() as a single range, all other commands to drawCommand().
+    template<typename DrawSpritesFunc, typename DrawCommandFunc>
+    void replay(const DrawSpritesFunc& drawSprites, const DrawCommandFunc& drawCommand) const
+    {
+        for (const auto& command : _commands)
+        {
+            if (command.type == CommandType::Sprites)
+            {
+                drawSprites(sprites().subspan(command.offset, command.count));
+            }
+            else
+            {
+                drawCommand(command);
+            }
+        }
+    }
+
+    void clear();
+
+  private:
+    List<Command>        _commands;
+    List<RecordedSprite> _sprites;
+    List<char>           _chars;
+    List<Vec2>           _polygonVertices;
+    List<MeshVertex>     _meshVertices;
+    List<uint16_t>       _meshIndices;
+};
+} // namespace Polly
@@ -5,7 +5,6 @@
 #include "Polly/Graphics/PainterImpl.hpp"
 
 #include "Polly/Array.hpp"
-#include "Polly/Core/Casting.hpp"
 #include "Polly/Core/LoggingInternals.hpp"
 #include "Polly/Defer.hpp"
 #include "Polly/Font.hpp"
@@ -15,6 +14,7 @@
 #include "Polly/Graphics/GraphicsResource.hpp"
 #include "Polly/Graphics/ImageImpl.hpp"
 #include "Polly/Graphics/ParticleSystemImpl.hpp"
+#include "Polly/Graphics/PrecompiledShader.hpp"
 #include "Polly/Graphics/ShaderImpl.hpp"
 #include "Polly/Graphics/Tessellation2D.hpp"
 #include "Polly/Graphics/TextImpl.hpp"
@@ -22,11 +22,9 @@
 #include "Polly/ImGui.hpp"
 #include "Polly/Logging.hpp"
 #include "Polly/ParticleSystem.hpp"
+#include "Polly/Profiler.hpp"
 #include "Polly/ShaderCompiler/Ast.hpp"
-#include "Polly/ShaderCompiler/CBufferPacker.hpp"
 #include "Polly/ShaderCompiler/Decl.hpp"
-#include "Polly/ShaderCompiler/Naming.hpp"
-#include "Polly/ShaderCompiler/ShaderGenerator.hpp"
 #include "Polly/ShaderCompiler/Transformer.hpp"
 #include "Polly/ShaderCompiler/Type.hpp"
 #include "Polly/Spine.hpp"
@@ -36,6 +34,8 @@
 #include "MeshShaderDefault.shd.hpp"
 #include "PolyShaderDefault.shd.hpp"
 #include "SpriteShaderDefault.shd.hpp"
+#include "SpriteShaderDistanceField.shd.hpp"
+#include <chrono>
 
 namespace Polly
 {
@@ -91,71 +91,11 @@ Painter::Impl::Impl(Window::Impl& windowImpl, GamePerformanceStats& performanceS
     ShaderCompiler::Type::createPrimitiveTypes();
 }
 
-static ShaderParameterType convertShdTypeToParamType(const ShaderCompiler::Type* type)
+UniquePtr<Image::Impl> Painter::Impl::createAlphaCoverageImage(
+    [[maybe_unused]] u32 width,
+    [[maybe_unused]] u32 height)
 {
-    if (type == ShaderCompiler::IntType::instance())
-    {
-        return ShaderParameterType::Int;
-    }
-    else if (type == ShaderCompiler::FloatType::instance())
-    {
-        return ShaderParameterType::Float;
-    }
-    else if (type == ShaderCompiler::BoolType::instance())
-    {
-        return ShaderParameterType::Bool;
-    }
-    else if (type == ShaderCompiler::Vec2Type::instance())
-    {
-        return ShaderParameterType::Vec2;
-    }
-    else if (type == ShaderCompiler::Vec3Type::instance())
-    {
-        return ShaderParameterType::Vec3;
-    }
-    else if (type == ShaderCompiler::Vec4Type::instance())
-    {
-        return ShaderParameterType::Vec4;
-    }
-    else if (type == ShaderCompiler::MatrixType::instance())
-    {
-        return ShaderParameterType::Matrix;
-    }
-    else if (const auto* arrayType = as<ShaderCompiler::ArrayType>(type))
-    {
-        const auto* elementType = arrayType->elementType();
-
-        if (elementType == ShaderCompiler::IntType::instance())
-        {
-            return ShaderParameterType::IntArray;
-        }
-        else if (elementType == ShaderCompiler::FloatType::instance())
-        {
-            return ShaderParameterType::FloatArray;
-        }
-        else if (elementType == ShaderCompiler::BoolType::instance())
-        {
-            return ShaderParameterType::BoolArray;
-        }
-        else if (elementType == ShaderCompiler::Vec2Type::instance())
-        {
-            return ShaderParameterType::Vec2Array;
-        }
-        else if (elementType == ShaderCompiler::Vec3Type::instance())
-        {
-            return ShaderParameterType::Vec3Array;
-        }
-        else if (elementType == ShaderCompiler::Vec4Type::instance())
-        {
-            return ShaderParameterType::Vec4Array;
-        }
-        else if (elementType == ShaderCompiler::MatrixType::instance())
-        {
-            return ShaderParameterType::MatrixArray;
-        }
-    }
-
-    throw Error("Unknown shader parameter type specified.");
+    return {};
 }
 
 UniquePtr<Shader::Impl> Painter::Impl::createUserShader(StringView sourceCode, StringView filenameHint)
@@ -167,72 +107,37 @@ UniquePtr<Shader::Impl> Painter::Impl::createUserShader(StringView sourceCode, S
         filenameHint,
         [&](const ShaderCompiler::Ast& ast, const ShaderCompiler::SemaContext& context)
         {
-            const auto maybeEntryPointDecl = ast.findDeclByName(ShaderCompiler::Naming::shaderEntryPoint);
-
-            if (!maybeEntryPointDecl)
-            {
-                throw Error("Entry point not found.");
-            }
-
-            const auto* entryPointDecl = maybeEntryPointDecl->get();
-            const auto* entryPointFunc = as<ShaderCompiler::FunctionDecl>(entryPointDecl);
-
-            if (!entryPointFunc)
-            {
-                throw Error("The entry point must be a function.");
-            }
-
-            const auto paramDecls =
-                ShaderCompiler::ShaderGenerator::extractShaderParameters(ast, entryPointFunc);
-
-            auto params = Shader::Impl::ParameterList();
-            params.reserve(paramDecls.size());
-
-            auto paramTypes = List<const ShaderCompiler::Type*, 4>();
-            paramTypes.reserve(paramDecls.size());
-
-            for (const auto& param : paramDecls)
-            {
-                paramTypes.add(param->type());
-            }
-
-            const auto cbufferPacking = ShaderCompiler::CBufferPacker::pack(paramTypes);
-
-            for (u32 idx = 0; const auto& param : paramDecls)
-            {
-                params.add(
-                    ShaderParameter{
-                        .name         = String(param->name()),
-                        .type         = convertShdTypeToParamType(param->type()),
-                        .offset       = cbufferPacking.offsets[idx],
-                        .sizeInBytes  = param->type()->occupiedSizeInCbuffer(),
-                        .arraySize    = param->arraySize(),
-                        .defaultValue = param->defaultValue(),
-                    });
-
-                ++idx;
-            }
-
-            auto flags = UserShaderFlags::None;
-
-            if (entryPointFunc->usesSystemValues())
-            {
-                flags |= UserShaderFlags::UsesSystemValues;
-            }
+            const auto* entryPointFunc = findUserShaderEntryPoint(ast);
+            auto        reflection     = reflectUserShader(ast, entryPointFunc);
 
             shader = onCreateNativeUserShader(
                 ast,
                 context,
                 entryPointFunc,
                 sourceCode,
-                std::move(params),
-                flags,
-                cbufferPacking.cbufferSize);
+                std::move(reflection.parameters),
+                reflection.flags,
+                reflection.cbufferSize);
         });
 
     return shader;
 }
 
+UniquePtr<Shader::Impl> Painter::Impl::createUserShader(
+    const PrecompiledShader& shader,
+    StringView               filenameHint)
+{
+    return onCreatePrecompiledUserShader(shader, filenameHint);
+}
+
+UniquePtr<Shader::Impl> Painter::Impl::onCreatePrecompiledUserShader(
+    const PrecompiledShader& shader,
+    StringView               filenameHint)
+{
+    // Backends that don't support precompiled code compile the shader from source.
+    return createUserShader(shader.sourceCode, filenameHint);
+}
+
 void Painter::Impl::notifyShaderParamAboutToChangeWhileBound([[maybe_unused]] const Shader::Impl& shaderImpl)
 {
     flush();
@@ -244,6 +149,11 @@ void Painter::Impl::notifyShaderParamHasChangedWhileBound([[maybe_unused]] const
     frameData.dirtyFlags |= DF_UserShaderParams;
 }
 
+void Painter::Impl::notifyDeferredShaderParamAboutToChange([[maybe_unused]] const Shader::Impl& shaderImpl)
+{
+    submitDeferredDraws();
+}
+
 void Painter::Impl::notifyResourceCreated(GraphicsResource& resource)
 {
     assume(!containsWhere(_resources, [&resource](const auto& e) { return e == &resource; }));
@@ -253,6 +163,12 @@ void Painter::Impl::notifyResourceCreated(GraphicsResource& resource)
 
 void Painter::Impl::prepareForBatchMode(FrameData& frameData, BatchMode mode)
 {
+    if (_isDrawingDeferred and mode != BatchMode::Sprites)
+    {
+        // Only sprites are recorded; anything else has to be drawn after what was recorded so far.
+        submitDeferredDraws();
+    }
+
     if (const auto currentBatchMode = frameData.batchMode)
     {
         if (currentBatchMode != mode)
@@ -292,8 +208,12 @@ Painter::Impl::~Impl() noexcept
 
 void Painter::Impl::startFrame()
 {
+    PollyProfileScope("Painter::startFrame");
+
     assume(_maxFramesInFlight > 0);
 
+    ++_frameNumber;
+
     resetCurrentStates();
 
     setScissorRects({});
@@ -312,12 +232,18 @@ void Painter::Impl::startFrame()
 
     _imagesToUpdateQueue.clear();
     _arenaAllocator.reset();
+    _shapedTextCache.onFrameStarted(_frameNumber);
 
     onFrameStarted();
 
-    auto& frameData            = _frameData[_currentFrameIndex];
-    frameData.batchMode        = none;
-    frameData.spriteBatchImage = nullptr;
+    if (_imageAtlas)
+    {
+        _imageAtlas->onFrameStarted();
+    }
+
+    auto& frameData     = _frameData[_currentFrameIndex];
+    frameData.batchMode = none;
+    frameData.spriteBatchImages.clear();
     frameData.spriteQueue.clear();
     frameData.meshBatchImage = nullptr;
 
@@ -333,6 +259,13 @@ void Painter::Impl::startFrame()
 
 void Painter::Impl::endFrame(ImGui imGui, const Function<void(ImGui)>& imGuiDrawFunc)
 {
+    PollyProfileScope("Painter::endFrame");
+
+    if (_isDrawingDeferred)
+    {
+        submitDeferredDrawing();
+    }
+
     flush();
     onFrameEnded(imGui, imGuiDrawFunc);
     resetCurrentStates();
@@ -353,6 +286,7 @@ void Painter::Impl::setCanvas(Image canvas, Maybe<Color> clearColor, bool force)
 {
     if (_currentCanvas != canvas || force)
     {
+        submitDeferredDraws();
         flush();
         onBeforeCanvasChanged(_currentCanvas, _viewport);
 
@@ -424,6 +358,7 @@ void Painter::Impl::setScissorRects(Span<Rectangle> scissorRects)
         ++index;
     }
 
+    submitDeferredDraws();
     onSetScissorRects(scissorRects);
 }
 
@@ -526,6 +461,132 @@ void Painter::Impl::setBlendState(const BlendState& blendState)
     }
 }
 
+void Painter::Impl::beginDeferredDrawing()
+{
+    if (_isDrawingDeferred)
+    {
+        throw Error("Deferred drawing has already begun. Please call submitDeferredDrawing() first.");
+    }
+
+    // Sprites that were drawn before have to be drawn before any recorded sprite.
+    flush();
+
+    _isDrawingDeferred = true;
+}
+
+void Painter::Impl::submitDeferredDrawing()
+{
+    if (not _isDrawingDeferred)
+    {
+        throw Error("Deferred drawing hasn't begun. Please call beginDeferredDrawing() first.");
+    }
+
+    submitDeferredDraws();
+
+    _isDrawingDeferred = false;
+}
+
+bool Painter::Impl::isDrawingDeferred() const
+{
+    return _isDrawingDeferred;
+}
+
+u8 Painter::Impl::drawLayer() const
+{
+    return _drawLayer;
+}
+
+void Painter::Impl::setDrawLayer(u8 layer)
+{
+    _drawLayer = layer;
+}
+
+const DistanceFieldTextStyle& Painter::Impl::distanceFieldTextStyle() const
+{
+    return _distanceFieldTextStyle;
+}
+
+void Painter::Impl::setDistanceFieldTextStyle(const DistanceFieldTextStyle& style)
+{
+    _distanceFieldTextStyle = style;
+}
+
+void Painter::Impl::recordDeferredSprite(const Sprite& sprite)
+{
+    auto& shader = currentShader(BatchMode::Sprites);
+
+    const auto wasRecorded = _deferredDrawQueue.record(
+        sprite,
+        _drawLayer,
+        shader,
+        _currentBlendState,
+        _currentSampler,
+        _currentTransformation);
+
+    if (not wasRecorded)
+    {
+        // The queue can't distinguish any more states, so draw what it has so far.
+        submitDeferredDraws();
+
+        [[maybe_unused]] const auto wasRecordedAfterSubmit = _deferredDrawQueue.record(
+            sprite,
+            _drawLayer,
+            shader,
+            _currentBlendState,
+            _currentSampler,
+            _currentTransformation);
+
+        assume(wasRecordedAfterSubmit);
+    }
+
+    shader.impl()->_isReferencedByDeferredDraws = true;
+}
+
+void Painter::Impl::submitDeferredDraws()
+{
+    if (_deferredDrawQueue.isEmpty())
+    {
+        return;
+    }
+
+    const auto previousShader         = currentShader(BatchMode::Sprites);
+    const auto previousBlendState     = _currentBlendState;
+    const auto previousSampler        = _currentSampler;
+    const auto previousTransformation = _currentTransformation;
+
+    // Draw the sprites for real this time.
+    _isDrawingDeferred = false;
+
+    defer
+    {
+        _isDrawingDeferred = true;
+    };
+
+    _deferredDrawQueue.sortAndVisit(
+        [this](const DeferredDrawQueue::Command& command)
+        {
+            // The setters only flush if the state actually changes.
+            setShader(BatchMode::Sprites, _deferredDrawQueue.shader(command.shader));
+            setBlendState(_deferredDrawQueue.blendState(command.blendState));
+            setSampler(_deferredDrawQueue.sampler(command.sampler));
+            setTransformation(_deferredDrawQueue.transformation(command.transformation));
+
+            drawSprite<false, true, false>(command.sprite);
+        });
+
+    for (auto shader : _deferredDrawQueue.shaders())
+    {
+        shader.impl()->_isReferencedByDeferredDraws = false;
+    }
+
+    _deferredDrawQueue.clear();
+
+    setShader(BatchMode::Sprites, previousShader);
+    setBlendState(previousBlendState);
+    setSampler(previousSampler);
+    setTransformation(previousTransformation);
+}
+
 void Painter::Impl::pushStringToQueue(
     StringView            text,
     Font&                 font,
@@ -535,15 +596,60 @@ void Painter::Impl::pushStringToQueue(
     Maybe<TextDecoration> decoration)
 {
     assume(font);
-    shapeText(text, font, fontSize, decoration, tmpGlyphs, tmpDecorationRects);
-    doInternalPushTextToQueue(tmpGlyphs, tmpDecorationRects, position, color);
+    const auto& shapedText = shapeString(text, font, fontSize, decoration);
+
+    doInternalPushTextToQueue(
+        shapedText.glyphs,
+        shapedText.decorationRects,
+        position,
+        color,
+        shapedText.distanceFieldScale);
 }
 
 void Painter::Impl::pushTextToQueue(Text text, Vec2 position, Color color)
 {
     assume(text);
     const auto& textImpl = *text.impl();
-    doInternalPushTextToQueue(textImpl.glyphs(), textImpl.decorationRects(), position, color);
+
+    doInternalPushTextToQueue(
+        textImpl.glyphs(),
+        textImpl.decorationRects(),
+        position,
+        color,
+        textImpl.distanceFieldScale());
+}
+
+const ShapedText& Painter::Impl::shapeString(
+    StringView                   text,
+    Font&                        font,
+    float                        fontSize,
+    const Maybe<TextDecoration>& decoration)
+{
+    auto&      fontImpl   = *font.impl();
+    const auto generation = fontImpl.shapingGeneration();
+
+    const auto key = ShapedTextKey{
+        .text       = text,
+        .fontId     = fontImpl.id(),
+        .fontSize   = fontSize,
+        .decoration = decoration,
+    };
+
+    if (const auto cachedText = _shapedTextCache.find(key, generation))
+    {
+        ++_performanceStats.shapedTextCacheHitCount;
+        fontImpl.markGlyphsAsUsed(cachedText->glyphs, fontSize);
+
+        return *cachedText;
+    }
+
+    ++_performanceStats.shapedTextCacheMissCount;
+
+    auto& shapedText = _shapedTextCache.prepare(key, generation);
+    shapeText(text, font, fontSize, decoration, shapedText.glyphs, shapedText.decorationRects);
+    shapedText.distanceFieldScale = fontImpl.distanceFieldScale(fontSize);
+
+    return shapedText;
 }
 
 void Painter::Impl::pushParticlesToQueue(ParticleSystem particleSystem)
@@ -593,6 +699,95 @@ void Painter::Impl::pushParticlesToQueue(ParticleSystem particleSystem)
     }
 }
 
+void Painter::Impl::drawStaticSpriteBatch(StaticSpriteBatch::Impl& batch)
+{
+    auto& frameData = _frameData[_currentFrameIndex];
+
+    prepareForBatchMode(frameData, BatchMode::Sprites);
+
+    auto* buffer = batch.buffer();
+
+    if (not buffer)
+    {
+        for (const auto& run : batch.runs())
+        {
+            for (auto i = run.offset; i < run.offset + run.count; ++i)
+            {
+                drawSprite<true, false, true>(batch.spriteAt(i));
+            }
+        }
+
+        return;
+    }
+
+    // Static sprites are drawn from their own buffer, so anything that's queued or recorded
+    // must be drawn first.
+    submitDeferredDraws();
+    flush();
+
+    batch.updateBuffer();
+
+    for (const auto& run : batch.runs())
+    {
+        if (run.image == _currentCanvas.impl())
+        {
+            throw Error(
+                "An image can't be drawn while it's bound as a canvas. Please unset the canvas first (using "
+                "setCanvas()) before drawing it.");
+        }
+
+        frameData.spriteBatchImages.clear();
+        frameData.spriteBatchImages.add(run.image);
+        frameData.dirtyFlags |= DF_SpriteImage;
+
+        for (auto offset = run.offset; offset < run.offset + run.count; offset += _maxSpriteBatchSize)
+        {
+            const auto count = min(run.offset + run.count - offset, _maxSpriteBatchSize);
+
+            prepareDraw(frameData);
+            drawStaticSprites(*buffer, offset, count, _performanceStats);
+
+            _performanceStats.spriteCount += count;
+        }
+    }
+
+    // The backend has bound the batch's buffer in place of the sprite vertex buffer,
+    // and possibly a different pipeline, if it draws regular sprites as instances.
+    frameData.spriteBatchImages.clear();
+    frameData.dirtyFlags |= DF_VertexBuffers;
+    frameData.dirtyFlags |= DF_IndexBuffer;
+    frameData.dirtyFlags |= DF_PipelineState;
+}
+
+UniquePtr<StaticSpriteBatch::Impl::Buffer> Painter::Impl::createStaticSpriteBuffer(
+    [[maybe_unused]] u32 spriteCount)
+{
+    return {};
+}
+
+void Painter::Impl::prepareDrawStates([[maybe_unused]] Span<DrawStateCombination> combinations)
+{
+    // Nothing to prepare by default.
+}
+
+void Painter::Impl::updateStaticSpriteBuffer(
+    [[maybe_unused]] StaticSpriteBatch::Impl::Buffer& buffer,
+    [[maybe_unused]] u32                              offset,
+    [[maybe_unused]] Span<InternalSprite>             sprites,
+    [[maybe_unused]] const Rectangle&                 imageSizeAndInverse)
+{
+    notImplemented();
+}
+
+void Painter::Impl::drawStaticSprites(
+    [[maybe_unused]] StaticSpriteBatch::Impl::Buffer& buffer,
+    [[maybe_unused]] u32                              offset,
+    [[maybe_unused]] u32                              count,
+    [[maybe_unused]] GamePerformanceStats&            stats)
+{
+    notImplemented();
+}
+
 template<bool PrepareBatchMode>
 void Painter::Impl::fillRectangleUsingSprite(Rectangle rectangle, Color color, Radians rotation, Vec2 origin)
 {
@@ -849,6 +1044,7 @@ void Painter::Impl::resetCurrentStates()
     _combinedTransformation = _viewportTransformation;
     _currentBlendState      = nonPremultiplied;
     _currentSampler         = linearClamp;
+    _drawLayer              = 0;
 
     for (auto& shader : _currentShaders)
     {
@@ -875,6 +1071,11 @@ u32 Painter::Impl::frameIndex() const
     return _currentFrameIndex;
 }
 
+u64 Painter::Impl::frameNumber() const
+{
+    return _frameNumber;
+}
+
 int Painter::Impl::dirtyFlags() const
 {
     return _frameData[_currentFrameIndex].dirtyFlags;
@@ -897,7 +1098,13 @@ Span<InternalSprite> Painter::Impl::currentFrameSpriteQueue() const
 
 Image::Impl* Painter::Impl::spriteBatchImage()
 {
-    return _frameData[_currentFrameIndex].spriteBatchImage;
+    const auto& images = _frameData[_currentFrameIndex].spriteBatchImages;
+    return images.isEmpty() ? nullptr : images.first();
+}
+
+Span<Image::Impl*> Painter::Impl::spriteBatchImages()
+{
+    return _frameData[_currentFrameIndex].spriteBatchImages;
 }
 
 Span<Tessellation2D::Command> Painter::Impl::currentFramePolyQueue() const
@@ -924,15 +1131,7 @@ void Painter::Impl::flush()
         return;
     }
 
-    auto prepareDraw = [this, &frameData]
-    {
-        if (prepareDrawCall() != DF_None)
-        {
-            throw Error("Graphics backend failed to perform a draw call.");
-        }
-
-        frameData.dirtyFlags = DF_None;
-    };
+    PollyProfileScope("Painter::flush");
 
     switch (*frameData.batchMode)
     {
@@ -942,20 +1141,25 @@ void Painter::Impl::flush()
                 return;
             }
 
-            prepareDraw();
+            prepareDraw(frameData);
+
+            auto imageSizes = List<Rectangle, maxSpriteBatchImages>();
 
-            const auto& imageImpl = static_cast<const Image::Impl&>(*frameData.spriteBatchImage);
+            for (const auto* imageImpl : frameData.spriteBatchImages)
+            {
+                const auto imageWidthf  = float(imageImpl->width());
+                const auto imageHeightf = float(imageImpl->height());
 
-            const auto imageWidthf  = float(imageImpl.width());
-            const auto imageHeightf = float(imageImpl.height());
+                imageSizes.add(Rectangle(imageWidthf, imageHeightf, 1.0f / imageWidthf, 1.0f / imageHeightf));
+            }
 
-            flushSprites(
-                frameData.spriteQueue,
-                _performanceStats,
-                Rectangle(imageWidthf, imageHeightf, 1.0f / imageWidthf, 1.0f / imageHeightf));
+            flushSprites(frameData.spriteQueue, _performanceStats, imageSizes);
 
             frameData.spriteQueue.clear();
 
+            // Images of the batch may be destroyed once its sprites are drawn.
+            frameData.spriteBatchImages.clear();
+
             break;
         }
         case BatchMode::Polygons: {
@@ -964,26 +1168,24 @@ void Painter::Impl::flush()
                 return;
             }
 
-            prepareDraw();
+            prepareDraw(frameData);
 
             const auto numberOfVerticesToDraw = Tessellation2D::calculatePolyQueueVertexCounts(
                 frameData.polyQueue,
                 frameData.polyCmdVertexCounts);
 
-            if (numberOfVerticesToDraw > _maxPolyVertices)
+            if (numberOfVerticesToDraw <= _maxPolyVertices)
             {
-                throw Error(formatString(
-                    "Attempting to draw too many polygons at once. The maximum number of {} polygon "
-                    "vertices would be "
-                    "exceeded.",
-                    _maxPolyVertices));
+                flushPolys(
+                    frameData.polyQueue,
+                    frameData.polyCmdVertexCounts,
+                    numberOfVerticesToDraw,
+                    _performanceStats);
+            }
+            else
+            {
+                flushPolysInParts(frameData.polyQueue, frameData.polyCmdVertexCounts);
             }
-
-            flushPolys(
-                frameData.polyQueue,
-                frameData.polyCmdVertexCounts,
-                numberOfVerticesToDraw,
-                _performanceStats);
 
             frameData.polyQueue.clear();
 
@@ -995,9 +1197,9 @@ void Painter::Impl::flush()
                 return;
             }
 
-            prepareDraw();
+            prepareDraw(frameData);
 
-            flushMeshes(frameData.meshQueue, _performanceStats);
+            flushMeshesInParts(frameData.meshQueue);
 
             frameData.meshQueue.clear();
 
@@ -1009,6 +1211,96 @@ void Painter::Impl::flush()
     }
 }
 
+void Painter::Impl::flushPolysInParts(Span<Tessellation2D::Command> polys, Span<u32> polyCmdVertexCounts)
+{
+    // The batch doesn't fit into the backend's vertex buffer, so it's drawn in multiple parts.
+    // Polygons are never split themselves.
+    auto first = 0u;
+
+    while (first < polys.size())
+    {
+        auto last        = first;
+        auto vertexCount = 0u;
+
+        while (last < polys.size() and vertexCount + polyCmdVertexCounts[last] <= _maxPolyVertices)
+        {
+            vertexCount += polyCmdVertexCounts[last];
+            ++last;
+        }
+
+        if (last == first)
+        {
+            throw Error(formatString(
+                "Attempting to draw a polygon with {} vertices. A single polygon may have at most {} "
+                "vertices.",
+                polyCmdVertexCounts[first],
+                _maxPolyVertices));
+        }
+
+        flushPolys(
+            polys.subspan(first, last - first),
+            polyCmdVertexCounts.subspan(first, last - first),
+            vertexCount,
+            _performanceStats);
+
+        first = last;
+    }
+}
+
+void Painter::Impl::flushMeshesInParts(Span<MeshEntry> meshes)
+{
+    // Backends report the capacities of their mesh vertex and index buffers separately,
+    // and a part must fit into both.
+    auto first = 0u;
+
+    while (first < meshes.size())
+    {
+        auto last        = first;
+        auto vertexCount = 0u;
+        auto indexCount  = 0u;
+
+        while (last < meshes.size())
+        {
+            const auto& entry = meshes[last];
+
+            if (vertexCount + entry.vertices.size() > _maxMeshVertices
+                or indexCount + entry.indices.size() > _maxMeshIndices)
+            {
+                break;
+            }
+
+            vertexCount += entry.vertices.size();
+            indexCount += entry.indices.size();
+            ++last;
+        }
+
+        if (last == first)
+        {
+            throw Error(formatString(
+                "Attempting to draw a mesh with {} vertices and {} indices. A single mesh may have at "
+                "most {} vertices and {} indices.",
+                meshes[first].vertices.size(),
+                meshes[first].indices.size(),
+                _maxMeshVertices,
+                _maxMeshIndices));
+        }
+
+        flushMeshes(meshes.subspan(first, last - first), _performanceStats);
+
+        first = last;
+    }
+}
+
+void Painter::Impl::prepareDraw(FrameData& frameData)
+{
+    if (prepareDrawCall() != DF_None)
+    {
+        throw Error("Graphics backend failed to perform a draw call.");
+    }
+
+    frameData.dirtyFlags = DF_None;
+}
+
 bool Painter::Impl::mustIndirectlyFlush(const FrameData& frameData) const
 {
     return (frameData.dirtyFlags & DF_UserShaderParams) == DF_UserShaderParams;
@@ -1027,6 +1319,9 @@ void Painter::Impl::createDefaultShaders()
     _defaultSpriteShader = Shader::fromSource("DefaultSpriteShader", SpriteShaderDefault_shdStringView());
     _defaultPolyShader   = Shader::fromSource("DefaultPolyShader", PolyShaderDefault_shdStringView());
     _defaultMeshShader   = Shader::fromSource("DefaultMeshShader", MeshShaderDefault_shdStringView());
+
+    _distanceFieldTextShader =
+        Shader::fromSource("DistanceFieldTextShader", SpriteShaderDistanceField_shdStringView());
 }
 
 void Painter::Impl::computeCombinedTransformation()
@@ -1056,8 +1351,32 @@ void Painter::Impl::doInternalPushTextToQueue(
     Span<PreshapedGlyph>     glyphs,
     Span<TextDecorationRect> decorationRects,
     const Vec2&              offset,
-    const Color&             color)
+    const Color&             color,
+    Maybe<float>             distanceFieldScale)
 {
+    const auto previousShader = currentShader(BatchMode::Sprites);
+
+    if (distanceFieldScale)
+    {
+        // The shader works in normalized distance field values, so convert the style's widths
+        // using the value change per pixel at the drawn size.
+        constexpr auto valuePerReferencePixel =
+            float(Font::Impl::distanceFieldOnEdgeValue) / 255.0f / float(Font::Impl::distanceFieldSpread);
+
+        const auto valuePerPixel = valuePerReferencePixel / *distanceFieldScale;
+
+        const auto& style  = _distanceFieldTextStyle;
+        auto&       shader = _distanceFieldTextShader;
+
+        shader.set("ValuePerPixel", valuePerPixel);
+        shader.set("OutlineWidth", max(style.outlineWidth, 0.0f));
+        shader.set("OutlineColor", style.outlineColor.toVec4());
+        shader.set("GlowWidth", max(style.glowWidth, 0.0f));
+        shader.set("GlowColor", style.glowColor.toVec4());
+
+        setShader(BatchMode::Sprites, shader);
+    }
+
     prepareForMultipleSprites();
 
     for (const auto& glyph : glyphs)
@@ -1072,6 +1391,11 @@ void Painter::Impl::doInternalPushTextToQueue(
 
     _performanceStats.spriteCount += glyphs.size();
 
+    if (distanceFieldScale)
+    {
+        setShader(BatchMode::Sprites, previousShader);
+    }
+
     for (const auto& deco : decorationRects)
     {
         fillRectangleUsingSprite<false>(
@@ -1089,6 +1413,126 @@ void Painter::Impl::prepareForMultipleSprites()
     prepareForBatchMode(frameData, BatchMode::Sprites);
 }
 
+void Painter::Impl::enableImageAtlasing(const ImageAtlasOptions& options)
+{
+    assume(not _imageAtlas);
+    _imageAtlas = makeUnique<ImageAtlas>(options);
+}
+
+void Painter::Impl::enableParallelVertexGeneration(const VertexGenerationOptions& options)
+{
+    assume(not _vertexWorkerPool);
+
+    // Writing vertices is mostly bound by memory bandwidth, which a few threads already saturate.
+    constexpr auto maxDefaultWorkerCount = 3u;
+
+    const auto workerCount =
+        options.workerCount.valueOr(min(WorkerPool::defaultWorkerCount(), maxDefaultWorkerCount));
+
+    _vertexGenerationOptions = options;
+
+    if (workerCount > 0)
+    {
+        _vertexWorkerPool = makeUnique<WorkerPool>(workerCount);
+    }
+}
+
+template<typename TVertex>
+void Painter::Impl::fillPolyVertices(
+    Span<Tessellation2D::Command> polys,
+    TVertex*                      dstVertices,
+    Span<u32>                     polyCmdVertexCounts,
+    u32                           numberOfVerticesToDraw)
+{
+    PollyProfileScope("Painter::tessellatePolygons");
+
+    if (not _vertexWorkerPool or numberOfVerticesToDraw < _vertexGenerationOptions.minPolygonVertexCount)
+    {
+        Tessellation2D::processPolyQueue(polys, dstVertices, polyCmdVertexCounts);
+        return;
+    }
+
+    // Because every command's vertex count is known up front, their prefix sum gives each
+    // command its own range of the vertex buffer, and commands can be tessellated independently.
+    auto vertexOffsets = List<u32>();
+    vertexOffsets.resize(polys.size());
+
+    auto vertexOffset = 0u;
+
+    for (auto i = 0u; i < polys.size(); ++i)
+    {
+        vertexOffsets[i] = vertexOffset;
+        vertexOffset += polyCmdVertexCounts[i];
+    }
+
+    fillVerticesInParallel(
+        polys.size(),
+        1,
+        [&](u32 offset, u32 count)
+        {
+            Tessellation2D::processPolyQueue(
+                polys.subspan(offset, count),
+                dstVertices + vertexOffsets[offset],
+                polyCmdVertexCounts.subspan(offset, count));
+        });
+}
+
+template void Painter::Impl::fillPolyVertices(
+    Span<Tessellation2D::Command>,
+    Tessellation2D::PolyVertex*,
+    Span<u32>,
+    u32);
+
+template void Painter::Impl::fillPolyVertices(
+    Span<Tessellation2D::Command>,
+    Tessellation2D::PackedPolyVertex*,
+    Span<u32>,
+    u32);
+
+void Painter::Impl::fillVerticesInParallel(
+    u32                             itemCount,
+    u32                             granularity,
+    const Function<void(u32, u32)>& fillRange)
+{
+    using Clock = std::chrono::steady_clock;
+
+    assume(_vertexWorkerPool);
+    assume(granularity > 0);
+
+    const auto threadCount = _vertexWorkerPool->workerCount() + 1;
+
+    auto chunkSize = (itemCount + threadCount - 1) / threadCount;
+    chunkSize      = ((chunkSize + granularity - 1) / granularity) * granularity;
+
+    const auto chunkCount = (itemCount + chunkSize - 1) / chunkSize;
+
+    auto chunkDurations = List<double, 16>();
+    chunkDurations.resize(chunkCount);
+
+    const auto startTime = Clock::now();
+
+    _vertexWorkerPool->parallelFor(
+        chunkCount,
+        [&](u32 chunkIndex)
+        {
+            PollyProfileScope("Painter::fillVertexChunk");
+
+            const auto chunkStartTime = Clock::now();
+            const auto offset         = chunkIndex * chunkSize;
+
+            fillRange(offset, min(chunkSize, itemCount - offset));
+
+            chunkDurations[chunkIndex] = std::chrono::duration<double>(Clock::now() - chunkStartTime).count();
+        });
+
+    const auto elapsedTime = std::chrono::duration<double>(Clock::now() - startTime).count();
+
+    // The chunks would have run one after another on the main thread otherwise.
+    const auto sequentialTime = sumBy(chunkDurations, [](double duration) { return duration; });
+
+    _performanceStats.vertexGenerationTimeSaved += max(sequentialTime - elapsedTime, 0.0);
+}
+
 void Painter::Impl::enqueueImageToUpdate(Image::Impl* image, u32 x, u32 y, u32 width, u32 height)
 {
     const auto dataSize = imageSlicePitch(width, height, image->format());
@@ -1125,15 +1569,19 @@ void Painter::Impl::postInit(
     u32                        maxFramesInFlight,
     u32                        maxSpriteBatchSize,
     u32                        maxPolyVertices,
-    u32                        maxMeshVertices)
+    u32                        maxMeshVertices,
+    u32                        maxMeshIndices)
 {
     assume(maxFramesInFlight > 0);
     assume(maxFramesInFlight <= _frameData.size());
-    _capabilities       = capabilities;
-    _maxFramesInFlight  = maxFramesInFlight;
-    _maxSpriteBatchSize = maxSpriteBatchSize;
-    _maxPolyVertices    = maxPolyVertices;
-    _maxMeshVertices    = maxMeshVertices;
+    assume(capabilities.maxSpriteBatchImages <= maxSpriteBatchImages);
+    _capabilities         = capabilities;
+    _maxFramesInFlight    = maxFramesInFlight;
+    _maxSpriteBatchSize   = maxSpriteBatchSize;
+    _maxSpriteBatchImages = max(capabilities.maxSpriteBatchImages, 1u);
+    _maxPolyVertices      = maxPolyVertices;
+    _maxMeshVertices      = maxMeshVertices;
+    _maxMeshIndices       = maxMeshIndices;
 
     createDefaultShaders();
 
@@ -1161,8 +1609,8 @@ void Painter::Impl::preBackendDtor()
     resetCurrentStates();
 
     _whiteImage = none;
-    tmpGlyphs.clear();
-    tmpDecorationRects.clear();
+    _imageAtlas.reset();
+    _shapedTextCache.clear();
 
     clearOnScreenMessages();
 
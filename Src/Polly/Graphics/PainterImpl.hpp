@@ -4,18 +4,27 @@
 
 #pragma once
 
+#include "Polly/Algorithm.hpp"
 #include "Polly/Array.hpp"
 #include "Polly/BlendState.hpp"
 #include "Polly/Color.hpp"
 #include "Polly/CopyMoveMacros.hpp"
 #include "Polly/Core/ArenaAllocator.hpp"
 #include "Polly/Core/Object.hpp"
+#include "Polly/Core/WorkerPool.hpp"
 #include "Polly/Function.hpp"
 #include "Polly/GamePerformanceStats.hpp"
+#include "Polly/Graphics/DeferredDrawQueue.hpp"
+#include "Polly/Graphics/ImageAtlas.hpp"
 #include "Polly/Graphics/ImageImpl.hpp"
 #include "Polly/Graphics/InternalSharedShaderStructs.hpp"
+#include "Polly/Graphics/InternalSprite.hpp"
 #include "Polly/Graphics/PolyDrawCommands.hpp"
 #include "Polly/Graphics/ShaderImpl.hpp"
+#include "Polly/Graphics/ShapedTextCache.hpp"
+#include "Polly/Graphics/SpriteVertexKernel.hpp"
+#include "Polly/Graphics/StaticSpriteBatchImpl.hpp"
+#include "Polly/Graphics/Tessellation2D.hpp"
 #include "Polly/Graphics/TextImpl.hpp"
 #include "Polly/Image.hpp"
 #include "Polly/Linalg.hpp"
@@ -30,6 +39,7 @@
 #include "Polly/Span.hpp"
 #include "Polly/Sprite.hpp"
 #include "Polly/UniquePtr.hpp"
+#include "Polly/VertexGenerationOptions.hpp"
 #include "Polly/Window.hpp"
 #include <spine/SkeletonRenderer.h>
 
@@ -37,6 +47,7 @@ namespace Polly
 {
 class Font;
 class ImGui;
+struct PrecompiledShader;
 
 namespace ShaderCompiler
 {
@@ -53,16 +64,9 @@ enum class BatchMode : u8
     Mesh     = 2,
 };
 
-struct InternalSprite
-{
-    Rectangle  dst;
-    Rectangle  src;
-    Color      color;
-    Vec2       origin;
-    Radians    rotation;
-    SpriteFlip flip = SpriteFlip::None;
-    bool       isCanvas;
-};
+// The maximum number of images a single sprite batch may reference.
+// Backends report their actual limit via PainterCapabilities::maxSpriteBatchImages.
+static constexpr auto maxSpriteBatchImages = 8u;
 
 struct MeshEntry
 {
@@ -96,14 +100,14 @@ class Painter::Impl : public Object
 
     struct FrameData
     {
-        int                           dirtyFlags = DF_None;
-        Maybe<BatchMode>              batchMode;
-        List<InternalSprite>          spriteQueue;
-        Image::Impl*                  spriteBatchImage = nullptr;
-        List<Tessellation2D::Command> polyQueue;
-        List<u32>                     polyCmdVertexCounts;
-        List<MeshEntry>               meshQueue;
-        Image::Impl*                  meshBatchImage = nullptr;
+        int                                      dirtyFlags = DF_None;
+        Maybe<BatchMode>                         batchMode;
+        List<InternalSprite>                     spriteQueue;
+        List<Image::Impl*, maxSpriteBatchImages> spriteBatchImages;
+        List<Tessellation2D::Command>            polyQueue;
+        List<u32>                                polyCmdVertexCounts;
+        List<MeshEntry>                          meshQueue;
+        Image::Impl*                             meshBatchImage = nullptr;
     };
 
     explicit Impl(Window::Impl& windowImpl, GamePerformanceStats& performanceStats);
@@ -144,8 +148,16 @@ class Painter::Impl : public Object
         ImageFormat format,
         const void* data) = 0;
 
+    // Creates an updatable R8Unorm image that is sampled as (1, 1, 1, r), so that the regular
+    // sprite shaders can draw it like a white RGBA image. Fonts use this for their atlases.
+    // The default implementation returns null, which means that the backend can't swizzle
+    // image channels and that callers should fall back to R8G8B8A8UNorm.
+    virtual UniquePtr<Image::Impl> createAlphaCoverageImage(u32 width, u32 height);
+
     UniquePtr<Shader::Impl> createUserShader(StringView sourceCode, StringView filenameHint);
 
+    UniquePtr<Shader::Impl> createUserShader(const PrecompiledShader& shader, StringView filenameHint);
+
     virtual UniquePtr<Shader::Impl> onCreateNativeUserShader(
         const ShaderCompiler::Ast&          ast,
         const ShaderCompiler::SemaContext&  context,
@@ -155,10 +167,18 @@ class Painter::Impl : public Object
         UserShaderFlags                     flags,
         u16                                 cbufferSize) = 0;
 
+    // Creates a shader from code that was generated at build time.
+    // The default implementation compiles the shader's source code instead.
+    virtual UniquePtr<Shader::Impl> onCreatePrecompiledUserShader(
+        const PrecompiledShader& shader,
+        StringView               filenameHint);
+
     void notifyShaderParamAboutToChangeWhileBound(const Shader::Impl& shaderImpl);
 
     void notifyShaderParamHasChangedWhileBound(const Shader::Impl& shaderImpl);
 
+    void notifyDeferredShaderParamAboutToChange(const Shader::Impl& shaderImpl);
+
     void notifyResourceCreated(GraphicsResource& resource);
 
     void prepareForBatchMode(FrameData& frameData, BatchMode mode);
@@ -194,6 +214,18 @@ class Painter::Impl : public Object
     const BlendState& currentBlendState() const;
     void              setBlendState(const BlendState& blendState);
 
+    void beginDeferredDrawing();
+
+    void submitDeferredDrawing();
+
+    bool isDrawingDeferred() const;
+
+    u8   drawLayer() const;
+    void setDrawLayer(u8 layer);
+
+    const DistanceFieldTextStyle& distanceFieldTextStyle() const;
+    void                          setDistanceFieldTextStyle(const DistanceFieldTextStyle& style);
+
     template<bool PerformCanvasCheck, bool PrepareBatchMode, bool IncrementDrawnSpriteCount>
     void drawSprite(Sprite sprite);
 
@@ -234,14 +266,43 @@ class Painter::Impl : public Object
 
     void pushTextToQueue(Text text, Vec2 position, Color color);
 
+    // Shapes a string for drawString(), reusing the result of previous frames if possible.
+    // The result remains valid until the next call.
+    const ShapedText& shapeString(
+        StringView                   text,
+        Font&                        font,
+        float                        fontSize,
+        const Maybe<TextDecoration>& decoration);
+
     void pushParticlesToQueue(ParticleSystem particleSystem);
 
+    void drawStaticSpriteBatch(StaticSpriteBatch::Impl& batch);
+
+    // Creates the GPU storage for the vertices of a static sprite batch.
+    // Backends that return null draw static sprite batches like regular sprites instead.
+    virtual UniquePtr<StaticSpriteBatch::Impl::Buffer> createStaticSpriteBuffer(u32 spriteCount);
+
+    // Writes the vertices of sprites [offset, offset + sprites.size()) of a static sprite batch.
+    // All sprites share the same image.
+    virtual void updateStaticSpriteBuffer(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        Span<InternalSprite>             sprites,
+        const Rectangle&                 imageSizeAndInverse);
+
     Vec2 currentCanvasSize() const;
 
     virtual void requestFrameCapture() = 0;
 
+    // Creates the backend objects that are needed to draw with the specified combinations of states.
+    // Shaders have already been verified to match their kind of object.
+    virtual void prepareDrawStates(Span<DrawStateCombination> combinations);
+
     PainterCapabilities capabilities() const;
 
+    // The number of frames that have been started so far.
+    u64 frameNumber() const;
+
     template<size_t SpriteCount>
     static auto createSpriteIndicesList();
 
@@ -274,12 +335,28 @@ class Painter::Impl : public Object
         Span<PreshapedGlyph>     glyphs,
         Span<TextDecorationRect> decorationRects,
         const Vec2&              offset,
-        const Color&             color);
+        const Color&             color,
+        Maybe<float>             distanceFieldScale);
 
     void prepareForMultipleSprites();
 
     void enqueueImageToUpdate(Image::Impl* image, u32 x, u32 y, u32 width, u32 height);
 
+    void enableImageAtlasing(const ImageAtlasOptions& options);
+
+    void enableParallelVertexGeneration(const VertexGenerationOptions& options);
+
+    // Null if image atlasing is disabled.
+    ImageAtlas* imageAtlas()
+    {
+        return _imageAtlas.get();
+    }
+
+    const ImageAtlas* imageAtlas() const
+    {
+        return _imageAtlas.get();
+    }
+
   protected:
     Window::Impl& window() const;
 
@@ -288,12 +365,30 @@ class Painter::Impl : public Object
         u32                        maxFramesInFlight,
         u32                        maxSpriteBatchSize,
         u32                        maxPolyVertices,
-        u32                        maxMeshVertices);
+        u32                        maxMeshVertices,
+        u32                        maxMeshIndices);
 
     void preBackendDtor();
 
     template<bool FlipCanvasUpsideDown, typename T>
-    void fillSpriteVertices(T* dst, Span<InternalSprite> sprites, const Rectangle& imageSizeAndInverse) const;
+    void fillSpriteVertices(T* dst, Span<InternalSprite> sprites, Span<Rectangle> imageSizesAndInverse);
+
+    // Same as fillSpriteVertices(), but for backends that draw one instance per sprite.
+    template<bool FlipCanvasUpsideDown>
+    void fillSpriteInstances(
+        SpriteInstance*      dst,
+        Span<InternalSprite> sprites,
+        Span<Rectangle>      imageSizesAndInverse);
+
+    // Tessellates a polygon batch, whose vertex counts were determined by
+    // Tessellation2D::calculatePolyQueueVertexCounts().
+    // TVertex is either Tessellation2D::PolyVertex or Tessellation2D::PackedPolyVertex.
+    template<typename TVertex>
+    void fillPolyVertices(
+        Span<Tessellation2D::Command> polys,
+        TVertex*                      dstVertices,
+        Span<u32>                     polyCmdVertexCounts,
+        u32                           numberOfVerticesToDraw);
 
     struct MeshFillResult
     {
@@ -307,7 +402,7 @@ class Painter::Impl : public Object
         Span<MeshEntry> meshes,
         TVertex*        dstVertices,
         TIndex*         dstIndices,
-        u32             baseVertex) const;
+        u32             baseVertex);
 
     void resetCurrentStates();
 
@@ -325,8 +420,12 @@ class Painter::Impl : public Object
 
     Span<InternalSprite> currentFrameSpriteQueue() const;
 
+    // The first image of the current sprite batch.
     Image::Impl* spriteBatchImage();
 
+    // All images of the current sprite batch, indexed by InternalSprite::imageSlot.
+    Span<Image::Impl*> spriteBatchImages();
+
     Span<Tessellation2D::Command> currentFramePolyQueue() const;
 
     Span<MeshEntry> currentFrameMeshQueue() const;
@@ -341,7 +440,7 @@ class Painter::Impl : public Object
     virtual void flushSprites(
         Span<InternalSprite>  sprites,
         GamePerformanceStats& stats,
-        Rectangle             imageSizeAndInverse) = 0;
+        Span<Rectangle>       imageSizesAndInverse) = 0;
 
     virtual void flushPolys(
         Span<Tessellation2D::Command> polys,
@@ -351,11 +450,25 @@ class Painter::Impl : public Object
 
     virtual void flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats) = 0;
 
+    // Draws sprites [offset, offset + count) of a static sprite batch, whose image is already bound.
+    // The count never exceeds the maximum sprite batch size.
+    virtual void drawStaticSprites(
+        StaticSpriteBatch::Impl::Buffer& buffer,
+        u32                              offset,
+        u32                              count,
+        GamePerformanceStats&            stats);
+
     virtual void spriteQueueLimitReached() = 0;
 
   private:
     virtual bool mustIndirectlyFlush(const FrameData& frameData) const;
 
+    void prepareDraw(FrameData& frameData);
+
+    void flushPolysInParts(Span<Tessellation2D::Command> polys, Span<u32> polyCmdVertexCounts);
+
+    void flushMeshesInParts(Span<MeshEntry> meshes);
+
     static Matrix computeViewportTransformation(const Rectangle& viewport);
 
     void createDefaultShaders();
@@ -364,10 +477,29 @@ class Painter::Impl : public Object
 
     void doResourceLeakCheck();
 
-    template<bool FlipCanvasUpsideDown, typename T>
-    static void fillSprite(
+    void recordDeferredSprite(const Sprite& sprite);
+
+    // Draws all recorded sprites, but keeps recording.
+    void submitDeferredDraws();
+
+    // Splits [0, itemCount) into one chunk per thread of the vertex worker pool and
+    // invokes fillRange(offset, count) for each chunk in parallel.
+    // Chunk sizes are multiples of granularity, except for the last one.
+    void fillVerticesInParallel(
+        u32                             itemCount,
+        u32                             granularity,
+        const Function<void(u32, u32)>& fillRange);
+
+    template<typename TVertex, typename TIndex>
+    static void fillMeshEntryVertices(
+        const MeshEntry& entry,
+        TVertex*         dstVertices,
+        TIndex*          dstIndices,
+        u32              baseVertex);
+
+    template<bool FlipCanvasUpsideDown>
+    static SpriteInstance makeSpriteInstance(
         const InternalSprite& sprite,
-        T*                    dstVertices,
         const Rectangle&      imageSizeAndInverse);
 
     static void resetShaderState(auto& shader)
@@ -384,21 +516,32 @@ class Painter::Impl : public Object
     Window::Impl&           _windowImpl;
     List<GraphicsResource*> _resources;
     u32                     _currentFrameIndex = 0;
+    u64                     _frameNumber       = 0;
     GamePerformanceStats&   _performanceStats;
     Image                   _whiteImage;
     Array<FrameData, 3>     _frameData;
     PainterCapabilities     _capabilities;
-    u32                     _maxFramesInFlight  = 0;
-    u32                     _maxSpriteBatchSize = 0;
-    u32                     _maxPolyVertices    = 0;
-    u32                     _maxMeshVertices    = 0;
+    u32                     _maxFramesInFlight    = 0;
+    u32                     _maxSpriteBatchSize   = 0;
+    u32                     _maxSpriteBatchImages = 1;
+    u32                     _maxPolyVertices      = 0;
+    u32                     _maxMeshVertices      = 0;
+    u32                     _maxMeshIndices       = 0;
 
     ArenaAllocator             _arenaAllocator;
     List<ImageDataToUpdate, 4> _imagesToUpdateQueue;
 
+    UniquePtr<ImageAtlas> _imageAtlas;
+
+    VertexGenerationOptions _vertexGenerationOptions;
+    UniquePtr<WorkerPool>   _vertexWorkerPool;
+
     Shader _defaultSpriteShader;
     Shader _defaultPolyShader;
     Shader _defaultMeshShader;
+    Shader _distanceFieldTextShader;
+
+    DistanceFieldTextStyle _distanceFieldTextStyle;
 
     Rectangle _viewport;
     Matrix    _viewportTransformation;
@@ -413,12 +556,13 @@ class Painter::Impl : public Object
     // Currently bound shaders. Slots correspond to BatchMode enum values.
     Array<Shader, 3> _currentShaders;
 
+    DeferredDrawQueue _deferredDrawQueue;
+    bool              _isDrawingDeferred = false;
+    u8                _drawLayer         = 0;
+
     spine::SkeletonRenderer _spineSkeletonRenderer;
 
-  public:
-    // Used in drawString() as temporary buffers for text shaping results.
-    List<PreshapedGlyph>     tmpGlyphs;
-    List<TextDecorationRect> tmpDecorationRects;
+    ShapedTextCache _shapedTextCache;
 };
 
 // Inline function implementations
@@ -427,12 +571,66 @@ template<bool FlipCanvasUpsideDown, typename T>
 void Painter::Impl::fillSpriteVertices(
     T*                   dst,
     Span<InternalSprite> sprites,
-    const Rectangle&     imageSizeAndInverse) const
+    Span<Rectangle>      imageSizesAndInverse)
 {
-    for (const auto& sprite : sprites)
+    const auto fillRange = [dst, sprites, imageSizesAndInverse](u32 offset, u32 count)
+    {
+        const auto rangeSprites = sprites.subspan(offset, count);
+        auto*      rangeDst     = dst + (offset * verticesPerSprite);
+
+        // The vectorized kernel handles sprites in groups of four; the rest is filled one by one.
+        // It only writes the unpacked vertex layouts.
+        auto simdSpriteCount = 0u;
+
+        if constexpr (std::is_same_v<T, SpriteVertex> or std::is_same_v<T, MultiImageSpriteVertex>)
+        {
+            simdSpriteCount =
+                fillSpriteVerticesSimd(rangeDst, rangeSprites, imageSizesAndInverse, FlipCanvasUpsideDown);
+        }
+
+        rangeDst += simdSpriteCount * verticesPerSprite;
+
+        for (const auto& sprite : rangeSprites.subspan(simdSpriteCount))
+        {
+            fillSprite<FlipCanvasUpsideDown>(sprite, rangeDst, imageSizesAndInverse[sprite.imageSlot]);
+            rangeDst += verticesPerSprite;
+        }
+    };
+
+    if (_vertexWorkerPool and sprites.size() >= _vertexGenerationOptions.minSpriteCount)
+    {
+        // Every sprite has a fixed number of vertices, so each chunk knows its destination.
+        // Chunks are kept at multiples of four sprites for the vectorized kernel.
+        fillVerticesInParallel(sprites.size(), 4, fillRange);
+    }
+    else
+    {
+        fillRange(0, sprites.size());
+    }
+}
+
+template<bool FlipCanvasUpsideDown>
+void Painter::Impl::fillSpriteInstances(
+    SpriteInstance*      dst,
+    Span<InternalSprite> sprites,
+    Span<Rectangle>      imageSizesAndInverse)
+{
+    const auto fillRange = [dst, sprites, imageSizesAndInverse](u32 offset, u32 count)
+    {
+        for (auto i = offset; i < offset + count; ++i)
+        {
+            const auto& sprite = sprites[i];
+            dst[i] = makeSpriteInstance<FlipCanvasUpsideDown>(sprite, imageSizesAndInverse[sprite.imageSlot]);
+        }
+    };
+
+    if (_vertexWorkerPool and sprites.size() >= _vertexGenerationOptions.minSpriteCount)
     {
-        fillSprite<FlipCanvasUpsideDown>(sprite, dst, imageSizeAndInverse);
-        dst += verticesPerSprite;
+        fillVerticesInParallel(sprites.size(), 1, fillRange);
+    }
+    else
+    {
+        fillRange(0, sprites.size());
     }
 }
 
@@ -441,36 +639,65 @@ Painter::Impl::MeshFillResult Painter::Impl::fillMeshVertices(
     Span<MeshEntry> meshes,
     TVertex*        dstVertices,
     TIndex*         dstIndices,
-    u32             baseVertex) const
+    u32             baseVertex)
 {
+    if (_vertexWorkerPool)
+    {
+        const auto vertexCount = sumBy(meshes, [](const MeshEntry& entry) { return entry.vertices.size(); });
+
+        if (vertexCount >= _vertexGenerationOptions.minMeshVertexCount)
+        {
+            // Each mesh's destination offsets are given by the prefix sum of all previous meshes.
+            auto offsets = List<MeshFillResult>();
+            offsets.reserve(meshes.size() + 1);
+            offsets.add(MeshFillResult{.totalVertexCount = 0, .totalIndexCount = 0});
+
+            for (const auto& entry : meshes)
+            {
+                const auto last = offsets.last();
+
+                offsets.add(
+                    MeshFillResult{
+                        .totalVertexCount = last.totalVertexCount + entry.vertices.size(),
+                        .totalIndexCount  = last.totalIndexCount + entry.indices.size(),
+                    });
+            }
+
+            fillVerticesInParallel(
+                meshes.size(),
+                1,
+                [&](u32 offset, u32 count)
+                {
+                    for (auto i = offset; i < offset + count; ++i)
+                    {
+                        const auto& meshOffsets = offsets[i];
+
+                        fillMeshEntryVertices(
+                            meshes[i],
+                            dstVertices + meshOffsets.totalVertexCount,
+                            dstIndices + meshOffsets.totalIndexCount,
+                            baseVertex + meshOffsets.totalVertexCount);
+                    }
+                });
+
+            return offsets.last();
+        }
+    }
+
     auto totalVertexCount = u32(0);
     auto totalIndexCount  = u32(0);
 
+    // The meshes are guaranteed to fit into the buffers, since flush() splits larger batches.
     for (const auto& entry : meshes)
     {
-        const auto vertexCount    = entry.vertices.size();
-        const auto indexCount     = entry.indices.size();
-        const auto newVertexCount = totalVertexCount + vertexCount;
+        const auto vertexCount = entry.vertices.size();
+        const auto indexCount  = entry.indices.size();
 
-        if (newVertexCount > _maxMeshVertices)
-        {
-            throw Error(formatString(
-                "Attempting to draw too many meshes at once. The maximum number of {} mesh "
-                "vertices would be "
-                "exceeded.",
-                _maxMeshVertices));
-        }
-
-        std::memcpy(dstVertices, entry.vertices.data(), sizeof(MeshVertex) * vertexCount);
+        fillMeshEntryVertices(entry, dstVertices, dstIndices, baseVertex);
         dstVertices += vertexCount;
+        dstIndices += indexCount;
 
-        for (auto i = 0u; i < indexCount; ++i)
-        {
-            *dstIndices = entry.indices[i] + static_cast<uint16_t>(baseVertex);
-            ++dstIndices;
-        }
-
-        totalVertexCount = newVertexCount;
+        totalVertexCount += vertexCount;
         totalIndexCount += indexCount;
 
         baseVertex += vertexCount;
@@ -482,15 +709,45 @@ Painter::Impl::MeshFillResult Painter::Impl::fillMeshVertices(
     };
 }
 
-template<bool FlipCanvasUpsideDown, typename T>
-void Painter::Impl::fillSprite(
+template<typename TVertex, typename TIndex>
+void Painter::Impl::fillMeshEntryVertices(
+    const MeshEntry& entry,
+    TVertex*         dstVertices,
+    TIndex*          dstIndices,
+    u32              baseVertex)
+{
+    if constexpr (std::is_same_v<TVertex, MeshVertex>)
+    {
+        std::memcpy(dstVertices, entry.vertices.data(), sizeof(MeshVertex) * entry.vertices.size());
+    }
+    else
+    {
+        for (const auto& vertex : entry.vertices)
+        {
+            *dstVertices = PackedMeshVertex{
+                .position = vertex.position,
+                .uv       = vertex.uv,
+                .color    = packColor(vertex.color),
+            };
+            ++dstVertices;
+        }
+    }
+
+    for (const auto index : entry.indices)
+    {
+        *dstIndices = static_cast<TIndex>(index + baseVertex);
+        ++dstIndices;
+    }
+}
+
+template<bool FlipCanvasUpsideDown>
+SpriteInstance Painter::Impl::makeSpriteInstance(
     const InternalSprite& sprite,
-    T*                    dstVertices,
     const Rectangle&      imageSizeAndInverse)
 {
-    const auto destination = sprite.dst;
-    const auto source      = sprite.src.scaled(imageSizeAndInverse.size());
-    const auto color       = sprite.color;
+    // This computes the same as fillSprite(), except that the quad's corners are
+    // calculated by the vertex shader.
+    const auto source = sprite.src.scaled(imageSizeAndInverse.size());
 
     auto origin = sprite.origin;
     if (not isZero(sprite.src.width))
@@ -511,30 +768,6 @@ void Painter::Impl::fillSprite(
         origin.y *= imageSizeAndInverse.height;
     }
 
-    const auto rotation = sprite.rotation;
-    const auto dstPos   = destination.topLeft();
-    const auto dstSize  = destination.size();
-
-    const auto [rot_matrix_row1, rot_matrix_row2] = [r = rotation.value]
-    {
-        if (isZero(r))
-        {
-            return Pair(Vec2(1, 0), Vec2(0, 1));
-        }
-
-        const auto s = sin(r);
-        const auto c = cos(r);
-
-        return Pair(Vec2(c, s), Vec2(-s, c));
-    }();
-
-    constexpr auto cornerOffsets = Array{
-        Vec2(0, 0),
-        Vec2(1, 0),
-        Vec2(0, 1),
-        Vec2(1, 1),
-    };
-
     auto flipFlags = u8(sprite.flip);
 
     if constexpr (FlipCanvasUpsideDown)
@@ -545,23 +778,29 @@ void Painter::Impl::fillSprite(
         }
     }
 
-    const auto mirrorBits = u32(flipFlags & 3);
-    const auto srcPos     = source.position();
-    const auto srcSize    = source.size();
+    auto srcPos  = source.position();
+    auto srcSize = source.size();
 
-    for (u32 i = 0; i < verticesPerSprite; ++i)
+    // Flipping mirrors the texture coordinates, which is the same as starting at the
+    // opposite edge of the source rectangle and walking backwards.
+    if (flipFlags & int(SpriteFlip::Horizontally))
     {
-        const auto originOffset = origin;
-        const auto cornerOffset = (cornerOffsets[i] - originOffset) * dstSize;
-        const auto position1    = Vec2(cornerOffset.x) * rot_matrix_row1 + dstPos;
-        const auto position2    = Vec2(cornerOffset.y) * rot_matrix_row2 + position1;
-        const auto uv           = cornerOffsets[i xor mirrorBits] * srcSize + srcPos;
+        srcPos.x += srcSize.x;
+        srcSize.x = -srcSize.x;
+    }
 
-        dstVertices[i] = SpriteVertex{
-            .positionAndUV = Vec4(position2, uv),
-            .color         = color,
-        };
+    if (flipFlags & int(SpriteFlip::Vertically))
+    {
+        srcPos.y += srcSize.y;
+        srcSize.y = -srcSize.y;
     }
+
+    return SpriteInstance{
+        .dst                        = Vec4(sprite.dst.topLeft(), sprite.dst.size()),
+        .src                        = Vec4(srcPos, srcSize),
+        .color                      = sprite.color,
+        .originRotationAndImageSlot = Vec4(origin, sprite.rotation.value, float(sprite.imageSlot)),
+    };
 }
 
 template<bool PerformCanvasCheck, bool PrepareBatchMode, bool IncrementDrawnSpriteCount>
@@ -589,33 +828,69 @@ void Painter::Impl::drawSprite(Sprite sprite)
         }
     }
 
-    if constexpr (PrepareBatchMode)
+    if (_isDrawingDeferred)
     {
-        prepareForBatchMode(frameData, BatchMode::Sprites);
+        recordDeferredSprite(sprite);
+
+        if constexpr (IncrementDrawnSpriteCount)
+        {
+            ++_performanceStats.spriteCount;
+        }
+
+        return;
     }
 
-    if (frameData.spriteBatchImage && frameData.spriteBatchImage != imageImpl)
+    const auto imageRect = Rectangle(0, 0, sprite.image.size());
+    auto       srcRect   = sprite.srcRect.valueOr(imageRect);
+
+    if (auto* atlasEntry = imageImpl->atlasEntry())
     {
-        flush();
+        // Draw from the atlas page instead, unless the sprite samples outside of
+        // its image (e.g. a repeating texture) or the sampler wraps coordinates, which
+        // would wrap around the page instead of the image.
+        const auto isClampingSampler = _currentSampler.addressU == ImageAddressMode::ClampToEdgeTexels
+                                       and _currentSampler.addressV == ImageAddressMode::ClampToEdgeTexels;
+
+        if (isClampingSampler and imageRect.contains(srcRect) and _imageAtlas->tryPlace(*atlasEntry))
+        {
+            imageImpl                 = atlasEntry->page;
+            srcRect                   = srcRect.offsetBy(atlasEntry->position);
+            atlasEntry->lastUsedFrame = _imageAtlas->currentFrame();
+        }
     }
 
-    frameData.spriteQueue.add(
-        InternalSprite{
-            .dst      = sprite.dstRect,
-            .src      = sprite.srcRect.valueOr(Rectangle(0, 0, sprite.image.size())),
-            .color    = sprite.color,
-            .origin   = sprite.origin,
-            .rotation = sprite.rotation,
-            .flip     = sprite.flip,
-            .isCanvas = isCanvas,
-        });
+    if constexpr (PrepareBatchMode)
+    {
+        prepareForBatchMode(frameData, BatchMode::Sprites);
+    }
+
+    auto imageSlot = indexOf(frameData.spriteBatchImages, imageImpl);
 
-    if (frameData.spriteBatchImage != imageImpl)
+    if (!imageSlot)
     {
+        // The image isn't part of the current batch yet. Start a new batch only if
+        // all of its image slots are taken.
+        if (frameData.spriteBatchImages.size() == _maxSpriteBatchImages)
+        {
+            flush();
+        }
+
+        imageSlot = frameData.spriteBatchImages.size();
+        frameData.spriteBatchImages.add(imageImpl);
         frameData.dirtyFlags |= DF_SpriteImage;
     }
 
-    frameData.spriteBatchImage = imageImpl;
+    frameData.spriteQueue.add(
+        InternalSprite{
+            .dst       = sprite.dstRect,
+            .src       = srcRect,
+            .color     = sprite.color,
+            .origin    = sprite.origin,
+            .rotation  = sprite.rotation,
+            .flip      = sprite.flip,
+            .isCanvas  = isCanvas,
+            .imageSlot = u8(*imageSlot),
+        });
 
     if constexpr (IncrementDrawnSpriteCount)
     {
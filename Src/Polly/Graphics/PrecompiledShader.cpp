@@ -0,0 +1,350 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/PrecompiledShader.hpp"
+
+#include "Polly/BinaryReader.hpp"
+#include "Polly/Core/Casting.hpp"
+#include "Polly/Error.hpp"
+#include "Polly/Format.hpp"
+#include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Narrow.hpp"
+#include "Polly/ShaderCompiler/Ast.hpp"
+#include "Polly/ShaderCompiler/CBufferPacker.hpp"
+#include "Polly/ShaderCompiler/Decl.hpp"
+#include "Polly/ShaderCompiler/GLSLShaderGenerator.hpp"
+#include "Polly/ShaderCompiler/HLSLShaderGenerator.hpp"
+#include "Polly/ShaderCompiler/MetalShaderGenerator.hpp"
+#include "Polly/ShaderCompiler/Naming.hpp"
+#include "Polly/ShaderCompiler/ShaderGenerator.hpp"
+#include "Polly/ShaderCompiler/Transformer.hpp"
+#include "Polly/ShaderCompiler/Type.hpp"
+
+namespace Polly
+{
+// Increment this whenever the serialized layout changes.
+static constexpr auto precompiledShaderFormatVersion = u8(1);
+
+static ShaderParameterType convertShdTypeToParamType(const ShaderCompiler::Type* type)
+{
+    if (type == ShaderCompiler::IntType::instance())
+    {
+        return ShaderParameterType::Int;
+    }
+    else if (type == ShaderCompiler::FloatType::instance())
+    {
+        return ShaderParameterType::Float;
+    }
+    else if (type == ShaderCompiler::BoolType::instance())
+    {
+        return ShaderParameterType::Bool;
+    }
+    else if (type == ShaderCompiler::Vec2Type::instance())
+    {
+        return ShaderParameterType::Vec2;
+    }
+    else if (type == ShaderCompiler::Vec3Type::instance())
+    {
+        return ShaderParameterType::Vec3;
+    }
+    else if (type == ShaderCompiler::Vec4Type::instance())
+    {
+        return ShaderParameterType::Vec4;
+    }
+    else if (type == ShaderCompiler::MatrixType::instance())
+    {
+        return ShaderParameterType::Matrix;
+    }
+    else if (const auto* arrayType = as<ShaderCompiler::ArrayType>(type))
+    {
+        const auto* elementType = arrayType->elementType();
+
+        if (elementType == ShaderCompiler::IntType::instance())
+        {
+            return ShaderParameterType::IntArray;
+        }
+        else if (elementType == ShaderCompiler::FloatType::instance())
+        {
+            return ShaderParameterType::FloatArray;
+        }
+        else if (elementType == ShaderCompiler::BoolType::instance())
+        {
+            return ShaderParameterType::BoolArray;
+        }
+        else if (elementType == ShaderCompiler::Vec2Type::instance())
+        {
+            return ShaderParameterType::Vec2Array;
+        }
+        else if (elementType == ShaderCompiler::Vec3Type::instance())
+        {
+            return ShaderParameterType::Vec3Array;
+        }
+        else if (elementType == ShaderCompiler::Vec4Type::instance())
+        {
+            return ShaderParameterType::Vec4Array;
+        }
+        else if (elementType == ShaderCompiler::MatrixType::instance())
+        {
+            return ShaderParameterType::MatrixArray;
+        }
+    }
+
+    throw Error("Unknown shader parameter type specified.");
+}
+
+const ShaderCompiler::FunctionDecl* findUserShaderEntryPoint(const ShaderCompiler::Ast& ast)
+{
+    const auto maybeEntryPointDecl = ast.findDeclByName(ShaderCompiler::Naming::shaderEntryPoint);
+
+    if (!maybeEntryPointDecl)
+    {
+        throw Error("Entry point not found.");
+    }
+
+    const auto* entryPointDecl = maybeEntryPointDecl->get();
+    const auto* entryPointFunc = as<ShaderCompiler::FunctionDecl>(entryPointDecl);
+
+    if (!entryPointFunc)
+    {
+        throw Error("The entry point must be a function.");
+    }
+
+    return entryPointFunc;
+}
+
+UserShaderReflection reflectUserShader(
+    const ShaderCompiler::Ast&          ast,
+    const ShaderCompiler::FunctionDecl* entryPoint)
+{
+    const auto paramDecls = ShaderCompiler::ShaderGenerator::extractShaderParameters(ast, entryPoint);
+
+    auto result = UserShaderReflection();
+    result.parameters.reserve(paramDecls.size());
+
+    auto paramTypes = List<const ShaderCompiler::Type*, 4>();
+    paramTypes.reserve(paramDecls.size());
+
+    for (const auto& param : paramDecls)
+    {
+        paramTypes.add(param->type());
+    }
+
+    const auto cbufferPacking = ShaderCompiler::CBufferPacker::pack(paramTypes);
+
+    for (u32 idx = 0; const auto& param : paramDecls)
+    {
+        result.parameters.add(
+            ShaderParameter{
+                .name         = String(param->name()),
+                .type         = convertShdTypeToParamType(param->type()),
+                .offset       = cbufferPacking.offsets[idx],
+                .sizeInBytes  = param->type()->occupiedSizeInCbuffer(),
+                .arraySize    = param->arraySize(),
+                .defaultValue = param->defaultValue(),
+            });
+
+        ++idx;
+    }
+
+    if (entryPoint->usesSystemValues())
+    {
+        result.flags |= UserShaderFlags::UsesSystemValues;
+    }
+
+    result.cbufferSize = cbufferPacking.cbufferSize;
+
+    return result;
+}
+
+PrecompiledShader PrecompiledShader::compile(StringView sourceCode, StringView filenameHint)
+{
+    auto result = PrecompiledShader();
+
+    ShaderCompiler::Transformer().transform(
+        sourceCode,
+        filenameHint,
+        [&](const ShaderCompiler::Ast& ast, const ShaderCompiler::SemaContext& context)
+        {
+            const auto* entryPoint = findUserShaderEntryPoint(ast);
+
+            result.type       = ast.shaderType();
+            result.reflection = reflectUserShader(ast, entryPoint);
+            result.sourceCode = sourceCode;
+
+            // The generators have to be configured exactly like the ones of the respective painters.
+#ifdef polly_have_gfx_opengl
+            result.glslCode = ShaderCompiler::GLSLShaderGenerator(false, maxSpriteBatchImages)
+                                  .generate(context, ast, entryPoint, false);
+#endif
+
+#ifdef polly_have_gfx_d3d11
+            result.hlslCode = ShaderCompiler::HLSLShaderGenerator().generate(context, ast, entryPoint, false);
+#endif
+
+#ifdef polly_have_gfx_metal
+            result.metalCode =
+                ShaderCompiler::MetalShaderGenerator().generate(context, ast, entryPoint, false);
+#endif
+        });
+
+    return result;
+}
+
+template<typename T>
+static T readPod(BinaryReader& reader)
+{
+    auto value = T();
+    reader.readBytesInto(MutableSpan(reinterpret_cast<u8*>(&value), sizeof(value)));
+    return value;
+}
+
+template<typename T>
+static void writePod(List<u8>& out, const T& value)
+{
+    out.addRange(Span(reinterpret_cast<const u8*>(&value), narrow<u32>(sizeof(value))));
+}
+
+static Maybe<u16> readMaybeU16(BinaryReader& reader)
+{
+    if (reader.readBool())
+    {
+        return reader.readUInt16();
+    }
+
+    return none;
+}
+
+static void writeMaybeU16(List<u8>& out, Maybe<u16> value)
+{
+    writePod(out, u8(value ? 1 : 0));
+
+    if (value)
+    {
+        writePod(out, *value);
+    }
+}
+
+static Any readDefaultValue(BinaryReader& reader)
+{
+    switch (const auto type = AnyType(reader.readUInt8()))
+    {
+        case AnyType::None: return Any();
+        case AnyType::Int: return readPod<int>(reader);
+        case AnyType::Float: return readPod<float>(reader);
+        case AnyType::Double: return readPod<double>(reader);
+        case AnyType::Bool: return reader.readBool();
+        case AnyType::Vec2: return readPod<Vec2>(reader);
+        case AnyType::Vec3: return readPod<Vec3>(reader);
+        case AnyType::Vec4: return readPod<Vec4>(reader);
+        case AnyType::Matrix: return readPod<Matrix>(reader);
+        default: throw Error(formatString("Invalid shader parameter default value type ({}).", int(type)));
+    }
+}
+
+static void writeDefaultValue(List<u8>& out, const Any& value)
+{
+    writePod(out, u8(value.type()));
+
+    switch (value.type())
+    {
+        case AnyType::None: break;
+        case AnyType::Int: writePod(out, value.get<int>()); break;
+        case AnyType::Float: writePod(out, value.get<float>()); break;
+        case AnyType::Double: writePod(out, value.get<double>()); break;
+        case AnyType::Bool: writePod(out, u8(value.get<bool>() ? 1 : 0)); break;
+        case AnyType::Vec2: writePod(out, value.get<Vec2>()); break;
+        case AnyType::Vec3: writePod(out, value.get<Vec3>()); break;
+        case AnyType::Vec4: writePod(out, value.get<Vec4>()); break;
+        case AnyType::Matrix: writePod(out, value.get<Matrix>()); break;
+        default:
+            throw Error(
+                formatString("Unsupported shader parameter default value type ({}).", int(value.type())));
+    }
+}
+
+// Mirrors BinaryReader::readString() and BinaryReader::readEncryptedString().
+static void writeString(List<u8>& out, StringView str, StringView encryptionKey)
+{
+    writePod(out, narrow<i32>(str.size()));
+
+    const auto keySize = encryptionKey.size();
+
+    for (u32 i = 0; i < str.size(); ++i)
+    {
+        const auto ch = keySize > 0 ? char(int(str[i]) xor encryptionKey[i % keySize]) : str[i];
+        out.add(u8(ch));
+    }
+}
+
+PrecompiledShader PrecompiledShader::deserialize(BinaryReader& reader)
+{
+    if (const auto formatVersion = reader.readUInt8(); formatVersion != precompiledShaderFormatVersion)
+    {
+        throw Error(formatString("Unsupported precompiled shader format ({}).", formatVersion));
+    }
+
+    auto result = PrecompiledShader();
+
+    result.type                   = ShaderType(reader.readUInt8());
+    result.reflection.flags       = UserShaderFlags(reader.readUInt8());
+    result.reflection.cbufferSize = reader.readUInt16();
+
+    const auto parameterCount = reader.readUInt32();
+    result.reflection.parameters.reserve(parameterCount);
+
+    for (u32 i = 0; i < parameterCount; ++i)
+    {
+        auto name         = reader.readEncryptedString();
+        const auto type   = ShaderParameterType(reader.readUInt8());
+        const auto offset = reader.readUInt16();
+        const auto size   = readMaybeU16(reader);
+        const auto count  = readMaybeU16(reader);
+
+        result.reflection.parameters.add(
+            ShaderParameter{
+                .name         = std::move(name),
+                .type         = type,
+                .offset       = offset,
+                .sizeInBytes  = size,
+                .arraySize    = count,
+                .defaultValue = readDefaultValue(reader),
+            });
+    }
+
+    result.sourceCode = reader.readEncryptedString();
+    result.glslCode   = reader.readEncryptedString();
+    result.hlslCode   = reader.readEncryptedString();
+    result.metalCode  = reader.readEncryptedString();
+
+    return result;
+}
+
+List<u8> PrecompiledShader::serialize(StringView encryptionKey) const
+{
+    auto out = List<u8>();
+
+    writePod(out, precompiledShaderFormatVersion);
+    writePod(out, u8(type));
+    writePod(out, u8(reflection.flags));
+    writePod(out, reflection.cbufferSize);
+    writePod(out, reflection.parameters.size());
+
+    for (const auto& param : reflection.parameters)
+    {
+        writeString(out, param.name, encryptionKey);
+        writePod(out, u8(param.type));
+        writePod(out, param.offset);
+        writeMaybeU16(out, param.sizeInBytes);
+        writeMaybeU16(out, param.arraySize);
+        writeDefaultValue(out, param.defaultValue);
+    }
+
+    writeString(out, sourceCode, encryptionKey);
+    writeString(out, glslCode, encryptionKey);
+    writeString(out, hlslCode, encryptionKey);
+    writeString(out, metalCode, encryptionKey);
+
+    return out;
+}
+} // namespace Polly
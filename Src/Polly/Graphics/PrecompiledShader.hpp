@@ -0,0 +1,69 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/ShaderImpl.hpp"
+#include "Polly/List.hpp"
+#include "Polly/String.hpp"
+
+namespace Polly
+{
+class BinaryReader;
+
+namespace ShaderCompiler
+{
+class Ast;
+class FunctionDecl;
+} // namespace ShaderCompiler
+
+// The backend-independent interface of a user shader, as seen by the painter.
+struct UserShaderReflection
+{
+    Shader::Impl::ParameterList parameters;
+    UserShaderFlags             flags       = UserShaderFlags::None;
+    u16                         cbufferSize = 0;
+};
+
+// Finds the entry point of a verified user shader AST.
+//
+// @throw Error If the shader has no (valid) entry point.
+const ShaderCompiler::FunctionDecl* findUserShaderEntryPoint(const ShaderCompiler::Ast& ast);
+
+// Extracts the parameters of a user shader and packs them into its cbuffer.
+UserShaderReflection reflectUserShader(
+    const ShaderCompiler::Ast&          ast,
+    const ShaderCompiler::FunctionDecl* entryPoint);
+
+// A user shader that was compiled ahead of time, i.e. at build time of a game.
+//
+// It contains the result of the shader compiler's front end, together with the code that
+// the graphics backend would otherwise generate when the shader is loaded. Loading such a shader
+// therefore skips lexing, parsing, verification and code generation entirely.
+//
+// Code is only generated for the backends that the compiling build of Polly supports, which
+// matches the backend of a game built alongside it. The original source code is kept as well,
+// so that backends without precompiled code can still compile it at runtime.
+struct PrecompiledShader
+{
+    ShaderType           type = ShaderType::Sprite;
+    UserShaderReflection reflection;
+    String               sourceCode;
+    String               glslCode;
+    String               hlslCode;
+    String               metalCode;
+
+    // Compiles a shader for the backends of the current build.
+    //
+    // @throw ShaderCompileError When the source code is ill-formed.
+    static PrecompiledShader compile(StringView sourceCode, StringView filenameHint);
+
+    // Reads a shader that was written by serialize().
+    static PrecompiledShader deserialize(BinaryReader& reader);
+
+    // Writes the shader in the format that is stored in asset archives.
+    // Strings are encrypted using the game's asset encryption key.
+    List<u8> serialize(StringView encryptionKey) const;
+};
+} // namespace Polly
@@ -189,6 +189,12 @@ void Shader::Impl::setDefaultParameterValues()
 
 void Shader::Impl::notifyPainterBeforeParamChanged()
 {
+    if (_isReferencedByDeferredDraws)
+    {
+        // Recorded sprites must be drawn with the parameter values they were recorded with.
+        painter().notifyDeferredShaderParamAboutToChange(*this);
+    }
+
     if (_isInUse)
     {
         painter().notifyShaderParamAboutToChangeWhileBound(*this);
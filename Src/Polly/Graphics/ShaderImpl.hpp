@@ -206,5 +206,8 @@ class Shader::Impl : public GraphicsResource
     SortedSet<const ShaderParameter*> _dirtyScalarParameters;
     UserShaderFlags                   _flags   = UserShaderFlags::None;
     bool                              _isInUse = false;
+
+    // Whether sprites that use this shader are recorded for deferred drawing.
+    bool _isReferencedByDeferredDraws = false;
 };
 } // namespace Polly
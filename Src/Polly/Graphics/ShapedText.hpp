@@ -0,0 +1,30 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Color.hpp"
+#include "Polly/List.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/Rectangle.hpp"
+#include "Polly/Text.hpp"
+
+namespace Polly
+{
+struct TextDecorationRect
+{
+    Rectangle    rect;
+    Maybe<Color> color;
+};
+
+// The result of shaping a string, as drawn by Painter::drawString().
+struct ShapedText
+{
+    List<PreshapedGlyph>     glyphs;
+    List<TextDecorationRect> decorationRects;
+
+    // Set if the text was shaped using distance field glyphs.
+    Maybe<float> distanceFieldScale;
+};
+} // namespace Polly
@@ -0,0 +1,143 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/ShapedTextCache.hpp"
+
+#include <bit>
+
+namespace Polly
+{
+static u64 combineHash(u64 seed, u64 value)
+{
+    return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+}
+
+ShapedTextCache::ShapedTextCache()
+    : ShapedTextCache(hashOf)
+{
+}
+
+ShapedTextCache::ShapedTextCache(HashFunction hashFunction)
+    : _hashOf(hashFunction)
+{
+}
+
+Maybe<const ShapedText&> ShapedTextCache::find(const ShapedTextKey& key, u64 shapingGeneration)
+{
+    const auto hash = _hashOf(key);
+
+    auto* entry = static_cast<Entry*>(nullptr);
+
+    if (auto currentEntry = _currentGeneration.find(hash))
+    {
+        entry = &*currentEntry;
+    }
+    else if (auto previousEntry = _previousGeneration.find(hash);
+             previousEntry and _currentGeneration.size() < maxEntriesPerGeneration)
+    {
+        // Strings that were drawn during the previous generation move into the current one.
+        entry = &_currentGeneration.add(hash, std::move(*previousEntry))->second;
+        _previousGeneration.remove(hash);
+    }
+
+    if (entry and isEntryFor(*entry, key) and entry->shapingGeneration == shapingGeneration)
+    {
+        return entry->shapedText;
+    }
+
+    return none;
+}
+
+ShapedText& ShapedTextCache::prepare(const ShapedTextKey& key, u64 shapingGeneration)
+{
+    const auto hash = _hashOf(key);
+
+    if (auto entry = _currentGeneration.find(hash))
+    {
+        // Either the font has changed its glyphs since the string was shaped, or another
+        // string has the same hash. In the latter case, the most recent one takes its place.
+        assignKey(*entry, key, shapingGeneration);
+        return entry->shapedText;
+    }
+
+    if (_currentGeneration.size() >= maxEntriesPerGeneration)
+    {
+        return _uncachedText;
+    }
+
+    auto newEntry = Entry();
+    assignKey(newEntry, key, shapingGeneration);
+
+    return _currentGeneration.add(hash, std::move(newEntry))->second.shapedText;
+}
+
+void ShapedTextCache::onFrameStarted(u64 frameNumber)
+{
+    if (frameNumber - _generationStartFrame < framesPerGeneration)
+    {
+        return;
+    }
+
+    _previousGeneration   = std::move(_currentGeneration);
+    _currentGeneration    = {};
+    _generationStartFrame = frameNumber;
+}
+
+void ShapedTextCache::clear()
+{
+    _currentGeneration.clear();
+    _previousGeneration.clear();
+    _uncachedText = {};
+}
+
+u32 ShapedTextCache::size() const
+{
+    return _currentGeneration.size() + _previousGeneration.size();
+}
+
+u64 ShapedTextCache::hashOf(const ShapedTextKey& key)
+{
+    auto hash = u64(key.text.hashCode());
+    hash      = combineHash(hash, key.fontId);
+    hash      = combineHash(hash, u64(std::bit_cast<u32>(key.fontSize)));
+
+    if (key.decoration)
+    {
+        hash = combineHash(hash, u64(key.decoration->type()) + 1);
+    }
+
+    return hash;
+}
+
+bool ShapedTextCache::isEntryFor(const Entry& entry, const ShapedTextKey& key)
+{
+    if (entry.fontId != key.fontId or entry.fontSize != key.fontSize or entry.text != key.text)
+    {
+        return false;
+    }
+
+    if (bool(entry.decoration) != bool(key.decoration))
+    {
+        return false;
+    }
+
+    if (key.decoration)
+    {
+        return entry.decoration->type() == key.decoration->type()
+               and entry.decoration->thickness() == key.decoration->thickness()
+               and entry.decoration->color() == key.decoration->color();
+    }
+
+    return true;
+}
+
+void ShapedTextCache::assignKey(Entry& entry, const ShapedTextKey& key, u64 shapingGeneration)
+{
+    entry.text              = String(key.text);
+    entry.fontId            = key.fontId;
+    entry.fontSize          = key.fontSize;
+    entry.decoration        = key.decoration;
+    entry.shapingGeneration = shapingGeneration;
+}
+} // namespace Polly
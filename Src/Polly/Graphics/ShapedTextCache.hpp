@@ -0,0 +1,89 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/ShapedText.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/SortedMap.hpp"
+#include "Polly/String.hpp"
+#include "Polly/TextDecoration.hpp"
+
+namespace Polly
+{
+// Identifies a string that was shaped for drawing.
+struct ShapedTextKey
+{
+    StringView            text;
+    u64                   fontId   = 0;
+    float                 fontSize = 0.0f;
+    Maybe<TextDecoration> decoration;
+};
+
+// Remembers the results of shapeText() across frames, so that strings which are drawn
+// every frame using Painter::drawString() don't have to be shaped again.
+//
+// Entries live in two generations. Every hit moves an entry into the current generation,
+// and when a generation is over, the previous one is dropped. Strings that weren't drawn
+// for a whole generation are therefore evicted without having to track them individually.
+//
+// Each entry remembers the shaping generation of its font (see Font::Impl::shapingGeneration()),
+// and is only returned as long as the font's generation hasn't changed.
+class ShapedTextCache final
+{
+  public:
+    using HashFunction = u64 (*)(const ShapedTextKey& key);
+
+    // The number of frames after which the generations are advanced.
+    // A string that isn't drawn anymore is evicted after one to two generations.
+    static constexpr auto framesPerGeneration = 60u;
+
+    // Limits the memory that strings which change every frame, such as timers, can take up.
+    static constexpr auto maxEntriesPerGeneration = 1024u;
+
+    ShapedTextCache();
+
+    // Allows tests to force hash collisions.
+    explicit ShapedTextCache(HashFunction hashFunction);
+
+    // Returns the shaped text for the key, if it was shaped using the given shaping generation.
+    // The result remains valid until the next call.
+    Maybe<const ShapedText&> find(const ShapedTextKey& key, u64 shapingGeneration);
+
+    // Returns the storage that the key's text is to be shaped into. When the current generation
+    // is full, this is a buffer that isn't cached and is reused by the next call.
+    ShapedText& prepare(const ShapedTextKey& key, u64 shapingGeneration);
+
+    void onFrameStarted(u64 frameNumber);
+
+    void clear();
+
+    u32 size() const;
+
+    static u64 hashOf(const ShapedTextKey& key);
+
+  private:
+    struct Entry
+    {
+        String                text;
+        u64                   fontId   = 0;
+        float                 fontSize = 0.0f;
+        Maybe<TextDecoration> decoration;
+        u64                   shapingGeneration = 0;
+        ShapedText            shapedText;
+    };
+
+    static bool isEntryFor(const Entry& entry, const ShapedTextKey& key);
+
+    static void assignKey(Entry& entry, const ShapedTextKey& key, u64 shapingGeneration);
+
+    HashFunction          _hashOf;
+    SortedMap<u64, Entry> _currentGeneration;
+    SortedMap<u64, Entry> _previousGeneration;
+    u64                   _generationStartFrame = 0;
+
+    // Used for strings that don't fit into the cache anymore.
+    ShapedText _uncachedText;
+};
+} // namespace Polly
@@ -0,0 +1,47 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Software/SoftwareImage.hpp"
+
+namespace Polly
+{
+SoftwareImage::SoftwareImage(
+    Painter::Impl& painter,
+    ImageUsage     usage,
+    u32            width,
+    u32            height,
+    ImageFormat    format,
+    const void*    data)
+    : Impl(painter, usage, width, height, format, true)
+    , _surface(width, height, format, data)
+{
+}
+
+SoftwareSurface& SoftwareImage::surface()
+{
+    return _surface;
+}
+
+const SoftwareSurface& SoftwareImage::surface() const
+{
+    return _surface;
+}
+
+void SoftwareImage::updateData(
+    u32                   x,
+    u32                   y,
+    u32                   width,
+    u32                   height,
+    const void*           data,
+    [[maybe_unused]] bool shouldUpdateImmediately)
+{
+    // System memory is always immediately writable.
+    _surface.update(x, y, width, height, data);
+}
+
+void SoftwareImage::updateFromEnqueuedData(u32 x, u32 y, u32 width, u32 height, const void* data)
+{
+    _surface.update(x, y, width, height, data);
+}
+} // namespace Polly
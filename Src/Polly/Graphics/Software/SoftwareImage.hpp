@@ -0,0 +1,37 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/ImageImpl.hpp"
+#include "Polly/Graphics/Software/SoftwareSurface.hpp"
+
+namespace Polly
+{
+class SoftwareImage final : public Image::Impl
+{
+  public:
+    explicit SoftwareImage(
+        Painter::Impl& painter,
+        ImageUsage     usage,
+        u32            width,
+        u32            height,
+        ImageFormat    format,
+        const void*    data);
+
+    DeleteCopyAndMove(SoftwareImage);
+
+    SoftwareSurface& surface();
+
+    const SoftwareSurface& surface() const;
+
+    void updateData(u32 x, u32 y, u32 width, u32 height, const void* data, bool shouldUpdateImmediately)
+        override;
+
+    void updateFromEnqueuedData(u32 x, u32 y, u32 width, u32 height, const void* data) override;
+
+  private:
+    SoftwareSurface _surface;
+};
+} // namespace Polly
@@ -0,0 +1,552 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Software/SoftwarePainter.hpp"
+
+#include "Polly/Defer.hpp"
+#include "Polly/GamePerformanceStats.hpp"
+#include "Polly/Graphics/InternalSharedShaderStructs.hpp"
+#include "Polly/Graphics/Software/SoftwareImage.hpp"
+#include "Polly/Graphics/Software/SoftwareUserShader.hpp"
+#include "Polly/Graphics/Software/SoftwareWindow.hpp"
+#include "Polly/ImGui.hpp"
+#include "Polly/Logging.hpp"
+#include "Polly/Profiler.hpp"
+#include "Polly/ShaderCompiler/Ast.hpp"
+
+#include <imgui.h>
+
+#include <backends/imgui_impl_sdl3.h>
+
+namespace Polly
+{
+static constexpr auto imGuiBackendFlags =
+    ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures;
+
+SoftwarePainter::SoftwarePainter(Window::Impl& windowImpl, GamePerformanceStats& performanceStats)
+    : Impl(windowImpl, performanceStats)
+    , _workerPool(WorkerPool::defaultWorkerCount())
+    , _rasterizer(_workerPool)
+{
+    // Sprite indices never change, so create them once for the largest possible batch.
+    _spriteIndices.reserve(maxSpriteBatchSize * indicesPerSprite);
+
+    for (auto j = 0u; j < maxSpriteBatchSize * verticesPerSprite; j += verticesPerSprite)
+    {
+        _spriteIndices.add(j);
+        _spriteIndices.add(j + 1);
+        _spriteIndices.add(j + 2);
+
+        _spriteIndices.add(j + 1);
+        _spriteIndices.add(j + 3);
+        _spriteIndices.add(j + 2);
+    }
+
+    auto caps                 = PainterCapabilities();
+    caps.maxImageExtent       = maxImageExtent;
+    caps.maxCanvasWidth       = maxImageExtent;
+    caps.maxCanvasHeight      = maxImageExtent;
+    caps.maxScissorRects      = 1;
+    caps.maxSpriteBatchImages = maxSpriteBatchImages;
+
+    postInit(caps, 1, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices, maxMeshIndices);
+
+    _isInitialized = true;
+
+    if (!ImGui_ImplSDL3_InitForOther(windowImpl.sdlWindow()))
+    {
+        throw Error("Failed to initialize ImGui for SDL3.");
+    }
+
+    auto& io               = ::ImGui::GetIO();
+    io.BackendRendererName = "Polly_Software";
+    io.BackendFlags |= imGuiBackendFlags;
+}
+
+SoftwarePainter::~SoftwarePainter() noexcept
+{
+    logVerbose("Destroying SoftwarePainter");
+    preBackendDtor();
+    destroyImGuiTextures();
+
+    auto& io               = ::ImGui::GetIO();
+    io.BackendRendererName = nullptr;
+    io.BackendFlags &= ~imGuiBackendFlags;
+}
+
+void SoftwarePainter::onFrameStarted()
+{
+    PollyProfileScope("SoftwarePainter::onFrameStarted");
+
+    _currentTarget = &_backBuffer;
+    _scissorRect   = none;
+}
+
+void SoftwarePainter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc)
+{
+    PollyProfileScope("SoftwarePainter::onFrameEnded");
+
+    // ImGui
+    if (imGuiDrawFunc)
+    {
+        PollyProfileScope("ImGui");
+
+        setCanvas({}, none, false);
+
+        defer
+        {
+            ::ImGui::Render();
+            renderImGuiDrawData(*::ImGui::GetDrawData());
+        };
+
+        ImGui_ImplSDL3_NewFrame();
+        ::ImGui::NewFrame();
+        imGuiDrawFunc(imgui);
+        ::ImGui::EndFrame();
+    }
+
+    static_cast<SoftwareWindow&>(window()).present(_backBuffer);
+}
+
+void SoftwarePainter::onBeforeCanvasChanged(
+    [[maybe_unused]] Image     oldCanvas,
+    [[maybe_unused]] Rectangle oldViewport)
+{
+    // Nothing to do.
+}
+
+void SoftwarePainter::onAfterCanvasChanged(Image newCanvas, Maybe<Color> clearColor, Rectangle viewport)
+{
+    if (newCanvas)
+    {
+        _currentTarget = &static_cast<SoftwareImage&>(*newCanvas.impl()).surface();
+    }
+    else
+    {
+        _backBuffer.resize(u32(viewport.width), u32(viewport.height));
+        _currentTarget = &_backBuffer;
+    }
+
+    if (clearColor)
+    {
+        _currentTarget->clear(*clearColor);
+    }
+
+    setDirtyFlags(
+        dirtyFlags()
+        | DF_GlobalCBufferParams
+        | DF_SpriteImage
+        | DF_MeshImage
+        | DF_Sampler
+        | DF_VertexBuffers
+        | DF_PipelineState);
+}
+
+void SoftwarePainter::onSetScissorRects(Span<Rectangle> scissorRects)
+{
+    flush();
+
+    _scissorRect = scissorRects.isEmpty() ? Maybe<Rectangle>() : scissorRects.first();
+}
+
+void SoftwarePainter::requestFrameCapture()
+{
+    throw Error("Frame capturing is not supported by the software painter.");
+}
+
+void SoftwarePainter::readCanvasDataInto(
+    const Image& canvas,
+    u32          x,
+    u32          y,
+    u32          width,
+    u32          height,
+    void*        destination)
+{
+    flush();
+
+    const auto& surface = canvas ? static_cast<const SoftwareImage&>(*canvas.impl()).surface() : _backBuffer;
+
+    surface.read(x, y, width, height, destination);
+}
+
+UniquePtr<Image::Impl> SoftwarePainter::createImage(
+    ImageUsage  usage,
+    u32         width,
+    u32         height,
+    ImageFormat format,
+    const void* data)
+{
+    return makeUnique<SoftwareImage>(*this, usage, width, height, format, data);
+}
+
+UniquePtr<Shader::Impl> SoftwarePainter::onCreateNativeUserShader(
+    const ShaderCompiler::Ast&                           ast,
+    [[maybe_unused]] const ShaderCompiler::SemaContext&  context,
+    [[maybe_unused]] const ShaderCompiler::FunctionDecl* entryPoint,
+    StringView                                           sourceCode,
+    Shader::Impl::ParameterList                          params,
+    UserShaderFlags                                      flags,
+    u16                                                  cbufferSize)
+{
+    // The default shaders are created during initialization; anything after that is a custom one.
+    if (_isInitialized)
+    {
+        logWarning(
+            "The software painter doesn't execute custom shaders. Draw calls that use them fall back to "
+            "the default shading.");
+    }
+
+    return makeUnique<SoftwareUserShader>(
+        *this,
+        ast.shaderType(),
+        sourceCode,
+        std::move(params),
+        flags,
+        cbufferSize);
+}
+
+int SoftwarePainter::prepareDrawCall()
+{
+    const auto df               = dirtyFlags();
+    const auto currentBatchMode = *batchMode();
+
+    if ((df & DF_SpriteImage) || (df & DF_MeshImage))
+    {
+        ++performanceStats().textureChangeCount;
+    }
+
+    const auto* image = currentBatchMode == BatchMode::Sprites ? spriteBatchImage()
+                        : currentBatchMode == BatchMode::Mesh  ? meshBatchImage()
+                                                               : nullptr;
+
+    _drawState = SoftwareDrawState{
+        .target      = _currentTarget,
+        .image       = image ? &static_cast<const SoftwareImage&>(*image).surface() : nullptr,
+        .sampler     = currentSampler(),
+        .blendState  = currentBlendState(),
+        .scissorRect = _scissorRect,
+    };
+
+    _currentTransformation = combinedTransformation();
+    _currentViewportSize   = currentViewport().size();
+
+    return DF_None;
+}
+
+void SoftwarePainter::flushSprites(
+    Span<InternalSprite>  sprites,
+    GamePerformanceStats& stats,
+    Span<Rectangle>       imageSizesAndInverse)
+{
+    PollyProfileScope("SoftwarePainter::flushSprites");
+
+    const auto vertexCount = sprites.size() * verticesPerSprite;
+
+    _spriteVertices.resize(vertexCount);
+    fillSpriteVertices<false>(_spriteVertices.data(), sprites, imageSizesAndInverse);
+
+    _rasterVertices.resize(vertexCount);
+
+    for (auto i = 0u; i < vertexCount; ++i)
+    {
+        const auto& src = _spriteVertices[i];
+
+        _rasterVertices[i] = SoftwareVertex{
+            .position = transformToPixels(Vec2(src.positionAndUV.x, src.positionAndUV.y)),
+            .uv       = Vec2(src.positionAndUV.z, src.positionAndUV.w),
+            .color    = src.color,
+        };
+    }
+
+    // A batch may reference multiple images. Rasterize each run of consecutive
+    // sprites that share the same image at once.
+    const auto images = spriteBatchImages();
+    auto       state  = _drawState;
+
+    for (auto first = 0u; first < sprites.size();)
+    {
+        const auto imageSlot = sprites[first].imageSlot;
+        auto       last      = first + 1;
+
+        while (last < sprites.size() and sprites[last].imageSlot == imageSlot)
+        {
+            ++last;
+        }
+
+        state.image = &static_cast<const SoftwareImage&>(*images[imageSlot]).surface();
+
+        _rasterizer.drawTriangles(
+            state,
+            _rasterVertices,
+            Span(_spriteIndices.data() + first * indicesPerSprite, (last - first) * indicesPerSprite));
+
+        first = last;
+    }
+
+    ++stats.drawCallCount;
+    stats.vertexCount += vertexCount;
+}
+
+void SoftwarePainter::flushPolys(
+    Span<Tessellation2D::Command> polys,
+    Span<u32>                     polyCmdVertexCounts,
+    u32                           numberOfVerticesToDraw,
+    GamePerformanceStats&         stats)
+{
+    PollyProfileScope("SoftwarePainter::flushPolys");
+
+    _polyVertices.resize(numberOfVerticesToDraw, Tessellation2D::PolyVertex(Vec2(), transparent));
+    fillPolyVertices(polys, _polyVertices.data(), polyCmdVertexCounts, numberOfVerticesToDraw);
+
+    _rasterVertices.resize(numberOfVerticesToDraw);
+
+    for (auto i = 0u; i < numberOfVerticesToDraw; ++i)
+    {
+        const auto& src = _polyVertices[i];
+
+        _rasterVertices[i] = SoftwareVertex{
+            .position = transformToPixels(Vec2(src.position.x, src.position.y)),
+            .uv       = Vec2(),
+            .color    = src.color,
+        };
+    }
+
+    // Polygons are drawn as a single triangle strip; the rasterizer discards the degenerate
+    // triangles that join individual commands.
+    _stripIndices.clear();
+
+    for (auto i = 0u; i + 2 < numberOfVerticesToDraw; ++i)
+    {
+        _stripIndices.add(i);
+        _stripIndices.add(i + 1);
+        _stripIndices.add(i + 2);
+    }
+
+    _rasterizer.drawTriangles(_drawState, _rasterVertices, _stripIndices);
+
+    ++stats.drawCallCount;
+    stats.vertexCount += numberOfVerticesToDraw;
+}
+
+void SoftwarePainter::flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats)
+{
+    PollyProfileScope("SoftwarePainter::flushMeshes");
+
+    auto vertexCount = 0u;
+    auto indexCount  = 0u;
+
+    for (const auto& entry : meshes)
+    {
+        vertexCount += entry.vertices.size();
+        indexCount += entry.indices.size();
+    }
+
+    _meshVertices.resize(vertexCount);
+    _meshIndices.resize(indexCount);
+
+    const auto [totalVertexCount, totalIndexCount] =
+        fillMeshVertices(meshes, _meshVertices.data(), _meshIndices.data(), 0);
+
+    _rasterVertices.resize(totalVertexCount);
+
+    for (auto i = 0u; i < totalVertexCount; ++i)
+    {
+        const auto& src = _meshVertices[i];
+
+        _rasterVertices[i] = SoftwareVertex{
+            .position = transformToPixels(src.position),
+            .uv       = src.uv,
+            .color    = src.color,
+        };
+    }
+
+    _rasterizer.drawTriangles(_drawState, _rasterVertices, Span(_meshIndices.data(), totalIndexCount));
+
+    ++stats.drawCallCount;
+    stats.vertexCount += totalVertexCount;
+}
+
+void SoftwarePainter::spriteQueueLimitReached()
+{
+    // Nothing limits us except the scratch buffer sizes, so just draw what we have so far.
+    flush();
+}
+
+Vec2 SoftwarePainter::transformToPixels(Vec2 position) const
+{
+    // Same as the vertex shaders of the GPU backends (row vector * matrix),
+    // followed by the viewport transformation.
+    const auto& m = _currentTransformation;
+
+    const auto x = position.x * m.row1.x + position.y * m.row2.x + m.row4.x;
+    const auto y = position.x * m.row1.y + position.y * m.row2.y + m.row4.y;
+    const auto w = position.x * m.row1.w + position.y * m.row2.w + m.row4.w;
+
+    const auto invW = isZero(w) ? 1.0f : 1.0f / w;
+
+    return Vec2(
+        (x * invW + 1.0f) * 0.5f * _currentViewportSize.x,
+        (1.0f - y * invW) * 0.5f * _currentViewportSize.y);
+}
+
+void SoftwarePainter::renderImGuiDrawData(const ImDrawData& drawData)
+{
+    if (drawData.Textures)
+    {
+        for (auto* texture : *drawData.Textures)
+        {
+            if (texture->Status != ImTextureStatus_OK)
+            {
+                updateImGuiTexture(*texture);
+            }
+        }
+    }
+
+    const auto clipOffset = Vec2(drawData.DisplayPos.x, drawData.DisplayPos.y);
+    const auto clipScale  = Vec2(drawData.FramebufferScale.x, drawData.FramebufferScale.y);
+
+    // ImGui uses straight alpha.
+    auto state = SoftwareDrawState{
+        .target  = &_backBuffer,
+        .image   = nullptr,
+        .sampler = linearClamp,
+        .blendState =
+            BlendState{
+                .isBlendingEnabled = true,
+                .colorSrcBlend     = Blend::SrcAlpha,
+                .colorDstBlend     = Blend::InvSrcAlpha,
+                .alphaSrcBlend     = Blend::One,
+                .alphaDstBlend     = Blend::InvSrcAlpha,
+            },
+        .scissorRect = none,
+    };
+
+    for (const auto* cmdList : drawData.CmdLists)
+    {
+        _rasterVertices.resize(u32(cmdList->VtxBuffer.Size));
+
+        for (auto i = 0u; i < _rasterVertices.size(); ++i)
+        {
+            const auto& src = cmdList->VtxBuffer[int(i)];
+
+            _rasterVertices[i] = SoftwareVertex{
+                .position = (Vec2(src.pos.x, src.pos.y) - clipOffset) * clipScale,
+                .uv       = Vec2(src.uv.x, src.uv.y),
+                .color    = Color::fromInt(
+                    int((src.col >> IM_COL32_R_SHIFT) & 0xFF),
+                    int((src.col >> IM_COL32_G_SHIFT) & 0xFF),
+                    int((src.col >> IM_COL32_B_SHIFT) & 0xFF),
+                    int((src.col >> IM_COL32_A_SHIFT) & 0xFF)),
+            };
+        }
+
+        for (const auto& cmd : cmdList->CmdBuffer)
+        {
+            if (cmd.UserCallback)
+            {
+                if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                {
+                    cmd.UserCallback(cmdList, &cmd);
+                }
+
+                continue;
+            }
+
+            const auto clipMin = (Vec2(cmd.ClipRect.x, cmd.ClipRect.y) - clipOffset) * clipScale;
+            const auto clipMax = (Vec2(cmd.ClipRect.z, cmd.ClipRect.w) - clipOffset) * clipScale;
+
+            if (clipMax.x <= clipMin.x or clipMax.y <= clipMin.y)
+            {
+                continue;
+            }
+
+            state.scissorRect = Rectangle(clipMin, clipMax - clipMin);
+            state.image       = reinterpret_cast<const SoftwareSurface*>(cmd.GetTexID());
+
+            _rasterIndices.resize(cmd.ElemCount);
+
+            for (auto i = 0u; i < cmd.ElemCount; ++i)
+            {
+                _rasterIndices[i] = u32(cmdList->IdxBuffer[int(cmd.IdxOffset + i)]) + cmd.VtxOffset;
+            }
+
+            _rasterizer.drawTriangles(state, _rasterVertices, _rasterIndices);
+        }
+    }
+}
+
+void SoftwarePainter::updateImGuiTexture(ImTextureData& texture)
+{
+    const auto copyPixels = [&texture](SoftwareSurface& surface, int x, int y, int width, int height)
+    {
+        for (auto row = y; row < y + height; ++row)
+        {
+            const auto* src = static_cast<const u8*>(texture.GetPixelsAt(x, row));
+
+            for (auto column = 0; column < width; ++column)
+            {
+                const auto color = texture.Format == ImTextureFormat_Alpha8
+                                       ? Color(1.0f, 1.0f, 1.0f, float(src[column]) / 255.0f)
+                                       : Color::fromInt(
+                                             src[column * 4],
+                                             src[column * 4 + 1],
+                                             src[column * 4 + 2],
+                                             src[column * 4 + 3]);
+
+                surface.store(u32(x + column), u32(row), color);
+            }
+        }
+    };
+
+    if (texture.Status == ImTextureStatus_WantCreate)
+    {
+        auto surface = makeUnique<SoftwareSurface>(
+            u32(texture.Width),
+            u32(texture.Height),
+            ImageFormat::R8G8B8A8UNorm,
+            nullptr);
+
+        copyPixels(*surface, 0, 0, texture.Width, texture.Height);
+
+        texture.SetTexID(ImTextureID(reinterpret_cast<intptr_t>(surface.get())));
+        texture.SetStatus(ImTextureStatus_OK);
+
+        _imGuiTextures.add(std::move(surface));
+    }
+    else if (texture.Status == ImTextureStatus_WantUpdates)
+    {
+        auto& surface = *reinterpret_cast<SoftwareSurface*>(texture.TexID);
+
+        for (const auto& rect : texture.Updates)
+        {
+            copyPixels(surface, rect.x, rect.y, rect.w, rect.h);
+        }
+
+        texture.SetStatus(ImTextureStatus_OK);
+    }
+    else if (texture.Status == ImTextureStatus_WantDestroy and texture.UnusedFrames > 0)
+    {
+        const auto* surface = reinterpret_cast<const SoftwareSurface*>(texture.TexID);
+
+        _imGuiTextures.removeFirstWhere([surface](const auto& ptr) { return ptr.get() == surface; });
+
+        texture.SetTexID(ImTextureID_Invalid);
+        texture.SetStatus(ImTextureStatus_Destroyed);
+    }
+}
+
+void SoftwarePainter::destroyImGuiTextures()
+{
+    for (auto* texture : ::ImGui::GetPlatformIO().Textures)
+    {
+        if (texture->RefCount == 1)
+        {
+            texture->SetTexID(ImTextureID_Invalid);
+            texture->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+
+    _imGuiTextures.clear();
+}
+} // namespace Polly
@@ -0,0 +1,122 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Core/WorkerPool.hpp"
+#include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Graphics/Software/SoftwareRasterizer.hpp"
+#include "Polly/Graphics/Software/SoftwareSurface.hpp"
+#include "Polly/Graphics/Tessellation2D.hpp"
+#include "Polly/List.hpp"
+
+struct ImDrawData;
+struct ImTextureData;
+
+namespace Polly
+{
+// A painter that renders everything on the CPU into system memory.
+//
+// It's useful on systems without a usable GPU driver, in CI environments and for
+// producing reference images. Sprites, polygons, meshes, canvases, blend states,
+// samplers and scissor rects are supported. Custom shaders are accepted, but draw
+// calls always use the default shading of their respective batch mode.
+class SoftwarePainter final : public Painter::Impl
+{
+  public:
+    explicit SoftwarePainter(Window::Impl& windowImpl, GamePerformanceStats& performanceStats);
+
+    DeleteCopyAndMove(SoftwarePainter);
+
+    ~SoftwarePainter() noexcept override;
+
+    void onFrameStarted() override;
+
+    void onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc) override;
+
+    void onBeforeCanvasChanged(Image oldCanvas, Rectangle oldViewport) override;
+
+    void onAfterCanvasChanged(Image newCanvas, Maybe<Color> clearColor, Rectangle viewport) override;
+
+    void onSetScissorRects(Span<Rectangle> scissorRects) override;
+
+    void requestFrameCapture() override;
+
+    // Copies a region of a canvas into destination, with tightly packed rows in the canvas's format.
+    // If canvas is empty, the back buffer is read instead, which holds the frame drawn so far.
+    // Pending draw calls are flushed first.
+    void readCanvasDataInto(const Image& canvas, u32 x, u32 y, u32 width, u32 height, void* destination);
+
+    UniquePtr<Image::Impl> createImage(
+        ImageUsage  usage,
+        u32         width,
+        u32         height,
+        ImageFormat format,
+        const void* data) override;
+
+    UniquePtr<Shader::Impl> onCreateNativeUserShader(
+        const ShaderCompiler::Ast&          ast,
+        const ShaderCompiler::SemaContext&  context,
+        const ShaderCompiler::FunctionDecl* entryPoint,
+        StringView                          sourceCode,
+        Shader::Impl::ParameterList         params,
+        UserShaderFlags                     flags,
+        u16                                 cbufferSize) override;
+
+  private:
+    // There are no GPU buffers to overflow; these only bound the size of a single flush.
+    static constexpr auto maxSpriteBatchSize = 16384u;
+    static constexpr auto maxPolyVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshIndices     = maxMeshVertices * 3;
+    static constexpr auto maxImageExtent     = 16384u;
+
+    int prepareDrawCall() override;
+
+    void flushSprites(
+        Span<InternalSprite>  sprites,
+        GamePerformanceStats& stats,
+        Span<Rectangle>       imageSizesAndInverse) override;
+
+    void flushPolys(
+        Span<Tessellation2D::Command> polys,
+        Span<u32>                     polyCmdVertexCounts,
+        u32                           numberOfVerticesToDraw,
+        GamePerformanceStats&         stats) override;
+
+    void flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats) override;
+
+    void spriteQueueLimitReached() override;
+
+    Vec2 transformToPixels(Vec2 position) const;
+
+    void renderImGuiDrawData(const ImDrawData& drawData);
+
+    void updateImGuiTexture(ImTextureData& texture);
+
+    void destroyImGuiTextures();
+
+    WorkerPool         _workerPool;
+    SoftwareRasterizer _rasterizer;
+    SoftwareSurface    _backBuffer;
+    SoftwareSurface*   _currentTarget = nullptr;
+    Maybe<Rectangle>   _scissorRect;
+    SoftwareDrawState  _drawState;
+    Matrix             _currentTransformation;
+    Vec2               _currentViewportSize;
+    bool               _isInitialized = false;
+
+    // Scratch buffers, reused across flushes
+    List<SpriteVertex>               _spriteVertices;
+    List<Tessellation2D::PolyVertex> _polyVertices;
+    List<MeshVertex>                 _meshVertices;
+    List<u32>                        _meshIndices;
+    List<u32>                        _spriteIndices;
+    List<u32>                        _stripIndices;
+    List<SoftwareVertex>             _rasterVertices;
+    List<u32>                        _rasterIndices;
+
+    List<UniquePtr<SoftwareSurface>> _imGuiTextures;
+};
+} // namespace Polly
@@ -0,0 +1,493 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Software/SoftwareRasterizer.hpp"
+
+#include "Polly/Core/WorkerPool.hpp"
+#include "Polly/Graphics/Software/SoftwareSurface.hpp"
+#include "Polly/Math.hpp"
+#include <cmath>
+#include <utility>
+
+namespace Polly
+{
+static constexpr auto subpixelBits  = 4;
+static constexpr auto subpixelScale = 1 << subpixelBits;
+static constexpr auto subpixelHalf  = subpixelScale / 2;
+
+// Keeps fixed-point products within 64 bits, even for absurdly large coordinates.
+static constexpr auto maxAbsCoordinate = float(1 << 26);
+
+static i64 toFixed(float value)
+{
+    return i64(std::lround(clamp(value, -maxAbsCoordinate, maxAbsCoordinate) * float(subpixelScale)));
+}
+
+static Color borderColor(SamplerBorderColor color)
+{
+    switch (color)
+    {
+        case SamplerBorderColor::TransparentBlack: return transparent;
+        case SamplerBorderColor::OpaqueBlack: return black;
+        case SamplerBorderColor::OpaqueWhite: return white;
+    }
+
+    return transparent;
+}
+
+// Maps a texel coordinate into [0, size), or returns -1 if the coordinate refers to the border.
+static int applyAddressMode(int coord, int size, ImageAddressMode mode)
+{
+    switch (mode)
+    {
+        case ImageAddressMode::Repeat: {
+            const auto m = coord % size;
+            return m < 0 ? m + size : m;
+        }
+        case ImageAddressMode::ClampToEdgeTexels: return clamp(coord, 0, size - 1);
+        case ImageAddressMode::ClampToSamplerBorderColor: return coord >= 0 and coord < size ? coord : -1;
+        case ImageAddressMode::Mirror: {
+            const auto period = size * 2;
+            auto       m      = coord % period;
+            m                 = m < 0 ? m + period : m;
+            return m < size ? m : period - 1 - m;
+        }
+    }
+
+    return -1;
+}
+
+static Color fetchTexel(const SoftwareSurface& image, const Sampler& sampler, int x, int y)
+{
+    x = applyAddressMode(x, int(image.width()), sampler.addressU);
+    y = applyAddressMode(y, int(image.height()), sampler.addressV);
+
+    if (x < 0 or y < 0)
+    {
+        return borderColor(sampler.borderColor);
+    }
+
+    return image.load(u32(x), u32(y));
+}
+
+static Color sample(const SoftwareSurface& image, const Sampler& sampler, float u, float v)
+{
+    const auto x = u * float(image.width());
+    const auto y = v * float(image.height());
+
+    if (sampler.filter == ImageFilter::Point)
+    {
+        return fetchTexel(image, sampler, int(std::floor(x)), int(std::floor(y)));
+    }
+
+    const auto fx = x - 0.5f;
+    const auto fy = y - 0.5f;
+    const auto x0 = std::floor(fx);
+    const auto y0 = std::floor(fy);
+    const auto tx = fx - x0;
+    const auto ty = fy - y0;
+    const auto ix = int(x0);
+    const auto iy = int(y0);
+
+    const auto c00 = fetchTexel(image, sampler, ix, iy);
+    const auto c10 = fetchTexel(image, sampler, ix + 1, iy);
+    const auto c01 = fetchTexel(image, sampler, ix, iy + 1);
+    const auto c11 = fetchTexel(image, sampler, ix + 1, iy + 1);
+
+    const auto top    = c00 + (c10 - c00) * tx;
+    const auto bottom = c01 + (c11 - c01) * tx;
+
+    return top + (bottom - top) * ty;
+}
+
+static float blendFactor(Blend blend, int channel, const Color& src, const Color& dst, const Color& constant)
+{
+    const auto get = [channel](const Color& color)
+    {
+        switch (channel)
+        {
+            case 0: return color.r;
+            case 1: return color.g;
+            case 2: return color.b;
+            default: return color.a;
+        }
+    };
+
+    switch (blend)
+    {
+        case Blend::One: return 1.0f;
+        case Blend::Zero: return 0.0f;
+        case Blend::SrcColor: return get(src);
+        case Blend::InvSrcColor: return 1.0f - get(src);
+        case Blend::SrcAlpha: return src.a;
+        case Blend::InvSrcAlpha: return 1.0f - src.a;
+        case Blend::DstColor: return get(dst);
+        case Blend::InvDstColor: return 1.0f - get(dst);
+        case Blend::DstAlpha: return dst.a;
+        case Blend::InvDstAlpha: return 1.0f - dst.a;
+        case Blend::BlendFactor: return get(constant);
+        case Blend::InvBlendFactor: return 1.0f - get(constant);
+        case Blend::SrcAlphaSaturation: return channel == 3 ? 1.0f : min(src.a, 1.0f - dst.a);
+    }
+
+    return 1.0f;
+}
+
+static float blendChannel(BlendFunction function, float src, float srcFactor, float dst, float dstFactor)
+{
+    switch (function)
+    {
+        case BlendFunction::Add: return src * srcFactor + dst * dstFactor;
+        case BlendFunction::Subtract: return src * srcFactor - dst * dstFactor;
+        case BlendFunction::ReverseSubtract: return dst * dstFactor - src * srcFactor;
+        case BlendFunction::Min: return min(src, dst);
+        case BlendFunction::Max: return max(src, dst);
+    }
+
+    return src;
+}
+
+static Color blend(const BlendState& state, const Color& src, const Color& dst)
+{
+    const auto color = [&](int channel, float s, float d)
+    {
+        return blendChannel(
+            state.colorBlendFunction,
+            s,
+            blendFactor(state.colorSrcBlend, channel, src, dst, state.blendFactor),
+            d,
+            blendFactor(state.colorDstBlend, channel, src, dst, state.blendFactor));
+    };
+
+    return Color(
+        color(0, src.r, dst.r),
+        color(1, src.g, dst.g),
+        color(2, src.b, dst.b),
+        blendChannel(
+            state.alphaBlendFunction,
+            src.a,
+            blendFactor(state.alphaSrcBlend, 3, src, dst, state.blendFactor),
+            dst.a,
+            blendFactor(state.alphaDstBlend, 3, src, dst, state.blendFactor)));
+}
+
+static Color applyColorWriteMask(ColorWriteMask mask, const Color& src, const Color& dst)
+{
+    return Color(
+        hasFlag(mask, ColorWriteMask::Red) ? src.r : dst.r,
+        hasFlag(mask, ColorWriteMask::Green) ? src.g : dst.g,
+        hasFlag(mask, ColorWriteMask::Blue) ? src.b : dst.b,
+        hasFlag(mask, ColorWriteMask::Alpha) ? src.a : dst.a);
+}
+
+SoftwareRasterizer::SoftwareRasterizer(WorkerPool& workerPool)
+    : _workerPool(workerPool)
+{
+}
+
+void SoftwareRasterizer::drawTriangles(
+    const SoftwareDrawState& state,
+    Span<SoftwareVertex>     vertices,
+    Span<u32>                indices)
+{
+    assume(state.target);
+
+    const auto& target = *state.target;
+
+    auto clipMinX = 0;
+    auto clipMinY = 0;
+    auto clipMaxX = int(target.width());
+    auto clipMaxY = int(target.height());
+
+    if (state.scissorRect)
+    {
+        const auto& rect = *state.scissorRect;
+
+        clipMinX = max(clipMinX, int(std::floor(rect.x)));
+        clipMinY = max(clipMinY, int(std::floor(rect.y)));
+        clipMaxX = min(clipMaxX, int(std::ceil(rect.right())));
+        clipMaxY = min(clipMaxY, int(std::ceil(rect.bottom())));
+    }
+
+    if (clipMinX >= clipMaxX or clipMinY >= clipMaxY)
+    {
+        return;
+    }
+
+    _triangles.clear();
+
+    for (auto i = 0u; i + 2 < indices.size(); i += 3)
+    {
+        setupTriangle(
+            vertices[indices[i]],
+            vertices[indices[i + 1]],
+            vertices[indices[i + 2]],
+            clipMinX,
+            clipMinY,
+            clipMaxX,
+            clipMaxY);
+    }
+
+    if (_triangles.isEmpty())
+    {
+        return;
+    }
+
+    auto coveredMinY         = clipMaxY;
+    auto coveredMaxY         = clipMinY;
+    auto estimatedPixelCount = i64(0);
+
+    for (const auto& triangle : _triangles)
+    {
+        const auto width  = i64(triangle.maxX - triangle.minX + 1);
+        const auto height = i64(triangle.maxY - triangle.minY + 1);
+
+        coveredMinY = min(coveredMinY, triangle.minY);
+        coveredMaxY = max(coveredMaxY, triangle.maxY + 1);
+        estimatedPixelCount += width * height / 2;
+    }
+
+    const auto triangles = Span<Triangle>(_triangles);
+    const auto tileCount = u32((coveredMaxY - coveredMinY + tileHeight - 1) / tileHeight);
+
+    const auto rasterizeTileAt = [&](u32 tileIndex)
+    {
+        const auto tileMinY = coveredMinY + int(tileIndex) * tileHeight;
+        rasterizeTile(state, triangles, tileMinY, min(tileMinY + tileHeight, coveredMaxY));
+    };
+
+    if (estimatedPixelCount < minPixelsForParallelRaster)
+    {
+        for (auto i = 0u; i < tileCount; ++i)
+        {
+            rasterizeTileAt(i);
+        }
+    }
+    else
+    {
+        _workerPool.parallelFor(tileCount, rasterizeTileAt);
+    }
+}
+
+void SoftwareRasterizer::setupTriangle(
+    const SoftwareVertex& v0,
+    const SoftwareVertex& v1,
+    const SoftwareVertex& v2,
+    int                   clipMinX,
+    int                   clipMinY,
+    int                   clipMaxX,
+    int                   clipMaxY)
+{
+    const SoftwareVertex* p0 = &v0;
+    const SoftwareVertex* p1 = &v1;
+    const SoftwareVertex* p2 = &v2;
+
+    auto x0 = toFixed(p0->position.x);
+    auto y0 = toFixed(p0->position.y);
+    auto x1 = toFixed(p1->position.x);
+    auto y1 = toFixed(p1->position.y);
+    auto x2 = toFixed(p2->position.x);
+    auto y2 = toFixed(p2->position.y);
+
+    auto area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+
+    if (area == 0)
+    {
+        // Degenerate triangles (e.g. the ones joining triangle strips) don't cover anything.
+        return;
+    }
+
+    // We don't cull; normalize the winding order instead.
+    if (area < 0)
+    {
+        std::swap(p1, p2);
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+        area = -area;
+    }
+
+    // Pixel centers lie at (n + 0.5), so a pixel n is a candidate if its center lies within the bounds.
+    const auto minXf = min(x0, x1, x2);
+    const auto minYf = min(y0, y1, y2);
+    const auto maxXf = max(x0, x1, x2);
+    const auto maxYf = max(y0, y1, y2);
+
+    auto triangle = Triangle();
+    triangle.minX = max(int((minXf - subpixelHalf + subpixelScale - 1) >> subpixelBits), clipMinX);
+    triangle.minY = max(int((minYf - subpixelHalf + subpixelScale - 1) >> subpixelBits), clipMinY);
+    triangle.maxX = min(int((maxXf - subpixelHalf) >> subpixelBits), clipMaxX - 1);
+    triangle.maxY = min(int((maxYf - subpixelHalf) >> subpixelBits), clipMaxY - 1);
+
+    if (triangle.minX > triangle.maxX or triangle.minY > triangle.maxY)
+    {
+        return;
+    }
+
+    const auto setupEdge = [&triangle](u32 index, i64 ax, i64 ay, i64 bx, i64 by)
+    {
+        const auto a = ay - by;
+        const auto b = bx - ax;
+
+        triangle.edgeA[index] = a;
+        triangle.edgeB[index] = b;
+        triangle.edgeC[index] = -(a * ax + b * ay);
+
+        // Top-left rule: any rule works, as long as it's antisymmetric for shared edges.
+        triangle.edgeBias[index] = a > 0 or (a == 0 and b < 0) ? 1 : 0;
+    };
+
+    setupEdge(0, x1, y1, x2, y2);
+    setupEdge(1, x2, y2, x0, y0);
+    setupEdge(2, x0, y0, x1, y1);
+
+    // Attribute planes
+    const auto areaf = float(area) / float(subpixelScale * subpixelScale);
+    const auto dx1   = float(x1 - x0) / float(subpixelScale);
+    const auto dy1   = float(y1 - y0) / float(subpixelScale);
+    const auto dx2   = float(x2 - x0) / float(subpixelScale);
+    const auto dy2   = float(y2 - y0) / float(subpixelScale);
+
+    const auto attributes = [](const SoftwareVertex& v)
+    {
+        return Array<float, attributeCount>{
+            v.uv.x,
+            v.uv.y,
+            v.color.r,
+            v.color.g,
+            v.color.b,
+            v.color.a,
+        };
+    };
+
+    const auto a0 = attributes(*p0);
+    const auto a1 = attributes(*p1);
+    const auto a2 = attributes(*p2);
+
+    triangle.origin = Vec2(float(x0), float(y0)) / float(subpixelScale);
+
+    for (auto i = 0u; i < attributeCount; ++i)
+    {
+        const auto d1 = a1[i] - a0[i];
+        const auto d2 = a2[i] - a0[i];
+
+        triangle.base[i] = a0[i];
+        triangle.ddx[i]  = (d1 * dy2 - d2 * dy1) / areaf;
+        triangle.ddy[i]  = (d2 * dx1 - d1 * dx2) / areaf;
+    }
+
+    _triangles.add(triangle);
+}
+
+void SoftwareRasterizer::rasterizeTile(
+    const SoftwareDrawState& state,
+    Span<Triangle>           triangles,
+    int                      tileMinY,
+    int                      tileMaxY)
+{
+    auto&       target          = *state.target;
+    const auto* image           = state.image;
+    const auto& sampler         = state.sampler;
+    const auto& blendState      = state.blendState;
+    const auto  isBlending      = blendState.isBlendingEnabled;
+    const auto  isColorMasked   = blendState.colorWriteMask != ColorWriteMask::All;
+    const auto  isWritingColors = blendState.colorWriteMask != ColorWriteMask::None;
+
+    if (not isWritingColors)
+    {
+        return;
+    }
+
+    for (const auto& triangle : triangles)
+    {
+        const auto minY = max(triangle.minY, tileMinY);
+        const auto maxY = min(triangle.maxY, tileMaxY - 1);
+
+        if (minY > maxY)
+        {
+            continue;
+        }
+
+        const auto startX  = i64(triangle.minX) * subpixelScale + subpixelHalf;
+        const auto stepX0  = triangle.edgeA[0] * subpixelScale;
+        const auto stepX1  = triangle.edgeA[1] * subpixelScale;
+        const auto stepX2  = triangle.edgeA[2] * subpixelScale;
+        const auto originX = float(triangle.minX) + 0.5f - triangle.origin.x;
+
+        for (auto y = minY; y <= maxY; ++y)
+        {
+            const auto py = i64(y) * subpixelScale + subpixelHalf;
+
+            auto w0 = triangle.edgeA[0] * startX + triangle.edgeB[0] * py + triangle.edgeC[0]
+                      + triangle.edgeBias[0];
+            auto w1 = triangle.edgeA[1] * startX + triangle.edgeB[1] * py + triangle.edgeC[1]
+                      + triangle.edgeBias[1];
+            auto w2 = triangle.edgeA[2] * startX + triangle.edgeB[2] * py + triangle.edgeC[2]
+                      + triangle.edgeBias[2];
+
+            const auto originY = float(y) + 0.5f - triangle.origin.y;
+
+            auto attr = Array<float, attributeCount>();
+
+            for (auto i = 0u; i < attributeCount; ++i)
+            {
+                attr[i] = triangle.base[i] + triangle.ddx[i] * originX + triangle.ddy[i] * originY;
+            }
+
+            auto wasInside = false;
+
+            for (auto x = triangle.minX; x <= triangle.maxX; ++x)
+            {
+                if (w0 > 0 and w1 > 0 and w2 > 0)
+                {
+                    wasInside = true;
+
+                    auto color = Color(attr[2], attr[3], attr[4], attr[5]);
+
+                    if (image)
+                    {
+                        const auto texel = sample(*image, sampler, attr[0], attr[1]);
+
+                        color = Color(
+                            color.r * texel.r,
+                            color.g * texel.g,
+                            color.b * texel.b,
+                            color.a * texel.a);
+                    }
+
+                    if (isBlending or isColorMasked)
+                    {
+                        const auto dst = target.load(u32(x), u32(y));
+
+                        if (isBlending)
+                        {
+                            color = blend(blendState, color, dst);
+                        }
+
+                        if (isColorMasked)
+                        {
+                            color = applyColorWriteMask(blendState.colorWriteMask, color, dst);
+                        }
+                    }
+
+                    target.store(u32(x), u32(y), color);
+                }
+                else if (wasInside)
+                {
+                    // Triangles are convex; once we've left one, the rest of the row is outside.
+                    break;
+                }
+
+                w0 += stepX0;
+                w1 += stepX1;
+                w2 += stepX2;
+
+                for (auto i = 0u; i < attributeCount; ++i)
+                {
+                    attr[i] += triangle.ddx[i];
+                }
+            }
+        }
+    }
+}
+} // namespace Polly
@@ -0,0 +1,108 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Array.hpp"
+#include "Polly/BlendState.hpp"
+#include "Polly/Color.hpp"
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Linalg.hpp"
+#include "Polly/List.hpp"
+#include "Polly/Maybe.hpp"
+#include "Polly/Rectangle.hpp"
+#include "Polly/Sampler.hpp"
+#include "Polly/Span.hpp"
+
+namespace Polly
+{
+class SoftwareSurface;
+class WorkerPool;
+
+// A vertex that has already been transformed into the pixel space of the target surface.
+struct SoftwareVertex
+{
+    Vec2  position;
+    Vec2  uv;
+    Color color;
+};
+
+struct SoftwareDrawState
+{
+    SoftwareSurface*       target = nullptr;
+    const SoftwareSurface* image  = nullptr;
+    Sampler                sampler;
+    BlendState             blendState;
+    Maybe<Rectangle>       scissorRect;
+};
+
+// Rasterizes indexed triangle lists into a SoftwareSurface.
+//
+// The target is split into horizontal bands (tiles) that are rasterized in parallel.
+// Every band processes the triangles in submission order, which keeps blending
+// results identical to sequential rendering.
+// Edge functions are evaluated in 28.4 fixed-point using the top-left fill rule,
+// so triangles that share an edge never touch the same pixel twice.
+class SoftwareRasterizer final
+{
+  public:
+    explicit SoftwareRasterizer(WorkerPool& workerPool);
+
+    DeleteCopyAndMove(SoftwareRasterizer);
+
+    ~SoftwareRasterizer() noexcept = default;
+
+    void drawTriangles(const SoftwareDrawState& state, Span<SoftwareVertex> vertices, Span<u32> indices);
+
+  private:
+    static constexpr auto tileHeight = 32;
+
+    // Below this number of (estimated) covered pixels, a draw is rasterized on the
+    // calling thread, since waking up the workers would cost more than it saves.
+    static constexpr auto minPixelsForParallelRaster = 128 * 128;
+
+    static constexpr auto attributeCount = 6u;
+
+    struct Triangle
+    {
+        // Bounding box in pixels, already clipped against the target and scissor rect.
+        int minX = 0;
+        int minY = 0;
+        int maxX = 0;
+        int maxY = 0;
+
+        // Edge functions (w = a*x + b*y + c), in 28.4 fixed-point.
+        Array<i64, 3> edgeA{};
+        Array<i64, 3> edgeB{};
+        Array<i64, 3> edgeC{};
+
+        // Whether a pixel that lies exactly on an edge belongs to this triangle.
+        Array<i64, 3> edgeBias{};
+
+        // Attribute planes (u, v, r, g, b, a), relative to the first vertex.
+        Vec2                         origin;
+        Array<float, attributeCount> base{};
+        Array<float, attributeCount> ddx{};
+        Array<float, attributeCount> ddy{};
+    };
+
+    void setupTriangle(
+        const SoftwareVertex& v0,
+        const SoftwareVertex& v1,
+        const SoftwareVertex& v2,
+        int                   clipMinX,
+        int                   clipMinY,
+        int                   clipMaxX,
+        int                   clipMaxY);
+
+    static void rasterizeTile(
+        const SoftwareDrawState& state,
+        Span<Triangle>           triangles,
+        int                      tileMinY,
+        int                      tileMaxY);
+
+    WorkerPool&    _workerPool;
+    List<Triangle> _triangles;
+};
+} // namespace Polly
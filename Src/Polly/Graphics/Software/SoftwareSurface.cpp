@@ -0,0 +1,123 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Software/SoftwareSurface.hpp"
+
+#include "Polly/Array.hpp"
+#include "Polly/Error.hpp"
+#include <cmath>
+
+namespace Polly
+{
+static auto createSrgbToLinearTable()
+{
+    auto table = Array<float, 256>();
+
+    for (auto i = 0u; i < 256u; ++i)
+    {
+        const auto value = float(i) / 255.0f;
+
+        table[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    return table;
+}
+
+float srgbToLinear(u8 value)
+{
+    static const auto sTable = createSrgbToLinearTable();
+    return sTable[value];
+}
+
+u8 linearToSrgb(float value)
+{
+    value = clamp(value, 0.0f, 1.0f);
+
+    const auto srgb = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+
+    return u8(srgb * 255.0f + 0.5f);
+}
+
+SoftwareSurface::SoftwareSurface(u32 width, u32 height, ImageFormat format, const void* data)
+    : _width(width)
+    , _height(height)
+    , _format(format)
+    , _bytesPerPixel(imageRowPitch(1, format))
+{
+    if (_bytesPerPixel == 0)
+    {
+        throw Error("Unsupported image format specified for a software surface.");
+    }
+
+    _pixels.resize(imageSlicePitch(width, height, format));
+
+    if (data)
+    {
+        std::memcpy(_pixels.data(), data, _pixels.size());
+    }
+}
+
+void SoftwareSurface::resize(u32 width, u32 height)
+{
+    if (width == _width and height == _height)
+    {
+        return;
+    }
+
+    _width  = width;
+    _height = height;
+    _pixels.resize(imageSlicePitch(width, height, _format));
+}
+
+void SoftwareSurface::update(u32 x, u32 y, u32 width, u32 height, const void* data)
+{
+    const auto* src         = static_cast<const u8*>(data);
+    const auto  srcRowPitch = width * _bytesPerPixel;
+    const auto  dstRowPitch = rowPitch();
+    auto*       dst         = _pixels.data() + size_t(y) * dstRowPitch + size_t(x) * _bytesPerPixel;
+
+    for (auto row = 0u; row < height; ++row)
+    {
+        std::memcpy(dst, src, srcRowPitch);
+        src += srcRowPitch;
+        dst += dstRowPitch;
+    }
+}
+
+void SoftwareSurface::read(u32 x, u32 y, u32 width, u32 height, void* destination) const
+{
+    if (x + width > _width or y + height > _height)
+    {
+        throw Error("The specified region lies outside of the software surface.");
+    }
+
+    const auto  srcRowPitch = rowPitch();
+    const auto  dstRowPitch = width * _bytesPerPixel;
+    const auto* src         = _pixels.data() + size_t(y) * srcRowPitch + size_t(x) * _bytesPerPixel;
+    auto*       dst         = static_cast<u8*>(destination);
+
+    for (auto row = 0u; row < height; ++row)
+    {
+        std::memcpy(dst, src, dstRowPitch);
+        src += srcRowPitch;
+        dst += dstRowPitch;
+    }
+}
+
+void SoftwareSurface::clear(Color color)
+{
+    if (_pixels.isEmpty())
+    {
+        return;
+    }
+
+    // Encode the color once, then replicate it.
+    store(0, 0, color);
+
+    for (auto offset = _bytesPerPixel; offset < _pixels.size(); offset += _bytesPerPixel)
+    {
+        std::memcpy(_pixels.data() + offset, _pixels.data(), _bytesPerPixel);
+    }
+}
+} // namespace Polly
@@ -0,0 +1,164 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Color.hpp"
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Image.hpp"
+#include "Polly/List.hpp"
+#include "Polly/Math.hpp"
+#include <cstring>
+
+namespace Polly
+{
+float srgbToLinear(u8 value);
+
+u8 linearToSrgb(float value);
+
+// A block of system memory that holds the pixels of an image or framebuffer.
+//
+// Pixels are stored top-down, i.e. row 0 is the top-most row, which matches the
+// coordinate system of the painter (Y pointing downwards).
+class SoftwareSurface final
+{
+  public:
+    SoftwareSurface() = default;
+
+    explicit SoftwareSurface(u32 width, u32 height, ImageFormat format, const void* data);
+
+    DeleteCopy(SoftwareSurface);
+
+    DefaultMove(SoftwareSurface);
+
+    ~SoftwareSurface() noexcept = default;
+
+    u32 width() const;
+
+    u32 height() const;
+
+    ImageFormat format() const;
+
+    u32 rowPitch() const;
+
+    u8* data();
+
+    const u8* data() const;
+
+    void resize(u32 width, u32 height);
+
+    void update(u32 x, u32 y, u32 width, u32 height, const void* data);
+
+    // Copies a region of pixels into destination, with tightly packed rows.
+    void read(u32 x, u32 y, u32 width, u32 height, void* destination) const;
+
+    void clear(Color color);
+
+    Color load(u32 x, u32 y) const;
+
+    void store(u32 x, u32 y, Color color);
+
+  private:
+    u32         _width         = 0;
+    u32         _height        = 0;
+    ImageFormat _format        = ImageFormat::R8G8B8A8UNorm;
+    u32         _bytesPerPixel = 4;
+    List<u8>    _pixels;
+};
+
+inline u32 SoftwareSurface::width() const
+{
+    return _width;
+}
+
+inline u32 SoftwareSurface::height() const
+{
+    return _height;
+}
+
+inline ImageFormat SoftwareSurface::format() const
+{
+    return _format;
+}
+
+inline u32 SoftwareSurface::rowPitch() const
+{
+    return _width * _bytesPerPixel;
+}
+
+inline u8* SoftwareSurface::data()
+{
+    return _pixels.data();
+}
+
+inline const u8* SoftwareSurface::data() const
+{
+    return _pixels.data();
+}
+
+inline Color SoftwareSurface::load(u32 x, u32 y) const
+{
+    const auto* src = _pixels.data() + (size_t(y) * _width + x) * _bytesPerPixel;
+
+    switch (_format)
+    {
+        case ImageFormat::R8Unorm: return Color(float(src[0]) / 255.0f, 0.0f, 0.0f, 1.0f);
+        case ImageFormat::R8G8B8A8UNorm:
+            return Color(
+                float(src[0]) / 255.0f,
+                float(src[1]) / 255.0f,
+                float(src[2]) / 255.0f,
+                float(src[3]) / 255.0f);
+        case ImageFormat::R8G8B8A8Srgb:
+            return Color(
+                srgbToLinear(src[0]),
+                srgbToLinear(src[1]),
+                srgbToLinear(src[2]),
+                float(src[3]) / 255.0f);
+        case ImageFormat::R32G32B32A32Float: {
+            auto color = Color();
+            std::memcpy(&color, src, sizeof(Color));
+            return color;
+        }
+    }
+
+    return transparent;
+}
+
+inline void SoftwareSurface::store(u32 x, u32 y, Color color)
+{
+    auto* dst = _pixels.data() + (size_t(y) * _width + x) * _bytesPerPixel;
+
+    const auto toUnorm = [](float value)
+    {
+        return u8(clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+
+    switch (_format)
+    {
+        case ImageFormat::R8Unorm: {
+            dst[0] = toUnorm(color.r);
+            break;
+        }
+        case ImageFormat::R8G8B8A8UNorm: {
+            dst[0] = toUnorm(color.r);
+            dst[1] = toUnorm(color.g);
+            dst[2] = toUnorm(color.b);
+            dst[3] = toUnorm(color.a);
+            break;
+        }
+        case ImageFormat::R8G8B8A8Srgb: {
+            dst[0] = linearToSrgb(color.r);
+            dst[1] = linearToSrgb(color.g);
+            dst[2] = linearToSrgb(color.b);
+            dst[3] = toUnorm(color.a);
+            break;
+        }
+        case ImageFormat::R32G32B32A32Float: {
+            std::memcpy(dst, &color, sizeof(Color));
+            break;
+        }
+    }
+}
+} // namespace Polly
@@ -0,0 +1,19 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Software/SoftwareUserShader.hpp"
+
+namespace Polly
+{
+SoftwareUserShader::SoftwareUserShader(
+    Painter::Impl&  painter,
+    ShaderType      shaderType,
+    StringView      sourceCode,
+    ParameterList   parameters,
+    UserShaderFlags flags,
+    u16             cbufferSize)
+    : Impl(painter, shaderType, sourceCode, std::move(parameters), flags, cbufferSize)
+{
+}
+} // namespace Polly
@@ -0,0 +1,25 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Graphics/ShaderImpl.hpp"
+
+namespace Polly
+{
+// The software painter doesn't execute user shaders. This type only keeps the
+// shader's parameters around, so that shaders can be created, bound and updated
+// just like on any other backend.
+class SoftwareUserShader final : public Shader::Impl
+{
+  public:
+    explicit SoftwareUserShader(
+        Painter::Impl&  painter,
+        ShaderType      shaderType,
+        StringView      sourceCode,
+        ParameterList   parameters,
+        UserShaderFlags flags,
+        u16             cbufferSize);
+};
+} // namespace Polly
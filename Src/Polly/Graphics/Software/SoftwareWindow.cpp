@@ -0,0 +1,74 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Software/SoftwareWindow.hpp"
+
+#include "Polly/Assume.hpp"
+#include "Polly/Defer.hpp"
+#include "Polly/Error.hpp"
+#include "Polly/Graphics/Software/SoftwareSurface.hpp"
+#include "Polly/Logging.hpp"
+
+namespace Polly
+{
+SoftwareWindow::SoftwareWindow(
+    StringView    title,
+    Maybe<Vec2>   initialWindowSize,
+    Maybe<u32>    fullScreenDisplayIndex,
+    Span<Display> displays)
+    : Impl(title)
+{
+    createSDLWindow(0, initialWindowSize, fullScreenDisplayIndex, displays);
+}
+
+SoftwareWindow::~SoftwareWindow() noexcept
+{
+    logVerbose("Destroying SoftwareWindow");
+}
+
+void SoftwareWindow::present(const SoftwareSurface& surface)
+{
+    assume(surface.format() == ImageFormat::R8G8B8A8UNorm);
+
+    auto* windowSurface = SDL_GetWindowSurface(sdlWindow());
+
+    if (!windowSurface)
+    {
+        throw Error(formatString("Failed to obtain the window surface. Reason: {}", SDL_GetError()));
+    }
+
+    auto* srcSurface = SDL_CreateSurfaceFrom(
+        int(surface.width()),
+        int(surface.height()),
+        SDL_PIXELFORMAT_RGBA32,
+        const_cast<u8*>(surface.data()), // NOLINT(*-pro-type-const-cast)
+        int(surface.rowPitch()));
+
+    if (!srcSurface)
+    {
+        throw Error(formatString("Failed to create the presentation surface. Reason: {}", SDL_GetError()));
+    }
+
+    defer
+    {
+        SDL_DestroySurface(srcSurface);
+    };
+
+    if (!SDL_BlitSurface(srcSurface, nullptr, windowSurface, nullptr))
+    {
+        throw Error(formatString("Failed to copy the framebuffer to the window. Reason: {}", SDL_GetError()));
+    }
+
+    if (!SDL_UpdateWindowSurface(sdlWindow()))
+    {
+        throw Error(formatString("Failed to present the window surface. Reason: {}", SDL_GetError()));
+    }
+}
+
+void SoftwareWindow::setIsDisplaySyncEnabled(bool value)
+{
+    Impl::setIsDisplaySyncEnabled(value);
+    SDL_SetWindowSurfaceVSync(sdlWindow(), value ? 1 : SDL_WINDOW_SURFACE_VSYNC_DISABLED);
+}
+} // namespace Polly
@@ -0,0 +1,31 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Game/WindowImpl.hpp"
+
+namespace Polly
+{
+class SoftwareSurface;
+
+class SoftwareWindow final : public Window::Impl
+{
+  public:
+    explicit SoftwareWindow(
+        StringView    title,
+        Maybe<Vec2>   initialWindowSize,
+        Maybe<u32>    fullScreenDisplayIndex,
+        Span<Display> displays);
+
+    DeleteCopyAndMove(SoftwareWindow);
+
+    ~SoftwareWindow() noexcept override;
+
+    // Copies the specified surface (R8G8B8A8UNorm) to the window and presents it.
+    void present(const SoftwareSurface& surface);
+
+    void setIsDisplaySyncEnabled(bool value) override;
+};
+} // namespace Polly
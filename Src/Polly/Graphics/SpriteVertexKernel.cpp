@@ -0,0 +1,505 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/SpriteVertexKernel.hpp"
+
+#include "Polly/Array.hpp"
+#include "Polly/Core/PlatformDetection.hpp"
+#include "Polly/Graphics/InternalSharedShaderStructs.hpp"
+#include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Math.hpp"
+#include <type_traits>
+
+#if polly_have_sse2
+#include <emmintrin.h>
+#elif polly_have_neon
+#include <arm_neon.h>
+#endif
+
+namespace Polly
+{
+#if polly_have_sse2 or polly_have_neon
+
+// Thin wrappers around the intrinsics of the respective instruction set, so that the kernel
+// itself only has to be written once.
+
+#if polly_have_sse2
+
+using Float4 = __m128;
+using Int4   = __m128i;
+using Mask4  = __m128;
+
+static Float4 splat(float value)
+{
+    return _mm_set1_ps(value);
+}
+
+static Float4 set(float x, float y, float z, float w)
+{
+    return _mm_setr_ps(x, y, z, w);
+}
+
+static Float4 load(const float* src)
+{
+    return _mm_loadu_ps(src);
+}
+
+static void store(float* dst, Float4 value)
+{
+    _mm_storeu_ps(dst, value);
+}
+
+static Float4 add(Float4 lhs, Float4 rhs)
+{
+    return _mm_add_ps(lhs, rhs);
+}
+
+static Float4 sub(Float4 lhs, Float4 rhs)
+{
+    return _mm_sub_ps(lhs, rhs);
+}
+
+static Float4 mul(Float4 lhs, Float4 rhs)
+{
+    return _mm_mul_ps(lhs, rhs);
+}
+
+static Float4 div(Float4 lhs, Float4 rhs)
+{
+    return _mm_div_ps(lhs, rhs);
+}
+
+static Float4 absolute(Float4 value)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+static Mask4 equal(Float4 lhs, Float4 rhs)
+{
+    return _mm_cmpeq_ps(lhs, rhs);
+}
+
+static Mask4 lessThan(Float4 lhs, Float4 rhs)
+{
+    return _mm_cmplt_ps(lhs, rhs);
+}
+
+// Picks lanes of a where the mask is set, and lanes of b otherwise.
+static Float4 select(Mask4 mask, Float4 a, Float4 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static Float4 negateWhere(Mask4 mask, Float4 value)
+{
+    return _mm_xor_ps(value, _mm_and_ps(mask, _mm_set1_ps(-0.0f)));
+}
+
+static void transpose(Float4& a, Float4& b, Float4& c, Float4& d)
+{
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+}
+
+static Int4 truncateToInt(Float4 value)
+{
+    return _mm_cvttps_epi32(value);
+}
+
+static Float4 toFloat(Int4 value)
+{
+    return _mm_cvtepi32_ps(value);
+}
+
+static Int4 addInt(Int4 value, int rhs)
+{
+    return _mm_add_epi32(value, _mm_set1_epi32(rhs));
+}
+
+static Int4 andInt(Int4 value, int rhs)
+{
+    return _mm_and_si128(value, _mm_set1_epi32(rhs));
+}
+
+// Gets a mask of the lanes in which a specific single bit is set.
+static Mask4 testBit(Int4 value, int bit)
+{
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(andInt(value, bit), _mm_set1_epi32(bit)));
+}
+
+#elif polly_have_neon
+
+using Float4 = float32x4_t;
+using Int4   = int32x4_t;
+using Mask4  = uint32x4_t;
+
+static Float4 splat(float value)
+{
+    return vdupq_n_f32(value);
+}
+
+static Float4 set(float x, float y, float z, float w)
+{
+    const float values[] = {x, y, z, w};
+    return vld1q_f32(values);
+}
+
+static Float4 load(const float* src)
+{
+    return vld1q_f32(src);
+}
+
+static void store(float* dst, Float4 value)
+{
+    vst1q_f32(dst, value);
+}
+
+static Float4 add(Float4 lhs, Float4 rhs)
+{
+    return vaddq_f32(lhs, rhs);
+}
+
+static Float4 sub(Float4 lhs, Float4 rhs)
+{
+    return vsubq_f32(lhs, rhs);
+}
+
+static Float4 mul(Float4 lhs, Float4 rhs)
+{
+    return vmulq_f32(lhs, rhs);
+}
+
+static Float4 div(Float4 lhs, Float4 rhs)
+{
+    return vdivq_f32(lhs, rhs);
+}
+
+static Float4 absolute(Float4 value)
+{
+    return vabsq_f32(value);
+}
+
+static Mask4 equal(Float4 lhs, Float4 rhs)
+{
+    return vceqq_f32(lhs, rhs);
+}
+
+static Mask4 lessThan(Float4 lhs, Float4 rhs)
+{
+    return vcltq_f32(lhs, rhs);
+}
+
+// Picks lanes of a where the mask is set, and lanes of b otherwise.
+static Float4 select(Mask4 mask, Float4 a, Float4 b)
+{
+    return vbslq_f32(mask, a, b);
+}
+
+static Float4 negateWhere(Mask4 mask, Float4 value)
+{
+    const auto signBits = vandq_u32(mask, vdupq_n_u32(0x80000000u));
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(value), signBits));
+}
+
+static void transpose(Float4& a, Float4& b, Float4& c, Float4& d)
+{
+    const auto ab = vtrnq_f32(a, b);
+    const auto cd = vtrnq_f32(c, d);
+
+    a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+    b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+    c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+    d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+
+static Int4 truncateToInt(Float4 value)
+{
+    return vcvtq_s32_f32(value);
+}
+
+static Float4 toFloat(Int4 value)
+{
+    return vcvtq_f32_s32(value);
+}
+
+static Int4 addInt(Int4 value, int rhs)
+{
+    return vaddq_s32(value, vdupq_n_s32(rhs));
+}
+
+static Int4 andInt(Int4 value, int rhs)
+{
+    return vandq_s32(value, vdupq_n_s32(rhs));
+}
+
+// Gets a mask of the lanes in which a specific single bit is set.
+static Mask4 testBit(Int4 value, int bit)
+{
+    return vceqq_s32(andInt(value, bit), vdupq_n_s32(bit));
+}
+
+#endif
+
+// Beyond this, the range reduction of sinCos() loses too much precision.
+static constexpr auto maxApproximatedAngle = 8192.0f;
+
+// Computes the sine and cosine of four angles at once, using the single-precision
+// polynomials of the Cephes library.
+static void sinCos(Float4 angle, Float4& outSin, Float4& outCos)
+{
+    const auto x = absolute(angle);
+
+    // Determine the octant of the angle and reduce it to [-pi/4, pi/4].
+    auto octant = truncateToInt(mul(x, splat(1.27323954473516f)));
+    octant      = andInt(addInt(octant, 1), ~1);
+
+    const auto y = toFloat(octant);
+
+    auto r = sub(x, mul(y, splat(0.78515625f)));
+    r      = sub(r, mul(y, splat(2.4187564849853515625e-4f)));
+    r      = sub(r, mul(y, splat(3.77489497744594108e-8f)));
+
+    const auto z = mul(r, r);
+
+    auto cosPoly = add(mul(splat(2.443315711809948e-5f), z), splat(-1.388731625493765e-3f));
+    cosPoly      = add(mul(cosPoly, z), splat(4.166664568298827e-2f));
+    cosPoly      = mul(mul(cosPoly, z), z);
+    cosPoly      = add(sub(cosPoly, mul(z, splat(0.5f))), splat(1.0f));
+
+    auto sinPoly = add(mul(splat(-1.9515295891e-4f), z), splat(8.3321608736e-3f));
+    sinPoly      = add(mul(sinPoly, z), splat(-1.6666654611e-1f));
+    sinPoly      = add(mul(mul(sinPoly, z), r), r);
+
+    const auto arePolysSwapped = testBit(octant, 2);
+
+    auto s = select(arePolysSwapped, cosPoly, sinPoly);
+    s      = negateWhere(testBit(octant, 4), s);
+    s      = negateWhere(lessThan(angle, splat(0.0f)), s);
+
+    auto c = select(arePolysSwapped, sinPoly, cosPoly);
+    c      = negateWhere(testBit(addInt(octant, 2), 4), c);
+
+    outSin = s;
+    outCos = c;
+}
+
+template<typename T>
+static u32 fillVertices(
+    T*                   dst,
+    Span<InternalSprite> sprites,
+    Span<Rectangle>      imageSizesAndInverse,
+    bool                 flipCanvasUpsideDown)
+{
+    constexpr auto verticesPerSprite = Painter::Impl::verticesPerSprite;
+
+    const auto groupCount = sprites.size() / 4;
+    const auto zero       = splat(0.0f);
+    const auto one        = splat(1.0f);
+
+    for (auto groupIndex = 0u; groupIndex < groupCount; ++groupIndex)
+    {
+        const auto* group = sprites.data() + (groupIndex * 4);
+
+        // Load four rectangles each and transpose them, so that every register holds a single
+        // component of all four sprites.
+        auto dstX = load(&group[0].dst.x);
+        auto dstY = load(&group[1].dst.x);
+        auto dstW = load(&group[2].dst.x);
+        auto dstH = load(&group[3].dst.x);
+        transpose(dstX, dstY, dstW, dstH);
+
+        auto srcX = load(&group[0].src.x);
+        auto srcY = load(&group[1].src.x);
+        auto srcW = load(&group[2].src.x);
+        auto srcH = load(&group[3].src.x);
+        transpose(srcX, srcY, srcW, srcH);
+
+        auto imageW    = load(&imageSizesAndInverse[group[0].imageSlot].x);
+        auto imageH    = load(&imageSizesAndInverse[group[1].imageSlot].x);
+        auto invImageW = load(&imageSizesAndInverse[group[2].imageSlot].x);
+        auto invImageH = load(&imageSizesAndInverse[group[3].imageSlot].x);
+        transpose(imageW, imageH, invImageW, invImageH);
+
+        auto flipH         = Array<float, 4>();
+        auto flipV         = Array<float, 4>();
+        auto isUnrotated   = true;
+        auto isUnflipped   = true;
+        auto isApproximate = true;
+
+        for (auto i = 0u; i < 4; ++i)
+        {
+            const auto& sprite    = group[i];
+            auto        flipFlags = u8(sprite.flip);
+
+            if (flipCanvasUpsideDown and sprite.isCanvas)
+            {
+                flipFlags |= u8(SpriteFlip::Vertically);
+            }
+
+            flipH[i] = (flipFlags & u8(SpriteFlip::Horizontally)) != 0 ? 1.0f : 0.0f;
+            flipV[i] = (flipFlags & u8(SpriteFlip::Vertically)) != 0 ? 1.0f : 0.0f;
+
+            isUnrotated   = isUnrotated and isZero(sprite.rotation.value);
+            isUnflipped   = isUnflipped and flipFlags == 0;
+            isApproximate = isApproximate and abs(sprite.rotation.value) <= maxApproximatedAngle;
+        }
+
+        auto originX = set(group[0].origin.x, group[1].origin.x, group[2].origin.x, group[3].origin.x);
+        auto originY = set(group[0].origin.y, group[1].origin.y, group[2].origin.y, group[3].origin.y);
+
+        // Without a source size, the origin is relative to the image instead.
+        originX = select(equal(srcW, zero), mul(originX, invImageW), div(originX, srcW));
+        originY = select(equal(srcH, zero), mul(originY, invImageH), div(originY, srcH));
+
+        const auto left   = mul(sub(zero, originX), dstW);
+        const auto right  = mul(sub(one, originX), dstW);
+        const auto top    = mul(sub(zero, originY), dstH);
+        const auto bottom = mul(sub(one, originY), dstH);
+
+        auto uvLeft   = mul(srcX, invImageW);
+        auto uvTop    = mul(srcY, invImageH);
+        auto uvRight  = add(mul(srcW, invImageW), uvLeft);
+        auto uvBottom = add(mul(srcH, invImageH), uvTop);
+
+        if (not isUnflipped)
+        {
+            const auto isFlippedH = lessThan(zero, load(flipH.data()));
+            const auto isFlippedV = lessThan(zero, load(flipV.data()));
+
+            const auto flippedLeft = select(isFlippedH, uvRight, uvLeft);
+            const auto flippedTop  = select(isFlippedV, uvBottom, uvTop);
+
+            uvRight  = select(isFlippedH, uvLeft, uvRight);
+            uvBottom = select(isFlippedV, uvTop, uvBottom);
+            uvLeft   = flippedLeft;
+            uvTop    = flippedTop;
+        }
+
+        auto s = zero;
+        auto c = one;
+
+        if (not isUnrotated)
+        {
+            if (isApproximate)
+            {
+                const auto rotation = set(
+                    group[0].rotation.value,
+                    group[1].rotation.value,
+                    group[2].rotation.value,
+                    group[3].rotation.value);
+
+                sinCos(rotation, s, c);
+            }
+            else
+            {
+                s = set(
+                    sin(group[0].rotation.value),
+                    sin(group[1].rotation.value),
+                    sin(group[2].rotation.value),
+                    sin(group[3].rotation.value));
+
+                c = set(
+                    cos(group[0].rotation.value),
+                    cos(group[1].rotation.value),
+                    cos(group[2].rotation.value),
+                    cos(group[3].rotation.value));
+            }
+        }
+
+        const auto minusS   = sub(zero, s);
+        auto*      groupDst = dst + (groupIndex * 4 * verticesPerSprite);
+
+        // Corners are in the order top-left, top-right, bottom-left, bottom-right.
+        for (auto i = 0u; i < verticesPerSprite; ++i)
+        {
+            const auto isRight  = (i & 1) != 0;
+            const auto isBottom = (i & 2) != 0;
+            const auto offsetX  = isRight ? right : left;
+            const auto offsetY  = isBottom ? bottom : top;
+
+            auto x  = Float4();
+            auto y  = Float4();
+            auto uv = isRight ? uvRight : uvLeft;
+            auto vv = isBottom ? uvBottom : uvTop;
+
+            if (isUnrotated)
+            {
+                // Fast path: corners are plain offsets of the destination.
+                x = add(offsetX, dstX);
+                y = add(offsetY, dstY);
+            }
+            else
+            {
+                x = add(mul(offsetY, minusS), add(mul(offsetX, c), dstX));
+                y = add(mul(offsetY, c), add(mul(offsetX, s), dstY));
+            }
+
+            // Transpose back, so that every register holds the position and UV of a single vertex.
+            transpose(x, y, uv, vv);
+
+            store(&groupDst[i].positionAndUV.x, x);
+            store(&groupDst[verticesPerSprite + i].positionAndUV.x, y);
+            store(&groupDst[(2 * verticesPerSprite) + i].positionAndUV.x, uv);
+            store(&groupDst[(3 * verticesPerSprite) + i].positionAndUV.x, vv);
+        }
+
+        for (auto i = 0u; i < 4; ++i)
+        {
+            const auto& sprite = group[i];
+
+            for (auto j = 0u; j < verticesPerSprite; ++j)
+            {
+                auto& vertex = groupDst[(i * verticesPerSprite) + j];
+                vertex.color = sprite.color;
+
+                if constexpr (std::is_same_v<T, MultiImageSpriteVertex>)
+                {
+                    vertex.imageSlot = float(sprite.imageSlot);
+                }
+            }
+        }
+    }
+
+    return groupCount * 4;
+}
+
+u32 fillSpriteVerticesSimd(
+    SpriteVertex*        dst,
+    Span<InternalSprite> sprites,
+    Span<Rectangle>      imageSizesAndInverse,
+    bool                 flipCanvasUpsideDown)
+{
+    return fillVertices(dst, sprites, imageSizesAndInverse, flipCanvasUpsideDown);
+}
+
+u32 fillSpriteVerticesSimd(
+    MultiImageSpriteVertex* dst,
+    Span<InternalSprite>    sprites,
+    Span<Rectangle>         imageSizesAndInverse,
+    bool                    flipCanvasUpsideDown)
+{
+    return fillVertices(dst, sprites, imageSizesAndInverse, flipCanvasUpsideDown);
+}
+
+#else
+
+u32 fillSpriteVerticesSimd(
+    [[maybe_unused]] SpriteVertex*        dst,
+    [[maybe_unused]] Span<InternalSprite> sprites,
+    [[maybe_unused]] Span<Rectangle>      imageSizesAndInverse,
+    [[maybe_unused]] bool                 flipCanvasUpsideDown)
+{
+    return 0;
+}
+
+u32 fillSpriteVerticesSimd(
+    [[maybe_unused]] MultiImageSpriteVertex* dst,
+    [[maybe_unused]] Span<InternalSprite>    sprites,
+    [[maybe_unused]] Span<Rectangle>         imageSizesAndInverse,
+    [[maybe_unused]] bool                    flipCanvasUpsideDown)
+{
+    return 0;
+}
+
+#endif
+} // namespace Polly
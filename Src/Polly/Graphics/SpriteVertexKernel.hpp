@@ -0,0 +1,152 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Array.hpp"
+#include "Polly/Graphics/InternalSharedShaderStructs.hpp"
+#include "Polly/Graphics/InternalSprite.hpp"
+#include "Polly/Math.hpp"
+#include "Polly/Pair.hpp"
+#include "Polly/Prerequisites.hpp"
+#include "Polly/Rectangle.hpp"
+#include "Polly/Span.hpp"
+#include <type_traits>
+
+namespace Polly
+{
+// Writes the four vertices of a sprite.
+template<bool FlipCanvasUpsideDown, typename T>
+void fillSprite(const InternalSprite& sprite, T* dstVertices, const Rectangle& imageSizeAndInverse);
+
+// Vectorized counterparts of fillSprite(), which transform four sprites at a time
+// using SSE2 or NEON.
+//
+// Only whole groups of four sprites are written. The number of sprites that were written is
+// returned, and the remaining ones are left to the caller. On targets without SIMD support,
+// nothing is written and zero is returned.
+u32 fillSpriteVerticesSimd(
+    SpriteVertex*        dst,
+    Span<InternalSprite> sprites,
+    Span<Rectangle>      imageSizesAndInverse,
+    bool                 flipCanvasUpsideDown);
+
+u32 fillSpriteVerticesSimd(
+    MultiImageSpriteVertex* dst,
+    Span<InternalSprite>    sprites,
+    Span<Rectangle>         imageSizesAndInverse,
+    bool                    flipCanvasUpsideDown);
+
+// Inline function implementations
+
+template<bool FlipCanvasUpsideDown, typename T>
+void fillSprite(
+    const InternalSprite& sprite,
+    T*                    dstVertices,
+    const Rectangle&      imageSizeAndInverse)
+{
+    const auto destination = sprite.dst;
+    const auto source      = sprite.src.scaled(imageSizeAndInverse.size());
+    const auto color       = sprite.color;
+
+    auto origin = sprite.origin;
+    if (not isZero(sprite.src.width))
+    {
+        origin.x /= sprite.src.width;
+    }
+    else
+    {
+        origin.x *= imageSizeAndInverse.width;
+    }
+
+    if (not isZero(sprite.src.height))
+    {
+        origin.y /= sprite.src.height;
+    }
+    else
+    {
+        origin.y *= imageSizeAndInverse.height;
+    }
+
+    const auto rotation = sprite.rotation;
+    const auto dstPos   = destination.topLeft();
+    const auto dstSize  = destination.size();
+
+    const auto [rot_matrix_row1, rot_matrix_row2] = [r = rotation.value]
+    {
+        if (isZero(r))
+        {
+            return Pair(Vec2(1, 0), Vec2(0, 1));
+        }
+
+        const auto s = sin(r);
+        const auto c = cos(r);
+
+        return Pair(Vec2(c, s), Vec2(-s, c));
+    }();
+
+    constexpr auto cornerOffsets = Array{
+        Vec2(0, 0),
+        Vec2(1, 0),
+        Vec2(0, 1),
+        Vec2(1, 1),
+    };
+
+    auto flipFlags = u8(sprite.flip);
+
+    if constexpr (FlipCanvasUpsideDown)
+    {
+        if (sprite.isCanvas)
+        {
+            flipFlags |= int(SpriteFlip::Vertically);
+        }
+    }
+
+    const auto mirrorBits = u32(flipFlags & 3);
+    const auto srcPos     = source.position();
+    const auto srcSize    = source.size();
+
+    for (u32 i = 0; i < cornerOffsets.size(); ++i)
+    {
+        const auto originOffset = origin;
+        const auto cornerOffset = (cornerOffsets[i] - originOffset) * dstSize;
+        const auto position1    = Vec2(cornerOffset.x) * rot_matrix_row1 + dstPos;
+        const auto position2    = Vec2(cornerOffset.y) * rot_matrix_row2 + position1;
+        const auto uv           = cornerOffsets[i xor mirrorBits] * srcSize + srcPos;
+
+        if constexpr (std::is_same_v<T, MultiImageSpriteVertex>)
+        {
+            dstVertices[i] = MultiImageSpriteVertex{
+                .positionAndUV = Vec4(position2, uv),
+                .color         = color,
+                .imageSlot     = float(sprite.imageSlot),
+            };
+        }
+        else if constexpr (std::is_same_v<T, PackedMultiImageSpriteVertex>)
+        {
+            dstVertices[i] = PackedMultiImageSpriteVertex{
+                .position  = position2,
+                .uv        = uv,
+                .color     = packColor(color),
+                .imageSlot = float(sprite.imageSlot),
+            };
+        }
+        else if constexpr (std::is_same_v<T, PackedSpriteVertex>)
+        {
+            dstVertices[i] = PackedSpriteVertex{
+                .position = position2,
+                .uv       = uv,
+                .color    = packColor(color),
+            };
+        }
+        else
+        {
+            dstVertices[i] = SpriteVertex{
+                .positionAndUV = Vec4(position2, uv),
+                .color         = color,
+            };
+        }
+    }
+}
+} // namespace Polly
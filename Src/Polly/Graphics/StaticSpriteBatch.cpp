@@ -0,0 +1,43 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/StaticSpriteBatch.hpp"
+
+#include "Polly/Graphics/PainterImpl.hpp"
+#include "Polly/Graphics/StaticSpriteBatchImpl.hpp"
+
+namespace Polly
+{
+PollyImplementObject(StaticSpriteBatch);
+
+StaticSpriteBatch::StaticSpriteBatch(Span<Sprite> sprites)
+    : StaticSpriteBatch()
+{
+    setImpl(*this, makeUnique<Impl>(*Painter::Impl::instance(), sprites).release());
+}
+
+u32 StaticSpriteBatch::spriteCount() const
+{
+    PollyDeclareThisImpl;
+    return impl->spriteCount();
+}
+
+const Sprite& StaticSpriteBatch::spriteAt(u32 index) const
+{
+    PollyDeclareThisImpl;
+    return impl->spriteAt(index);
+}
+
+void StaticSpriteBatch::setSprite(u32 index, const Sprite& sprite)
+{
+    PollyDeclareThisImpl;
+    impl->setSprites(index, Span<Sprite>(&sprite, 1));
+}
+
+void StaticSpriteBatch::setSprites(u32 offset, Span<Sprite> sprites)
+{
+    PollyDeclareThisImpl;
+    impl->setSprites(offset, sprites);
+}
+} // namespace Polly
@@ -0,0 +1,184 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/StaticSpriteBatchImpl.hpp"
+
+#include "Polly/Graphics/PainterImpl.hpp"
+
+namespace Polly
+{
+StaticSpriteBatch::Impl::Impl(Painter::Impl& painter, Span<Sprite> sprites)
+    : GraphicsResource(painter, GraphicsResourceType::StaticSpriteBatch)
+    , _sprites(sprites)
+    , _dirtyEnd(sprites.size())
+{
+    rebuildRuns();
+
+    if (not _sprites.isEmpty())
+    {
+        _buffer = painter.createStaticSpriteBuffer(_sprites.size());
+    }
+}
+
+StaticSpriteBatch::Impl::~Impl() noexcept = default;
+
+u32 StaticSpriteBatch::Impl::spriteCount() const
+{
+    return _sprites.size();
+}
+
+const Sprite& StaticSpriteBatch::Impl::spriteAt(u32 index) const
+{
+    if (index >= _sprites.size())
+    {
+        throw Error(formatString(
+            "Sprite index {} is out of range; the batch contains {} sprite(s).",
+            index,
+            _sprites.size()));
+    }
+
+    return _sprites[index];
+}
+
+void StaticSpriteBatch::Impl::setSprites(u32 offset, Span<Sprite> sprites)
+{
+    if (sprites.isEmpty())
+    {
+        return;
+    }
+
+    if (offset + sprites.size() > _sprites.size())
+    {
+        throw Error(formatString(
+            "Attempting to replace sprites {} to {}, but the batch contains only {} sprite(s).",
+            offset,
+            offset + sprites.size() - 1,
+            _sprites.size()));
+    }
+
+    auto imagesChanged = false;
+
+    for (auto i = 0u; i < sprites.size(); ++i)
+    {
+        auto& dst = _sprites[offset + i];
+
+        if (dst.image != sprites[i].image)
+        {
+            imagesChanged = true;
+        }
+
+        dst = sprites[i];
+    }
+
+    if (imagesChanged)
+    {
+        rebuildRuns();
+    }
+
+    // Extend the range of sprites that have to be uploaded again.
+    if (_dirtyBegin == _dirtyEnd)
+    {
+        _dirtyBegin = offset;
+        _dirtyEnd   = offset + sprites.size();
+    }
+    else
+    {
+        _dirtyBegin = min(_dirtyBegin, offset);
+        _dirtyEnd   = max(_dirtyEnd, offset + sprites.size());
+    }
+}
+
+void StaticSpriteBatch::Impl::updateBuffer()
+{
+    if (_dirtyBegin == _dirtyEnd)
+    {
+        return;
+    }
+
+    if (_buffer)
+    {
+        auto& painterImpl     = painter();
+        auto  internalSprites = List<InternalSprite>();
+
+        for (const auto& run : _runs)
+        {
+            const auto begin = max(run.offset, _dirtyBegin);
+            const auto end   = min(run.offset + run.count, _dirtyEnd);
+
+            if (begin >= end)
+            {
+                continue;
+            }
+
+            internalSprites.clear();
+
+            for (auto i = begin; i < end; ++i)
+            {
+                internalSprites.add(toInternalSprite(_sprites[i]));
+            }
+
+            const auto imageWidthf  = float(run.image->width());
+            const auto imageHeightf = float(run.image->height());
+
+            painterImpl.updateStaticSpriteBuffer(
+                *_buffer,
+                begin,
+                internalSprites,
+                Rectangle(imageWidthf, imageHeightf, 1.0f / imageWidthf, 1.0f / imageHeightf));
+        }
+    }
+
+    _dirtyBegin = 0;
+    _dirtyEnd   = 0;
+}
+
+void StaticSpriteBatch::Impl::rebuildRuns()
+{
+    _runs.clear();
+
+    for (auto i = 0u; i < _sprites.size(); ++i)
+    {
+        auto* imageImpl = _sprites[i].image.impl();
+
+        if (not imageImpl)
+        {
+            continue;
+        }
+
+        if (not _runs.isEmpty())
+        {
+            auto& lastRun = _runs.last();
+
+            if (lastRun.image == imageImpl and lastRun.offset + lastRun.count == i)
+            {
+                ++lastRun.count;
+                continue;
+            }
+        }
+
+        _runs.add(
+            Run{
+                .image  = imageImpl,
+                .offset = i,
+                .count  = 1,
+            });
+    }
+}
+
+InternalSprite StaticSpriteBatch::Impl::toInternalSprite(const Sprite& sprite) const
+{
+    // Static sprites are always drawn from their own image, even if it's part of an image atlas,
+    // because atlas placements may change over time.
+    return InternalSprite{
+        .dst       = sprite.dstRect,
+        .src       = sprite.srcRect.valueOr(Rectangle(0, 0, sprite.image.size())),
+        .color     = sprite.color,
+        .origin    = sprite.origin,
+        .rotation  = sprite.rotation,
+        .flip      = sprite.flip,
+        .isCanvas  = sprite.image.impl()->usage() == ImageUsage::Canvas,
+        .imageSlot = 0,
+    };
+}
+} // namespace Polly
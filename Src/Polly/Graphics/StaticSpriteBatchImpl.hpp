@@ -0,0 +1,78 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/CopyMoveMacros.hpp"
+#include "Polly/Graphics/GraphicsResource.hpp"
+#include "Polly/Image.hpp"
+#include "Polly/List.hpp"
+#include "Polly/StaticSpriteBatch.hpp"
+#include "Polly/UniquePtr.hpp"
+
+namespace Polly
+{
+struct InternalSprite;
+
+class StaticSpriteBatch::Impl final : public GraphicsResource
+{
+  public:
+    // The vertices of a batch in GPU memory, created and used by the painter backend.
+    class Buffer
+    {
+      public:
+        Buffer() = default;
+
+        DeleteCopyAndMove(Buffer);
+
+        virtual ~Buffer() noexcept = default;
+    };
+
+    // Consecutive sprites that share the same image, and can therefore be drawn
+    // using a single draw call.
+    struct Run
+    {
+        Image::Impl* image  = nullptr;
+        u32          offset = 0;
+        u32          count  = 0;
+    };
+
+    explicit Impl(Painter::Impl& painter, Span<Sprite> sprites);
+
+    DeleteCopyAndMove(Impl);
+
+    ~Impl() noexcept override;
+
+    u32 spriteCount() const;
+
+    const Sprite& spriteAt(u32 index) const;
+
+    void setSprites(u32 offset, Span<Sprite> sprites);
+
+    // Null if the backend doesn't support static sprite batches.
+    Buffer* buffer()
+    {
+        return _buffer.get();
+    }
+
+    // Writes the vertices of all sprites that were replaced since the last call to the buffer.
+    void updateBuffer();
+
+    Span<Run> runs() const
+    {
+        return _runs;
+    }
+
+  private:
+    void rebuildRuns();
+
+    InternalSprite toInternalSprite(const Sprite& sprite) const;
+
+    List<Sprite>      _sprites;
+    List<Run>         _runs;
+    UniquePtr<Buffer> _buffer;
+    u32               _dirtyBegin = 0;
+    u32               _dirtyEnd   = 0;
+};
+} // namespace Polly
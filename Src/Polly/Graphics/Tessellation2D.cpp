@@ -14,10 +14,11 @@ namespace Tessellation2D
 static constexpr auto sRoundedRectangleSegmentCount = 12u;
 static constexpr auto sEllipseSegmentCount          = 65u;
 
+template<typename TVertex>
 class PolyVertexAppender
 {
   public:
-    explicit PolyVertexAppender(const PolyVertex* src, PolyVertex* dst)
+    explicit PolyVertexAppender(const TVertex* src, TVertex* dst)
         : _src(src)
         , _dst(dst)
     {
@@ -29,25 +30,26 @@ class PolyVertexAppender
         ++_dst;
     }
 
-    PolyVertex* dstPtr()
+    TVertex* dstPtr()
     {
         return _dst;
     }
 
-    const PolyVertex* dstPtr() const
+    const TVertex* dstPtr() const
     {
         return _dst;
     }
 
   private:
-    const PolyVertex* _src;
-    PolyVertex*       _dst;
+    const TVertex* _src;
+    TVertex*       _dst;
 };
 } // namespace Tessellation2D
 
 // DrawLine
 
-void Tessellation2D::process(PolyVertex* dst, const DrawLineCmd& cmd)
+template<typename TVertex>
+void Tessellation2D::process(TVertex* dst, const DrawLineCmd& cmd)
 {
     const auto start         = cmd.start;
     const auto end           = cmd.end;
@@ -57,10 +59,10 @@ void Tessellation2D::process(PolyVertex* dst, const DrawLineCmd& cmd)
     const auto normalStretch = normal * strokeWidth * 0.5f;
 
     const auto vertices = Array{
-        PolyVertex(start - normalStretch, color),
-        PolyVertex(start + normalStretch, color),
-        PolyVertex(end - normalStretch, color),
-        PolyVertex(end + normalStretch, color),
+        TVertex(start - normalStretch, color),
+        TVertex(start + normalStretch, color),
+        TVertex(end - normalStretch, color),
+        TVertex(end + normalStretch, color),
     };
 
     auto appender = PolyVertexAppender(vertices.data(), dst);
@@ -88,7 +90,8 @@ void Tessellation2D::process([[maybe_unused]] PolyVertex* dst, [[maybe_unused]]
 
 // DrawRectangle
 
-void Tessellation2D::process(PolyVertex* dst, const DrawRectangleCmd& cmd)
+template<typename TVertex>
+void Tessellation2D::process(TVertex* dst, const DrawRectangleCmd& cmd)
 {
     const auto left   = cmd.rectangle.left();
     const auto top    = cmd.rectangle.top();
@@ -104,14 +107,14 @@ void Tessellation2D::process(PolyVertex* dst, const DrawRectangleCmd& cmd)
     const auto p3 = Vec2(right, bottom);
 
     const auto v = Array{
-        PolyVertex(Vec2(p0.x + halfWidth, p0.y + halfWidth), color),
-        PolyVertex(Vec2(p0.x - halfWidth, p0.y - halfWidth), color),
-        PolyVertex(Vec2(p1.x + halfWidth, p1.y - halfWidth), color),
-        PolyVertex(Vec2(p1.x - halfWidth, p1.y + halfWidth), color),
-        PolyVertex(Vec2(p3.x - halfWidth, p3.y - halfWidth), color),
-        PolyVertex(Vec2(p3.x + halfWidth, p3.y + halfWidth), color),
-        PolyVertex(Vec2(p2.x - halfWidth, p2.y + halfWidth), color),
-        PolyVertex(Vec2(p2.x + halfWidth, p2.y - halfWidth), color),
+        TVertex(Vec2(p0.x + halfWidth, p0.y + halfWidth), color),
+        TVertex(Vec2(p0.x - halfWidth, p0.y - halfWidth), color),
+        TVertex(Vec2(p1.x + halfWidth, p1.y - halfWidth), color),
+        TVertex(Vec2(p1.x - halfWidth, p1.y + halfWidth), color),
+        TVertex(Vec2(p3.x - halfWidth, p3.y - halfWidth), color),
+        TVertex(Vec2(p3.x + halfWidth, p3.y + halfWidth), color),
+        TVertex(Vec2(p2.x - halfWidth, p2.y + halfWidth), color),
+        TVertex(Vec2(p2.x + halfWidth, p2.y - halfWidth), color),
     };
 
     auto appender = PolyVertexAppender(v.data(), dst);
@@ -136,7 +139,8 @@ void Tessellation2D::process(PolyVertex* dst, const DrawRectangleCmd& cmd)
 
 // FillRectangle
 
-void Tessellation2D::process(PolyVertex* dst, const FillRectangleCmd& cmd)
+template<typename TVertex>
+void Tessellation2D::process(TVertex* dst, const FillRectangleCmd& cmd)
 {
     const auto left   = cmd.rectangle.left();
     const auto top    = cmd.rectangle.top();
@@ -146,10 +150,10 @@ void Tessellation2D::process(PolyVertex* dst, const FillRectangleCmd& cmd)
     const auto color = cmd.color;
 
     const auto vertices = Array{
-        PolyVertex({left, top}, color),
-        PolyVertex({left, bottom}, color),
-        PolyVertex({right, top}, color),
-        PolyVertex({right, bottom}, color),
+        TVertex({left, top}, color),
+        TVertex({left, bottom}, color),
+        TVertex({right, top}, color),
+        TVertex({right, bottom}, color),
     };
 
     auto appender = PolyVertexAppender(vertices.data(), dst);
@@ -308,7 +312,8 @@ u32 Tessellation2D::vertexCountForDrawRoundedRectangle()
     return count;
 }
 
-void Tessellation2D::process(PolyVertex* dst, const DrawRoundedRectangleCmd& cmd)
+template<typename TVertex>
+void Tessellation2D::process(TVertex* dst, const DrawRoundedRectangleCmd& cmd)
 {
     const auto color = cmd.color;
 
@@ -416,7 +421,8 @@ u32 Tessellation2D::vertexCountForFillRoundedRectangle()
     return count;
 }
 
-void Tessellation2D::process(PolyVertex* dst, const FillRoundedRectangleCmd& cmd)
+template<typename TVertex>
+void Tessellation2D::process(TVertex* dst, const FillRoundedRectangleCmd& cmd)
 {
     const auto color = cmd.color;
 
@@ -486,7 +492,8 @@ u32 Tessellation2D::vertexCountForDrawEllipse()
     return count;
 }
 
-void Tessellation2D::process(PolyVertex* dst, const DrawEllipseCmd& cmd)
+template<typename TVertex>
+void Tessellation2D::process(TVertex* dst, const DrawEllipseCmd& cmd)
 {
     const auto color = cmd.color;
 
@@ -542,7 +549,8 @@ u32 Tessellation2D::vertexCountForFillEllipse(const FillEllipseCmd& cmd)
     return count;
 }
 
-void Tessellation2D::process(PolyVertex* dst, const FillEllipseCmd& cmd)
+template<typename TVertex>
+void Tessellation2D::process(TVertex* dst, const FillEllipseCmd& cmd)
 {
     const auto color = cmd.color;
 
@@ -625,9 +633,10 @@ u32 Tessellation2D::calculatePolyQueueVertexCounts(const Span<Command> commands,
     return totalVertexCount;
 }
 
+template<typename TVertex>
 void Tessellation2D::processPolyQueue(
     Span<Command>   commands,
-    PolyVertex*     dstVertices,
+    TVertex*        dstVertices,
     const Span<u32> vertexCounts)
 {
     for (int idx = 0; const auto& cmd : commands)
@@ -674,20 +683,24 @@ void Tessellation2D::processPolyQueue(
             const auto color = fillPolygon->color;
             auto*      dst   = dstVertices;
 
-            *dst = PolyVertex(vertices[0], color);
+            *dst = TVertex(vertices[0], color);
             ++dst;
 
             for (const auto& vertex : fillPolygon->vertices)
             {
-                *dst = PolyVertex(vertex, color);
+                *dst = TVertex(vertex, color);
                 ++dst;
             }
 
-            *dst = PolyVertex(vertices.last(), color);
+            *dst = TVertex(vertices.last(), color);
         }
 
         dstVertices += vertexCounts[idx];
         ++idx;
     }
 }
+
+template void Tessellation2D::processPolyQueue(Span<Command>, PolyVertex*, Span<u32>);
+
+template void Tessellation2D::processPolyQueue(Span<Command>, PackedPolyVertex*, Span<u32>);
 } // namespace Polly
\ No newline at end of file
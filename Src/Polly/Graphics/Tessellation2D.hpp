@@ -5,6 +5,7 @@
 #pragma once
 
 #include "Polly/Color.hpp"
+#include "Polly/Graphics/InternalSharedShaderStructs.hpp"
 #include "Polly/Graphics/PolyDrawCommands.hpp"
 #include "Polly/Linalg.hpp"
 
@@ -26,6 +27,23 @@ struct alignas(16) PolyVertex
     Color color;
 };
 
+// Compact counterpart of PolyVertex, used by backends that support VertexElement::UByte4Normalized.
+struct PackedPolyVertex
+{
+    constexpr PackedPolyVertex(const Vec2 position, const Color color)
+        : position(position)
+        , color(packColor(color))
+    {
+    }
+
+    Vec2 position;
+    u32  color;
+};
+
+static_assert(sizeof(PackedPolyVertex) == 12);
+
+// The process functions below are implemented for both PolyVertex and PackedPolyVertex.
+
 // draw_line
 
 constexpr u32 vertexCountForDrawLine()
@@ -33,7 +51,8 @@ constexpr u32 vertexCountForDrawLine()
     return 6;
 }
 
-void process(PolyVertex* dst, const DrawLineCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const DrawLineCmd& cmd);
 
 // drawLinePath
 
@@ -41,7 +60,8 @@ void process(PolyVertex* dst, const DrawLineCmd& cmd);
 #if 0
 u32 vertexCountForDrawLinePath(const Tessellation2D::DrawLinePathCmd& cmd);
 
-void process(PolyVertex* dst, const Tessellation2D::DrawLinePathCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const Tessellation2D::DrawLinePathCmd& cmd);
 #endif
 
 // drawRectangle
@@ -51,7 +71,8 @@ constexpr u32 vertexCountForDrawRectangle()
     return 16;
 }
 
-void process(PolyVertex* dst, const DrawRectangleCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const DrawRectangleCmd& cmd);
 
 // fillRectangle
 
@@ -60,37 +81,43 @@ constexpr u32 vertexCountForFillRectangle()
     return 6;
 }
 
-void process(PolyVertex* dst, const FillRectangleCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const FillRectangleCmd& cmd);
 
 // drawRoundedRectangle
 
 u32 vertexCountForDrawRoundedRectangle();
 
-void process(PolyVertex* dst, const DrawRoundedRectangleCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const DrawRoundedRectangleCmd& cmd);
 
 // fillRoundedRectangle
 
 u32 vertexCountForFillRoundedRectangle();
 
-void process(PolyVertex* dst, const FillRoundedRectangleCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const FillRoundedRectangleCmd& cmd);
 
 // drawEllipse
 
 u32 vertexCountForDrawEllipse();
 
-void process(PolyVertex* dst, const DrawEllipseCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const DrawEllipseCmd& cmd);
 
 // fillEllipse
 
 u32 vertexCountForFillEllipse(const FillEllipseCmd& cmd);
 
-void process(PolyVertex* dst, const FillEllipseCmd& cmd);
+template<typename TVertex>
+void process(TVertex* dst, const FillEllipseCmd& cmd);
 
 // Misc
 
 [[nodiscard]]
 u32 calculatePolyQueueVertexCounts(Span<Command> commands, List<u32>& dstList);
 
-void processPolyQueue(Span<Command> commands, PolyVertex* dstVertices, Span<u32> vertexCounts);
+template<typename TVertex>
+void processPolyQueue(Span<Command> commands, TVertex* dstVertices, Span<u32> vertexCounts);
 } // namespace Tessellation2D
 } // namespace Polly
\ No newline at end of file
@@ -23,8 +23,35 @@ void shapeText(
 
     auto& fontImpl = *font.impl();
 
-    const auto lineHeight  = fontImpl.lineHeight(fontSize);
-    const auto strokeWidth = lineHeight * 0.1f;
+    const auto lineHeight         = fontImpl.lineHeight(fontSize);
+    const auto strokeWidth        = lineHeight * 0.1f;
+    const auto distanceFieldScale = fontImpl.distanceFieldScale(fontSize);
+
+    const auto addGlyph = [&](const char32_t codepoint, const Rectangle& rect)
+    {
+        const auto& glyph = fontImpl.rasterizedGlyph(codepoint, fontSize);
+        const auto& page  = fontImpl.page(glyph.pageIndex);
+
+        auto dstRect = rect;
+
+        if (distanceFieldScale)
+        {
+            // Distance fields are larger than the glyph's outline, and are scaled from the
+            // reference size.
+            const auto scale = *distanceFieldScale;
+
+            dstRect = Rectangle(
+                rect.position() - (glyph.distanceFieldInset * scale),
+                glyph.uvRect.size() * scale);
+        }
+
+        dstGlyphs.add({
+            .codepoint = codepoint,
+            .image     = page.atlas,
+            .dstRect   = dstRect,
+            .srcRect   = glyph.uvRect,
+        });
+    };
 
     if (!decoration)
     {
@@ -33,16 +60,7 @@ void shapeText(
             fontSize,
             [&](const char32_t codepoint, const Rectangle rect)
             {
-                const auto& glyph = fontImpl.rasterizedGlyph(codepoint, fontSize);
-                const auto& page  = fontImpl.page(glyph.pageIndex);
-
-                dstGlyphs.add({
-                    .codepoint = codepoint,
-                    .image     = page.atlas,
-                    .dstRect   = rect,
-                    .srcRect   = glyph.uvRect,
-                });
-
+                addGlyph(codepoint, rect);
                 return true;
             });
     }
@@ -57,15 +75,7 @@ void shapeText(
                 const Rectangle&                        rect,
                 const Font::Impl::GlyphIterationExtras& extras)
             {
-                const auto& glyph = fontImpl.rasterizedGlyph(codepoint, fontSize);
-                const auto& page  = fontImpl.page(glyph.pageIndex);
-
-                dstGlyphs.add({
-                    .codepoint = codepoint,
-                    .image     = page.atlas,
-                    .dstRect   = rect,
-                    .srcRect   = glyph.uvRect,
-                });
+                addGlyph(codepoint, rect);
 
                 if (extras.isLastOnLine)
                 {
@@ -120,7 +130,8 @@ Text::Impl::Impl(
 
     shapeText(text, font, fontSize, decoration, _glyphs, _decorationRects);
 
-    _size = font.measure(text, fontSize);
+    _size               = font.measure(text, fontSize);
+    _distanceFieldScale = font.impl()->distanceFieldScale(fontSize);
 }
 
 Span<PreshapedGlyph> Text::Impl::glyphs() const
@@ -137,4 +148,9 @@ Vec2 Text::Impl::size() const
 {
     return _size;
 }
+
+Maybe<float> Text::Impl::distanceFieldScale() const
+{
+    return _distanceFieldScale;
+}
 } // namespace Polly
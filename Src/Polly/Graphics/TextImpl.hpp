@@ -7,18 +7,13 @@
 #include "Polly/Core/Object.hpp"
 #include "Polly/Font.hpp"
 #include "Polly/Graphics/FontImpl.hpp"
+#include "Polly/Graphics/ShapedText.hpp"
 #include "Polly/List.hpp"
 #include "Polly/Span.hpp"
 #include "Polly/Text.hpp"
 
 namespace Polly
 {
-struct TextDecorationRect
-{
-    Rectangle    rect;
-    Maybe<Color> color;
-};
-
 void shapeText(
     StringView                   text,
     Font&                        font,
@@ -38,9 +33,13 @@ class Text::Impl final : public Object
 
     Vec2 size() const;
 
+    // Set if the text was shaped using distance field glyphs.
+    Maybe<float> distanceFieldScale() const;
+
   private:
     List<PreshapedGlyph>     _glyphs;
     List<TextDecorationRect> _decorationRects;
     Vec2                     _size;
+    Maybe<float>             _distanceFieldScale;
 };
 } // namespace Polly
@@ -0,0 +1,83 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include "Polly/Math.hpp"
+#include "Polly/Maybe.hpp"
+
+namespace Polly
+{
+// Places aligned allocations one after another within a growable buffer, and counts the
+// bytes that they use, including alignment padding.
+//
+// When an allocation doesn't fit, the buffer is replaced by a larger one, and the allocation
+// starts at the beginning of the new buffer.
+class UniformBufferCursor final
+{
+  public:
+    struct Allocation
+    {
+        u32 offset = 0;
+
+        // Set if the caller has to replace its buffer by one of this capacity first.
+        Maybe<u32> newCapacity;
+    };
+
+    explicit UniformBufferCursor(u32 alignment, u32 capacity)
+        : _alignment(alignment)
+        , _capacity(capacity)
+    {
+    }
+
+    Allocation allocate(u32 size)
+    {
+        auto offset  = nextAlignedNumber(_position, _alignment);
+        auto padding = offset - _position;
+
+        auto newCapacity = Maybe<u32>();
+
+        if (offset + size > _capacity)
+        {
+            newCapacity = max(_capacity * 2, size);
+            _capacity   = *newCapacity;
+
+            // The new buffer is empty, so nothing has to be skipped.
+            offset  = 0;
+            padding = 0;
+        }
+
+        _usedBytes += padding + size;
+        _position = offset + size;
+
+        return Allocation{
+            .offset      = offset,
+            .newCapacity = newCapacity,
+        };
+    }
+
+    void reset()
+    {
+        _position  = 0;
+        _usedBytes = 0;
+    }
+
+    u32 capacity() const
+    {
+        return _capacity;
+    }
+
+    // The number of bytes that were allocated since the last reset, including alignment.
+    u32 usedBytes() const
+    {
+        return _usedBytes;
+    }
+
+  private:
+    u32 _alignment = 0;
+    u32 _capacity  = 0;
+    u32 _position  = 0;
+    u32 _usedBytes = 0;
+};
+} // namespace Polly
@@ -13,5 +13,9 @@ enum class VertexElement
     Vec2,
     Vec3,
     Vec4,
+
+    // Four unsigned 8-bit values that are read as floats in the range [0 .. 1],
+    // for example a color packed via packColor().
+    UByte4Normalized,
 };
 } // namespace Polly
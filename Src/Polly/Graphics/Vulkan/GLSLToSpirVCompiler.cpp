@@ -2,18 +2,154 @@
 
 #include "glslang/Public/ResourceLimits.h"
 #include "glslang/Public/ShaderLang.h"
+#include "Polly/Array.hpp"
+#include "Polly/ContentManagement/ContentManager.hpp"
+#include "Polly/Core/komihash.h"
 #include "Polly/FileSystem.hpp"
 #include "Polly/Format.hpp"
+#include "Polly/Game/GameImpl.hpp"
 #include "Polly/Logging.hpp"
 #include "Polly/Narrow.hpp"
+#include "Polly/Version.hpp"
 #include "SPIRV/GlslangToSpv.h"
 #include "VulkanPrerequisites.hpp"
+#include <SDL3/SDL_filesystem.h>
 
+#include <cstring>
 #include <vector>
 
 namespace Polly
 {
-ByteBlob GLSLToSpirVCompiler::compile(StringView glslCode, VulkanShaderType type)
+// Increment this whenever the way GLSL is compiled to SPIR-V changes in a way that the
+// cache key doesn't capture (e.g. different compiler options).
+static constexpr auto spirvCacheFormatVersion = 1u;
+
+static constexpr auto spirvCacheDirectoryName = "SpirVCache"_sv;
+static constexpr auto spirvMagicNumber        = 0x07230203u;
+
+static u64 computeSpirvCacheKey(StringView glslCode, VulkanShaderType type)
+{
+    const auto glslangVersion = glslang::GetVersion();
+
+#ifdef NDEBUG
+    constexpr auto isDebugBuild = 0u;
+#else
+    constexpr auto isDebugBuild = 1u;
+#endif
+
+    const auto header = Array{
+        spirvCacheFormatVersion,
+        u32(type),
+        u32(glslangVersion.major),
+        u32(glslangVersion.minor),
+        u32(glslangVersion.patch),
+        u32(version.major),
+        u32(version.minor),
+        u32(version.revision),
+        isDebugBuild,
+    };
+
+    auto stream = komihash_stream_t();
+    komihash_stream_init(&stream, 0);
+    komihash_stream_update(&stream, header.data(), sizeof(header));
+    komihash_stream_update(&stream, glslCode.data(), glslCode.size());
+
+    return komihash_stream_final(&stream);
+}
+
+// Cache entries are named "SpirVCache/<key as hex>.spv", both on disk and in the asset archive.
+// Entries can therefore be shipped with a game by adding them to its assets.
+static String spirvCacheEntryName(u64 key)
+{
+    constexpr auto hexDigits = "0123456789abcdef"_sv;
+
+    auto name = String(spirvCacheDirectoryName);
+    name += '/';
+
+    for (auto shift = 60; shift >= 0; shift -= 4)
+    {
+        name += hexDigits[u32((key >> shift) & 0xF)];
+    }
+
+    name += ".spv";
+
+    return name;
+}
+
+static bool isValidSpirv(const u8* data, u32 size)
+{
+    if (size < sizeof(u32) or size % sizeof(u32) != 0)
+    {
+        return false;
+    }
+
+    auto magic = u32();
+    std::memcpy(&magic, data, sizeof(magic));
+
+    return magic == spirvMagicNumber;
+}
+
+static Maybe<ByteBlob> loadCachedSpirv(StringView entryName)
+{
+    auto& gameImpl = Game::Impl::instance();
+
+    if (auto data = gameImpl.contentManager().tryLoadAssetData(entryName))
+    {
+        if (isValidSpirv(data->data(), data->size()))
+        {
+            logVerbose("Using SPIR-V '{}' from the game's assets", entryName);
+            return ByteBlob::createByCopying(Span(data->data(), data->size()));
+        }
+    }
+
+    const auto storagePath = gameImpl.writableStoragePath();
+
+    if (not storagePath)
+    {
+        return none;
+    }
+
+    try
+    {
+        if (auto data = FileSystem::loadFileFromDisk(*storagePath + entryName))
+        {
+            if (isValidSpirv(data->data(), data->size()))
+            {
+                logVerbose("Using cached SPIR-V '{}'", entryName);
+                return data;
+            }
+        }
+    }
+    catch (const Error& error)
+    {
+        logVerbose("Failed to load cached SPIR-V '{}': {}", entryName, error.message());
+    }
+
+    return none;
+}
+
+static void storeCachedSpirv(StringView entryName, const ByteBlob& spirv)
+{
+    const auto storagePath = Game::Impl::instance().writableStoragePath();
+
+    if (not storagePath)
+    {
+        return;
+    }
+
+    // A failure here only means that the shader is compiled again next time.
+    try
+    {
+        SDL_CreateDirectory((*storagePath + spirvCacheDirectoryName).cstring());
+        FileSystem::writeBinaryFileToDisk(*storagePath + entryName, Span(spirv.data(), spirv.size()));
+    }
+    catch (const Error& error)
+    {
+        logVerbose("Failed to store SPIR-V '{}' in the cache: {}", entryName, error.message());
+    }
+}
+
+static ByteBlob compileWithGlslang(StringView glslCode, VulkanShaderType type)
 {
     const auto shaderStage = [type]
     {
@@ -93,4 +229,19 @@ ByteBlob GLSLToSpirVCompiler::compile(StringView glslCode, VulkanShaderType type
 
     return ByteBlob::createByCopying(Span(spirv.data(), narrow<u32>(spirv.size())));
 }
+
+ByteBlob GLSLToSpirVCompiler::compile(StringView glslCode, VulkanShaderType type)
+{
+    const auto entryName = spirvCacheEntryName(computeSpirvCacheKey(glslCode, type));
+
+    if (auto spirv = loadCachedSpirv(entryName))
+    {
+        return std::move(*spirv);
+    }
+
+    auto spirv = compileWithGlslang(glslCode, type);
+    storeCachedSpirv(entryName, spirv);
+
+    return spirv;
+}
 } // namespace Polly
\ No newline at end of file
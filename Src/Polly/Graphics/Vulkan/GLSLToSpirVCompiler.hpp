@@ -10,6 +10,11 @@ enum class VulkanShaderType;
 class GLSLToSpirVCompiler final
 {
   public:
+    // Compiles GLSL code to SPIR-V.
+    //
+    // Results are cached by a hash of the code, the shader type and the compiler version.
+    // The cache is looked up in the game's assets first, then in the game's writable storage,
+    // where newly compiled shaders are stored.
     ByteBlob compile(StringView glslCode, VulkanShaderType type);
 };
 } // namespace Polly
@@ -5,17 +5,28 @@ layout ( push_constant, std430 ) uniform constants
     mat4 Transformation;
 } PushConstants;
 
-layout ( location = 0 ) in vec4 vsin_PositionAndUV;
-layout ( location = 1 ) in vec4 vsin_Color;
+// One instance per sprite, see SpriteInstance.
+layout ( location = 0 ) in vec4 vsin_Dst;
+layout ( location = 1 ) in vec4 vsin_Src;
+layout ( location = 2 ) in vec4 vsin_Color;
+layout ( location = 3 ) in vec4 vsin_OriginRotationAndImageSlot;
 
 layout ( location = 0 ) out vec4 pl_v2f_Color;
 layout ( location = 1 ) out vec2 pl_v2f_UV;
 
 void main( ) {
-    vec2 position = vsin_PositionAndUV.xy;
-    vec2 uv = vsin_PositionAndUV.zw;
+    // The quad is drawn as a triangle strip with the corners (0, 0), (1, 0), (0, 1) and (1, 1).
+    vec2 corner = vec2( float( gl_VertexIndex & 1 ), float( gl_VertexIndex >> 1 ) );
+
+    vec2 origin = vsin_OriginRotationAndImageSlot.xy;
+    float rotation = vsin_OriginRotationAndImageSlot.z;
+    float s = sin( rotation );
+    float c = cos( rotation );
+
+    vec2 offset = ( corner - origin ) * vsin_Dst.zw;
+    vec2 position = vsin_Dst.xy + ( offset.x * vec2( c, s ) ) + ( offset.y * vec2( -s, c ) );
 
     gl_Position = PushConstants.Transformation * vec4( position, 0, 1 );
     pl_v2f_Color = vsin_Color;
-    pl_v2f_UV = uv;
+    pl_v2f_UV = vsin_Src.xy + ( corner * vsin_Src.zw );
 }
@@ -11,14 +11,12 @@ class VulkanImage final : public Image::Impl
   public:
     VulkanImage(
         Painter::Impl& painter,
+        ImageUsage     usage,
         u32            width,
         u32            height,
         ImageFormat    format,
         const void*    data,
-        bool           isStatic);
-
-    // Canvas overload
-    explicit VulkanImage(Painter::Impl& painter, u32 width, u32 height, ImageFormat format);
+        bool           isAlphaCoverage);
 
     DeleteCopyAndMove(VulkanImage);
 
@@ -32,10 +30,17 @@ class VulkanImage final : public Image::Impl
 
     void setDebuggingLabel(StringView value) override;
 
+    // Uploads are asynchronous (see VulkanUploadQueue), so this never has to be deferred.
+    void updateData(u32 x, u32 y, u32 width, u32 height, const void* data, bool shouldUpdateImmediately)
+        override;
+
+    void updateFromEnqueuedData(u32 x, u32 y, u32 width, u32 height, const void* data) override;
+
+    // The layout the image is in after all commands that were recorded so far.
     VkImageLayout currentLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
   private:
-    void createVkImage(const void* data, bool isStatic);
+    void createVkImage(const void* data, bool isAlphaCoverage);
 
     VulkanImageAndViewPair _pair;
     VkFormat               _vk_format = VK_FORMAT_UNDEFINED;
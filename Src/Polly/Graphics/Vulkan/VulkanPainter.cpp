@@ -4,6 +4,7 @@
 #include "Polly/Algorithm.hpp"
 #include "Polly/Array.hpp"
 #include "Polly/Defer.hpp"
+#include "Polly/DrawStateCombination.hpp"
 #include "Polly/GamePerformanceStats.hpp"
 #include "Polly/Graphics/Vulkan/GLSLToSpirVCompiler.hpp"
 #include "Polly/Graphics/Vulkan/VulkanImage.hpp"
@@ -13,6 +14,7 @@
 #include "Polly/ImGui.hpp"
 #include "Polly/List.hpp"
 #include "Polly/Logging.hpp"
+#include "Polly/Profiler.hpp"
 #include "Polly/Util.hpp"
 
 #include <backends/imgui_impl_sdl3.h>
@@ -39,12 +41,6 @@ struct alignas(16) SystemValueCBufferParams
     Vec2 viewportSizeInv;
 };
 
-struct alignas(16) SpriteVertex
-{
-    Vec4  positionAndUV;
-    Color color;
-};
-
 #ifndef NDEBUG
 
 static VKAPI_ATTR VkBool32 vulkanDebugCallback(
@@ -120,7 +116,10 @@ VulkanPainter::VulkanPainter(
 
     assume(_vkDevice != VK_NULL_HANDLE);
 
+    _uploadQueue = makeUnique<VulkanUploadQueue>(*this, _transferQueueFamilyIndex, _vkTransferQueue);
+
     createPipelineLayouts();
+    _psoCache.loadVkPipelineCache();
     createShaderModules();
     createSpriteRenderingResources();
     createPolyRenderingResources();
@@ -171,7 +170,7 @@ VulkanPainter::VulkanPainter(
         .maxCanvasHeight = max(0u, _vkPhysicalDeviceProps.limits.maxFramebufferHeight),
     };
 
-    postInit(caps, maxFramesInFlight, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices);
+    postInit(caps, maxFramesInFlight, maxSpriteBatchSize, maxPolyVertices, maxMeshVertices, maxMeshIndices);
     _imageDescriptorCache.init(this, _vkDescriptorSetLayouts[0]);
     _samplerDescriptorCache.init(this, _vkDescriptorSetLayouts[1]);
 
@@ -245,6 +244,7 @@ VulkanPainter::~VulkanPainter() noexcept
     if (_vkDevice != VK_NULL_HANDLE)
     {
         vkDeviceWaitIdle(_vkDevice);
+        _psoCache.saveVkPipelineCache();
     }
 
     ImGui_ImplVulkan_Shutdown();
@@ -296,6 +296,7 @@ VulkanPainter::~VulkanPainter() noexcept
         }
     }
 
+    _uploadQueue.reset();
     _samplerCache.clear();
     _renderPassCache.clear();
     _framebufferCache.clear();
@@ -303,7 +304,7 @@ VulkanPainter::~VulkanPainter() noexcept
     _samplerDescriptorCache.destroy();
     _imageDescriptorCache.destroy();
 
-    auto cmdBuffers = List<VkCommandBuffer, maxFramesInFlight + 1>();
+    auto cmdBuffers = List<VkCommandBuffer, maxFramesInFlight>();
 
     for (auto& frame : _frameData)
     {
@@ -313,18 +314,11 @@ VulkanPainter::~VulkanPainter() noexcept
         }
     }
 
-    if (_vkImmediateCmdBuffer != VK_NULL_HANDLE)
-    {
-        cmdBuffers.add(_vkImmediateCmdBuffer);
-    }
-
     if (!cmdBuffers.isEmpty())
     {
         vkFreeCommandBuffers(_vkDevice, _vkCommandPool, u32(cmdBuffers.size()), cmdBuffers.data());
     }
 
-    _vkImmediateCmdBuffer = VK_NULL_HANDLE;
-
     if (_vkCommandPool != VK_NULL_HANDLE)
     {
         logVerbose("Destroying VkCommandPool 0x{}", uintptr_t(_vkCommandPool));
@@ -332,12 +326,6 @@ VulkanPainter::~VulkanPainter() noexcept
         _vkCommandPool = VK_NULL_HANDLE;
     }
 
-    if (_vkImmediateFence != VK_NULL_HANDLE)
-    {
-        vkDestroyFence(_vkDevice, _vkImmediateFence, nullptr);
-        _vkImmediateFence = VK_NULL_HANDLE;
-    }
-
     for (auto& frame : _frameData)
     {
         if (frame.imageAvailableSemaphore != VK_NULL_HANDLE)
@@ -359,8 +347,7 @@ VulkanPainter::~VulkanPainter() noexcept
         }
     }
 
-    _frameData         = {};
-    _spriteIndexBuffer = {};
+    _frameData = {};
 
     if (_vkUboDescriptorPool != VK_NULL_HANDLE)
     {
@@ -407,6 +394,8 @@ VulkanPainter::~VulkanPainter() noexcept
 
 void VulkanPainter::onFrameStarted()
 {
+    PollyProfileScope("VulkanPainter::onFrameStarted");
+
     auto& vulkanWindow = static_cast<VulkanWindow&>(window());
 
     if (vulkanWindow.isSwapChainRecreationRequested())
@@ -418,6 +407,8 @@ void VulkanPainter::onFrameStarted()
 
     vkWaitForFences(_vkDevice, 1, &frameData.inFlightFence, VK_TRUE, UINT64_MAX);
 
+    _uploadQueue->onFrameStarted(frameIndex());
+
     vulkanWindow.nextSwapChainImage(
         _vkDevice,
         _vkPhysicalDevice,
@@ -438,12 +429,11 @@ void VulkanPainter::onFrameStarted()
         vkBeginCommandBuffer(frameData.vkCommandBuffer, &beginInfo);
     }
 
-    frameData.spriteVertexCounter            = 0;
-    frameData.spriteIndexCounter             = 0;
-    frameData.currentSpriteVertexBufferIndex = 0;
-    frameData.polyVertexCounter              = 0;
-    frameData.meshVertexCounter              = 0;
-    frameData.meshIndexCounter               = 0;
+    frameData.spriteInstanceCounter            = 0;
+    frameData.currentSpriteInstanceBufferIndex = 0;
+    frameData.polyVertexCounter                = 0;
+    frameData.meshVertexCounter                = 0;
+    frameData.meshIndexCounter                 = 0;
 
     setCanvas({}, black, true);
 
@@ -459,12 +449,16 @@ void VulkanPainter::onFrameStarted()
 
 void VulkanPainter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGuiDrawFunc)
 {
+    PollyProfileScope("VulkanPainter::onFrameEnded");
+
     auto&      frameData   = _frameData[frameIndex()];
     const auto vkCmdBuffer = frameData.vkCommandBuffer;
 
     // ImGui
     if (imGuiDrawFunc)
     {
+        PollyProfileScope("ImGui");
+
         setCanvas({}, none, false);
 
         ImGui_ImplVulkan_NewFrame();
@@ -484,25 +478,39 @@ void VulkanPainter::onFrameEnded(ImGui& imgui, const Function<void(ImGui)>& imGu
     if (frameData.currentVkRenderPass != VK_NULL_HANDLE)
     {
         vkCmdEndRenderPass(vkCmdBuffer);
-        frameData.currentVkRenderPass = VK_NULL_HANDLE;
-#ifndef NDEBUG
-        frameData.currentRenderPassTargetFormat = none;
-#endif
+        frameData.currentVkRenderPass       = VK_NULL_HANDLE;
+        frameData.currentRenderTargetFormat = VK_FORMAT_UNDEFINED;
     }
 
     checkVkResult(vkEndCommandBuffer(vkCmdBuffer), "Failed to record a command buffer.");
 
-    auto submitInfo  = VkSubmitInfo();
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    // Pending image uploads are executed ahead of the frame's commands.
+    const auto upload = _uploadQueue->submit(frameIndex());
 
-    const auto     waitSemaphores = Array{frameData.imageAvailableSemaphore};
-    constexpr auto waitStages = Array<VkPipelineStageFlags, 1>{VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    auto waitSemaphores = List<VkSemaphore, 2>{frameData.imageAvailableSemaphore};
+    auto waitStages     = List<VkPipelineStageFlags, 2>{VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    auto cmdBuffers     = List<VkCommandBuffer, 2>();
 
+    if (upload.waitSemaphore != VK_NULL_HANDLE)
+    {
+        waitSemaphores.add(upload.waitSemaphore);
+        waitStages.add(VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    }
+
+    if (upload.vkCommandBuffer != VK_NULL_HANDLE)
+    {
+        cmdBuffers.add(upload.vkCommandBuffer);
+    }
+
+    cmdBuffers.add(vkCmdBuffer);
+
+    auto submitInfo               = VkSubmitInfo();
+    submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.waitSemaphoreCount = waitSemaphores.size();
     submitInfo.pWaitSemaphores    = waitSemaphores.data();
     submitInfo.pWaitDstStageMask  = waitStages.data();
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers    = &vkCmdBuffer;
+    submitInfo.commandBufferCount = cmdBuffers.size();
+    submitInfo.pCommandBuffers    = cmdBuffers.data();
 
     const auto signalSemaphores     = Array{frameData.renderFinishedSemaphore};
     submitInfo.signalSemaphoreCount = signalSemaphores.size();
@@ -540,10 +548,8 @@ void VulkanPainter::onBeforeCanvasChanged(Image oldCanvas, [[maybe_unused]] Rect
     if (frameData.currentVkRenderPass != VK_NULL_HANDLE)
     {
         vkCmdEndRenderPass(vkCmdBuffer);
-        frameData.currentVkRenderPass = VK_NULL_HANDLE;
-#ifndef NDEBUG
-        frameData.currentRenderPassTargetFormat = none;
-#endif
+        frameData.currentVkRenderPass       = VK_NULL_HANDLE;
+        frameData.currentRenderTargetFormat = VK_FORMAT_UNDEFINED;
     }
 
     // If we had a canvas bound, its Vulkan image must be transitioned from
@@ -688,11 +694,8 @@ void VulkanPainter::onAfterCanvasChanged(Image newCanvas, Maybe<Color> clearColo
 
     vkCmdSetScissor(vkCmdBuffer, 0, 1, &vkScissorRect);
 
-    frameData.currentVkRenderPass = vkRenderPass;
-
-#ifndef NDEBUG
-    frameData.currentRenderPassTargetFormat = renderPassCacheKey.renderTargetFormat;
-#endif
+    frameData.currentVkRenderPass       = vkRenderPass;
+    frameData.currentRenderTargetFormat = renderPassCacheKey.renderTargetFormat;
 
     setDirtyFlags(
         dirtyFlags()
@@ -744,19 +747,26 @@ void VulkanPainter::setScissorRects([[maybe_unused]] Span<Rectangle> scissorRect
 #endif
 }
 
-UniquePtr<Image::Impl> VulkanPainter::createCanvas(u32 width, u32 height, ImageFormat format)
-{
-    return makeUnique<VulkanImage>(*this, width, height, format);
-}
-
 UniquePtr<Image::Impl> VulkanPainter::createImage(
+    ImageUsage  usage,
     u32         width,
     u32         height,
     ImageFormat format,
-    const void* data,
-    bool        isStatic)
+    const void* data)
 {
-    return makeUnique<VulkanImage>(*this, width, height, format, data, isStatic);
+    return makeUnique<VulkanImage>(*this, usage, width, height, format, data, false);
+}
+
+UniquePtr<Image::Impl> VulkanPainter::createAlphaCoverageImage(u32 width, u32 height)
+{
+    return makeUnique<VulkanImage>(
+        *this,
+        ImageUsage::Updatable,
+        width,
+        height,
+        ImageFormat::R8Unorm,
+        nullptr,
+        true);
 }
 
 UniquePtr<Shader::Impl> VulkanPainter::onCreateNativeUserShader(
@@ -833,6 +843,11 @@ VulkanSamplerCache& VulkanPainter::samplerCache()
     return _samplerCache;
 }
 
+VulkanUploadQueue& VulkanPainter::uploadQueue()
+{
+    return *_uploadQueue;
+}
+
 List<String> VulkanPainter::determineVkPhysicalDevice(
     VkInstance        vkInstance,
     VkSurfaceKHR      surface,
@@ -889,6 +904,7 @@ List<String> VulkanPainter::determineVkPhysicalDevice(
 
                 auto graphicsQueueFamily = Maybe<uint32_t>();
                 auto presentQueueFamily  = Maybe<uint32_t>();
+                auto transferQueueFamily = Maybe<uint32_t>();
                 {
                     auto queueFamilies = List<VkQueueFamilyProperties>();
                     {
@@ -934,6 +950,29 @@ List<String> VulkanPainter::determineVkPhysicalDevice(
                             break;
                         }
                     }
+
+                    // A transfer-only family is usually backed by a DMA engine, which can upload image
+                    // data while the graphics queue is busy. Coarse transfer granularities would
+                    // restrict the regions we can copy, so we only accept families without one.
+                    for (uint32_t j = 0; j < queueFamilies.size(); ++j)
+                    {
+                        const auto& family      = queueFamilies[j];
+                        const auto& granularity = family.minImageTransferGranularity;
+
+                        const auto isTransferOnly =
+                            (family.queueFlags & VK_QUEUE_TRANSFER_BIT)
+                            && !(family.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
+
+                        if (isTransferOnly
+                            && granularity.width == 1
+                            && granularity.height == 1
+                            && granularity.depth == 1)
+                        {
+                            logVerbose("Found dedicated transfer queue family (index={})", j);
+                            transferQueueFamily = j;
+                            break;
+                        }
+                    }
                 }
 
                 if (!graphicsQueueFamily || !presentQueueFamily)
@@ -991,6 +1030,7 @@ List<String> VulkanPainter::determineVkPhysicalDevice(
 
                 _graphicsQueueFamilyIndex = *graphicsQueueFamily;
                 _presentQueueFamilyIndex  = *presentQueueFamily;
+                _transferQueueFamilyIndex = transferQueueFamily;
 
                 return supportedExtensionsList;
             }
@@ -1124,6 +1164,19 @@ void VulkanPainter::createVkLogicalDevice(Span<const char*> requiredExtensions)
             });
     }
 
+    if (_transferQueueFamilyIndex)
+    {
+        queueCreateInfos.add(
+            VkDeviceQueueCreateInfo{
+                .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+                .pNext            = nullptr,
+                .flags            = 0,
+                .queueFamilyIndex = *_transferQueueFamilyIndex,
+                .queueCount       = 1,
+                .pQueuePriorities = &queuePriority,
+            });
+    }
+
     auto deviceCreateInfo                 = VkDeviceCreateInfo();
     deviceCreateInfo.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     deviceCreateInfo.pQueueCreateInfos    = queueCreateInfos.data();
@@ -1196,6 +1249,11 @@ void VulkanPainter::createVkLogicalDevice(Span<const char*> requiredExtensions)
 
     vkGetDeviceQueue(_vkDevice, _graphicsQueueFamilyIndex, 0, &_vkGraphicsQueue);
     vkGetDeviceQueue(_vkDevice, _presentQueueFamilyIndex, 0, &_vkPresentQueue);
+
+    if (_transferQueueFamilyIndex)
+    {
+        vkGetDeviceQueue(_vkDevice, *_transferQueueFamilyIndex, 0, &_vkTransferQueue);
+    }
 }
 
 void VulkanPainter::createVkCommandPool()
@@ -1244,26 +1302,6 @@ void VulkanPainter::createVkCommandBuffers()
                 formatString("CmdBuf[{}]", i));
         }
     }
-
-    // Immediate command buffer
-    {
-        logVerbose("  - Immediate command buffer");
-
-        auto info               = VkCommandBufferAllocateInfo();
-        info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        info.commandPool        = _vkCommandPool;
-        info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        info.commandBufferCount = 1;
-
-        checkVkResult(
-            vkAllocateCommandBuffers(_vkDevice, &info, &_vkImmediateCmdBuffer),
-            "Failed to create a command buffer.");
-
-        setVulkanObjectName(
-            _vkImmediateCmdBuffer,
-            VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
-            "ImmCmdBuf");
-    }
 }
 
 void VulkanPainter::createSyncObjects()
@@ -1290,10 +1328,6 @@ void VulkanPainter::createSyncObjects()
             throw Error("Failed to create sync objects.");
         }
     }
-
-    checkVkResult(
-        vkCreateFence(_vkDevice, &fenceInfo, nullptr, &_vkImmediateFence),
-        "Failed to create a fence.");
 }
 
 void VulkanPainter::createVmaAllocator(VkInstance vkInstance, uint32_t vkApiVersion)
@@ -1390,6 +1424,107 @@ void VulkanPainter::notifyResourceDestroyed(GraphicsResource& resource)
     Impl::notifyResourceDestroyed(resource);
 }
 
+void VulkanPainter::prepareDrawStates(Span<DrawStateCombination> combinations)
+{
+    const auto& vulkanWindow = static_cast<const VulkanWindow&>(window());
+
+    for (const auto& combination : combinations)
+    {
+        const auto mode = [&]
+        {
+            switch (combination.objectType)
+            {
+                case ShaderType::Sprite: return BatchMode::Sprites;
+                case ShaderType::Polygon: return BatchMode::Polygons;
+                case ShaderType::Mesh: return BatchMode::Mesh;
+            }
+
+            return BatchMode::Sprites;
+        }();
+
+        const auto renderTargetFormat = combination.canvasFormat ? convert(*combination.canvasFormat)
+                                                                 : vulkanWindow.swapChainImageFormat();
+
+        auto vkPsModules = List<VkShaderModule, 2>();
+
+        if (combination.shader)
+        {
+            vkPsModules.add(static_cast<VulkanUserShader*>(combination.shader.impl())->vkShaderModule());
+        }
+        else if (mode == BatchMode::Sprites)
+        {
+            // It's not known which kind of sprites are drawn, so prepare both.
+            vkPsModules.add(_defaultSpritePs);
+            vkPsModules.add(_monochromaticSpritePs);
+        }
+        else
+        {
+            vkPsModules.add(VK_NULL_HANDLE);
+        }
+
+        for (const auto vkPsModule : vkPsModules)
+        {
+            _psoCache.get(makePsoCacheKey(mode, vkPsModule, combination.blendState, renderTargetFormat));
+        }
+    }
+}
+
+VulkanPsoCache::Key VulkanPainter::makePsoCacheKey(
+    BatchMode         mode,
+    VkShaderModule    vkPsModule,
+    const BlendState& blendState,
+    VkFormat          renderTargetFormat) const
+{
+    auto key = VulkanPsoCache::Key();
+
+    switch (mode)
+    {
+        case BatchMode::Sprites: {
+            key.vkVsModule = _spriteVs;
+            key.vkPsModule = vkPsModule != VK_NULL_HANDLE ? vkPsModule : _defaultSpritePs;
+
+            // Every sprite is an instance, which the vertex shader expands to a quad.
+            key.vkPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+            key.vkVertexInputRate   = VK_VERTEX_INPUT_RATE_INSTANCE;
+            key.inputElements       = {
+                VertexElement::Vec4,
+                VertexElement::Vec4,
+                VertexElement::Vec4,
+                VertexElement::Vec4,
+            };
+
+            break;
+        }
+        case BatchMode::Polygons: {
+            key.vkVsModule          = _polyVs;
+            key.vkPsModule          = vkPsModule != VK_NULL_HANDLE ? vkPsModule : _polyPs;
+            key.vkPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+            key.inputElements       = {
+                VertexElement::Vec4,
+                VertexElement::Vec4,
+            };
+
+            break;
+        }
+        case BatchMode::Mesh: {
+            key.vkVsModule          = _meshVs;
+            key.vkPsModule          = _meshPs;
+            key.vkPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+            key.inputElements       = {
+                VertexElement::Vec4,
+                VertexElement::Vec4,
+            };
+            break;
+        }
+    }
+
+    key.blendState         = blendState;
+    key.vkPipelineLayout   = _vkPipelineLayout;
+    key.renderTargetFormat = renderTargetFormat;
+
+    return key;
+}
+
 int VulkanPainter::prepareDrawCall()
 {
     auto&      frameData               = _frameData[frameIndex()];
@@ -1401,62 +1536,23 @@ int VulkanPainter::prepareDrawCall()
 
     if ((df & DF_PipelineState) == DF_PipelineState)
     {
-        auto psoCacheKey = VulkanPsoCache::Key();
+        auto vkPsModule = VkShaderModule();
 
-        switch (currentBatchMode)
+        if (currentVulkanUserShader) [[unlikely]]
         {
-            case BatchMode::Sprites: {
-                psoCacheKey.vkVsModule = _spriteVs;
-
-                if (currentVulkanUserShader) [[unlikely]]
-                {
-                    psoCacheKey.vkPsModule = currentVulkanUserShader->vkShaderModule();
-                }
-                else
-                {
-                    psoCacheKey.vkPsModule = spriteShaderKind() == SpriteShaderKind::Default
-                                                 ? _defaultSpritePs
-                                                 : _monochromaticSpritePs;
-                }
-
-                psoCacheKey.vkPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-                break;
-            }
-            case BatchMode::Polygons: {
-                psoCacheKey.vkVsModule = _polyVs;
-
-                if (currentVulkanUserShader) [[unlikely]]
-                {
-                    psoCacheKey.vkPsModule = currentVulkanUserShader->vkShaderModule();
-                }
-                else
-                {
-                    psoCacheKey.vkPsModule = _polyPs;
-                }
-
-                psoCacheKey.vkPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
-
-                break;
-            }
-            case BatchMode::Mesh: {
-                psoCacheKey.vkVsModule          = _meshVs;
-                psoCacheKey.vkPsModule          = _meshPs;
-                psoCacheKey.vkPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-                break;
-            }
+            vkPsModule = currentVulkanUserShader->vkShaderModule();
+        }
+        else if (currentBatchMode == BatchMode::Sprites)
+        {
+            vkPsModule =
+                spriteShaderKind() == SpriteShaderKind::Default ? _defaultSpritePs : _monochromaticSpritePs;
         }
 
-        psoCacheKey.blendState       = currentBlendState();
-        psoCacheKey.vkPipelineLayout = _vkPipelineLayout;
-        psoCacheKey.vkRenderPass     = frameData.currentVkRenderPass;
-
-        // TODO: Make this dependent on batch mode.
-        // For now, all modes incidentally share the same input layout.
-        psoCacheKey.inputElements = {
-            VertexElement::Vec4,
-            VertexElement::Vec4,
-        };
+        const auto psoCacheKey = makePsoCacheKey(
+            currentBatchMode,
+            vkPsModule,
+            currentBlendState(),
+            frameData.currentRenderTargetFormat);
 
         vkCmdBindPipeline(
             frameData.vkCommandBuffer,
@@ -1474,7 +1570,8 @@ int VulkanPainter::prepareDrawCall()
         {
             [[likely]]
             case BatchMode::Sprites: {
-                vkBuffer = frameData.spriteVertexBuffers[frameData.currentSpriteVertexBufferIndex].vkBuffer();
+                vkBuffer =
+                    frameData.spriteInstanceBuffers[frameData.currentSpriteInstanceBufferIndex].vkBuffer();
                 break;
             }
             case BatchMode::Polygons: vkBuffer = frameData.polyVertexBuffer.vkBuffer(); break;
@@ -1492,11 +1589,8 @@ int VulkanPainter::prepareDrawCall()
     {
         VkBuffer indexBufferToBind = VK_NULL_HANDLE;
 
-        if (currentBatchMode == BatchMode::Sprites)
-        {
-            indexBufferToBind = _spriteIndexBuffer.vkBuffer();
-        }
-        else if (currentBatchMode == BatchMode::Mesh)
+        // Sprites and polygons are drawn without indices.
+        if (currentBatchMode == BatchMode::Mesh)
         {
             indexBufferToBind = frameData.meshIndexBuffer.vkBuffer();
         }
@@ -1533,6 +1627,8 @@ int VulkanPainter::prepareDrawCall()
                 nullptr);
 
             frameData.lastBoundSets[1] = samplerDescriptorSet;
+
+            ++perfStats.descriptorSetBindCount;
         }
 
         df &= ~DF_Sampler;
@@ -1624,31 +1720,15 @@ int VulkanPainter::prepareDrawCall()
     {
         if (currentVulkanUserShader)
         {
-            auto allocation = frameData.uboAllocator->allocate(currentVulkanUserShader->cbufferSize());
+            const auto allocation = frameData.uboAllocator->allocate(
+                currentVulkanUserShader->cbufferData(),
+                currentVulkanUserShader->cbufferSize());
 
-            const auto offset = allocation.offsetToMapAt;
+            const auto offset = allocation.dynamicOffset;
 
             if (frameData.lastBoundSets[2] != allocation.vkDescriptorSet
                 || frameData.lastBoundSet2Offset != offset)
             {
-                u8* dstData = nullptr;
-
-                checkVkResult(
-                    vmaMapMemory(
-                        _vmaAllocator,
-                        allocation.buffer->allocation(),
-                        reinterpret_cast<void**>(&dstData)),
-                    "Failed to map an internal buffer.");
-
-                dstData += offset;
-
-                std::memcpy(
-                    dstData,
-                    currentVulkanUserShader->cbufferData(),
-                    currentVulkanUserShader->cbufferSize());
-
-                vmaUnmapMemory(_vmaAllocator, allocation.buffer->allocation());
-
                 vkCmdBindDescriptorSets(
                     frameData.vkCommandBuffer,
                     VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -1661,8 +1741,12 @@ int VulkanPainter::prepareDrawCall()
 
                 frameData.lastBoundSets[2]    = allocation.vkDescriptorSet;
                 frameData.lastBoundSet2Offset = offset;
+
+                ++perfStats.descriptorSetBindCount;
             }
 
+            perfStats.uniformBufferBytes = frameData.uboAllocator->usedBytes();
+
             currentVulkanUserShader->clearDirtyScalarParameters();
         }
 
@@ -1688,6 +1772,7 @@ int VulkanPainter::prepareDrawCall()
             frameData.lastBoundSets[0] = vkDescriptorSet;
 
             ++perfStats.textureChangeCount;
+            ++perfStats.descriptorSetBindCount;
         }
     }
 
@@ -1697,45 +1782,38 @@ int VulkanPainter::prepareDrawCall()
 void VulkanPainter::flushSprites(
     Span<InternalSprite>  sprites,
     GamePerformanceStats& stats,
-    Rectangle             imageSizeAndInverse)
+    Span<Rectangle>       imageSizesAndInverse)
 {
-    auto&       frameData    = _frameData[frameIndex()];
-    const auto& vertexBuffer = frameData.spriteVertexBuffers[frameData.currentSpriteVertexBufferIndex];
+    PollyProfileScope("VulkanPainter::flushSprites");
 
-    const auto vertexCount = sprites.size() * verticesPerSprite;
-    const auto indexCount  = sprites.size() * indicesPerSprite;
+    auto&       frameData      = _frameData[frameIndex()];
+    const auto& instanceBuffer = frameData.spriteInstanceBuffers[frameData.currentSpriteInstanceBufferIndex];
 
     // Draw sprites
-    SpriteVertex* dstVertices = nullptr;
+    SpriteInstance* dstInstances = nullptr;
 
     checkVkResult(
-        vmaMapMemory(_vmaAllocator, vertexBuffer.allocation(), reinterpret_cast<void**>(&dstVertices)),
+        vmaMapMemory(_vmaAllocator, instanceBuffer.allocation(), reinterpret_cast<void**>(&dstInstances)),
         "Failed to map a sprite buffer.");
 
-    dstVertices += frameData.spriteVertexCounter;
+    dstInstances += frameData.spriteInstanceCounter;
 
-    fillSpriteVertices(
-        dstVertices,
-        sprites,
-        imageSizeAndInverse,
-        false,
-        [](const Vec2& position, const Color& color, const Vec2& uv)
-        {
-            return SpriteVertex{
-                .positionAndUV = {position, uv},
-                .color         = color,
-            };
-        });
+    fillSpriteInstances<false>(dstInstances, sprites, imageSizesAndInverse);
 
-    vmaUnmapMemory(_vmaAllocator, vertexBuffer.allocation());
+    vmaUnmapMemory(_vmaAllocator, instanceBuffer.allocation());
 
-    vkCmdDrawIndexed(frameData.vkCommandBuffer, indexCount, 1, frameData.spriteIndexCounter, 0, 0);
+    // The vertex shader expands each instance to a quad.
+    vkCmdDraw(
+        frameData.vkCommandBuffer,
+        verticesPerSprite,
+        sprites.size(),
+        0,
+        frameData.spriteInstanceCounter);
 
     ++stats.drawCallCount;
-    stats.vertexCount += vertexCount;
+    stats.vertexCount += sprites.size() * verticesPerSprite;
 
-    frameData.spriteVertexCounter += vertexCount;
-    frameData.spriteIndexCounter += indexCount;
+    frameData.spriteInstanceCounter += sprites.size();
 }
 
 void VulkanPainter::flushPolys(
@@ -1744,6 +1822,8 @@ void VulkanPainter::flushPolys(
     u32                           numberOfVerticesToDraw,
     GamePerformanceStats&         stats)
 {
+    PollyProfileScope("VulkanPainter::flushPolys");
+
     auto& frameData = _frameData[frameIndex()];
 
     Tessellation2D::PolyVertex* dstVertices = nullptr;
@@ -1757,7 +1837,7 @@ void VulkanPainter::flushPolys(
 
     dstVertices += frameData.polyVertexCounter;
 
-    Tessellation2D::processPolyQueue(polys, dstVertices, polyCmdVertexCounts);
+    fillPolyVertices(polys, dstVertices, polyCmdVertexCounts, numberOfVerticesToDraw);
 
     vmaUnmapMemory(_vmaAllocator, frameData.polyVertexBuffer.allocation());
 
@@ -1771,6 +1851,8 @@ void VulkanPainter::flushPolys(
 
 void VulkanPainter::flushMeshes(Span<MeshEntry> meshes, GamePerformanceStats& stats)
 {
+    PollyProfileScope("VulkanPainter::flushMeshes");
+
     auto& frameData = _frameData[frameIndex()];
 
     auto        baseVertex  = frameData.meshVertexCounter;
@@ -1817,20 +1899,20 @@ void VulkanPainter::spriteQueueLimitReached()
     const auto currentFrameIndex = frameIndex();
     auto&      frameData         = _frameData[currentFrameIndex];
 
-    if (frameData.currentSpriteVertexBufferIndex + 1 >= frameData.spriteVertexBuffers.size())
+    if (frameData.currentSpriteInstanceBufferIndex + 1 >= frameData.spriteInstanceBuffers.size())
     {
-        // Have to allocate a new sprite vertex buffer.
-        frameData.spriteVertexBuffers.add(createSingleSpriteVertexBuffer(
-            (10u * frameData.currentSpriteVertexBufferIndex) + currentFrameIndex));
+        // Have to allocate a new sprite instance buffer.
+        frameData.spriteInstanceBuffers.add(createSingleSpriteInstanceBuffer(
+            (10u * frameData.currentSpriteInstanceBufferIndex) + currentFrameIndex));
     }
 
     flush();
 
-    ++frameData.currentSpriteVertexBufferIndex;
-    frameData.spriteVertexCounter = 0;
-    frameData.spriteIndexCounter  = 0;
+    ++frameData.currentSpriteInstanceBufferIndex;
+    frameData.spriteInstanceCounter = 0;
 
-    const auto buffer = frameData.spriteVertexBuffers[frameData.currentSpriteVertexBufferIndex].vkBuffer();
+    const auto buffer =
+        frameData.spriteInstanceBuffers[frameData.currentSpriteInstanceBufferIndex].vkBuffer();
     constexpr auto offset = static_cast<VkDeviceSize>(0);
 
     vkCmdBindVertexBuffers(frameData.vkCommandBuffer, 0, 1, &buffer, &offset);
@@ -1968,33 +2050,12 @@ void VulkanPainter::createShaderModules()
 
 void VulkanPainter::createSpriteRenderingResources()
 {
-    // Vertex buffer
+    // Instance buffer
     for (uint32_t i = 0; auto& data : _frameData)
     {
-        data.spriteVertexBuffers.add(createSingleSpriteVertexBuffer(i));
+        data.spriteInstanceBuffers.add(createSingleSpriteInstanceBuffer(i));
         ++i;
     }
-
-    // Index buffer
-    {
-        const auto indices = createSpriteIndicesList<maxSpriteBatchSize>();
-
-        // TODO: optimize flags and usage?
-        _spriteIndexBuffer = VulkanBuffer(
-            _vkDevice,
-            _vmaAllocator,
-            sizeof(uint16_t) * indices.size(),
-            VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-            VK_SHARING_MODE_EXCLUSIVE,
-            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
-            indices.data(),
-            "SpriteIndexBuffer");
-
-        setVulkanObjectName(
-            _spriteIndexBuffer.vkBuffer(),
-            VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT,
-            "SpriteIndexBuffer");
-    }
 }
 
 void VulkanPainter::createPolyRenderingResources()
@@ -2040,7 +2101,7 @@ void VulkanPainter::createMeshRenderingResources()
         data.meshIndexBuffer = VulkanBuffer(
             _vkDevice,
             _vmaAllocator,
-            sizeof(MeshVertex) * maxMeshVertices,
+            sizeof(uint16_t) * maxMeshIndices,
             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
             VK_SHARING_MODE_EXCLUSIVE,
             VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
@@ -2054,14 +2115,14 @@ void VulkanPainter::createMeshRenderingResources()
     }
 }
 
-VulkanBuffer VulkanPainter::createSingleSpriteVertexBuffer(uint32_t index)
+VulkanBuffer VulkanPainter::createSingleSpriteInstanceBuffer(uint32_t index)
 {
-    const auto nameStr = formatString("SpriteVB[{}]", index);
+    const auto nameStr = formatString("SpriteInstanceBuffer[{}]", index);
 
     auto buffer = VulkanBuffer(
         _vkDevice,
         _vmaAllocator,
-        sizeof(SpriteVertex) * maxSpriteBatchSize * verticesPerSprite,
+        sizeof(SpriteInstance) * maxSpriteBatchSize,
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_SHARING_MODE_EXCLUSIVE,
         VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
@@ -2171,6 +2232,10 @@ void VulkanPainter::setResourceDebugName(
             info.object            = reinterpret_cast<u64>(userShader.vkShaderModule());
             break;
         }
+        case GraphicsResourceType::StaticSpriteBatch: {
+            // Static sprite batches aren't backed by a Vulkan object.
+            return;
+        }
     }
 
     info.pObjectName = name.data();
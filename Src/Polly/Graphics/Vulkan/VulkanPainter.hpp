@@ -13,6 +13,7 @@
 #include <Polly/Graphics/Vulkan/VulkanSamplerCache.hpp>
 #include <Polly/Graphics/Vulkan/VulkanSamplerDescriptorCache.hpp>
 #include <Polly/Graphics/Vulkan/VulkanUBOAllocator.hpp>
+#include <Polly/Graphics/Vulkan/VulkanUploadQueue.hpp>
 #include <Polly/List.hpp>
 
 namespace Polly
@@ -46,14 +47,14 @@ class VulkanPainter final : public Painter::Impl
     void readCanvasDataInto(const Image& canvas, u32 x, u32 y, u32 width, u32 height, void* destination)
         override;
 
-    UniquePtr<Image::Impl> createCanvas(u32 width, u32 height, ImageFormat format) override;
-
     UniquePtr<Image::Impl> createImage(
+        ImageUsage  usage,
         u32         width,
         u32         height,
         ImageFormat format,
-        const void* data,
-        bool        isStatic) override;
+        const void* data) override;
+
+    UniquePtr<Image::Impl> createAlphaCoverageImage(u32 width, u32 height) override;
 
     UniquePtr<Shader::Impl> onCreateNativeUserShader(
         const ShaderCompiler::Ast&          ast,
@@ -84,10 +85,9 @@ class VulkanPainter final : public Painter::Impl
 
     VulkanSamplerCache& samplerCache();
 
-    void setResourceDebugName(GraphicsResource& resource, StringView name);
+    VulkanUploadQueue& uploadQueue();
 
-    template<typename Action>
-    void submitImmediateGraphicsCommands(const Action& function);
+    void setResourceDebugName(GraphicsResource& resource, StringView name);
 
     template<typename TVulkanHandle>
     void setVulkanObjectName(TVulkanHandle handle, VkDebugReportObjectTypeEXT type, const String& name)
@@ -108,9 +108,11 @@ class VulkanPainter final : public Painter::Impl
 
   private:
     // Limit vertex counts to 16 bit, because we're using 16 bit index buffers.
+    // Sprites are drawn as instances without indices, but share the same limit as the other backends.
     static constexpr auto maxSpriteBatchSize = std::numeric_limits<uint16_t>::max() / verticesPerSprite;
     static constexpr auto maxPolyVertices    = std::numeric_limits<uint16_t>::max();
     static constexpr auto maxMeshVertices    = std::numeric_limits<uint16_t>::max();
+    static constexpr auto maxMeshIndices     = maxMeshVertices * 3;
 
     // We have 3 descriptor sets:
     // [0] = images
@@ -141,12 +143,20 @@ class VulkanPainter final : public Painter::Impl
 
     void notifyResourceDestroyed(GraphicsResource& resource) override;
 
+    void prepareDrawStates(Span<DrawStateCombination> combinations) override;
+
     int prepareDrawCall() override;
 
+    VulkanPsoCache::Key makePsoCacheKey(
+        BatchMode         mode,
+        VkShaderModule    vkPsModule,
+        const BlendState& blendState,
+        VkFormat          renderTargetFormat) const;
+
     void flushSprites(
         Span<InternalSprite>  sprites,
         GamePerformanceStats& stats,
-        Rectangle             imageSizeAndInverse) override;
+        Span<Rectangle>       imageSizesAndInverse) override;
 
     void flushPolys(
         Span<Tessellation2D::Command> polys,
@@ -168,7 +178,7 @@ class VulkanPainter final : public Painter::Impl
 
     void createMeshRenderingResources();
 
-    VulkanBuffer createSingleSpriteVertexBuffer(u32 index);
+    VulkanBuffer createSingleSpriteInstanceBuffer(u32 index);
 
     void destroyQueuedVulkanObjects();
 
@@ -183,9 +193,11 @@ class VulkanPainter final : public Painter::Impl
     VkPhysicalDeviceProperties _vkPhysicalDeviceProps    = {};
     u32                        _graphicsQueueFamilyIndex = 0;
     u32                        _presentQueueFamilyIndex  = 0;
+    Maybe<u32>                 _transferQueueFamilyIndex;
     VkDevice                   _vkDevice                 = VK_NULL_HANDLE;
     VkQueue                    _vkGraphicsQueue          = VK_NULL_HANDLE;
     VkQueue                    _vkPresentQueue           = VK_NULL_HANDLE;
+    VkQueue                    _vkTransferQueue          = VK_NULL_HANDLE;
     VkCommandPool              _vkCommandPool            = VK_NULL_HANDLE;
     VmaAllocator               _vmaAllocator             = VK_NULL_HANDLE;
     VkDescriptorPool           _vkUboDescriptorPool      = VK_NULL_HANDLE;
@@ -197,8 +209,7 @@ class VulkanPainter final : public Painter::Impl
     VulkanImageDescriptorCache   _imageDescriptorCache;
     VulkanSamplerDescriptorCache _samplerDescriptorCache;
 
-    VkCommandBuffer _vkImmediateCmdBuffer = VK_NULL_HANDLE;
-    VkFence         _vkImmediateFence     = VK_NULL_HANDLE;
+    UniquePtr<VulkanUploadQueue> _uploadQueue;
 
     VkPipelineLayout                                 _vkPipelineLayout       = VK_NULL_HANDLE;
     Array<VkDescriptorSetLayout, descriptorSetCount> _vkDescriptorSetLayouts = {};
@@ -218,25 +229,20 @@ class VulkanPainter final : public Painter::Impl
         VkSemaphore     renderFinishedSemaphore = VK_NULL_HANDLE;
         VkFence         inFlightFence           = VK_NULL_HANDLE;
 
-        VkRenderPass currentVkRenderPass = VK_NULL_HANDLE;
-
-        // Extra props for debugging:
-#ifndef NDEBUG
-        Maybe<VkFormat> currentRenderPassTargetFormat;
-#endif
+        VkRenderPass currentVkRenderPass       = VK_NULL_HANDLE;
+        VkFormat     currentRenderTargetFormat = VK_FORMAT_UNDEFINED;
 
         Array<VkDescriptorSet, descriptorSetCount> lastBoundSets{};
         u32                                        lastBoundSet2Offset = 0;
 
-        List<VulkanBuffer, 4> spriteVertexBuffers;
-        u32                   currentSpriteVertexBufferIndex = 0;
+        List<VulkanBuffer, 4> spriteInstanceBuffers;
+        u32                   currentSpriteInstanceBufferIndex = 0;
 
         VulkanBuffer polyVertexBuffer;
         VulkanBuffer meshVertexBuffer;
         VulkanBuffer meshIndexBuffer;
 
-        u32 spriteVertexCounter = 0;
-        u32 spriteIndexCounter  = 0;
+        u32 spriteInstanceCounter = 0;
 
         u32 polyVertexCounter = 0;
 
@@ -253,8 +259,6 @@ class VulkanPainter final : public Painter::Impl
 
     Array<FrameData, maxFramesInFlight> _frameData;
 
-    VulkanBuffer _spriteIndexBuffer;
-
     struct
     {
         List<VulkanImageAndViewPair, 8> imageAndViewPairs;
@@ -273,33 +277,4 @@ class VulkanPainter final : public Painter::Impl
     PFN_vkDestroyDebugUtilsMessengerEXT _vkDestroyDebugUtilsMessenger  = {};
 #endif
 };
-
-template<typename Action>
-void VulkanPainter::submitImmediateGraphicsCommands(const Action& function)
-{
-    checkVkResult(vkResetFences(_vkDevice, 1, &_vkImmediateFence), "Failed to reset internal fence.");
-
-    checkVkResult(vkResetCommandBuffer(_vkImmediateCmdBuffer, 0), "Failed to reset internal command buffer.");
-
-    auto cmd_begin_info  = VkCommandBufferBeginInfo();
-    cmd_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    cmd_begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-    checkVkResult(
-        vkBeginCommandBuffer(_vkImmediateCmdBuffer, &cmd_begin_info),
-        "Failed to begin internal command buffer.");
-
-    function(_vkImmediateCmdBuffer);
-
-    checkVkResult(vkEndCommandBuffer(_vkImmediateCmdBuffer), "Failed to end internal command buffer.");
-
-    auto submit               = VkSubmitInfo();
-    submit.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit.commandBufferCount = 1;
-    submit.pCommandBuffers    = &_vkImmediateCmdBuffer;
-
-    // vkQueueSubmit2(m_vkGraphicsQueue, 1, &submit, _immFence);
-    checkVkResult(vkQueueSubmit(_vkGraphicsQueue, 1, &submit, _vkImmediateFence));
-    checkVkResult(vkWaitForFences(_vkDevice, 1, &_vkImmediateFence, true, 9999999999));
-}
 } // namespace Polly
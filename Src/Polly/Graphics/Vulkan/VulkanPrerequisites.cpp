@@ -83,6 +83,7 @@ Polly::Pair<VkFormat, size_t> Polly::convert(VertexElement element)
         case VertexElement::Vec2: return {VK_FORMAT_R32G32_SFLOAT, sizeof(Vec2)};
         case VertexElement::Vec3: return {VK_FORMAT_R32G32B32_SFLOAT, sizeof(Vec3)};
         case VertexElement::Vec4: return {VK_FORMAT_R32G32B32A32_SFLOAT, sizeof(Vec4)};
+        case VertexElement::UByte4Normalized: return {VK_FORMAT_R8G8B8A8_UNORM, sizeof(u8) * 4};
     }
 
     return {VK_FORMAT_UNDEFINED, 0};
@@ -1,10 +1,47 @@
 #include <Polly/Graphics/Vulkan/VulkanPsoCache.hpp>
 
+#include <Polly/FileSystem.hpp>
+#include <Polly/Game/GameImpl.hpp>
 #include <Polly/Graphics/Vulkan/VulkanPainter.hpp>
 #include <Polly/Logging.hpp>
+#include <cstring>
 
 namespace Polly
 {
+static constexpr auto pipelineCacheFilename = "VulkanPipelineCache.bin"_sv;
+
+// The pipeline cache depends on the user's GPU and driver, so it's stored in the game's
+// writable storage instead of next to its assets.
+static Maybe<String> pipelineCacheFilePath()
+{
+    auto path = Game::Impl::instance().writableStoragePath();
+
+    if (path)
+    {
+        *path += pipelineCacheFilename;
+    }
+
+    return path;
+}
+
+// Drivers should reject incompatible cache data themselves, but not all of them do so reliably.
+static bool isPipelineCacheDataCompatible(const ByteBlob& data, const VkPhysicalDeviceProperties& props)
+{
+    auto header = VkPipelineCacheHeaderVersionOne();
+
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    return header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+           and header.vendorID == props.vendorID
+           and header.deviceID == props.deviceID
+           and std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
 VulkanPsoCache::VulkanPsoCache(VulkanPainter& painter)
     : _painter(painter)
 {
@@ -24,7 +61,7 @@ VkPipeline VulkanPsoCache::get(const Key& entry)
         assume(entry.vkVsModule != VK_NULL_HANDLE);
         assume(entry.vkPsModule != VK_NULL_HANDLE);
         assume(entry.vkPipelineLayout != VK_NULL_HANDLE);
-        assume(entry.vkRenderPass != VK_NULL_HANDLE);
+        assume(entry.renderTargetFormat != VK_FORMAT_UNDEFINED);
 
         logVerbose("Creating VkPipeline");
 
@@ -32,7 +69,7 @@ VkPipeline VulkanPsoCache::get(const Key& entry)
 
         auto vertexBindingDesc      = VkVertexInputBindingDescription();
         vertexBindingDesc.binding   = 0;
-        vertexBindingDesc.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        vertexBindingDesc.inputRate = entry.vkVertexInputRate;
 
         auto attributeDescs = List<VkVertexInputAttributeDescription>();
         {
@@ -144,14 +181,24 @@ VkPipeline VulkanPsoCache::get(const Key& entry)
         pipelineInfo.pViewportState      = &viewportStateInfo;
         pipelineInfo.layout              = entry.vkPipelineLayout;
 
-        pipelineInfo.renderPass = entry.vkRenderPass;
-        pipelineInfo.subpass    = 0;
+        // A pipeline may be used with any render pass that is compatible with the one it was
+        // created with. Render passes that only differ in their load operations and layouts are
+        // compatible, so one pipeline per render target format is enough.
+        pipelineInfo.renderPass = _painter.renderPassCache().get(
+            VulkanRenderPassCache::Key{
+                .renderTargetFormat = entry.renderTargetFormat,
+                .initialLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                .finalLayout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .clearColor         = none,
+            });
+
+        pipelineInfo.subpass = 0;
 
         const auto vkDevice   = _painter.vkDevice();
         auto       vkPipeline = VkPipeline();
 
         checkVkResult(
-            vkCreateGraphicsPipelines(vkDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &vkPipeline),
+            vkCreateGraphicsPipelines(vkDevice, _vkPipelineCache, 1, &pipelineInfo, nullptr, &vkPipeline),
             "Failed to create a Vulkan pipeline object.");
 
         logVerbose("Created VkPipeline 0x{}", uintptr_t(vkPipeline));
@@ -179,10 +226,91 @@ void VulkanPsoCache::notifyVkShaderModuleAboutToBeDestroyed(VkShaderModule mod)
         });
 }
 
+void VulkanPsoCache::loadVkPipelineCache()
+{
+    assume(_vkPipelineCache == VK_NULL_HANDLE);
+
+    auto initialData = Maybe<ByteBlob>();
+
+    if (const auto path = pipelineCacheFilePath())
+    {
+        initialData = FileSystem::loadFileFromDisk(*path);
+
+        if (initialData and not isPipelineCacheDataCompatible(*initialData, _painter.vkPhysicalDeviceProps()))
+        {
+            logVerbose("Ignoring Vulkan pipeline cache '{}', since it belongs to a different device", *path);
+            initialData = none;
+        }
+    }
+
+    auto info  = VkPipelineCacheCreateInfo();
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    if (initialData)
+    {
+        info.initialDataSize = initialData->size();
+        info.pInitialData    = initialData->data();
+    }
+
+    checkVkResult(
+        vkCreatePipelineCache(_painter.vkDevice(), &info, nullptr, &_vkPipelineCache),
+        "Failed to create a Vulkan pipeline cache.");
+
+    logVerbose("Created VkPipelineCache with {} bytes of initial data", info.initialDataSize);
+}
+
+void VulkanPsoCache::saveVkPipelineCache()
+{
+    if (_vkPipelineCache == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    const auto path = pipelineCacheFilePath();
+
+    if (not path)
+    {
+        logVerbose("Not saving the Vulkan pipeline cache, since the game has no title or company name");
+        return;
+    }
+
+    const auto vkDevice = _painter.vkDevice();
+
+    // This is called while the painter is destroyed, so a failure is not fatal.
+    // Any VkResult other than VK_SUCCESS, including VK_INCOMPLETE, skips saving.
+    try
+    {
+        auto dataSize = size_t();
+
+        checkVkResult(
+            vkGetPipelineCacheData(vkDevice, _vkPipelineCache, &dataSize, nullptr),
+            "Failed to obtain the size of the Vulkan pipeline cache.");
+
+        auto data = ByteBlob(narrow<u32>(dataSize));
+
+        checkVkResult(
+            vkGetPipelineCacheData(vkDevice, _vkPipelineCache, &dataSize, data.data()),
+            "Failed to obtain the data of the Vulkan pipeline cache.");
+
+        FileSystem::writeBinaryFileToDisk(*path, Span(data.data(), narrow<u32>(dataSize)));
+        logVerbose("Saved {} bytes of Vulkan pipeline cache data to '{}'", dataSize, *path);
+    }
+    catch (const Error& error)
+    {
+        logWarning("Failed to save the Vulkan pipeline cache: {}", error.message());
+    }
+}
+
 void VulkanPsoCache::clear()
 {
     logVerbose("Clearing VulkanPsoCache");
     _cache.clear();
+
+    if (_vkPipelineCache != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineCache(_painter.vkDevice(), _vkPipelineCache, nullptr);
+        _vkPipelineCache = VK_NULL_HANDLE;
+    }
 }
 
 VulkanPsoCache::PipelineValue::PipelineValue(VkDevice vkDevice, VkPipeline vkPipeline)
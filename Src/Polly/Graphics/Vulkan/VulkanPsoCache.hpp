@@ -24,8 +24,9 @@ class VulkanPsoCache final
         VkShaderModule         vkPsModule = VK_NULL_HANDLE;
         BlendState             blendState{};
         VkPrimitiveTopology    vkPrimitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        VkVertexInputRate      vkVertexInputRate   = VK_VERTEX_INPUT_RATE_VERTEX;
         VkPipelineLayout       vkPipelineLayout{};
-        VkRenderPass           vkRenderPass{};
+        VkFormat               renderTargetFormat = VK_FORMAT_UNDEFINED;
         List<VertexElement, 4> inputElements;
 
         DefineDefaultEqualityOperations(Key);
@@ -41,6 +42,14 @@ class VulkanPsoCache final
 
     void notifyVkShaderModuleAboutToBeDestroyed(VkShaderModule mod);
 
+    // Creates the VkPipelineCache that backs all pipeline creation, using the data that was
+    // saved by a previous run of the game, if it's compatible with the current device.
+    void loadVkPipelineCache();
+
+    // Writes the VkPipelineCache's data to the game's storage, so that subsequent runs of the
+    // game can create their pipelines faster.
+    void saveVkPipelineCache();
+
     void clear();
 
   private:
@@ -66,6 +75,7 @@ class VulkanPsoCache final
     };
 
     VulkanPainter&                _painter;
+    VkPipelineCache               _vkPipelineCache = VK_NULL_HANDLE;
     SortedMap<Key, PipelineValue> _cache;
 };
 } // namespace Polly
\ No newline at end of file
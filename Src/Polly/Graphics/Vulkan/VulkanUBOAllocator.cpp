@@ -6,12 +6,17 @@
 
 #include "Polly/Graphics/Vulkan/VulkanPainter.hpp"
 #include "Polly/Logging.hpp"
-#include "Polly/PlatformInfo.hpp"
+#include "Polly/Math.hpp"
+#include "Polly/Util.hpp"
+
+#include <cstring>
 
 namespace Polly
 {
-static constexpr auto maxCBufferSize = static_cast<size_t>(std::numeric_limits<uint16_t>::max());
-static constexpr auto requiredCBufferOffsetAlignment = 16u;
+// User shader parameters are limited to 16 bit sizes (see Shader::Impl::cbufferSize()).
+static constexpr auto maxCBufferSize = u32(std::numeric_limits<uint16_t>::max()) + 1u;
+
+static constexpr auto initialCapacity = 256u * 1024u;
 
 VulkanUBOAllocator::VulkanUBOAllocator(
     VulkanPainter&        device,
@@ -23,93 +28,140 @@ VulkanUBOAllocator::VulkanUBOAllocator(
 {
     assume(vkDescriptorPool != VK_NULL_HANDLE);
     assume(vkDescriptorSetLayout != VK_NULL_HANDLE);
-}
 
-VulkanUBOAllocator::Allocation VulkanUBOAllocator::allocate(u32 size)
-{
-    assume(size < maxCBufferSize);
+    const auto& limits = device.vkPhysicalDeviceProps().limits;
+
+    const auto alignment = max(16u, u32(limits.minUniformBufferOffsetAlignment));
 
-    auto newPosition = _positionInBuffer + size;
+    _cursor          = UniformBufferCursor(alignment, initialCapacity);
+    _descriptorRange = min(maxCBufferSize, u32(limits.maxUniformBufferRange));
+    _current         = createEntry(initialCapacity);
+}
 
-    if (!_currentBuffer || newPosition > _entries[*_currentBuffer].buffer.sizeInBytes())
+VulkanUBOAllocator::~VulkanUBOAllocator() noexcept
+{
+    for (auto& entry : _retired)
     {
-        logVerbose("VulkanCBufferAllocator: Creating buffer of size {}", maxCBufferSize);
-
-        const auto bufferName = formatString("VulkanUBOAllocator[{}]", _entries.size());
-
-        auto entry = Entry();
-
-        entry.buffer = VulkanBuffer(
-            _device.vkDevice(),
-            _device.vmaAllocator(),
-            maxCBufferSize,
-            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-            VK_SHARING_MODE_EXCLUSIVE,
-            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
-            nullptr,
-            bufferName.cstring());
-
-        _device.setVulkanObjectName(
-            entry.buffer.vkBuffer(),
-            VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT,
-            bufferName);
-
-        {
-            auto allocInfo               = VkDescriptorSetAllocateInfo();
-            allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            allocInfo.descriptorPool     = _vkDescriptorPool;
-            allocInfo.descriptorSetCount = 1;
-            allocInfo.pSetLayouts        = &_vkDescriptorSetLayout;
-
-            checkVkResult(
-                vkAllocateDescriptorSets(_device.vkDevice(), &allocInfo, &entry.set),
-                "Failed to create an UBO descriptor set.");
-
-            // Create descriptor set
-            {
-                auto bufferInfo   = VkDescriptorBufferInfo();
-                bufferInfo.buffer = entry.buffer.vkBuffer();
-                bufferInfo.offset = 0;
-                bufferInfo.range  = VK_WHOLE_SIZE;
-
-                auto setWrite            = VkWriteDescriptorSet();
-                setWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                setWrite.dstBinding      = 0;
-                setWrite.dstSet          = entry.set;
-                setWrite.descriptorCount = 1;
-                setWrite.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-                setWrite.pBufferInfo     = &bufferInfo;
-
-                vkUpdateDescriptorSets(_device.vkDevice(), 1, &setWrite, 0, nullptr);
-            }
-        }
-
-        _entries.add(std::move(entry));
-
-        _currentBuffer    = _entries.size() - 1;
-        _positionInBuffer = 0;
+        destroyEntry(entry);
     }
 
-    const auto nextBindingPoint =
-        _positionInBuffer > 0u ? nextAlignedNumber(newPosition, requiredCBufferOffsetAlignment) : 0u;
+    destroyEntry(_current);
+}
 
-    newPosition = max(nextBindingPoint, newPosition);
+VulkanUBOAllocator::Allocation VulkanUBOAllocator::allocate(const void* data, u32 size)
+{
+    assume(size <= _descriptorRange);
 
-    _positionInBuffer = newPosition;
+    const auto [offset, newCapacity] = _cursor.allocate(size);
 
-    auto& entry = _entries[*_currentBuffer];
+    if (newCapacity)
+    {
+        logVerbose(
+            "VulkanUBOAllocator: Growing from {} to {}",
+            bytesDisplayString(_current.capacity),
+            bytesDisplayString(*newCapacity));
+
+        // The current buffer is still referenced by the frame's commands.
+        _retired.add(std::move(_current));
+        _current = createEntry(*newCapacity);
+    }
+
+    std::memcpy(_current.data + offset, data, size);
+
+    checkVkResult(
+        vmaFlushAllocation(_device.vmaAllocator(), _current.buffer.allocation(), offset, size),
+        "Failed to flush a uniform buffer.");
 
     return Allocation{
-        .offsetToMapAt   = nextBindingPoint,
-        .buffer          = &entry.buffer,
-        .vkDescriptorSet = entry.set,
-        .size            = size,
+        .vkDescriptorSet = _current.vkDescriptorSet,
+        .dynamicOffset   = offset,
     };
 }
 
 void VulkanUBOAllocator::reset()
 {
-    _currentBuffer    = _entries.isEmpty() ? Maybe<int>() : 0;
-    _positionInBuffer = 0;
+    for (auto& entry : _retired)
+    {
+        destroyEntry(entry);
+    }
+
+    _retired.clear();
+    _cursor.reset();
+}
+
+u32 VulkanUBOAllocator::usedBytes() const
+{
+    return _cursor.usedBytes();
+}
+
+VulkanUBOAllocator::Entry VulkanUBOAllocator::createEntry(u32 capacity)
+{
+    const auto vkDevice   = _device.vkDevice();
+    const auto bufferName = String("VulkanUBOAllocator");
+
+    auto entry     = Entry();
+    entry.capacity = capacity;
+
+    // Every offset up to the capacity must be able to address the entire descriptor range.
+    entry.buffer = VulkanBuffer(
+        vkDevice,
+        _device.vmaAllocator(),
+        capacity + _descriptorRange,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+        VK_SHARING_MODE_EXCLUSIVE,
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        nullptr,
+        bufferName.cstring());
+
+    _device.setVulkanObjectName(entry.buffer.vkBuffer(), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, bufferName);
+
+    {
+        auto allocInfo = VmaAllocationInfo();
+        vmaGetAllocationInfo(_device.vmaAllocator(), entry.buffer.allocation(), &allocInfo);
+        entry.data = static_cast<u8*>(allocInfo.pMappedData);
+    }
+
+    {
+        auto allocInfo               = VkDescriptorSetAllocateInfo();
+        allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool     = _vkDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts        = &_vkDescriptorSetLayout;
+
+        checkVkResult(
+            vkAllocateDescriptorSets(vkDevice, &allocInfo, &entry.vkDescriptorSet),
+            "Failed to create an UBO descriptor set.");
+    }
+
+    // The descriptor covers one parameter block. Its position is chosen by the dynamic offset.
+    {
+        auto bufferInfo   = VkDescriptorBufferInfo();
+        bufferInfo.buffer = entry.buffer.vkBuffer();
+        bufferInfo.offset = 0;
+        bufferInfo.range  = VkDeviceSize(_descriptorRange);
+
+        auto setWrite            = VkWriteDescriptorSet();
+        setWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        setWrite.dstBinding      = 0;
+        setWrite.dstSet          = entry.vkDescriptorSet;
+        setWrite.descriptorCount = 1;
+        setWrite.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        setWrite.pBufferInfo     = &bufferInfo;
+
+        vkUpdateDescriptorSets(vkDevice, 1, &setWrite, 0, nullptr);
+    }
+
+    return entry;
+}
+
+void VulkanUBOAllocator::destroyEntry(Entry& entry)
+{
+    if (entry.vkDescriptorSet != VK_NULL_HANDLE)
+    {
+        vkFreeDescriptorSets(_device.vkDevice(), _vkDescriptorPool, 1, &entry.vkDescriptorSet);
+        entry.vkDescriptorSet = VK_NULL_HANDLE;
+    }
+
+    entry.buffer = {};
 }
 } // namespace Polly
@@ -5,23 +5,29 @@
 #pragma once
 
 #include <Polly/CopyMoveMacros.hpp>
+#include <Polly/Graphics/UniformBufferCursor.hpp>
 #include <Polly/Graphics/Vulkan/VulkanBuffer.hpp>
 #include <Polly/List.hpp>
-#include <Polly/Maybe.hpp>
 
 namespace Polly
 {
 class VulkanPainter;
 
+// Allocates uniform buffer space for user shader parameters within a frame.
+//
+// Every frame owns one persistently mapped uniform buffer, which is described by a single
+// VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor set. Allocations only differ in their
+// dynamic offset, so the draw path never has to allocate or update descriptor sets.
+//
+// If a frame needs more space than the buffer holds, a larger buffer replaces it.
+// The previous buffer stays alive until the frame has finished on the GPU.
 class VulkanUBOAllocator final
 {
   public:
     struct Allocation
     {
-        u32             offsetToMapAt   = 0;
-        VulkanBuffer*   buffer          = nullptr;
         VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
-        u32             size            = 0;
+        u32             dynamicOffset   = 0;
     };
 
     explicit VulkanUBOAllocator(
@@ -31,23 +37,36 @@ class VulkanUBOAllocator final
 
     DeleteCopyAndMove(VulkanUBOAllocator);
 
-    Allocation allocate(u32 size);
+    ~VulkanUBOAllocator() noexcept;
 
+    // Copies the data into the buffer and returns where it's bound.
+    Allocation allocate(const void* data, u32 size);
+
+    // Must be called when the frame's fence has been waited for.
     void reset();
 
+    // The number of bytes that were allocated since the last reset, including alignment.
+    u32 usedBytes() const;
+
   private:
     struct Entry
     {
         VulkanBuffer    buffer;
-        VkDescriptorSet set;
+        VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+        u8*             data            = nullptr;
+        u32             capacity        = 0;
     };
 
+    Entry createEntry(u32 capacity);
+
+    void destroyEntry(Entry& entry);
+
     VulkanPainter&        _device;
     VkDescriptorPool      _vkDescriptorPool      = VK_NULL_HANDLE;
     VkDescriptorSetLayout _vkDescriptorSetLayout = VK_NULL_HANDLE;
-    List<Entry>           _entries;
-    Maybe<u32>            _currentBuffer;
-    u32                   _positionInBuffer = 0;
+    UniformBufferCursor   _cursor                = UniformBufferCursor(0, 0);
+    u32                   _descriptorRange       = 0;
+    Entry                 _current;
+    List<Entry, 2>        _retired;
 };
-
 } // namespace Polly
@@ -0,0 +1,489 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Graphics/Vulkan/VulkanUploadQueue.hpp"
+
+#include "Polly/Graphics/Vulkan/VulkanImage.hpp"
+#include "Polly/Graphics/Vulkan/VulkanPainter.hpp"
+#include "Polly/Logging.hpp"
+#include "Polly/Math.hpp"
+#include "Polly/Util.hpp"
+
+#include <cstring>
+
+namespace Polly
+{
+// Large enough for a few full-screen images per frame. Uploads that don't fit into the ring get a
+// dedicated staging buffer instead, which is released together with its batch.
+static constexpr auto stagingRingSize = 32u * 1024u * 1024u;
+
+// Buffer offsets of buffer-to-image copies must be multiples of the texel size.
+// This covers all image formats.
+static constexpr auto minStagingAlignment = 16u;
+
+VulkanUploadQueue::VulkanUploadQueue(
+    VulkanPainter& painter,
+    Maybe<u32>     transferQueueFamilyIndex,
+    VkQueue        vkTransferQueue)
+    : _painter(painter)
+    , _transferQueueFamilyIndex(transferQueueFamilyIndex)
+    , _vkTransferQueue(vkTransferQueue)
+{
+    assume(not _transferQueueFamilyIndex or _vkTransferQueue != VK_NULL_HANDLE);
+
+    const auto createCommandPool = [&](u32 queueFamilyIndex)
+    {
+        auto info             = VkCommandPoolCreateInfo();
+        info.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        info.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        info.queueFamilyIndex = queueFamilyIndex;
+
+        auto vkCommandPool = VkCommandPool();
+
+        checkVkResult(
+            vkCreateCommandPool(_painter.vkDevice(), &info, nullptr, &vkCommandPool),
+            "Failed to create an upload command pool.");
+
+        return vkCommandPool;
+    };
+
+    _vkGraphicsCommandPool = createCommandPool(_painter.graphicsQueueFamilyIndex());
+
+    if (_transferQueueFamilyIndex)
+    {
+        logVerbose("VulkanUploadQueue: Using transfer queue family {}", *_transferQueueFamilyIndex);
+
+        _vkTransferCommandPool    = createCommandPool(*_transferQueueFamilyIndex);
+        _sharedQueueFamilyIndices = {_painter.graphicsQueueFamilyIndex(), *_transferQueueFamilyIndex};
+    }
+
+    _ringAlignment = max(
+        minStagingAlignment,
+        u32(_painter.vkPhysicalDeviceProps().limits.optimalBufferCopyOffsetAlignment));
+
+    _ring = createStagingBuffer(stagingRingSize, "VulkanUploadQueue ring");
+
+    logVerbose("VulkanUploadQueue: Created staging ring of size {}", bytesDisplayString(stagingRingSize));
+}
+
+VulkanUploadQueue::~VulkanUploadQueue() noexcept
+{
+    // The painter waits for the device to be idle before destroying us.
+    if (_pendingBatch)
+    {
+        destroyBatch(*_pendingBatch);
+    }
+
+    for (auto& batch : _submittedBatches)
+    {
+        if (batch)
+        {
+            destroyBatch(*batch);
+        }
+    }
+
+    for (auto& batch : _freeBatches)
+    {
+        destroyBatch(*batch);
+    }
+
+    destroyStagingBuffer(_ring);
+
+    const auto vkDevice = _painter.vkDevice();
+
+    if (_vkTransferCommandPool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(vkDevice, _vkTransferCommandPool, nullptr);
+    }
+
+    vkDestroyCommandPool(vkDevice, _vkGraphicsCommandPool, nullptr);
+}
+
+Span<u32> VulkanUploadQueue::sharedQueueFamilyIndices() const
+{
+    return _transferQueueFamilyIndex ? Span<u32>(_sharedQueueFamilyIndices) : Span<u32>();
+}
+
+void VulkanUploadQueue::uploadImageData(
+    VulkanImage& image,
+    u32          x,
+    u32          y,
+    u32          width,
+    u32          height,
+    const void*  data)
+{
+    assume(image.usage() != ImageUsage::Canvas);
+    assume(data);
+
+    const auto sizeInBytes = imageSlicePitch(width, height, image.format());
+
+    auto&      batch   = pendingBatch();
+    const auto staging = allocateStagingMemory(batch, sizeInBytes);
+
+    std::memcpy(staging.buffer->data + staging.offset, data, sizeInBytes);
+
+    checkVkResult(
+        vmaFlushAllocation(
+            _painter.vmaAllocator(),
+            staging.buffer->vmaAllocation,
+            staging.offset,
+            sizeInBytes),
+        "Failed to flush a staging buffer.");
+
+    // An image that was never written to can't be sampled by any frame yet.
+    const auto isInitialUpload = image.currentLayout == VK_IMAGE_LAYOUT_UNDEFINED;
+    const auto onTransferQueue = isInitialUpload and _transferQueueFamilyIndex;
+    const auto vkCmdBuffer     = beginCommands(batch, onTransferQueue);
+
+    auto range       = VkImageSubresourceRange();
+    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.levelCount = 1;
+    range.layerCount = 1;
+
+    auto barrierToTransfer                = VkImageMemoryBarrier();
+    barrierToTransfer.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrierToTransfer.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrierToTransfer.oldLayout           = image.currentLayout;
+    barrierToTransfer.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrierToTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrierToTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrierToTransfer.image               = image.vkImage();
+    barrierToTransfer.subresourceRange    = range;
+
+    // Updates must not overwrite the image while earlier frames are still sampling it.
+    vkCmdPipelineBarrier(
+        vkCmdBuffer,
+        isInitialUpload ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &barrierToTransfer);
+
+    auto copyRegion                        = VkBufferImageCopy();
+    copyRegion.bufferOffset                = VkDeviceSize(staging.offset);
+    copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    copyRegion.imageSubresource.layerCount = 1;
+    copyRegion.imageOffset                 = VkOffset3D{.x = i32(x), .y = i32(y), .z = 0};
+    copyRegion.imageExtent                 = VkExtent3D{.width = width, .height = height, .depth = 1};
+
+    vkCmdCopyBufferToImage(
+        vkCmdBuffer,
+        staging.buffer->vkBuffer,
+        image.vkImage(),
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        1,
+        &copyRegion);
+
+    auto barrierToReadable          = barrierToTransfer;
+    barrierToReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrierToReadable.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrierToReadable.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    // A transfer queue can't wait for shader stages. Visibility to the frame is established by the
+    // semaphore that the frame waits for instead.
+    barrierToReadable.dstAccessMask = onTransferQueue ? VkAccessFlags(0) : VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(
+        vkCmdBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        onTransferQueue ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        1,
+        &barrierToReadable);
+
+    image.currentLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
+void VulkanUploadQueue::onFrameStarted(u32 frameIndex)
+{
+    auto& batch = _submittedBatches[frameIndex];
+
+    if (not batch)
+    {
+        return;
+    }
+
+    assume(_ringUsed >= batch->ringBytes);
+    _ringUsed -= batch->ringBytes;
+
+    // Start from the beginning when the ring is empty, so that later uploads are less likely to wrap.
+    if (_ringUsed == 0)
+    {
+        _ringHead = 0;
+    }
+
+    for (auto& buffer : batch->overflowBuffers)
+    {
+        destroyStagingBuffer(buffer);
+    }
+
+    batch->overflowBuffers.clear();
+
+    if (batch->hasGraphicsCommands)
+    {
+        vkResetCommandBuffer(batch->graphicsCmdBuffer, 0);
+    }
+
+    if (batch->hasTransferCommands)
+    {
+        vkResetCommandBuffer(batch->transferCmdBuffer, 0);
+    }
+
+    batch->hasGraphicsCommands = false;
+    batch->hasTransferCommands = false;
+    batch->ringBytes           = 0;
+
+    _freeBatches.add(std::move(batch));
+}
+
+VulkanUploadQueue::Submission VulkanUploadQueue::submit(u32 frameIndex)
+{
+    assume(not _submittedBatches[frameIndex]);
+
+    if (not _pendingBatch)
+    {
+        return {};
+    }
+
+    auto& batch  = *_pendingBatch;
+    auto  result = Submission();
+
+    if (batch.hasTransferCommands)
+    {
+        checkVkResult(
+            vkEndCommandBuffer(batch.transferCmdBuffer),
+            "Failed to record an upload command buffer.");
+
+        auto submitInfo                 = VkSubmitInfo();
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &batch.transferCmdBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &batch.transferFinishedSemaphore;
+
+        checkVkResult(
+            vkQueueSubmit(_vkTransferQueue, 1, &submitInfo, VK_NULL_HANDLE),
+            "Failed to submit upload commands.");
+
+        result.waitSemaphore = batch.transferFinishedSemaphore;
+    }
+
+    if (batch.hasGraphicsCommands)
+    {
+        checkVkResult(
+            vkEndCommandBuffer(batch.graphicsCmdBuffer),
+            "Failed to record an upload command buffer.");
+
+        result.vkCommandBuffer = batch.graphicsCmdBuffer;
+    }
+
+    _submittedBatches[frameIndex] = std::move(_pendingBatch);
+
+    return result;
+}
+
+VulkanUploadQueue::Batch& VulkanUploadQueue::pendingBatch()
+{
+    if (not _pendingBatch)
+    {
+        if (_freeBatches.isEmpty())
+        {
+            _pendingBatch = createBatch();
+        }
+        else
+        {
+            _pendingBatch = std::move(_freeBatches.last());
+            _freeBatches.removeLast();
+        }
+    }
+
+    return *_pendingBatch;
+}
+
+UniquePtr<VulkanUploadQueue::Batch> VulkanUploadQueue::createBatch()
+{
+    const auto vkDevice = _painter.vkDevice();
+    auto       batch    = makeUnique<Batch>();
+
+    const auto allocateCommandBuffer = [&](VkCommandPool vkCommandPool, StringView name)
+    {
+        auto info               = VkCommandBufferAllocateInfo();
+        info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        info.commandPool        = vkCommandPool;
+        info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        info.commandBufferCount = 1;
+
+        auto vkCmdBuffer = VkCommandBuffer();
+
+        checkVkResult(
+            vkAllocateCommandBuffers(vkDevice, &info, &vkCmdBuffer),
+            "Failed to create an upload command buffer.");
+
+        _painter.setVulkanObjectName(
+            vkCmdBuffer,
+            VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
+            String(name));
+
+        return vkCmdBuffer;
+    };
+
+    batch->graphicsCmdBuffer = allocateCommandBuffer(_vkGraphicsCommandPool, "UploadCmdBuf");
+
+    if (_transferQueueFamilyIndex)
+    {
+        batch->transferCmdBuffer = allocateCommandBuffer(_vkTransferCommandPool, "TransferCmdBuf");
+
+        auto semaphoreInfo  = VkSemaphoreCreateInfo();
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        checkVkResult(
+            vkCreateSemaphore(vkDevice, &semaphoreInfo, nullptr, &batch->transferFinishedSemaphore),
+            "Failed to create an upload semaphore.");
+    }
+
+    return batch;
+}
+
+void VulkanUploadQueue::destroyBatch(Batch& batch)
+{
+    // Command buffers are freed alongside their pools.
+    if (batch.transferFinishedSemaphore != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(_painter.vkDevice(), batch.transferFinishedSemaphore, nullptr);
+        batch.transferFinishedSemaphore = VK_NULL_HANDLE;
+    }
+
+    for (auto& buffer : batch.overflowBuffers)
+    {
+        destroyStagingBuffer(buffer);
+    }
+
+    batch.overflowBuffers.clear();
+}
+
+VkCommandBuffer VulkanUploadQueue::beginCommands(Batch& batch, bool onTransferQueue)
+{
+    const auto vkCmdBuffer = onTransferQueue ? batch.transferCmdBuffer : batch.graphicsCmdBuffer;
+    auto&      hasCommands = onTransferQueue ? batch.hasTransferCommands : batch.hasGraphicsCommands;
+
+    if (not hasCommands)
+    {
+        auto beginInfo  = VkCommandBufferBeginInfo();
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        checkVkResult(
+            vkBeginCommandBuffer(vkCmdBuffer, &beginInfo),
+            "Failed to begin an upload command buffer.");
+
+        hasCommands = true;
+    }
+
+    return vkCmdBuffer;
+}
+
+VulkanUploadQueue::StagingBuffer VulkanUploadQueue::createStagingBuffer(
+    u32                          size,
+    [[maybe_unused]] const char* debugName)
+{
+    const auto sharedFamilies = sharedQueueFamilyIndices();
+
+    auto bufferInfo  = VkBufferCreateInfo();
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size  = VkDeviceSize(size);
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    // Staging memory is read by both queues, if there's a dedicated transfer queue.
+    if (sharedFamilies.isEmpty())
+    {
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+    else
+    {
+        bufferInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = sharedFamilies.size();
+        bufferInfo.pQueueFamilyIndices   = sharedFamilies.data();
+    }
+
+    auto allocInfo  = VmaAllocationCreateInfo();
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags =
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    auto buffer          = StagingBuffer();
+    auto allocResultInfo = VmaAllocationInfo();
+
+    checkVkResult(
+        vmaCreateBuffer(
+            _painter.vmaAllocator(),
+            &bufferInfo,
+            &allocInfo,
+            &buffer.vkBuffer,
+            &buffer.vmaAllocation,
+            &allocResultInfo),
+        "Failed to create a staging buffer.");
+
+#ifndef NDEBUG
+    vmaSetAllocationName(_painter.vmaAllocator(), buffer.vmaAllocation, debugName);
+#endif
+
+    buffer.data = static_cast<u8*>(allocResultInfo.pMappedData);
+
+    return buffer;
+}
+
+void VulkanUploadQueue::destroyStagingBuffer(StagingBuffer& buffer)
+{
+    if (buffer.vkBuffer != VK_NULL_HANDLE)
+    {
+        vmaDestroyBuffer(_painter.vmaAllocator(), buffer.vkBuffer, buffer.vmaAllocation);
+        buffer = {};
+    }
+}
+
+VulkanUploadQueue::StagingAllocation VulkanUploadQueue::allocateStagingMemory(Batch& batch, u32 size)
+{
+    auto offset   = nextAlignedNumber(_ringHead, _ringAlignment);
+    auto consumed = (offset - _ringHead) + size;
+
+    if (offset + size > stagingRingSize)
+    {
+        // Wrap around. The bytes until the end of the ring are wasted until the batch is reclaimed.
+        offset   = 0;
+        consumed = (stagingRingSize - _ringHead) + size;
+    }
+
+    if (_ringUsed + consumed <= stagingRingSize)
+    {
+        _ringHead = offset + size;
+        _ringUsed += consumed;
+        batch.ringBytes += consumed;
+
+        return StagingAllocation{
+            .buffer = &_ring,
+            .offset = offset,
+        };
+    }
+
+    logVerbose(
+        "VulkanUploadQueue: Staging ring is full, creating a dedicated buffer of size {}",
+        bytesDisplayString(size));
+
+    const auto& buffer =
+        batch.overflowBuffers.emplace(createStagingBuffer(size, "VulkanUploadQueue overflow"));
+
+    return StagingAllocation{
+        .buffer = &buffer,
+        .offset = 0,
+    };
+}
+} // namespace Polly
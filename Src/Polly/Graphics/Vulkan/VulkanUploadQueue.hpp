@@ -0,0 +1,128 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#pragma once
+
+#include <Polly/Array.hpp>
+#include <Polly/CopyMoveMacros.hpp>
+#include <Polly/Graphics/Vulkan/VulkanPrerequisites.hpp>
+#include <Polly/List.hpp>
+#include <Polly/Maybe.hpp>
+#include <Polly/Span.hpp>
+#include <Polly/UniquePtr.hpp>
+
+namespace Polly
+{
+class VulkanPainter;
+class VulkanImage;
+
+// Uploads image data to the GPU without blocking the CPU.
+//
+// Data is copied into a persistently mapped staging ring buffer, and the copy commands are recorded
+// into an upload batch. The batch is submitted right before the command buffer of the current frame,
+// which waits for it on the GPU. A batch's ring space and command buffers are reclaimed as soon as
+// that frame's fence is signaled, so the ring never has to be waited on by the CPU.
+//
+// The initial data of an image is uploaded on a dedicated transfer queue, if the device has one.
+// Nothing can sample such an image yet, so its copies may overlap with earlier frames.
+// Updates of images that are already in use are recorded on the graphics queue instead, which orders
+// them after all earlier frames that sample the same image.
+//
+// Because a batch executes before the frame's command buffer, an update becomes visible to the
+// entire frame it was made in, including draws that were recorded before it.
+class VulkanUploadQueue final
+{
+  public:
+    struct Submission
+    {
+        // The semaphore that the frame's submission has to wait for, if any.
+        VkSemaphore waitSemaphore = VK_NULL_HANDLE;
+
+        // The command buffer that has to be submitted ahead of the frame's command buffer, if any.
+        VkCommandBuffer vkCommandBuffer = VK_NULL_HANDLE;
+    };
+
+    explicit VulkanUploadQueue(
+        VulkanPainter& painter,
+        Maybe<u32>     transferQueueFamilyIndex,
+        VkQueue        vkTransferQueue);
+
+    DeleteCopyAndMove(VulkanUploadQueue);
+
+    ~VulkanUploadQueue() noexcept;
+
+    // The queue families that images have to be shared between.
+    // Empty if there's no dedicated transfer queue, in which case images are used exclusively.
+    Span<u32> sharedQueueFamilyIndices() const;
+
+    // Copies the data into a region of the image.
+    // The data is copied into the staging ring immediately and may be released after the call.
+    void uploadImageData(VulkanImage& image, u32 x, u32 y, u32 width, u32 height, const void* data);
+
+    // Reclaims the batch that was submitted alongside the frame.
+    // Must be called after the frame's fence has been waited for.
+    void onFrameStarted(u32 frameIndex);
+
+    // Submits the pending batch, if there is one.
+    // Must be called right before the frame's command buffer is submitted.
+    Submission submit(u32 frameIndex);
+
+  private:
+    struct StagingBuffer
+    {
+        VkBuffer      vkBuffer      = VK_NULL_HANDLE;
+        VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+        u8*           data          = nullptr;
+    };
+
+    struct StagingAllocation
+    {
+        const StagingBuffer* buffer = nullptr;
+        u32                  offset = 0;
+    };
+
+    struct Batch
+    {
+        VkCommandBuffer     graphicsCmdBuffer         = VK_NULL_HANDLE;
+        VkCommandBuffer     transferCmdBuffer         = VK_NULL_HANDLE;
+        VkSemaphore         transferFinishedSemaphore = VK_NULL_HANDLE;
+        bool                hasGraphicsCommands       = false;
+        bool                hasTransferCommands       = false;
+        u32                 ringBytes                 = 0;
+        List<StagingBuffer> overflowBuffers;
+    };
+
+    Batch& pendingBatch();
+
+    UniquePtr<Batch> createBatch();
+
+    void destroyBatch(Batch& batch);
+
+    VkCommandBuffer beginCommands(Batch& batch, bool onTransferQueue);
+
+    StagingBuffer createStagingBuffer(u32 size, const char* debugName);
+
+    void destroyStagingBuffer(StagingBuffer& buffer);
+
+    StagingAllocation allocateStagingMemory(Batch& batch, u32 size);
+
+    VulkanPainter& _painter;
+    Maybe<u32>     _transferQueueFamilyIndex;
+    VkQueue        _vkTransferQueue          = VK_NULL_HANDLE;
+    Array<u32, 2>  _sharedQueueFamilyIndices = {};
+    VkCommandPool  _vkGraphicsCommandPool    = VK_NULL_HANDLE;
+    VkCommandPool  _vkTransferCommandPool    = VK_NULL_HANDLE;
+
+    // The staging ring. Batches are reclaimed in the order they were submitted, which means that the
+    // free space always starts at the head and spans (size - used) bytes, wrapping around.
+    StagingBuffer _ring;
+    u32           _ringHead      = 0;
+    u32           _ringUsed      = 0;
+    u32           _ringAlignment = 0;
+
+    UniquePtr<Batch>                              _pendingBatch;
+    Array<UniquePtr<Batch>, maxFramesInFlight>    _submittedBatches;
+    List<UniquePtr<Batch>, maxFramesInFlight + 1> _freeBatches;
+};
+} // namespace Polly
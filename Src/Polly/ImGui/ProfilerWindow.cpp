@@ -0,0 +1,147 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+#include "Polly/Core/ProfilerInternals.hpp"
+#include "Polly/Error.hpp"
+#include "Polly/Format.hpp"
+#include "Polly/ImGui/ImGuiImpl.hpp"
+#include "Polly/Logging.hpp"
+#include "Polly/Math.hpp"
+#include "Polly/Profiler.hpp"
+
+namespace Polly
+{
+#ifdef POLLY_ENABLE_PROFILER
+static constexpr auto zoneRowHeight = 20.0f;
+
+struct ProfilerWindowState
+{
+    bool                 isPaused = false;
+    ProfiledFrame        frame;
+    List<ProfiledThread> threads;
+};
+
+static ProfilerWindowState sProfilerWindowState;
+
+// Zones of the same name get the same color across frames.
+static ImU32 zoneColor(const char* name)
+{
+    auto hash = u32(2166136261u);
+
+    for (auto* ch = name; *ch != '\0'; ++ch)
+    {
+        hash = (hash ^ u32(*ch)) * 16777619u;
+    }
+
+    const auto hue = float(hash % 360u) / 360.0f;
+
+    return ImColor::HSV(hue, 0.5f, 0.7f);
+}
+
+static void drawThreadZones(const ProfiledThread& thread, const ProfiledFrame& frame)
+{
+    auto maxDepth = 0u;
+
+    for (const auto& event : thread.events)
+    {
+        maxDepth = max(maxDepth, event.depth);
+    }
+
+    const auto label = thread.name.isEmpty() ? formatString("Thread {}", thread.id) : thread.name;
+
+    ::ImGui::TextUnformatted(label.cstring());
+
+    const auto origin = ::ImGui::GetCursorScreenPos();
+    const auto size   = ImVec2(::ImGui::GetContentRegionAvail().x, float(maxDepth + 1) * zoneRowHeight);
+
+    ::ImGui::PushID(int(thread.id));
+    ::ImGui::InvisibleButton("zones", ImVec2(max(size.x, 1.0f), size.y));
+    ::ImGui::PopID();
+
+    auto*      drawList      = ::ImGui::GetWindowDrawList();
+    const auto frameDuration = double(frame.endTime - frame.startTime);
+    const auto toX           = [&](u64 time)
+    {
+        const auto clampedTime = clamp(time, frame.startTime, frame.endTime);
+        return origin.x + float(double(clampedTime - frame.startTime) / frameDuration) * size.x;
+    };
+
+    drawList->PushClipRect(origin, origin + size, true);
+
+    for (const auto& event : thread.events)
+    {
+        const auto zoneMin = ImVec2(toX(event.startTime), origin.y + float(event.depth) * zoneRowHeight);
+        const auto zoneMax = ImVec2(toX(event.endTime), zoneMin.y + zoneRowHeight - 1.0f);
+
+        drawList->AddRectFilled(zoneMin, zoneMax, zoneColor(event.name));
+
+        if (zoneMax.x - zoneMin.x > 4.0f)
+        {
+            drawList->PushClipRect(zoneMin, zoneMax, true);
+            drawList->AddText(zoneMin + ImVec2(2.0f, 2.0f), IM_COL32_WHITE, event.name);
+            drawList->PopClipRect();
+        }
+
+        if (::ImGui::IsItemHovered() and ::ImGui::IsMouseHoveringRect(zoneMin, zoneMax))
+        {
+            const auto milliseconds = double(event.endTime - event.startTime) / 1'000'000.0;
+            ::ImGui::SetTooltip("%s\n%.3f ms", event.name, milliseconds);
+        }
+    }
+
+    drawList->PopClipRect();
+}
+#endif
+
+void showProfilerWindow([[maybe_unused]] ImGui imgui)
+{
+    if (::ImGui::Begin("Profiler"))
+    {
+#ifdef POLLY_ENABLE_PROFILER
+        auto& state = sProfilerWindowState;
+
+        ::ImGui::Checkbox("Pause", &state.isPaused);
+        ::ImGui::SameLine();
+
+        if (::ImGui::Button("Save Chrome Trace"))
+        {
+            try
+            {
+                saveProfilerChromeTrace("PollyTrace.json");
+            }
+            catch (const Error& error)
+            {
+                logError("Failed to save the profiler trace: {}", error.message());
+            }
+        }
+
+        if (not state.isPaused)
+        {
+            if (const auto frame = lastProfiledFrame())
+            {
+                state.frame   = *frame;
+                state.threads = collectProfileEvents(frame->startTime, frame->endTime);
+            }
+        }
+
+        if (state.frame.endTime > state.frame.startTime)
+        {
+            const auto frameTime = double(state.frame.endTime - state.frame.startTime) / 1'000'000.0;
+
+            ::ImGui::Text("Frame: %.3f ms", frameTime);
+
+            for (const auto& thread : state.threads)
+            {
+                drawThreadZones(thread, state.frame);
+            }
+        }
+#else
+        ::ImGui::TextUnformatted(
+            "The profiler is disabled. Build Polly with POLLY_ENABLE_PROFILER to enable it.");
+#endif
+    }
+
+    ::ImGui::End();
+}
+} // namespace Polly
@@ -24,9 +24,13 @@ namespace Polly::ShaderCompiler
 {
 static constexpr auto fragmentShaderOutputVariableName = "outColor";
 
-GLSLShaderGenerator::GLSLShaderGenerator(bool shouldGenerateForVulkan)
+GLSLShaderGenerator::GLSLShaderGenerator(bool shouldGenerateForVulkan, u32 spriteImageCount)
     : _shouldGenerateForVulkan(shouldGenerateForVulkan)
+    , _spriteImageCount(spriteImageCount)
 {
+    assume(spriteImageCount > 0);
+    assume(spriteImageCount == 1 or !shouldGenerateForVulkan);
+
     _isSwappingMatrixVectorMults = true;
 
     _builtInTypeDict = {
@@ -45,6 +49,9 @@ GLSLShaderGenerator::GLSLShaderGenerator(bool shouldGenerateForVulkan)
     _v2fUV            = Naming::forbiddenIdentifierPrefix + "v2f_uv"_sv;
     _imageName        = Naming::forbiddenIdentifierPrefix + "image"_sv;
     _imageSamplerName = Naming::forbiddenIdentifierPrefix + "imageSampler"_sv;
+
+    _v2fImageSlot              = Naming::forbiddenIdentifierPrefix + "v2f_imageSlot"_sv;
+    _sampleSpriteImageFuncName = Naming::forbiddenIdentifierPrefix + "sampleSpriteImage"_sv;
 }
 
 String GLSLShaderGenerator::doGeneration(
@@ -102,6 +109,16 @@ String GLSLShaderGenerator::doGeneration(
                 << ";"
                 << wnewline;
         }
+        else if (isSamplingMultipleSpriteImages())
+        {
+            // Helper functions may sample the sprite image as well, so the slot input and
+            // the sampling function are declared up front instead of next to main().
+            w << "uniform sampler2D " << spriteImagesName << '[' << _spriteImageCount << "];" << wnewline;
+            w << "flat in float " << _v2fImageSlot << ';' << wnewline;
+            w << wnewline;
+            emitSpriteImageSamplingFunction(w);
+            w << wnewline;
+        }
         else
         {
             w << "uniform sampler2D " << _imageName << ';' << wnewline;
@@ -176,7 +193,7 @@ void GLSLShaderGenerator::generateFunctionDecl(
         // Sprite and Mesh shaders share the same inputs and names.
         if (_ast->shaderType() == ShaderType::Sprite || _ast->shaderType() == ShaderType::Mesh)
         {
-            // Keep this in sync with the output of SpriteBatchOpenGL.vert/SpriteBatchVulkan.vert!
+            // Keep this in sync with the output of the sprite vertex shaders (SpriteBatch*.vert)!
             w << "in vec4 " << _v2fColor << ';' << wnewline;
             w << "in vec2 " << _v2fUV << ';' << wnewline;
         }
@@ -284,6 +301,19 @@ void GLSLShaderGenerator::generateFunctionCallExpr(
         prepareExpr(w, arg.get(), context);
     }
 
+    if (isImageSamplingFunc and isSamplingMultipleSpriteImages())
+    {
+        if (const auto* image = as<SymAccessExpr>(args.first().get());
+            image and image->symbol() == builtins.svSpriteImage.get())
+        {
+            // sample(pl_spriteImage, uv) -> pl_sampleSpriteImage(uv)
+            w << _sampleSpriteImageFuncName << '(';
+            generateExpr(w, args[1].get(), context);
+            w << ')';
+            return;
+        }
+    }
+
     generateExpr(w, callee, context);
 
     w << '(';
@@ -385,6 +415,41 @@ void GLSLShaderGenerator::generateSymAccessExpr(
     }
 }
 
+void GLSLShaderGenerator::emitSpriteImageSamplingFunction(Writer& w) const
+{
+    // The image slot is constant across a sprite, but not necessarily across all pixels that
+    // are shaded together. Compute derivatives outside of the branches, so that mipmapping
+    // stays well-defined.
+    w << "vec4 " << _sampleSpriteImageFuncName << "(vec2 uv) ";
+    w.openBrace();
+
+    w << "vec2 dx = dFdx(uv);" << wnewline;
+    w << "vec2 dy = dFdy(uv);" << wnewline;
+    w << "int slot = int(" << _v2fImageSlot << ");" << wnewline;
+
+    for (auto i = 1u; i < _spriteImageCount; ++i)
+    {
+        w
+            << "if (slot == "
+            << i
+            << ") return textureGrad("
+            << spriteImagesName
+            << '['
+            << i
+            << "], uv, dx, dy);"
+            << wnewline;
+    }
+
+    w << "return textureGrad(" << spriteImagesName << "[0], uv, dx, dy);" << wnewline;
+
+    w.closeBrace();
+}
+
+bool GLSLShaderGenerator::isSamplingMultipleSpriteImages() const
+{
+    return _spriteImageCount > 1 and _ast->shaderType() == ShaderType::Sprite;
+}
+
 void GLSLShaderGenerator::emitUniformBufferForUserParams(
     Writer&                              w,
     [[maybe_unused]] const FunctionDecl* shader,
@@ -15,7 +15,13 @@ class GLSLShaderGenerator final : public TextBasedShaderGenerator
   public:
     static constexpr auto uboName = "UBO"_sv;
 
-    explicit GLSLShaderGenerator(bool shouldGenerateForVulkan);
+    // The name of the sampler array that sprite shaders use when they support more than one image.
+    static constexpr auto spriteImagesName = "pl_spriteImages"_sv;
+
+    // If spriteImageCount is greater than one, sprite shaders sample the image that is selected
+    // by the vertex shader's image slot output (see SpriteBatchOpenGL.vert).
+    // This is only supported for OpenGL.
+    explicit GLSLShaderGenerator(bool shouldGenerateForVulkan, u32 spriteImageCount = 1);
 
     String doGeneration(
         const SemaContext&  context,
@@ -39,7 +45,14 @@ class GLSLShaderGenerator final : public TextBasedShaderGenerator
     void emitUniformBufferForUserParams(Writer& w, const FunctionDecl* shader, const AccessedParams& params)
         const;
 
+    void emitSpriteImageSamplingFunction(Writer& w) const;
+
+    bool isSamplingMultipleSpriteImages() const;
+
     bool   _shouldGenerateForVulkan;
+    u32    _spriteImageCount;
+    String _v2fImageSlot;
+    String _sampleSpriteImageFuncName;
     String _v2fColor;
     String _v2fUV;
     String _imageName;
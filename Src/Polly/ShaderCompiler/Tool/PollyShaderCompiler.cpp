@@ -0,0 +1,72 @@
+// Copyright (C) 2025 Cem Dervis
+// This file is part of Polly.
+// For conditions of distribution and use, see copyright notice in LICENSE, or https://polly2d.org.
+
+// Compiles a shader asset at build time into a precompiled shader (see PrecompiledShader).
+// This is invoked by the BuildTool's compile command for every .shd asset of a game.
+//
+// Usage: PollyShaderCompiler <source file> <asset name> <destination file> <encryption key>
+
+#include "Polly/Defer.hpp"
+#include "Polly/Details/ContentManagement.hpp"
+#include "Polly/Error.hpp"
+#include "Polly/FileSystem.hpp"
+#include "Polly/Format.hpp"
+#include "Polly/Graphics/PrecompiledShader.hpp"
+#include "Polly/ShaderCompiler/Type.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+namespace Polly::Details
+{
+// Only defined so that the Polly library links; assets are never decrypted here.
+constexpr StringView assetDecryptionKey = "";
+} // namespace Polly::Details
+
+int main(int argc, char* argv[])
+{
+    using namespace Polly;
+
+    if (argc != 5)
+    {
+        std::fprintf(
+            stderr,
+            "Usage: PollyShaderCompiler <source file> <asset name> <destination file> <encryption key>\n");
+
+        return EXIT_FAILURE;
+    }
+
+    const auto srcFilename   = StringView(argv[1]);
+    const auto assetName     = StringView(argv[2]);
+    const auto dstFilename   = StringView(argv[3]);
+    const auto encryptionKey = StringView(argv[4]);
+
+    ShaderCompiler::Type::createPrimitiveTypes();
+
+    defer
+    {
+        ShaderCompiler::Type::destroyPrimitiveTypes();
+    };
+
+    try
+    {
+        const auto sourceCode = FileSystem::loadTextFileFromDisk(srcFilename);
+
+        if (not sourceCode)
+        {
+            throw Error(formatString("Failed to open shader file '{}'.", srcFilename));
+        }
+
+        const auto shader = PrecompiledShader::compile(*sourceCode, assetName);
+        const auto data   = shader.serialize(encryptionKey);
+
+        FileSystem::writeBinaryFileToDisk(dstFilename, data);
+    }
+    catch (const Error& error)
+    {
+        std::fprintf(stderr, "%s\n", String(error.message()).cstring());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
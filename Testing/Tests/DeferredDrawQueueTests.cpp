@@ -0,0 +1,123 @@
+#include "Polly/Graphics/DeferredDrawQueue.hpp"
+#include <snitch/snitch.hpp>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+// Sprites are told apart by their x-coordinate.
+static Sprite spriteWithId(int id)
+{
+    auto sprite    = Sprite();
+    sprite.dstRect = Rectangle(float(id), 0, 1, 1);
+
+    return sprite;
+}
+
+static List<int> visitedIds(DeferredDrawQueue& queue)
+{
+    auto ids = List<int>();
+    queue.sortAndVisit([&ids](const DeferredDrawQueue::Command& command)
+                       { ids.add(int(command.sprite.dstRect.x)); });
+
+    return ids;
+}
+
+static bool recordSprite(
+    DeferredDrawQueue& queue,
+    int                id,
+    u8                 layer,
+    const BlendState&  blendState     = alphaBlend,
+    const Sampler&     sampler        = linearClamp,
+    const Matrix&      transformation = Matrix())
+{
+    return queue.record(spriteWithId(id), layer, Shader(), blendState, sampler, transformation);
+}
+
+TEST_CASE("DeferredDrawQueue sort key order", "[graphics]")
+{
+    auto queue = DeferredDrawQueue();
+    REQUIRE(queue.isEmpty());
+
+    // The layer is the most significant part of the key.
+    REQUIRE(recordSprite(queue, 0, 2));
+    REQUIRE(recordSprite(queue, 1, 0));
+    REQUIRE(recordSprite(queue, 2, 1));
+    REQUIRE(not queue.isEmpty());
+
+    REQUIRE(visitedIds(queue) == List{1, 2, 0});
+
+    queue.clear();
+    REQUIRE(queue.isEmpty());
+
+    // Within a layer, sprites are grouped by state, in the order the states were first recorded.
+    REQUIRE(recordSprite(queue, 0, 0, alphaBlend));
+    REQUIRE(recordSprite(queue, 1, 0, additive));
+    REQUIRE(recordSprite(queue, 2, 0, alphaBlend));
+    REQUIRE(recordSprite(queue, 3, 0, additive, pointClamp));
+    REQUIRE(recordSprite(queue, 4, 0, alphaBlend, linearClamp, Matrix(2.0f)));
+    REQUIRE(recordSprite(queue, 5, 0, additive));
+
+    REQUIRE(visitedIds(queue) == List{0, 2, 4, 1, 5, 3});
+}
+
+TEST_CASE("DeferredDrawQueue commands", "[graphics]")
+{
+    auto queue = DeferredDrawQueue();
+
+    REQUIRE(recordSprite(queue, 0, 0, additive, pointClamp, Matrix(2.0f)));
+
+    auto visitCount = 0;
+
+    queue.sortAndVisit(
+        [&](const DeferredDrawQueue::Command& command)
+        {
+            REQUIRE(queue.blendState(command.blendState) == additive);
+            REQUIRE(queue.sampler(command.sampler) == pointClamp);
+            REQUIRE(queue.transformation(command.transformation) == Matrix(2.0f));
+            ++visitCount;
+        });
+
+    REQUIRE(visitCount == 1);
+    REQUIRE(queue.shaders().size() == 1u);
+}
+
+TEST_CASE("DeferredDrawQueue stability", "[graphics]")
+{
+    constexpr auto count = 1000;
+
+    auto queue = DeferredDrawQueue();
+
+    // Interleave two layers. Sprites of the same key must keep the order they were recorded in,
+    // regardless of how many of them there are.
+    for (auto i = 0; i < count; ++i)
+    {
+        REQUIRE(recordSprite(queue, i, u8(i % 2 == 0 ? 1 : 0)));
+    }
+
+    const auto ids = visitedIds(queue);
+    REQUIRE(ids.size() == u32(count));
+
+    for (auto i = 0; i < count / 2; ++i)
+    {
+        REQUIRE(ids[u32(i)] == (i * 2) + 1);
+        REQUIRE(ids[u32((count / 2) + i)] == i * 2);
+    }
+}
+
+TEST_CASE("DeferredDrawQueue state limit", "[graphics]")
+{
+    auto queue = DeferredDrawQueue();
+
+    // Up to 256 distinct transformations can be recorded.
+    for (auto i = 0; i < 256; ++i)
+    {
+        REQUIRE(recordSprite(queue, i, 0, alphaBlend, linearClamp, Matrix(float(i + 1))));
+    }
+
+    REQUIRE(not recordSprite(queue, 256, 0, alphaBlend, linearClamp, Matrix(1000.0f)));
+
+    // Known states can still be recorded.
+    REQUIRE(recordSprite(queue, 257, 0, alphaBlend, linearClamp, Matrix(1.0f)));
+
+    queue.clear();
+    REQUIRE(recordSprite(queue, 0, 0, alphaBlend, linearClamp, Matrix(1000.0f)));
+}
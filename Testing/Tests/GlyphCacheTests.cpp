@@ -0,0 +1,163 @@
+#include "Polly/Graphics/GlyphCache.hpp"
+#include <snitch/snitch.hpp>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+static GlyphCacheKey keyOf(u32 i)
+{
+    // Spread the glyphs across several sizes, like a font that is drawn at different sizes.
+    return GlyphCacheKey{
+        .codepoint = char32_t(32 + (i / 4)),
+        .fontSize  = 10.0f + float(i % 4),
+    };
+}
+
+static CachedGlyph glyphOf(u32 i, u32 pageIndex)
+{
+    return CachedGlyph{
+        .uvRect             = Rectangle(float(i), 0, 1, 1),
+        .pageIndex          = pageIndex,
+        .distanceFieldInset = {},
+        .lastUsedFrame      = i,
+    };
+}
+
+TEST_CASE("GlyphCache basics", "[graphics]")
+{
+    auto cache = GlyphCache();
+    REQUIRE(cache.size() == 0u);
+    REQUIRE(not cache.find(keyOf(0)));
+
+    cache.add(keyOf(0), glyphOf(0, 0));
+    REQUIRE(cache.size() == 1u);
+
+    auto glyph = cache.find(keyOf(0));
+    REQUIRE(glyph);
+    REQUIRE(glyph->lastUsedFrame == 0u);
+
+    // The same codepoint at a different size is a different glyph.
+    REQUIRE(not cache.find(GlyphCacheKey{.codepoint = keyOf(0).codepoint, .fontSize = 20.0f}));
+
+    // Found glyphs can be modified in place.
+    glyph->lastUsedFrame = 42;
+    REQUIRE(cache.find(keyOf(0))->lastUsedFrame == 42u);
+}
+
+TEST_CASE("GlyphCache growth", "[graphics]")
+{
+    constexpr auto count = 2000u;
+
+    auto cache = GlyphCache();
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        cache.add(keyOf(i), glyphOf(i, 0));
+    }
+
+    REQUIRE(cache.size() == count);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        auto glyph = cache.find(keyOf(i));
+        REQUIRE(glyph);
+        REQUIRE(glyph->lastUsedFrame == u64(i));
+    }
+
+    REQUIRE(not cache.find(keyOf(count)));
+}
+
+TEST_CASE("GlyphCache backward-shift deletion", "[graphics]")
+{
+    // Close to the maximum load factor of the initial capacity, so that probe sequences overlap.
+    constexpr auto count = 380u;
+
+    auto cache = GlyphCache();
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        cache.add(keyOf(i), glyphOf(i, 0));
+    }
+
+    // Remove every third glyph. Glyphs behind them in their probe sequence are shifted back.
+    const auto removedCount = cache.removeWhere(
+        [](const GlyphCacheKey&, const CachedGlyph& glyph) { return glyph.lastUsedFrame % 3 == 0; });
+
+    REQUIRE(removedCount == (count + 2) / 3);
+    REQUIRE(cache.size() == count - removedCount);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        auto glyph = cache.find(keyOf(i));
+
+        if (i % 3 == 0)
+        {
+            REQUIRE(not glyph);
+        }
+        else
+        {
+            REQUIRE(glyph);
+            REQUIRE(glyph->lastUsedFrame == u64(i));
+        }
+    }
+
+    // Removed glyphs can be added again.
+    for (auto i = 0u; i < count; i += 3)
+    {
+        cache.add(keyOf(i), glyphOf(i, 1));
+    }
+
+    REQUIRE(cache.size() == count);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        auto glyph = cache.find(keyOf(i));
+        REQUIRE(glyph);
+        REQUIRE(glyph->pageIndex == (i % 3 == 0 ? 1u : 0u));
+    }
+}
+
+TEST_CASE("GlyphCache lookup after page recycle", "[graphics]")
+{
+    constexpr auto count     = 300u;
+    constexpr auto pageCount = 3u;
+
+    auto cache = GlyphCache();
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        cache.add(keyOf(i), glyphOf(i, i % pageCount));
+    }
+
+    // This is what a font does when it recycles one of its atlas pages.
+    constexpr auto recycledPage = 1u;
+    const auto     isInPage     = [](const GlyphCacheKey&, const CachedGlyph& glyph)
+    {
+        return glyph.pageIndex == recycledPage;
+    };
+
+    const auto removedCount = cache.removeWhere(isInPage);
+
+    REQUIRE(removedCount == count / pageCount);
+    REQUIRE(cache.size() == count - removedCount);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        auto glyph = cache.find(keyOf(i));
+
+        if (i % pageCount == recycledPage)
+        {
+            REQUIRE(not glyph);
+        }
+        else
+        {
+            REQUIRE(glyph);
+            REQUIRE(glyph->pageIndex == i % pageCount);
+            REQUIRE(glyph->uvRect.x == float(i));
+        }
+    }
+
+    // Recycling a page that has no glyphs anymore doesn't change anything.
+    REQUIRE(cache.removeWhere(isInPage) == 0u);
+
+    REQUIRE(cache.size() == count - removedCount);
+}
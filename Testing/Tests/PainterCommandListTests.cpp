@@ -0,0 +1,136 @@
+#include "Polly/Array.hpp"
+#include "Polly/Graphics/PainterCommandListImpl.hpp"
+#include <snitch/snitch.hpp>
+#include <thread>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+using RecordedSprite = Painter::CommandList::Impl::RecordedSprite;
+using Command        = Painter::CommandList::Impl::Command;
+using CommandType    = Painter::CommandList::Impl::CommandType;
+
+// Commands are told apart by their x-coordinate. Runs of sprites alternate with shapes,
+// so that each list contains both merged sprite commands and individual ones.
+static void recordCommands(Painter::CommandList& list, u32 firstId, u32 count)
+{
+    for (auto id = firstId; id < firstId + count; ++id)
+    {
+        const auto x = float(id);
+
+        switch (id % 5)
+        {
+            case 0:
+            case 1:
+            case 2:
+                // Sprites are recorded without an image, because creating one requires a painter.
+                // The lists never dereference the images they store.
+                list.impl()->addSprite(RecordedSprite{.dstRect = Rectangle(x, 0, 1, 1)});
+                break;
+            case 3: list.drawLine(Vec2(x, 0), Vec2(x, 1), white, 1.0f); break;
+            default: {
+                const auto vertices = Array{Vec2(x, 0), Vec2(x + 1, 0), Vec2(x, 1)};
+                list.fillPolygon(vertices, white);
+                break;
+            }
+        }
+    }
+}
+
+// Does what Painter::submitCommandList() does, but collects the IDs instead of drawing.
+static void submit(const Painter::CommandList& list, List<u32>& ids, u32& spriteRangeCount)
+{
+    const auto& listImpl = *list.impl();
+
+    listImpl.replay(
+        [&](Span<RecordedSprite> sprites)
+        {
+            ++spriteRangeCount;
+
+            for (const auto& sprite : sprites)
+            {
+                ids.add(u32(sprite.dstRect.x));
+            }
+        },
+        [&](const Command& command)
+        {
+            switch (command.type)
+            {
+                case CommandType::Line: ids.add(u32(command.position.x)); break;
+                case CommandType::FillPolygon:
+                    ids.add(u32(listImpl.polygonVertices(command.offset, command.count)[0].x));
+                    break;
+                default: REQUIRE(false);
+            }
+        });
+}
+
+TEST_CASE("Painter::CommandList recording on multiple threads", "[graphics]")
+{
+    constexpr auto threadCount       = 8u;
+    constexpr auto commandsPerThread = 5000u;
+
+    auto lists = List<Painter::CommandList>();
+
+    for (auto i = 0u; i < threadCount; ++i)
+    {
+        lists.add(Painter::CommandList());
+    }
+
+    {
+        auto threads = List<std::thread>();
+
+        for (auto i = 0u; i < threadCount; ++i)
+        {
+            threads.add(std::thread(
+                [&list = lists[i], firstId = i * commandsPerThread]
+                { recordCommands(list, firstId, commandsPerThread); }));
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Submitting the lists one after another draws their commands in the order they were
+    // recorded, list by list.
+    auto ids              = List<u32>();
+    auto spriteRangeCount = 0u;
+
+    for (const auto& list : lists)
+    {
+        submit(list, ids, spriteRangeCount);
+    }
+
+    REQUIRE(ids.size() == threadCount * commandsPerThread);
+
+    for (auto i = 0u; i < ids.size(); ++i)
+    {
+        REQUIRE(ids[i] == i);
+    }
+
+    // Every run of three consecutive sprites is submitted as a single range.
+    REQUIRE(spriteRangeCount == threadCount * commandsPerThread / 5);
+}
+
+TEST_CASE("Painter::CommandList clear", "[graphics]")
+{
+    auto list = Painter::CommandList();
+    REQUIRE(list.isEmpty());
+
+    recordCommands(list, 0, 10);
+    REQUIRE(not list.isEmpty());
+
+    list.clear();
+    REQUIRE(list.isEmpty());
+
+    // A cleared list can be recorded into again, and only submits the new commands.
+    recordCommands(list, 100, 5);
+
+    auto ids              = List<u32>();
+    auto spriteRangeCount = 0u;
+    submit(list, ids, spriteRangeCount);
+
+    REQUIRE(ids == List<u32>{100, 101, 102, 103, 104});
+    REQUIRE(spriteRangeCount == 1u);
+}
@@ -0,0 +1,154 @@
+#include "Polly/BinaryReader.hpp"
+#include "Polly/Error.hpp"
+#include "Polly/Graphics/PrecompiledShader.hpp"
+#include <snitch/snitch.hpp>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+static PrecompiledShader exampleShader()
+{
+    auto shader                   = PrecompiledShader();
+    shader.type                   = ShaderType::Polygon;
+    shader.reflection.flags       = UserShaderFlags::UsesSystemValues;
+    shader.reflection.cbufferSize = 112;
+
+    shader.reflection.parameters.add(
+        ShaderParameter{
+            .name         = "intensity",
+            .type         = ShaderParameterType::Float,
+            .offset       = 0,
+            .sizeInBytes  = 4,
+            .arraySize    = none,
+            .defaultValue = 0.5f,
+        });
+
+    shader.reflection.parameters.add(
+        ShaderParameter{
+            .name         = "tint",
+            .type         = ShaderParameterType::Vec4,
+            .offset       = 16,
+            .sizeInBytes  = 16,
+            .arraySize    = none,
+            .defaultValue = Vec4(1, 2, 3, 4),
+        });
+
+    shader.reflection.parameters.add(
+        ShaderParameter{
+            .name         = "mode",
+            .type         = ShaderParameterType::Int,
+            .offset       = 32,
+            .sizeInBytes  = 4,
+            .arraySize    = none,
+            .defaultValue = -3,
+        });
+
+    shader.reflection.parameters.add(
+        ShaderParameter{
+            .name         = "offsets",
+            .type         = ShaderParameterType::Vec2Array,
+            .offset       = 48,
+            .sizeInBytes  = 64,
+            .arraySize    = 4,
+            .defaultValue = Any(),
+        });
+
+    shader.reflection.parameters.add(
+        ShaderParameter{
+            .name         = "enabled",
+            .type         = ShaderParameterType::Bool,
+            .offset       = 1,
+            .sizeInBytes  = none,
+            .arraySize    = none,
+            .defaultValue = true,
+        });
+
+    shader.sourceCode = "// Sprite shader\nVec4 main() { return tint; }";
+    shader.glslCode   = "void main() {}";
+    shader.hlslCode   = "";
+    shader.metalCode  = "fragment float4 ps_main() { return 0; }";
+
+    return shader;
+}
+
+static PrecompiledShader roundTrip(const PrecompiledShader& shader, StringView key)
+{
+    const auto data   = shader.serialize(key);
+    auto       reader = BinaryReader(data, key);
+
+    return PrecompiledShader::deserialize(reader);
+}
+
+// ShaderParameter's equality operator only compares names.
+static void requireEqualParameters(const ShaderParameter& lhs, const ShaderParameter& rhs)
+{
+    REQUIRE(lhs.name == rhs.name);
+    REQUIRE(lhs.type == rhs.type);
+    REQUIRE(lhs.offset == rhs.offset);
+    REQUIRE(lhs.sizeInBytes == rhs.sizeInBytes);
+    REQUIRE(lhs.arraySize == rhs.arraySize);
+    REQUIRE(lhs.defaultValue.type() == rhs.defaultValue.type());
+
+    switch (lhs.defaultValue.type())
+    {
+        case AnyType::Int: REQUIRE(lhs.defaultValue.get<int>() == rhs.defaultValue.get<int>()); break;
+        case AnyType::Float: REQUIRE(lhs.defaultValue.get<float>() == rhs.defaultValue.get<float>()); break;
+        case AnyType::Bool: REQUIRE(lhs.defaultValue.get<bool>() == rhs.defaultValue.get<bool>()); break;
+        case AnyType::Vec4: REQUIRE(lhs.defaultValue.get<Vec4>() == rhs.defaultValue.get<Vec4>()); break;
+        default: break;
+    }
+}
+
+static void requireEqualShaders(const PrecompiledShader& lhs, const PrecompiledShader& rhs)
+{
+    REQUIRE(lhs.type == rhs.type);
+    REQUIRE(lhs.reflection.flags == rhs.reflection.flags);
+    REQUIRE(lhs.reflection.cbufferSize == rhs.reflection.cbufferSize);
+    REQUIRE(lhs.reflection.parameters.size() == rhs.reflection.parameters.size());
+
+    for (auto i = 0u; i < lhs.reflection.parameters.size(); ++i)
+    {
+        requireEqualParameters(lhs.reflection.parameters[i], rhs.reflection.parameters[i]);
+    }
+
+    REQUIRE(lhs.sourceCode == rhs.sourceCode);
+    REQUIRE(lhs.glslCode == rhs.glslCode);
+    REQUIRE(lhs.hlslCode == rhs.hlslCode);
+    REQUIRE(lhs.metalCode == rhs.metalCode);
+}
+
+TEST_CASE("PrecompiledShader round trip", "[graphics]")
+{
+    const auto shader = exampleShader();
+
+    requireEqualShaders(roundTrip(shader, ""), shader);
+}
+
+TEST_CASE("PrecompiledShader round trip with encryption", "[graphics]")
+{
+    const auto shader = exampleShader();
+    const auto key    = StringView("sEcReT-kEy");
+
+    requireEqualShaders(roundTrip(shader, key), shader);
+
+    // Strings must not be stored as plain text.
+    const auto data = shader.serialize(key);
+    const auto text = StringView(reinterpret_cast<const char*>(data.data()), data.size());
+    REQUIRE(not text.contains(shader.metalCode));
+    REQUIRE(not text.contains("intensity"));
+}
+
+TEST_CASE("PrecompiledShader empty shader", "[graphics]")
+{
+    const auto shader = PrecompiledShader();
+
+    requireEqualShaders(roundTrip(shader, "key"), shader);
+}
+
+TEST_CASE("PrecompiledShader unsupported format", "[graphics]")
+{
+    auto data = exampleShader().serialize("");
+    data[0]   = 0xFF;
+
+    auto reader = BinaryReader(data, "");
+    REQUIRE_THROWS_AS(PrecompiledShader::deserialize(reader), Error);
+}
@@ -0,0 +1,154 @@
+#include "Polly/Format.hpp"
+#include "Polly/Graphics/ShapedTextCache.hpp"
+#include <snitch/snitch.hpp>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+static ShapedTextKey keyOf(StringView text, u64 fontId = 1, float fontSize = 16.0f)
+{
+    return ShapedTextKey{
+        .text       = text,
+        .fontId     = fontId,
+        .fontSize   = fontSize,
+        .decoration = none,
+    };
+}
+
+// Stores a marker instead of actually shaping the text.
+static void shapeInto(ShapedTextCache& cache, const ShapedTextKey& key, u64 generation, float marker)
+{
+    cache.prepare(key, generation).distanceFieldScale = marker;
+}
+
+TEST_CASE("ShapedTextCache hit and miss", "[graphics]")
+{
+    auto cache = ShapedTextCache();
+
+    REQUIRE(not cache.find(keyOf("Hello"), 0));
+
+    shapeInto(cache, keyOf("Hello"), 0, 1.0f);
+
+    auto hit = cache.find(keyOf("Hello"), 0);
+    REQUIRE(hit);
+    REQUIRE(hit->distanceFieldScale == 1.0f);
+
+    REQUIRE(not cache.find(keyOf("Hello", 2), 0));
+    REQUIRE(not cache.find(keyOf("Hello", 1, 17.0f), 0));
+    REQUIRE(not cache.find(keyOf("Hello!"), 0));
+
+    auto underlined       = keyOf("Hello");
+    underlined.decoration = Underline();
+    REQUIRE(not cache.find(underlined, 0));
+
+    REQUIRE(cache.size() == 1u);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0u);
+    REQUIRE(not cache.find(keyOf("Hello"), 0));
+}
+
+TEST_CASE("ShapedTextCache generation rollover", "[graphics]")
+{
+    constexpr auto frames = u64(ShapedTextCache::framesPerGeneration);
+
+    auto cache = ShapedTextCache();
+
+    shapeInto(cache, keyOf("Used"), 0, 1.0f);
+    shapeInto(cache, keyOf("Unused"), 0, 2.0f);
+
+    // Within the same generation, nothing is evicted.
+    cache.onFrameStarted(frames - 1);
+    REQUIRE(cache.size() == 2u);
+
+    // Both strings move into the previous generation.
+    cache.onFrameStarted(frames);
+    REQUIRE(cache.size() == 2u);
+
+    // A hit moves the string back into the current generation.
+    REQUIRE(cache.find(keyOf("Used"), 0));
+
+    // The previous generation is dropped, together with the string that wasn't drawn.
+    cache.onFrameStarted(frames * 2);
+    REQUIRE(cache.size() == 1u);
+    REQUIRE(not cache.find(keyOf("Unused"), 0));
+
+    auto hit = cache.find(keyOf("Used"), 0);
+    REQUIRE(hit);
+    REQUIRE(hit->distanceFieldScale == 1.0f);
+}
+
+TEST_CASE("ShapedTextCache compares full keys", "[graphics]")
+{
+    // Every key has the same hash.
+    auto cache = ShapedTextCache([](const ShapedTextKey&) { return u64(1); });
+
+    shapeInto(cache, keyOf("First"), 0, 1.0f);
+
+    REQUIRE(cache.find(keyOf("First"), 0));
+    REQUIRE(not cache.find(keyOf("Second"), 0));
+
+    // The most recent string takes the place of the colliding one.
+    shapeInto(cache, keyOf("Second"), 0, 2.0f);
+    REQUIRE(cache.size() == 1u);
+    REQUIRE(not cache.find(keyOf("First"), 0));
+
+    auto hit = cache.find(keyOf("Second"), 0);
+    REQUIRE(hit);
+    REQUIRE(hit->distanceFieldScale == 2.0f);
+}
+
+TEST_CASE("ShapedTextCache shaping generation", "[graphics]")
+{
+    auto cache = ShapedTextCache();
+
+    auto& shapedText = cache.prepare(keyOf("Text"), 1);
+    REQUIRE(cache.find(keyOf("Text"), 1));
+
+    // The font's glyphs have changed since the string was shaped.
+    REQUIRE(not cache.find(keyOf("Text"), 2));
+
+    // The string is shaped again into its existing entry.
+    REQUIRE(&cache.prepare(keyOf("Text"), 2) == &shapedText);
+    REQUIRE(cache.size() == 1u);
+    REQUIRE(cache.find(keyOf("Text"), 2));
+    REQUIRE(not cache.find(keyOf("Text"), 1));
+}
+
+TEST_CASE("ShapedTextCache capacity", "[graphics]")
+{
+    constexpr auto maxEntries = ShapedTextCache::maxEntriesPerGeneration;
+
+    auto cache = ShapedTextCache();
+    auto texts = List<String>();
+
+    for (auto i = 0u; i < maxEntries * 2; ++i)
+    {
+        texts.add(formatString("Text {}", i));
+    }
+
+    for (auto i = 0u; i < maxEntries; ++i)
+    {
+        shapeInto(cache, keyOf(texts[i]), 0, float(i));
+    }
+
+    // A full generation doesn't take any more strings.
+    auto& uncached = cache.prepare(keyOf(texts[maxEntries]), 0);
+    REQUIRE(cache.size() == maxEntries);
+    REQUIRE(not cache.find(keyOf(texts[maxEntries]), 0));
+    REQUIRE(&cache.prepare(keyOf(texts[maxEntries + 1]), 0) == &uncached);
+
+    // Move the strings into the previous generation and fill the current one with others.
+    cache.onFrameStarted(ShapedTextCache::framesPerGeneration);
+
+    for (auto i = maxEntries; i < maxEntries * 2; ++i)
+    {
+        shapeInto(cache, keyOf(texts[i]), 0, float(i));
+    }
+
+    REQUIRE(cache.size() == maxEntries * 2);
+
+    // Strings of the previous generation aren't promoted into a full generation.
+    REQUIRE(not cache.find(keyOf(texts[0]), 0));
+    REQUIRE(&cache.prepare(keyOf(texts[0]), 0) == &uncached);
+    REQUIRE(cache.size() == maxEntries * 2);
+}
@@ -0,0 +1,228 @@
+#if polly_have_gfx_software
+
+#include "Polly/Core/WorkerPool.hpp"
+#include "Polly/Error.hpp"
+#include "Polly/Graphics/Software/SoftwareRasterizer.hpp"
+#include "Polly/Graphics/Software/SoftwareSurface.hpp"
+#include "Polly/Random.hpp"
+#include <snitch/snitch.hpp>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+static constexpr auto sceneWidth  = 16u;
+static constexpr auto sceneHeight = 12u;
+
+// The expected result of drawScene(), one character per pixel:
+//   .    clear color (black)
+//   R G  the sprite's red and green texels
+//   B    the blue polygon
+//   y    the half-transparent yellow mesh over black
+//   r b  the mesh over red and blue
+//
+// The mesh is clipped by the scissor rect, so it doesn't reach the last row.
+static constexpr auto referenceImage = Array<StringView, sceneHeight>{
+    "................",
+    ".RRRRGGGG.BBBBB.",
+    ".RRRRGGGG.BBBB..",
+    ".RRRRGGGG.BBB...",
+    ".RRRRGGGG.BB....",
+    ".GGGGRrrryby....",
+    ".GGGGRrrryyy....",
+    ".GGGGRrrryyy....",
+    ".GGGGRrrryyy....",
+    "......yyyyyy....",
+    "......yyyyyy....",
+    "................",
+};
+
+static Array<u8, 4> referenceColor(char c)
+{
+    switch (c)
+    {
+        case 'R': return {255, 0, 0, 255};
+        case 'G': return {0, 255, 0, 255};
+        case 'B': return {0, 0, 255, 255};
+        case 'y': return {128, 128, 0, 255};
+        case 'r': return {255, 128, 0, 255};
+        case 'b': return {128, 128, 128, 255};
+        default: return {0, 0, 0, 255};
+    }
+}
+
+// A quad as the painter submits sprites and meshes: four vertices, two triangles.
+static Array<SoftwareVertex, 4> quad(Rectangle rect, Color color)
+{
+    return {
+        SoftwareVertex{.position = rect.topLeft(), .uv = Vec2(0, 0), .color = color},
+        SoftwareVertex{.position = rect.topRight(), .uv = Vec2(1, 0), .color = color},
+        SoftwareVertex{.position = rect.bottomLeft(), .uv = Vec2(0, 1), .color = color},
+        SoftwareVertex{.position = rect.bottomRight(), .uv = Vec2(1, 1), .color = color},
+    };
+}
+
+static constexpr auto quadIndices = Array<u32, 6>{0, 1, 2, 1, 3, 2};
+
+static void drawScene(SoftwareRasterizer& rasterizer, SoftwareSurface& target)
+{
+    // A 2x2 checkerboard, stretched over 8x8 pixels.
+    constexpr auto checkerboardPixels = Array<u8, 16>{
+        255, 0, 0, 255, 0, 255, 0, 255, // Top row: red, green
+        0, 255, 0, 255, 255, 0, 0, 255, // Bottom row: green, red
+    };
+
+    const auto checkerboard = SoftwareSurface(2, 2, ImageFormat::R8G8B8A8UNorm, checkerboardPixels.data());
+
+    target.clear(black);
+
+    // Sprite
+    rasterizer.drawTriangles(
+        SoftwareDrawState{
+            .target      = &target,
+            .image       = &checkerboard,
+            .sampler     = pointClamp,
+            .blendState  = alphaBlend,
+            .scissorRect = none,
+        },
+        quad(Rectangle(1, 1, 8, 8), white),
+        quadIndices);
+
+    // Polygon: the diagonal edge doesn't pass through any pixel center, so the
+    // result doesn't depend on the fill rule.
+    {
+        const auto vertices = Array{
+            SoftwareVertex{.position = Vec2(10, 1), .uv = Vec2(), .color = blue},
+            SoftwareVertex{.position = Vec2(15.5f, 1), .uv = Vec2(), .color = blue},
+            SoftwareVertex{.position = Vec2(10, 6.5f), .uv = Vec2(), .color = blue},
+        };
+
+        constexpr auto indices = Array<u32, 3>{0, 1, 2};
+
+        rasterizer.drawTriangles(
+            SoftwareDrawState{
+                .target      = &target,
+                .image       = nullptr,
+                .sampler     = pointClamp,
+                .blendState  = alphaBlend,
+                .scissorRect = none,
+            },
+            vertices,
+            indices);
+    }
+
+    // Mesh: premultiplied, half-transparent yellow that blends over everything else.
+    rasterizer.drawTriangles(
+        SoftwareDrawState{
+            .target      = &target,
+            .image       = nullptr,
+            .sampler     = pointClamp,
+            .blendState  = alphaBlend,
+            .scissorRect = Rectangle(0, 0, 16, 11),
+        },
+        quad(Rectangle(6, 5, 6, 7), Color(0.5f, 0.5f, 0.0f, 0.5f)),
+        quadIndices);
+}
+
+TEST_CASE("SoftwareRasterizer reference scene", "[graphics]")
+{
+    auto workerPool = WorkerPool(0);
+    auto rasterizer = SoftwareRasterizer(workerPool);
+    auto target     = SoftwareSurface(sceneWidth, sceneHeight, ImageFormat::R8G8B8A8UNorm, nullptr);
+
+    drawScene(rasterizer, target);
+
+    auto pixels = List<u8>();
+    pixels.resize(sceneWidth * sceneHeight * 4);
+    target.read(0, 0, sceneWidth, sceneHeight, pixels.data());
+
+    for (auto y = 0u; y < sceneHeight; ++y)
+    {
+        for (auto x = 0u; x < sceneWidth; ++x)
+        {
+            const auto  expected = referenceColor(referenceImage[y][x]);
+            const auto* actual   = &pixels[(y * sceneWidth + x) * 4];
+
+            CAPTURE(x, y);
+
+            for (auto channel = 0u; channel < 4u; ++channel)
+            {
+                // Allow for rounding differences in blending.
+                REQUIRE(abs(int(actual[channel]) - int(expected[channel])) <= 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("SoftwareRasterizer partial readback", "[graphics]")
+{
+    auto workerPool = WorkerPool(0);
+    auto rasterizer = SoftwareRasterizer(workerPool);
+    auto target     = SoftwareSurface(sceneWidth, sceneHeight, ImageFormat::R8G8B8A8UNorm, nullptr);
+
+    drawScene(rasterizer, target);
+
+    // The sprite's top-right texel, next to the polygon.
+    auto pixels = Array<u8, 3 * 2 * 4>();
+    target.read(7, 1, 3, 2, pixels.data());
+
+    REQUIRE(pixels == Array<u8, 3 * 2 * 4>{
+                          0, 255, 0, 255, 0, 255, 0, 255, 0, 0, 0, 255, // Row 1
+                          0, 255, 0, 255, 0, 255, 0, 255, 0, 0, 0, 255, // Row 2
+                      });
+
+    REQUIRE_THROWS_AS(target.read(14, 0, 3, 1, pixels.data()), Error);
+}
+
+TEST_CASE("SoftwareRasterizer parallel tiles match sequential rendering", "[graphics]")
+{
+    constexpr auto width  = 300u;
+    constexpr auto height = 250u;
+
+    Random::seed(1);
+
+    // Large, overlapping and blended triangles, so that draws are split across tiles and
+    // the results depend on the order in which triangles are processed.
+    auto vertices = List<SoftwareVertex>();
+    auto indices  = List<u32>();
+
+    for (auto i = 0u; i < 200u * 3u; ++i)
+    {
+        vertices.add(
+            SoftwareVertex{
+                .position = Random::nextVec2(FloatInterval(-20, 320)),
+                .uv       = Vec2(),
+                .color    = Random::nextColor() * 0.5f,
+            });
+
+        indices.add(i);
+    }
+
+    const auto render = [&](u32 workerCount)
+    {
+        auto workerPool = WorkerPool(workerCount);
+        auto rasterizer = SoftwareRasterizer(workerPool);
+        auto target     = SoftwareSurface(width, height, ImageFormat::R8G8B8A8UNorm, nullptr);
+
+        target.clear(black);
+
+        rasterizer.drawTriangles(
+            SoftwareDrawState{
+                .target      = &target,
+                .image       = nullptr,
+                .sampler     = pointClamp,
+                .blendState  = alphaBlend,
+                .scissorRect = none,
+            },
+            vertices,
+            indices);
+
+        auto pixels = List<u8>();
+        pixels.resize(width * height * 4);
+        target.read(0, 0, width, height, pixels.data());
+
+        return pixels;
+    };
+
+    REQUIRE(render(0) == render(4));
+}
+
+#endif
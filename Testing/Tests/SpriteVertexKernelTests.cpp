@@ -0,0 +1,195 @@
+#include "Polly/Graphics/SpriteVertexKernel.hpp"
+#include "Polly/List.hpp"
+#include "Polly/Random.hpp"
+#include <snitch/snitch.hpp>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+enum class RotationKind
+{
+    None,
+    Small,
+    Large,
+    Mixed,
+};
+
+static const auto imageSizesAndInverse = Array{
+    Rectangle(64, 64, 1.0f / 64, 1.0f / 64),
+    Rectangle(512, 128, 1.0f / 512, 1.0f / 128),
+    Rectangle(33, 700, 1.0f / 33, 1.0f / 700),
+};
+
+static Radians randomRotation(RotationKind kind)
+{
+    switch (kind)
+    {
+        case RotationKind::None: return Radians(0);
+        case RotationKind::Small: return Radians(Random::nextFloat(FloatInterval(-10, 10)));
+        case RotationKind::Large: {
+            // Beyond the range of the approximated sine and cosine.
+            const auto angle = Random::nextFloat(FloatInterval(9000, 50000));
+            return Radians(Random::nextBool() ? angle : -angle);
+        }
+        case RotationKind::Mixed:
+            return Random::nextBool() ? Radians(0) : randomRotation(RotationKind::Small);
+    }
+
+    return Radians(0);
+}
+
+static List<InternalSprite> randomSprites(u32 count, RotationKind rotationKind)
+{
+    auto sprites = List<InternalSprite>();
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        const auto imageSlot = u8(Random::nextUInt(UIntInterval(0, imageSizesAndInverse.size() - 1)));
+        const auto imageSize = imageSizesAndInverse[imageSlot].position();
+
+        // A source rectangle without a size makes the origin relative to the image.
+        const auto hasSourceSize = Random::nextUInt(UIntInterval(0, 3)) != 0;
+
+        sprites.add(
+            InternalSprite{
+                .dst = Rectangle(
+                    Random::nextVec2(FloatInterval(-500, 2000)),
+                    Random::nextVec2(FloatInterval(1, 300))),
+                .src = hasSourceSize ? Rectangle(
+                                           Random::nextVec2(FloatInterval(0, 32)),
+                                           Random::nextFloat(FloatInterval(1, imageSize.x)),
+                                           Random::nextFloat(FloatInterval(1, imageSize.y)))
+                                     : Rectangle(),
+                .color     = Random::nextColor(),
+                .origin    = Random::nextBool() ? Random::nextVec2(FloatInterval(-50, 50)) : Vec2(),
+                .rotation  = randomRotation(rotationKind),
+                .flip      = SpriteFlip(Random::nextUInt(UIntInterval(0, 3))),
+                .isCanvas  = Random::nextBool(),
+                .imageSlot = imageSlot,
+            });
+    }
+
+    return sprites;
+}
+
+static bool isClose(float lhs, float rhs)
+{
+    // The kernel approximates sine and cosine, which is noticeable at large destinations.
+    constexpr auto tolerance = 1.0e-3f;
+
+    return abs(lhs - rhs) <= tolerance * max(1.0f, abs(lhs), abs(rhs));
+}
+
+template<bool FlipCanvasUpsideDown, typename T>
+static void requireSameVertices(Span<InternalSprite> sprites)
+{
+    auto scalarVertices = List<T>();
+    auto simdVertices   = List<T>();
+    scalarVertices.resize(sprites.size() * 4);
+    simdVertices.resize(sprites.size() * 4);
+
+    for (auto i = 0u; i < sprites.size(); ++i)
+    {
+        const auto& sprite = sprites[i];
+        const auto& image  = imageSizesAndInverse[sprite.imageSlot];
+        fillSprite<FlipCanvasUpsideDown>(sprite, &scalarVertices[i * 4], image);
+    }
+
+    const auto simdSpriteCount =
+        fillSpriteVerticesSimd(simdVertices.data(), sprites, imageSizesAndInverse, FlipCanvasUpsideDown);
+
+    // Targets without SIMD support don't write anything.
+    REQUIRE((simdSpriteCount == 0 or simdSpriteCount == sprites.size() / 4 * 4));
+
+    for (auto i = 0u; i < simdSpriteCount * 4; ++i)
+    {
+        const auto& expected = scalarVertices[i];
+        const auto& actual   = simdVertices[i];
+
+        REQUIRE(isClose(actual.positionAndUV.x, expected.positionAndUV.x));
+        REQUIRE(isClose(actual.positionAndUV.y, expected.positionAndUV.y));
+        REQUIRE(isClose(actual.positionAndUV.z, expected.positionAndUV.z));
+        REQUIRE(isClose(actual.positionAndUV.w, expected.positionAndUV.w));
+        REQUIRE(actual.color == expected.color);
+
+        if constexpr (std::is_same_v<T, MultiImageSpriteVertex>)
+        {
+            REQUIRE(actual.imageSlot == expected.imageSlot);
+        }
+    }
+}
+
+static void requireSameVerticesForAllLayouts(RotationKind rotationKind)
+{
+    Random::seed(u64(rotationKind) + 1);
+
+    // Not a multiple of four, so that the kernel leaves some sprites to the caller.
+    const auto sprites = randomSprites(1001, rotationKind);
+
+    requireSameVertices<false, SpriteVertex>(sprites);
+    requireSameVertices<true, SpriteVertex>(sprites);
+    requireSameVertices<false, MultiImageSpriteVertex>(sprites);
+    requireSameVertices<true, MultiImageSpriteVertex>(sprites);
+}
+
+TEST_CASE("SpriteVertexKernel unrotated sprites", "[graphics]")
+{
+    requireSameVerticesForAllLayouts(RotationKind::None);
+}
+
+TEST_CASE("SpriteVertexKernel rotated sprites", "[graphics]")
+{
+    requireSameVerticesForAllLayouts(RotationKind::Small);
+}
+
+TEST_CASE("SpriteVertexKernel large rotations", "[graphics]")
+{
+    requireSameVerticesForAllLayouts(RotationKind::Large);
+}
+
+TEST_CASE("SpriteVertexKernel partially rotated groups", "[graphics]")
+{
+    requireSameVerticesForAllLayouts(RotationKind::Mixed);
+}
+
+TEST_CASE("SpriteVertexKernel flips", "[graphics]")
+{
+    const auto imageSize = imageSizesAndInverse[0];
+
+    auto sprites = List<InternalSprite>();
+
+    constexpr auto flips =
+        Array{SpriteFlip::None, SpriteFlip::Horizontally, SpriteFlip::Vertically, SpriteFlip::Both};
+
+    for (const auto flip : flips)
+    {
+        sprites.add(
+            InternalSprite{
+                .dst       = Rectangle(10, 20, 64, 64),
+                .src       = Rectangle(0, 0, 64, 64),
+                .color     = white,
+                .origin    = Vec2(),
+                .rotation  = Radians(0),
+                .flip      = flip,
+                .isCanvas  = true,
+                .imageSlot = 0,
+            });
+    }
+
+    requireSameVertices<false, SpriteVertex>(sprites);
+    requireSameVertices<true, SpriteVertex>(sprites);
+
+    // Check the actual UVs as well, in case both paths are wrong in the same way.
+    auto vertices = Array<SpriteVertex, 4>();
+    fillSprite<false>(sprites[1], vertices.data(), imageSize);
+
+    REQUIRE(vertices[0].positionAndUV == Vec4(10, 20, 1, 0));
+    REQUIRE(vertices[1].positionAndUV == Vec4(74, 20, 0, 0));
+    REQUIRE(vertices[2].positionAndUV == Vec4(10, 84, 1, 1));
+    REQUIRE(vertices[3].positionAndUV == Vec4(74, 84, 0, 1));
+
+    // Canvases are flipped vertically in addition.
+    fillSprite<true>(sprites[1], vertices.data(), imageSize);
+
+    REQUIRE(vertices[0].positionAndUV == Vec4(10, 20, 1, 1));
+    REQUIRE(vertices[3].positionAndUV == Vec4(74, 84, 0, 0));
+}
@@ -0,0 +1,48 @@
+#include "Polly/Graphics/UniformBufferCursor.hpp"
+#include <snitch/snitch.hpp>
+
+using namespace Polly; // NOLINT(*-build-using-namespace)
+
+TEST_CASE("UniformBufferCursor alignment", "[graphics]")
+{
+    auto cursor = UniformBufferCursor(256, 1024);
+
+    auto a = cursor.allocate(64);
+    REQUIRE(a.offset == 0u);
+    REQUIRE(not a.newCapacity);
+    REQUIRE(cursor.usedBytes() == 64u);
+
+    // Padded up to the next multiple of the alignment.
+    auto b = cursor.allocate(64);
+    REQUIRE(b.offset == 256u);
+    REQUIRE(not b.newCapacity);
+    REQUIRE(cursor.usedBytes() == 256u + 64u);
+
+    cursor.reset();
+    REQUIRE(cursor.usedBytes() == 0u);
+    REQUIRE(cursor.allocate(16).offset == 0u);
+}
+
+TEST_CASE("UniformBufferCursor growth", "[graphics]")
+{
+    auto cursor = UniformBufferCursor(256, 512);
+
+    REQUIRE(cursor.allocate(200).offset == 0u);
+    REQUIRE(cursor.allocate(200).offset == 256u);
+    REQUIRE(cursor.usedBytes() == 456u);
+
+    // The next aligned offset (512) lies beyond the capacity, so the buffer grows.
+    auto grown = cursor.allocate(100);
+    REQUIRE(grown.offset == 0u);
+    REQUIRE(grown.newCapacity);
+    REQUIRE(*grown.newCapacity == 1024u);
+    REQUIRE(cursor.capacity() == 1024u);
+
+    // The new buffer starts without padding.
+    REQUIRE(cursor.usedBytes() == 456u + 100u);
+
+    auto next = cursor.allocate(50);
+    REQUIRE(next.offset == 256u);
+    REQUIRE(not next.newCapacity);
+    REQUIRE(cursor.usedBytes() == 456u + 100u + 156u + 50u);
+}